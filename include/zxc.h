@@ -11,6 +11,7 @@
 
 #include "zxc_buffer.h"     // IWYU pragma: keep
 #include "zxc_constants.h"  // IWYU pragma: keep
+#include "zxc_pool.h"       // IWYU pragma: keep
 #include "zxc_stream.h"     // IWYU pragma: keep
 
 #endif  // ZXC_H
\ No newline at end of file
@@ -11,6 +11,9 @@
 
 #include <stddef.h>
 
+#include "zxc_constants.h"
+#include "zxc_pool.h"
+
 /*
  * ============================================================================
  * ZXC Compression Library - Public API (Buffer-Based)
@@ -21,8 +24,8 @@
  * @brief Calculates the maximum theoretical compressed size for a given input.
  *
  * Useful for allocating output buffers before compression.
- * Accounts for file headers, block headers, and potential expansion
- * of incompressible data.
+ * Accounts for file headers, block headers, the seek table and potential
+ * expansion of incompressible data, for any accepted block size.
  *
  * @param[in] input_size Size of the input data in bytes.
  *
@@ -44,12 +47,14 @@ size_t zxc_compress_bound(size_t input_size);
  * @param[in] level        Compression level (e.g., ZXC_LEVEL_BALANCED).
  * @param[in] checksum_enabled Flag indicating whether to verify the checksum of the
  * data (1 to enable, 0 to disable).
+ * @param[in] block_size   Block size in bytes: a power of two between
+ * ZXC_BLOCK_SIZE_MIN and ZXC_BLOCK_SIZE_MAX, or 0 for ZXC_BLOCK_SIZE_DEFAULT.
  *
  * @return The number of bytes written to dst, or 0 if the destination buffer
- * is too small or an error occurred.
+ * is too small or an error occurred (including an invalid block size).
  */
 size_t zxc_compress(const void* src, size_t src_size, void* dst, size_t dst_capacity, int level,
-                    int checksum_enabled);
+                    int checksum_enabled, size_t block_size);
 
 /**
  * @brief Decompresses a ZXC compressed buffer.
@@ -71,4 +76,426 @@ size_t zxc_compress(const void* src, size_t src_size, void* dst, size_t dst_capa
 size_t zxc_decompress(const void* src, size_t src_size, void* dst, size_t dst_capacity,
                       int checksum_enabled);
 
+/*
+ * ============================================================================
+ * Reusable Contexts
+ * ============================================================================
+ * For workloads made of many small buffers, creating a context once and
+ * reusing it avoids the per-call allocation and hash table reset performed by
+ * zxc_compress() / zxc_decompress(). A context must not be used by several
+ * threads at the same time.
+ */
+
+/**
+ * @typedef zxc_cctx_t
+ * @brief Compression context (opaque here; defined in zxc_sans_io.h).
+ */
+typedef struct zxc_cctx_s zxc_cctx_t;
+
+/**
+ * @typedef zxc_dctx_t
+ * @brief Decompression context. Shares the compression context layout, of
+ * which only the literal scratch buffer is allocated.
+ */
+typedef struct zxc_cctx_s zxc_dctx_t;
+
+/**
+ * @brief Allocates a reusable compression context.
+ *
+ * @return A new context, or NULL if memory allocation fails. Release it with
+ * zxc_free_cctx().
+ */
+zxc_cctx_t* zxc_create_cctx(void);
+
+/**
+ * @brief Compresses a data buffer using a reusable context.
+ *
+ * Produces exactly the same output as zxc_compress() unless a cost model was
+ * set with zxc_cctx_set_cost_model(), or linked blocks or block trials were
+ * enabled with zxc_cctx_set_linked_blocks() or zxc_cctx_set_block_trials().
+ *
+ * @param[in,out] cctx     Context obtained from zxc_create_cctx().
+ * @param[in] src          Pointer to the source buffer.
+ * @param[in] src_size     Size of the source data in bytes.
+ * @param[out] dst          Pointer to the destination buffer.
+ * @param[in] dst_capacity Maximum capacity of the destination buffer.
+ * @param[in] level        Compression level (e.g., ZXC_LEVEL_BALANCED).
+ * @param[in] checksum_enabled Flag indicating whether to store block checksums.
+ * @param[in] block_size   Block size in bytes (0 for the default). The context
+ * grows its buffers the first time a larger block size is used.
+ *
+ * @return The number of bytes written to dst, or 0 if an error occurred.
+ */
+size_t zxc_compress_cctx(zxc_cctx_t* cctx, const void* src, size_t src_size, void* dst,
+                         size_t dst_capacity, int level, int checksum_enabled,
+                         size_t block_size);
+
+/**
+ * @brief Fills a cost model for the optimal parser (levels 6-10).
+ *
+ * @param[out] model       Model to fill.
+ * @param[in] decode_bias  Weight of decode speed against size: 0 optimizes
+ * size only; each step makes one estimated decode cycle worth 1/16 of an
+ * encoded byte (16: a cycle is worth a byte). Typical values are 1 to 8.
+ */
+void zxc_cost_model_init(zxc_cost_model_t* model, int decode_bias);
+
+/**
+ * @brief Sets the cost model used by a context at levels 6-10.
+ *
+ * The model stays with the context until changed; it has no effect at lower
+ * levels, whose parsers do not price sequences, except to rank the block
+ * trials (see zxc_cctx_set_block_trials()).
+ *
+ * @param[in,out] cctx Context obtained from zxc_create_cctx().
+ * @param[in] model    Model to use, or NULL to restore the size-only default.
+ */
+void zxc_cctx_set_cost_model(zxc_cctx_t* cctx, const zxc_cost_model_t* model);
+
+/**
+ * @brief Enables or disables linked blocks for the frames compressed with a context.
+ *
+ * In a linked frame, every block may reference the last 64 KB of the previous
+ * one, which recovers most of the ratio lost at block starts. The blocks must
+ * then be decoded in order: multi-threaded decompression of such a frame runs
+ * on a single thread, and zxc_decompress_range() decodes from the first block.
+ * Independent blocks are the default; every decoder recognizes both kinds.
+ *
+ * @param[in,out] cctx Context obtained from zxc_create_cctx().
+ * @param[in] enabled  Non-zero to link the blocks.
+ */
+void zxc_cctx_set_linked_blocks(zxc_cctx_t* cctx, int enabled);
+
+/**
+ * @brief Enables or disables per-block trial encoding for a context.
+ *
+ * Every block is then encoded as GLO, GHI and (for 32-bit aligned sizes) NUM,
+ * with the parser of the compression level, and the block that minimizes the
+ * cost model's `byte_weight * size + cycle_weight * estimated decode cycles`
+ * is kept (size only without a cost model, see zxc_cctx_set_cost_model()).
+ * Compression is about three times slower; the frames decode as usual.
+ *
+ * @param[in,out] cctx Context obtained from zxc_create_cctx().
+ * @param[in] enabled  Non-zero to try every block type.
+ */
+void zxc_cctx_set_block_trials(zxc_cctx_t* cctx, int enabled);
+
+/**
+ * @brief Loads a dictionary into a compression context.
+ *
+ * The dictionary is copied; the first block of every frame compressed with the
+ * context may then reference it, as if it preceded the data, which helps
+ * small inputs most. Its ID (zxc_dict_id()) is recorded in the file header, and
+ * the frame can only be decompressed with the same dictionary.
+ *
+ * @param[in,out] cctx  Context obtained from zxc_create_cctx().
+ * @param[in] dict      Dictionary content (e.g. from zxc_train_dict()), or NULL
+ * to unload the current one. Only the last ZXC_DICT_SIZE_MAX bytes are kept.
+ * @param[in] dict_size Size of `dict` in bytes (0 unloads).
+ *
+ * @return 0 on success, -1 if memory allocation fails.
+ */
+int zxc_cctx_load_dict(zxc_cctx_t* cctx, const void* dict, size_t dict_size);
+
+/**
+ * @brief Releases a context created by zxc_create_cctx(). NULL is accepted.
+ *
+ * @param[in] cctx Context to free.
+ */
+void zxc_free_cctx(zxc_cctx_t* cctx);
+
+/**
+ * @brief Allocates a reusable decompression context.
+ *
+ * @return A new context, or NULL if memory allocation fails. Release it with
+ * zxc_free_dctx().
+ */
+zxc_dctx_t* zxc_create_dctx(void);
+
+/**
+ * @brief Decompresses a ZXC compressed buffer using a reusable context.
+ *
+ * The RLE literal scratch buffer grows as needed and is kept for later calls.
+ *
+ * @param[in,out] dctx     Context obtained from zxc_create_dctx().
+ * @param[in] src          Pointer to the source buffer containing compressed data.
+ * @param[in] src_size     Size of the compressed data in bytes.
+ * @param[out] dst          Pointer to the destination buffer.
+ * @param[in] dst_capacity Capacity of the destination buffer.
+ * @param[in] checksum_enabled Flag indicating whether to verify block checksums.
+ *
+ * @return The number of bytes written to dst, or 0 if decompression fails.
+ */
+size_t zxc_decompress_dctx(zxc_dctx_t* dctx, const void* src, size_t src_size, void* dst,
+                           size_t dst_capacity, int checksum_enabled);
+
+/**
+ * @brief Loads the dictionary needed by frames compressed with one.
+ *
+ * Frames whose dictionary ID differs from the loaded dictionary's are
+ * rejected; frames without a dictionary are decoded as usual.
+ *
+ * @param[in,out] dctx  Context obtained from zxc_create_dctx().
+ * @param[in] dict      Dictionary content, or NULL to unload the current one.
+ * @param[in] dict_size Size of `dict` in bytes (0 unloads).
+ *
+ * @return 0 on success, -1 if memory allocation fails.
+ */
+int zxc_dctx_load_dict(zxc_dctx_t* dctx, const void* dict, size_t dict_size);
+
+/**
+ * @brief Releases a context created by zxc_create_dctx(). NULL is accepted.
+ *
+ * @param[in] dctx Context to free.
+ */
+void zxc_free_dctx(zxc_dctx_t* dctx);
+
+/**
+ * @brief Returns the original (decompressed) size of a ZXC compressed buffer.
+ *
+ * The size is read from the file header when the compressor recorded it
+ * (always the case for `zxc_compress`, and for the stream compressor when the
+ * input size is known), otherwise from the trailing seek table if present.
+ * Only the header and footer are inspected; no block is decoded.
+ *
+ * @param[in] src      Pointer to the source buffer containing compressed data.
+ * @param[in] src_size Size of the compressed data in bytes.
+ *
+ * @return The decompressed size in bytes, or 0 if it is unknown or the header
+ * is invalid.
+ */
+size_t zxc_get_decompressed_size(const void* src, size_t src_size);
+
+/**
+ * @brief Compresses a data buffer on the threads of `pool`.
+ *
+ * Blocks are compressed concurrently, each into a provisional slot of `dst`,
+ * then compacted in place. Produces exactly the same output as zxc_compress(),
+ * without allocating a context once the pool has seen the same or a larger
+ * block size. A `dst_capacity` of at least zxc_compress_bound(src_size) is
+ * needed for parallel operation; smaller buffers are compressed sequentially.
+ *
+ * @param[in] pool         Pool obtained from zxc_create_pool().
+ * @param[in] src          Pointer to the source buffer.
+ * @param[in] src_size     Size of the source data in bytes.
+ * @param[out] dst          Pointer to the destination buffer.
+ * @param[in] dst_capacity Maximum capacity of the destination buffer.
+ * @param[in] level        Compression level (e.g., ZXC_LEVEL_BALANCED).
+ * @param[in] checksum_enabled Flag indicating whether to store block checksums.
+ * @param[in] block_size   Block size in bytes (0 for the default).
+ *
+ * @return The number of bytes written to dst, or 0 if an error occurred.
+ */
+size_t zxc_compress_pool(zxc_pool_t* pool, const void* src, size_t src_size, void* dst,
+                         size_t dst_capacity, int level, int checksum_enabled,
+                         size_t block_size);
+
+/**
+ * @brief Compresses a data buffer using several threads.
+ *
+ * Same as zxc_compress_pool() on a temporary pool of `n_threads` threads.
+ * Applications compressing many buffers should keep a pool instead.
+ *
+ * @param[in] src          Pointer to the source buffer.
+ * @param[in] src_size     Size of the source data in bytes.
+ * @param[out] dst          Pointer to the destination buffer.
+ * @param[in] dst_capacity Maximum capacity of the destination buffer.
+ * @param[in] n_threads    Number of threads (0 = auto-detect number of CPU cores).
+ * @param[in] level        Compression level (e.g., ZXC_LEVEL_BALANCED).
+ * @param[in] checksum_enabled Flag indicating whether to store block checksums.
+ * @param[in] block_size   Block size in bytes (0 for the default).
+ *
+ * @return The number of bytes written to dst, or 0 if an error occurred.
+ */
+size_t zxc_compress_mt(const void* src, size_t src_size, void* dst, size_t dst_capacity,
+                       int n_threads, int level, int checksum_enabled, size_t block_size);
+
+/**
+ * @brief Decompresses a ZXC compressed buffer on the threads of `pool`.
+ *
+ * The block headers are scanned first to place every block in `dst`; the pool
+ * threads then decode blocks concurrently, each straight into its final
+ * position. Produces the same result as zxc_decompress().
+ *
+ * @param[in] pool         Pool obtained from zxc_create_pool().
+ * @param[in] src          Pointer to the source buffer containing compressed data.
+ * @param[in] src_size     Size of the compressed data in bytes.
+ * @param[out] dst          Pointer to the destination buffer.
+ * @param[in] dst_capacity Capacity of the destination buffer.
+ * @param[in] checksum_enabled Flag indicating whether to verify block checksums.
+ *
+ * @return The number of bytes written to dst, or 0 if decompression fails.
+ */
+size_t zxc_decompress_pool(zxc_pool_t* pool, const void* src, size_t src_size, void* dst,
+                           size_t dst_capacity, int checksum_enabled);
+
+/**
+ * @brief Decompresses a ZXC compressed buffer using several threads.
+ *
+ * Same as zxc_decompress_pool() on a temporary pool of `n_threads` threads.
+ * Applications decompressing many buffers should keep a pool instead.
+ *
+ * @param[in] src          Pointer to the source buffer containing compressed data.
+ * @param[in] src_size     Size of the compressed data in bytes.
+ * @param[out] dst          Pointer to the destination buffer.
+ * @param[in] dst_capacity Capacity of the destination buffer.
+ * @param[in] n_threads    Number of threads (0 = auto-detect number of CPU cores).
+ * @param[in] checksum_enabled Flag indicating whether to verify block checksums.
+ *
+ * @return The number of bytes written to dst, or 0 if decompression fails.
+ */
+size_t zxc_decompress_mt(const void* src, size_t src_size, void* dst, size_t dst_capacity,
+                         int n_threads, int checksum_enabled);
+
+/**
+ * @brief Decompresses a byte range of a ZXC compressed buffer.
+ *
+ * Only the blocks covering `[raw_offset, raw_offset + len)` are decoded. When
+ * the buffer ends with a seek table (written by the stream compressor), the
+ * first covering block is found by binary search; otherwise the block headers
+ * are walked from the start without decoding. Block checksums are verified
+ * when present. In a linked frame, every block up to the end of the range is
+ * decoded, since each one depends on the previous one.
+ *
+ * @param[in] src          Pointer to the source buffer containing compressed data.
+ * @param[in] src_size     Size of the compressed data in bytes.
+ * @param[in] raw_offset   Offset of the first requested byte in the decompressed data.
+ * @param[in] len          Number of bytes requested.
+ * @param[out] dst          Pointer to the destination buffer (at least `len` bytes).
+ *
+ * @return The number of bytes written to dst (less than `len` if the range
+ * extends past the end of the data), or 0 if raw_offset is out of range or
+ * decompression fails. This function has no dictionary: on a frame compressed
+ * with one, ranges that start in the first block fail, and so does every range
+ * of a linked frame (see zxc_decompress_range_dctx()).
+ */
+size_t zxc_decompress_range(const void* src, size_t src_size, size_t raw_offset, size_t len,
+                            void* dst);
+
+/**
+ * @brief Decompresses a byte range of a ZXC compressed buffer with a context.
+ *
+ * Same as zxc_decompress_range(), but the first block of a frame compressed
+ * with a dictionary is decoded with the one loaded in the context (see
+ * zxc_dctx_load_dict()), so every range of such a frame can be decoded.
+ *
+ * @param[in,out] dctx     Decompression context (with the frame's dictionary, if any).
+ * @param[in] src          Pointer to the source buffer containing compressed data.
+ * @param[in] src_size     Size of the compressed data in bytes.
+ * @param[in] raw_offset   Offset of the first requested byte in the decompressed data.
+ * @param[in] len          Number of bytes requested.
+ * @param[out] dst          Pointer to the destination buffer (at least `len` bytes).
+ * @param[in] checksum_enabled If non-zero, verifies the block checksums.
+ *
+ * @return The number of bytes written to dst (less than `len` if the range
+ * extends past the end of the data), or 0 if raw_offset is out of range or
+ * decompression fails (including a frame whose dictionary is not loaded).
+ */
+size_t zxc_decompress_range_dctx(zxc_dctx_t* dctx, const void* src, size_t src_size,
+                                 size_t raw_offset, size_t len, void* dst, int checksum_enabled);
+
+/**
+ * @brief Returns the ID of a dictionary, as recorded in the frames it compresses.
+ *
+ * The ID is a 32-bit hash of the dictionary content (its last
+ * ZXC_DICT_SIZE_MAX bytes); it is never 0.
+ *
+ * @param[in] dict      Dictionary content.
+ * @param[in] dict_size Size of `dict` in bytes.
+ *
+ * @return The dictionary ID, or 0 if `dict` is NULL or empty.
+ */
+uint32_t zxc_dict_id(const void* dict, size_t dict_size);
+
+/**
+ * @brief Returns the ID of the dictionary a compressed buffer needs.
+ *
+ * @param[in] src      Pointer to the compressed data (the file header is enough).
+ * @param[in] src_size Size of the compressed data in bytes.
+ *
+ * @return The dictionary ID, or 0 if the frame needs no dictionary or the
+ * header is invalid.
+ */
+uint32_t zxc_get_dict_id(const void* src, size_t src_size);
+
+/**
+ * @brief Builds a dictionary from sample inputs.
+ *
+ * Samples are cut into segments; the segments whose 8-byte substrings occur
+ * in the most samples are kept, the most useful ones last (closest to the
+ * data, so at the smallest offsets). When the samples are smaller than the
+ * capacity, the dictionary is simply their concatenation.
+ *
+ * @param[out] dict          Destination of the dictionary.
+ * @param[in] dict_capacity  Capacity of `dict` (at most ZXC_DICT_SIZE_MAX is used).
+ * @param[in] samples        Samples, stored back to back.
+ * @param[in] sample_sizes   Size of each sample.
+ * @param[in] n_samples      Number of samples.
+ *
+ * @return The size of the dictionary, or 0 on error (no samples, allocation
+ * failure).
+ */
+size_t zxc_train_dict(void* dict, size_t dict_capacity, const void* samples,
+                      const size_t* sample_sizes, size_t n_samples);
+
+/**
+ * @struct zxc_block_cost_t
+ * @brief Decode cost estimate of one block (see zxc_estimate_decode_cost()).
+ */
+typedef struct {
+    size_t comp_offset;    // Offset of the block header in the compressed buffer
+    size_t raw_offset;     // Offset of the block in the decompressed data
+    uint32_t raw_size;     // Decompressed size
+    uint32_t comp_size;    // Payload size
+    uint32_t n_sequences;  // LZ sequences (0 for RAW, NUM and FLT blocks)
+    uint8_t block_type;    // 0 = RAW, 1 = GLO, 2 = NUM, 3 = GHI, 5 = FLT
+    uint64_t est_cycles;   // Estimated decode cycles under the cost model
+} zxc_block_cost_t;
+
+/**
+ * @brief Estimates the decode cost of every block of a compressed buffer.
+ *
+ * LZ blocks are costed sequence by sequence with the cycle fields of `model`
+ * (its weights are ignored); RAW and NUM blocks are costed as one wild copy
+ * per 32 bytes. Compare with measured per-block times (e.g. with
+ * zxc_decompress_block_dctx()) to calibrate the model for a target CPU.
+ *
+ * @param[in] src        Compressed buffer (a complete frame).
+ * @param[in] src_size   Size of the compressed buffer.
+ * @param[in] model      Cost model, or NULL for zxc_cost_model_init() defaults.
+ * @param[out] blocks    Per-block estimates (may be NULL when max_blocks is 0).
+ * @param[in] max_blocks Capacity of `blocks`.
+ *
+ * @return The number of blocks in the frame (only the first `max_blocks` are
+ * stored), or 0 if the buffer is malformed.
+ */
+size_t zxc_estimate_decode_cost(const void* src, size_t src_size,
+                                const zxc_cost_model_t* model, zxc_block_cost_t* blocks,
+                                size_t max_blocks);
+
+/**
+ * @brief Decodes one block of a frame again, in place in the decompressed frame.
+ *
+ * Times blocks one by one, e.g. against zxc_estimate_decode_cost(): `frame`
+ * holds the whole decompressed frame (from zxc_decompress_dctx()), so a linked
+ * block finds the tail of the previous one right before it and only this
+ * block is decoded (zxc_decompress_range() decodes a linked frame from its
+ * first block). As with any destination buffer, bytes after the block, up to
+ * `frame_size`, may be used as scratch: decode the blocks in order to leave
+ * `frame` intact.
+ *
+ * @param[in] dctx         Decompression context (with the frame's dictionary, if any).
+ * @param[in] src          Compressed buffer (a complete frame).
+ * @param[in] src_size     Size of the compressed buffer.
+ * @param[in] block        Block to decode, as listed by zxc_estimate_decode_cost().
+ * @param[in,out] frame    Decompressed frame; the block is written again.
+ * @param[in] frame_size   Size of `frame`.
+ * @param[in] checksum_enabled If non-zero, verifies the block's checksum.
+ *
+ * @return The decompressed size of the block, or 0 on error.
+ */
+size_t zxc_decompress_block_dctx(zxc_dctx_t* dctx, const void* src, size_t src_size,
+                                 const zxc_block_cost_t* block, void* frame, size_t frame_size,
+                                 int checksum_enabled);
+
 #endif  // ZXC_BUFFER_H
\ No newline at end of file
@@ -9,6 +9,8 @@
 #ifndef ZXC_CONSTANTS_H
 #define ZXC_CONSTANTS_H
 
+#include <stdint.h>
+
 /*
  * ============================================================================
  * ZXC Compression Library - Public Constants
@@ -41,7 +43,58 @@ typedef enum {
     ZXC_LEVEL_FAST = 2,      // Fast compression, good for real-time applications
     ZXC_LEVEL_DEFAULT = 3,   // Recommended: ratio > LZ4, decode speed > LZ4
     ZXC_LEVEL_BALANCED = 4,  // Good ratio, good decode speed
-    ZXC_LEVEL_COMPACT = 5    // High density. Best for storage/firmware/assets.
+    ZXC_LEVEL_COMPACT = 5,   // High density. Best for storage/firmware/assets.
+    ZXC_LEVEL_OPTIMAL = 6,   // Optimal (price-based) parsing: slow compression, same decoder
+    ZXC_LEVEL_DENSE = 10,    // Level 9 parsing + Huffman-coded literals: densest, slower decode
+    ZXC_LEVEL_MAX = 10       // Maximum ratio
 } zxc_compression_level_t;
 
+/* =============================================================
+ * ZXC Block Sizes
+ * =============================================================
+ * Accepted by the compression APIs (0 selects ZXC_BLOCK_SIZE_DEFAULT).
+ * Must be a power of two within [ZXC_BLOCK_SIZE_MIN, ZXC_BLOCK_SIZE_MAX].
+ * Smaller blocks: finer random access, lower first-byte latency.
+ * Larger blocks: better ratio, less per-block overhead.
+ */
+
+#define ZXC_BLOCK_SIZE_MIN (16 * 1024)         // 16 KB
+#define ZXC_BLOCK_SIZE_DEFAULT (256 * 1024)    // 256 KB
+#define ZXC_BLOCK_SIZE_MAX (2 * 1024 * 1024)  // 2 MB
+
+/* =============================================================
+ * ZXC Dictionaries
+ * =============================================================
+ * A dictionary is plain content that the first block of a frame may reference,
+ * as if it preceded the data. Only its last ZXC_DICT_SIZE_MAX bytes are used.
+ */
+
+#define ZXC_DICT_SIZE_MAX (64 * 1024)  // 64 KB: the reach of the 16-bit offsets
+
+/* =============================================================
+ * ZXC Cost Model
+ * =============================================================
+ */
+
+/**
+ * @typedef zxc_cost_model_t
+ * @brief Price model of the optimal parser (levels >= 6).
+ *
+ * The parser minimizes `byte_weight * encoded bytes + cycle_weight * estimated
+ * decode cycles`. The cycle estimate follows the GLO decoder: a fixed cost per
+ * sequence, one wild copy per 32 bytes (16 bytes when the offset is below 32),
+ * and penalties for offsets below 16 (overlap copy) and for literal runs longer
+ * than one wild copy. An all-zero model (the default) optimizes size only.
+ *
+ * Fill it with zxc_cost_model_init() and adjust individual fields if needed.
+ */
+typedef struct {
+    uint32_t byte_weight;       // Price of one encoded byte
+    uint32_t cycle_weight;      // Price of one estimated decode cycle (0 = size only)
+    uint32_t seq_cycles;        // Per sequence: token, extras, first literal and match copy
+    uint32_t copy_cycles;       // Per additional wild copy
+    uint32_t short_off_cycles;  // Per match with an offset below 16
+    uint32_t long_lit_cycles;   // Per literal run longer than 32 bytes
+} zxc_cost_model_t;
+
 #endif  // ZXC_CONSTANTS_H
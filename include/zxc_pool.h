@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2025-2026, Bertrand Lebonnois
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#ifndef ZXC_POOL_H
+#define ZXC_POOL_H
+
+#include "zxc_constants.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * ============================================================================
+ * ZXC Compression Library - Persistent Thread Pool
+ * ============================================================================
+ * By default every streaming call spawns its worker and writer threads, and
+ * each worker allocates its own compression context, then tears everything
+ * down on return. A pool keeps the threads and their contexts alive between
+ * calls, which matters when many small or medium inputs are processed.
+ *
+ * A pool runs one operation at a time: concurrent calls sharing a pool are
+ * serialized. Use one pool per concurrent pipeline.
+ */
+
+/**
+ * @typedef zxc_pool_t
+ * @brief Opaque persistent thread pool.
+ */
+typedef struct zxc_pool_s zxc_pool_t;
+
+/**
+ * @brief Creates a thread pool.
+ *
+ * @param[in] n_threads Number of threads, with the same meaning as the
+ * `n_threads` argument of zxc_stream_compress() (0 = auto-detect the number of
+ * CPU cores).
+ *
+ * @return A new pool, or NULL if thread creation or memory allocation fails.
+ * Release it with zxc_free_pool().
+ */
+zxc_pool_t* zxc_create_pool(int n_threads);
+
+/**
+ * @brief Stops the pool threads and releases all their resources.
+ *
+ * Must not be called while an operation is running on the pool. NULL is
+ * accepted.
+ *
+ * @param[in] pool Pool to free.
+ */
+void zxc_free_pool(zxc_pool_t* pool);
+
+/**
+ * @brief Sets the cost model used by the pool's contexts at levels 6-10.
+ *
+ * Applies to the operations started after the call (see zxc_cost_model_init()).
+ *
+ * @param[in,out] pool Pool obtained from zxc_create_pool().
+ * @param[in] model    Model to use, or NULL to restore the size-only default.
+ */
+void zxc_pool_set_cost_model(zxc_pool_t* pool, const zxc_cost_model_t* model);
+
+/**
+ * @brief Enables or disables linked blocks for the frames compressed on the pool.
+ *
+ * Applies to the operations started after the call (see
+ * zxc_cctx_set_linked_blocks()). Blocks are still compressed in parallel;
+ * decompressing a linked frame uses a single worker.
+ *
+ * @param[in,out] pool Pool obtained from zxc_create_pool().
+ * @param[in] enabled  Non-zero to link the blocks.
+ */
+void zxc_pool_set_linked_blocks(zxc_pool_t* pool, int enabled);
+
+/**
+ * @brief Enables or disables per-block trial encoding on the pool.
+ *
+ * Applies to the operations started after the call (see
+ * zxc_cctx_set_block_trials()); blocks are still compressed in parallel.
+ *
+ * @param[in,out] pool Pool obtained from zxc_create_pool().
+ * @param[in] enabled  Non-zero to try every block type.
+ */
+void zxc_pool_set_block_trials(zxc_pool_t* pool, int enabled);
+
+/**
+ * @brief Enables or disables the seek table of the streams compressed on the pool.
+ *
+ * Enabled by default. The table (one 24-byte entry per block) lets
+ * zxc_decompress_range() find a block without walking the block headers, and
+ * zxc_get_decompressed_size() size a stream whose input size was unknown.
+ * Without it, the stream ends with its last block and decodes as usual.
+ * Applies to the operations started after the call.
+ *
+ * @param[in,out] pool Pool obtained from zxc_create_pool().
+ * @param[in] enabled  Non-zero to append the seek table.
+ */
+void zxc_pool_set_seek_table(zxc_pool_t* pool, int enabled);
+
+/**
+ * @brief Loads a dictionary for the operations run on the pool.
+ *
+ * Compressions (buffer and stream) reference it from the first block of each
+ * frame and record its ID; decompressions use it for the frames that carry
+ * that ID. See zxc_cctx_load_dict().
+ *
+ * @param[in,out] pool  Pool obtained from zxc_create_pool().
+ * @param[in] dict      Dictionary content, or NULL to unload the current one.
+ * @param[in] dict_size Size of `dict` in bytes (0 unloads).
+ *
+ * @return 0 on success, -1 if memory allocation fails.
+ */
+int zxc_pool_load_dict(zxc_pool_t* pool, const void* dict, size_t dict_size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // ZXC_POOL_H
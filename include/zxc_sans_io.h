@@ -12,6 +12,8 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include "zxc_constants.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -33,9 +35,9 @@ extern "C" {
  * **Key Fields:**
  * - `hash_table`: Stores indices of 4-byte sequences. Size is `2 *
  * ZXC_LZ_HASH_SIZE` to reduce collisions (load factor < 0.5).
- * - `chain_table`: Handles collisions by storing the *previous* occurrence of a
- *   hash. This forms a linked list for each hash bucket, allowing us to
- * traverse history.
+ * - `chain_table`: Handles collisions by storing the distance to the *previous*
+ *   occurrence of a hash. This forms a linked list for each hash bucket,
+ * allowing us to traverse history back to the start of the block.
  * - `epoch`: Used for "Lazy Hash Table Invalidation". Instead of
  * `ZXC_MEMSET`ing the entire hash table (which is slow) for every block, we
  * store `(epoch << 16) | offset`. If the stored epoch doesn't match the current
@@ -54,12 +56,39 @@ extern "C" {
  * @field lit_buffer_cap Current capacity of the literal scratch buffer.
  * @field checksum_enabled Flag indicating if checksums should be computed.
  * @field compression_level The configured compression level.
+ * @field chunk_size Block size the working buffers were sized for.
+ * @field opt_state Scratch state of the optimal parser (allocated on first use).
+ * @field bt_table Binary-tree match finder nodes: two children per position of
+ * the block and its linked prefix (allocated on first use).
+ * @field cost_model Price model of the optimal parser (kept across reallocations).
+ * @field linked_blocks Linked-block mode of the frame compressors (kept across
+ * reallocations).
+ * @field block_trials Encode every block as GLO, GHI and NUM and keep the
+ * cheapest (kept across reallocations).
+ * @field trial_buf Scratch output of the block trials (allocated on first use).
+ * @field trial_buf_cap Capacity of `trial_buf`.
+ * @field filter_buf Scratch of the block filters: the filtered block (compression)
+ * or its decoded byte planes (decompression), allocated on first use.
+ * @field filter_buf_cap Capacity of `filter_buf`.
+ * @field prefix_len Bytes of history right before the block being processed that
+ * it may reference (linked blocks); 0 for an independent block.
+ * @field dict_buf Loaded dictionary, followed by room to stage the first block
+ * of a frame behind it (NULL without a dictionary).
+ * @field dict_size Size of the loaded dictionary (0 = none).
+ * @field dict_buf_cap Capacity of `dict_buf`.
+ * @field dict_id ID of the loaded dictionary (0 = none).
+ * @field dict_tables Hash heads and match-finder nodes right after indexing the
+ * dictionary, restored instead of indexing it again (allocated on first use).
+ * @field dict_tables_key Indexing mode (level, parser) of `dict_tables`; 0 = none.
+ * @field dict_live_key Indexing mode of the dictionary nodes still in place in
+ * the chain table (0 = overwritten since).
+ * @field prefix_is_dict Set while compressing a block whose prefix is the dictionary.
  */
-typedef struct {
+typedef struct zxc_cctx_s {
     // Hot zone: random access / high frequency
     // Kept at the start to ensure they reside in the first cache line (64 bytes).
     uint32_t* hash_table;   // Hash table for LZ77
-    uint16_t* chain_table;  // Chain table for collision resolution
+    uint32_t* chain_table;  // Chain table for collision resolution
     void* memory_block;     // Single allocation block owner
     uint32_t epoch;         // Current epoch for hash table (checked per match)
 
@@ -75,6 +104,25 @@ typedef struct {
     size_t lit_buffer_cap;  // Current capacity of this buffer
     int checksum_enabled;   // Checksum enabled flag
     int compression_level;  // Compression level
+    size_t chunk_size;      // Block size the buffers are sized for
+    void* opt_state;        // Optimal parser scratch (levels >= 6, lazily allocated)
+    uint32_t* bt_table;     // Binary-tree nodes (tree levels, lazily allocated)
+    zxc_cost_model_t cost_model;  // Optimal parser prices (all zero = size only)
+    int linked_blocks;            // Frames compressed with this context are linked
+    int block_trials;             // Trial-encode each block with every block type
+    uint8_t* trial_buf;           // Scratch output of the trials (lazily allocated)
+    size_t trial_buf_cap;         // Capacity of trial_buf
+    uint8_t* filter_buf;          // Scratch of the block filters (lazily allocated)
+    size_t filter_buf_cap;        // Capacity of filter_buf
+    size_t prefix_len;            // History before the current block (linked blocks)
+    uint8_t* dict_buf;            // Dictionary + staging room for one block
+    size_t dict_size;             // Dictionary size (0 = none)
+    size_t dict_buf_cap;          // Capacity of dict_buf
+    uint32_t dict_id;             // Dictionary ID (0 = none)
+    uint32_t* dict_tables;        // Indexed dictionary snapshot (lazily allocated)
+    uint32_t dict_tables_key;     // Indexing mode of the snapshot (0 = none)
+    uint32_t dict_live_key;       // Indexing mode of the dictionary nodes in place (0 = none)
+    int prefix_is_dict;           // The current block's prefix is the dictionary
 } zxc_cctx_t;
 
 /**
@@ -105,19 +153,40 @@ int zxc_cctx_init(zxc_cctx_t* ctx, size_t chunk_size, int mode, int level, int c
  */
 void zxc_cctx_free(zxc_cctx_t* ctx);
 
+/**
+ * @brief Sentinel value for an unknown original content size.
+ *
+ * Pass it to `zxc_write_file_header` when the total input size is not known
+ * up front (e.g. compressing from a pipe); the optional content size field is
+ * then omitted from the header.
+ */
+#define ZXC_CONTENT_SIZE_UNKNOWN UINT64_MAX
+
 /**
  * @brief Writes the standard ZXC file header to a destination buffer.
  *
- * This function stores the magic word (little-endian) and the version number
- * into the provided buffer. It ensures the buffer has sufficient capacity
+ * This function stores the magic word (little-endian), the version number and
+ * the block size code (log2 of `block_size`) into the provided buffer. When
+ * `content_size` is known, the content size flag is set and the 8-byte
+ * original size is appended. It ensures the buffer has sufficient capacity
  * before writing.
  *
  * @param[out] dst The destination buffer where the header will be written.
  * @param[in] dst_capacity The total capacity of the destination buffer in bytes.
- * @return The number of bytes written (ZXC_FILE_HEADER_SIZE) on success,
- *         or -1 if the destination capacity is insufficient.
+ * @param[in] block_size Block size used by the compressor (power of two between
+ * 16 KB and 2 MB).
+ * @param[in] content_size Total size of the original data, or
+ * `ZXC_CONTENT_SIZE_UNKNOWN` to omit the field.
+ * @param[in] linked Non-zero if the blocks are linked: each one may reference the
+ * last 64 KB of the previous block (see `zxc_cctx_t::prefix_len`).
+ * @param[in] dict_id ID of the dictionary the first block was compressed with,
+ * or 0 for none; a non-zero ID is appended after the optional content size.
+ * @return The number of bytes written (8, plus 8 with a content size and 4 with
+ *         a dictionary ID) on success, or -1 if the destination capacity is
+ *         insufficient or the block size is invalid.
  */
-int zxc_write_file_header(uint8_t* dst, size_t dst_capacity);
+int zxc_write_file_header(uint8_t* dst, size_t dst_capacity, size_t block_size,
+                          uint64_t content_size, int linked, uint32_t dict_id);
 
 /**
  * @brief Validates and reads the ZXC file header from a source buffer.
@@ -128,11 +197,20 @@ int zxc_write_file_header(uint8_t* dst, size_t dst_capacity);
  *
  * @param[in] src Pointer to the source buffer containing the file data.
  * @param[in] src_size Size of the source buffer in bytes.
- * @param[out] out_block_size Optional pointer to receive the recommended block size
- * @return 0 if the header is valid, -1 otherwise (e.g., buffer too small,
- * invalid magic word, or incorrect version).
+ * @param[out] out_block_size Optional pointer to receive the block size used by the
+ * compressor (an upper bound on the raw size of every block).
+ * @param[out] out_content_size Optional pointer to receive the original content
+ * size, or `ZXC_CONTENT_SIZE_UNKNOWN` if the header does not carry it.
+ * @param[out] out_linked Optional pointer receiving 1 if the blocks are linked
+ * (they must then be decoded in order, each after the previous one), 0 otherwise.
+ * @param[out] out_dict_id Optional pointer receiving the ID of the dictionary
+ * needed by the first block, or 0 if there is none.
+ * @return The header length in bytes (including the optional content size and
+ * dictionary ID) if the header is valid, -1 otherwise (e.g., buffer too small,
+ * invalid magic word, or unsupported version).
  */
-int zxc_read_file_header(const uint8_t* src, size_t src_size, size_t* out_block_size);
+int zxc_read_file_header(const uint8_t* src, size_t src_size, size_t* out_block_size,
+                         uint64_t* out_content_size, int* out_linked, uint32_t* out_dict_id);
 
 /**
  * @struct zxc_block_header_t
@@ -145,7 +223,9 @@ int zxc_read_file_header(const uint8_t* src, size_t src_size, size_t* out_block_
  * @var zxc_block_header_t::block_flags
  * Bit flags indicating properties like checksum presence.
  * @var zxc_block_header_t::reserved
- * Reserved bytes for future protocol extensions.
+ * Parameter of the block filter flagged in `block_flags` (record stride of a
+ * byte-shuffled block, architecture of a branch-filtered block), 0 without a
+ * filter.
  * @var zxc_block_header_t::comp_size
  * The size of the compressed data payload in bytes (excluding this header).
  * @var zxc_block_header_t::raw_size
@@ -154,7 +234,7 @@ int zxc_read_file_header(const uint8_t* src, size_t src_size, size_t* out_block_
 typedef struct {
     uint8_t block_type;   // Block type (e.g., RAW, GLO, GHI, NUM)
     uint8_t block_flags;  // Flags (e.g., checksum presence)
-    uint16_t reserved;    // Reserved for future use
+    uint16_t reserved;    // Block filter parameter (0 = none)
     uint32_t comp_size;   // Compressed size excluding header
     uint32_t raw_size;    // Decompressed size
 } zxc_block_header_t;
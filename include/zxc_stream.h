@@ -12,6 +12,9 @@
 #include <stdint.h>
 #include <stdio.h>
 
+#include "zxc_constants.h"
+#include "zxc_pool.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -37,14 +40,16 @@ extern "C" {
  * @param[out] f_out     Output file stream (must be opened in "wb" mode).
  * @param[in] n_threads Number of worker threads to spawn (0 = auto-detect number of
  * CPU cores).
- * @param[in] level     Compression level (1-9).
+ * @param[in] level     Compression level (1-10).
  * @param[in] checksum_enabled  If non-zero, enables checksum verification for data
  * integrity.
+ * @param[in] block_size Block size in bytes: a power of two between
+ * ZXC_BLOCK_SIZE_MIN and ZXC_BLOCK_SIZE_MAX, or 0 for ZXC_BLOCK_SIZE_DEFAULT.
  *
  * @return          Total compressed bytes written, or -1 if an error occurred.
  */
 int64_t zxc_stream_compress(FILE* f_in, FILE* f_out, int n_threads, int level,
-                            int checksum_enabled);
+                            int checksum_enabled, size_t block_size);
 
 /**
  * @brief Decompresses data from an input stream to an output stream.
@@ -63,6 +68,164 @@ int64_t zxc_stream_compress(FILE* f_in, FILE* f_out, int n_threads, int level,
  */
 int64_t zxc_stream_decompress(FILE* f_in, FILE* f_out, int n_threads, int checksum_enabled);
 
+/**
+ * @brief Same as zxc_stream_compress(), running on the threads of `pool`.
+ *
+ * No thread is created and, once the pool has processed a stream with the same
+ * or a larger block size, no compression context is allocated.
+ *
+ * @param[in] pool      Pool obtained from zxc_create_pool().
+ * @param[in] f_in      Input file stream (must be opened in "rb" mode).
+ * @param[out] f_out     Output file stream (must be opened in "wb" mode).
+ * @param[in] level     Compression level (1-10).
+ * @param[in] checksum_enabled  If non-zero, enables checksum verification for data
+ * integrity.
+ * @param[in] block_size Block size in bytes, or 0 for ZXC_BLOCK_SIZE_DEFAULT.
+ *
+ * @return          Total compressed bytes written, or -1 if an error occurred.
+ */
+int64_t zxc_stream_compress_pool(zxc_pool_t* pool, FILE* f_in, FILE* f_out, int level,
+                                 int checksum_enabled, size_t block_size);
+
+/**
+ * @brief Same as zxc_stream_decompress(), running on the threads of `pool`.
+ *
+ * @param[in] pool      Pool obtained from zxc_create_pool().
+ * @param[in] f_in      Input file stream (must be opened in "rb" mode).
+ * @param[out] f_out     Output file stream (must be opened in "wb" mode).
+ * @param[in] checksum_enabled  If non-zero, enables checksum verification for data
+ * integrity.
+ *
+ * @return          Total decompressed bytes written, or -1 if an error
+ * occurred.
+ */
+int64_t zxc_stream_decompress_pool(zxc_pool_t* pool, FILE* f_in, FILE* f_out,
+                                   int checksum_enabled);
+
+/*
+ * ============================================================================
+ * Callback-Based I/O
+ * ============================================================================
+ * The same pipeline, fed and drained through user callbacks instead of stdio.
+ * This avoids libc buffering when the data lives in sockets, ring buffers,
+ * memory or custom object stores, and lets in-memory sources hand their data
+ * to the workers without any copy.
+ */
+
+/**
+ * @struct zxc_reader_t
+ * @brief Input source of a callback-based stream operation.
+ *
+ * At least one of `read` and `borrow` must be set.
+ *
+ * @var zxc_reader_t::opaque
+ *      User pointer passed back to every callback.
+ * @var zxc_reader_t::read
+ *      Copies up to `len` bytes into `buf`. Returns the number of bytes
+ * copied, which may be less than `len` only at the end of the input (0 once
+ * exhausted), or -1 on error.
+ * @var zxc_reader_t::borrow
+ *      Optional zero-copy path. Returns a pointer to the next bytes of input,
+ * stores their count in `*avail` and consumes them. The count may be less
+ * than `len` only at the end of the input. The memory must remain valid and
+ * unchanged until the stream call returns. Returning NULL makes the engine
+ * use `read` for this request instead.
+ * @var zxc_reader_t::content_size
+ *      Total number of bytes the source will deliver, or 0 if unknown. When
+ * set, compression records it in the file header and fails if the input turns
+ * out to have a different size. Ignored by decompression.
+ */
+typedef struct {
+    void* opaque;
+    int64_t (*read)(void* opaque, void* buf, size_t len);
+    const void* (*borrow)(void* opaque, size_t len, size_t* avail);
+    uint64_t content_size;
+} zxc_reader_t;
+
+/**
+ * @struct zxc_writer_t
+ * @brief Output sink of a callback-based stream operation.
+ *
+ * @var zxc_writer_t::opaque
+ *      User pointer passed back to the callback.
+ * @var zxc_writer_t::write
+ *      Consumes `len` bytes from `buf`, in stream order. Returns 0 on success,
+ * or -1 on error. Called from a single thread at a time.
+ */
+typedef struct {
+    void* opaque;
+    int (*write)(void* opaque, const void* buf, size_t len);
+} zxc_writer_t;
+
+/**
+ * @brief Compresses data pulled from `in` and pushes the result to `out`.
+ *
+ * Behaves like zxc_stream_compress(); the output format is identical.
+ *
+ * @param[in] in        Input source.
+ * @param[in] out       Output sink, or NULL to discard the output (benchmarks).
+ * @param[in] n_threads Number of threads (0 = auto-detect number of CPU cores).
+ * @param[in] level     Compression level (1-10).
+ * @param[in] checksum_enabled  If non-zero, enables checksum verification for data
+ * integrity.
+ * @param[in] block_size Block size in bytes, or 0 for ZXC_BLOCK_SIZE_DEFAULT.
+ *
+ * @return          Total compressed bytes written, or -1 if an error occurred
+ * (including a callback reporting an error).
+ */
+int64_t zxc_stream_compress_cb(const zxc_reader_t* in, const zxc_writer_t* out, int n_threads,
+                               int level, int checksum_enabled, size_t block_size);
+
+/**
+ * @brief Decompresses data pulled from `in` and pushes the result to `out`.
+ *
+ * When the reader can `borrow`, blocks are decoded straight from the borrowed
+ * memory.
+ *
+ * @param[in] in        Input source.
+ * @param[in] out       Output sink, or NULL to discard the output (benchmarks).
+ * @param[in] n_threads Number of threads (0 = auto-detect number of CPU cores).
+ * @param[in] checksum_enabled  If non-zero, enables checksum verification for data
+ * integrity.
+ *
+ * @return          Total decompressed bytes written, or -1 if an error
+ * occurred.
+ */
+int64_t zxc_stream_decompress_cb(const zxc_reader_t* in, const zxc_writer_t* out, int n_threads,
+                                 int checksum_enabled);
+
+/**
+ * @brief Same as zxc_stream_compress_cb(), running on the threads of `pool`.
+ *
+ * @param[in] pool      Pool obtained from zxc_create_pool().
+ * @param[in] in        Input source.
+ * @param[in] out       Output sink, or NULL to discard the output (benchmarks).
+ * @param[in] level     Compression level (1-10).
+ * @param[in] checksum_enabled  If non-zero, enables checksum verification for data
+ * integrity.
+ * @param[in] block_size Block size in bytes, or 0 for ZXC_BLOCK_SIZE_DEFAULT.
+ *
+ * @return          Total compressed bytes written, or -1 if an error occurred.
+ */
+int64_t zxc_stream_compress_cb_pool(zxc_pool_t* pool, const zxc_reader_t* in,
+                                    const zxc_writer_t* out, int level, int checksum_enabled,
+                                    size_t block_size);
+
+/**
+ * @brief Same as zxc_stream_decompress_cb(), running on the threads of `pool`.
+ *
+ * @param[in] pool      Pool obtained from zxc_create_pool().
+ * @param[in] in        Input source.
+ * @param[in] out       Output sink, or NULL to discard the output (benchmarks).
+ * @param[in] checksum_enabled  If non-zero, enables checksum verification for data
+ * integrity.
+ *
+ * @return          Total decompressed bytes written, or -1 if an error
+ * occurred.
+ */
+int64_t zxc_stream_decompress_cb_pool(zxc_pool_t* pool, const zxc_reader_t* in,
+                                      const zxc_writer_t* out, int checksum_enabled);
+
 #ifdef __cplusplus
 }
 #endif
@@ -70,6 +70,15 @@ static double zxc_now(void) {
     return (double)count.QuadPart / frequency.QuadPart;
 }
 
+/**
+ * @brief Returns the number of logical processors.
+ */
+static int zxc_cpu_count(void) {
+    SYSTEM_INFO sysinfo;
+    GetSystemInfo(&sysinfo);
+    return (int)sysinfo.dwNumberOfProcessors;
+}
+
 struct option {
     const char* name;
     int has_arg;
@@ -172,6 +181,14 @@ static double zxc_now(void) {
     clock_gettime(CLOCK_MONOTONIC, &ts);
     return ts.tv_sec + ts.tv_nsec / 1e9;
 }
+
+/**
+ * @brief Returns the number of online logical processors.
+ */
+static int zxc_cpu_count(void) {
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (int)n : 1;
+}
 #endif
 
 /**
@@ -296,19 +313,310 @@ static void zxc_log_v(const char* fmt, ...) {
     va_end(args);
 }
 
+/**
+ * @brief Parses a block size argument such as "65536", "64K" or "1M".
+ *
+ * @param[in] arg The option argument.
+ * @return The size in bytes, or 0 if the argument is malformed.
+ */
+static size_t zxc_parse_block_size(const char* arg) {
+    char* end = NULL;
+    unsigned long long v = strtoull(arg, &end, 10);
+    if (end == arg || v > ZXC_BLOCK_SIZE_MAX) return 0;
+    if (*end == 'K' || *end == 'k') {
+        v *= 1024;
+        end++;
+    } else if (*end == 'M' || *end == 'm') {
+        v *= 1024 * 1024;
+        end++;
+    }
+    if (*end == 'B' || *end == 'b') end++;
+    if (*end != '\0') return 0;
+    return (size_t)v;
+}
+
+/**
+ * @brief Reads a whole file into memory.
+ *
+ * @param[in] path File to read.
+ * @param[out] size Receives the file size.
+ * @return A buffer to release with free(), or NULL on error (errno is set).
+ */
+static uint8_t* zxc_read_file(const char* path, size_t* size) {
+    char resolved_path[4096];
+    if (zxc_validate_input_path(path, resolved_path, sizeof(resolved_path)) != 0) return NULL;
+    FILE* f = fopen(resolved_path, "rb");
+    if (!f) return NULL;
+    uint8_t* buf = NULL;
+    long long fsize = -1;
+    if (fseeko(f, 0, SEEK_END) == 0) fsize = ftello(f);
+    if (fsize >= 0 && fseeko(f, 0, SEEK_SET) == 0) {
+        buf = malloc((size_t)fsize ? (size_t)fsize : 1);
+        if (buf && fread(buf, 1, (size_t)fsize, f) != (size_t)fsize) {
+            free(buf);
+            buf = NULL;
+            errno = EIO;
+        }
+    }
+    fclose(f);
+    if (buf) *size = (size_t)fsize;
+    return buf;
+}
+
+/**
+ * @brief Trains a dictionary on sample files and writes it to `dict_path`.
+ *
+ * @param[in] dict_path Output dictionary file.
+ * @param[in] files     Sample files.
+ * @param[in] n_files   Number of entries in `files`.
+ * @param[in] force     Overwrite an existing output.
+ * @return 0 on success, 1 on error.
+ */
+static int zxc_train(const char* dict_path, char* const* files, int n_files, int force) {
+    int ret = 1;
+    uint8_t* samples = NULL;
+    size_t* sizes = calloc((size_t)n_files, sizeof(size_t));
+    uint8_t dict[ZXC_DICT_SIZE_MAX];
+    size_t total = 0;
+    if (!sizes) goto train_cleanup;
+
+    for (int i = 0; i < n_files; i++) {
+        size_t sz;
+        uint8_t* data = zxc_read_file(files[i], &sz);
+        if (!data) {
+            zxc_log("Error: Invalid sample file '%s': %s\n", files[i], strerror(errno));
+            goto train_cleanup;
+        }
+        uint8_t* grown = realloc(samples, total + sz + 1);
+        if (!grown) {
+            free(data);
+            goto train_cleanup;
+        }
+        samples = grown;
+        memcpy(samples + total, data, sz);
+        free(data);
+        sizes[i] = sz;
+        total += sz;
+    }
+
+    size_t dict_size = zxc_train_dict(dict, sizeof(dict), samples, sizes, (size_t)n_files);
+    if (dict_size == 0) {
+        zxc_log("Error: No dictionary could be trained (empty samples?).\n");
+        goto train_cleanup;
+    }
+
+    char resolved_out[4096];
+    if (zxc_validate_output_path(dict_path, resolved_out, sizeof(resolved_out)) != 0) {
+        zxc_log("Error: Invalid output path '%s': %s\n", dict_path, strerror(errno));
+        goto train_cleanup;
+    }
+    if (!force && access(resolved_out, F_OK) == 0) {
+        zxc_log("Output exists. Use -f.\n");
+        goto train_cleanup;
+    }
+    FILE* f = fopen(resolved_out, "wb");
+    if (!f || fwrite(dict, 1, dict_size, f) != dict_size) {
+        zxc_log("Error writing %s: %s\n", resolved_out, strerror(errno));
+        if (f) fclose(f);
+        goto train_cleanup;
+    }
+    if (fclose(f) != 0) goto train_cleanup;
+    zxc_log_v("Dictionary: %zu bytes from %d samples (%zu bytes), ID %08x\n", dict_size, n_files,
+              total, (unsigned)zxc_dict_id(dict, dict_size));
+    ret = 0;
+
+train_cleanup:
+    free(samples);
+    free(sizes);
+    return ret;
+}
+
+/**
+ * @struct zxc_mem_io_t
+ * @brief In-memory source or sink for the callback stream API.
+ */
+typedef struct {
+    uint8_t* buf;
+    size_t size;
+    size_t pos;
+} zxc_mem_io_t;
+
+/** @brief `zxc_reader_t::borrow` over a memory buffer: lends it in place. */
+static const void* zxc_mem_borrow(void* opaque, size_t len, size_t* avail) {
+    zxc_mem_io_t* m = (zxc_mem_io_t*)opaque;
+    size_t n = m->size - m->pos;
+    if (n > len) n = len;
+    const uint8_t* p = m->buf + m->pos;
+    m->pos += n;
+    *avail = n;
+    return p;
+}
+
+/** @brief `zxc_writer_t::write` into a memory buffer. */
+static int zxc_mem_write(void* opaque, const void* buf, size_t len) {
+    zxc_mem_io_t* m = (zxc_mem_io_t*)opaque;
+    if (len > m->size - m->pos) return -1;
+    memcpy(m->buf + m->pos, buf, len);
+    m->pos += len;
+    return 0;
+}
+
+/**
+ * @brief Times repeated stream compression and decompression of an in-memory
+ * input on a thread pool. Input is lent to the engine without copies and
+ * output is discarded, so only the codec and pipeline are measured.
+ *
+ * @param[in] ram        Uncompressed input.
+ * @param[in] in_size    Size of `ram`.
+ * @param[in] c_dat      Compressed form of `ram`.
+ * @param[in] c_sz       Size of `c_dat`.
+ * @param[in] threads    Thread count of the pool (0 = all cores).
+ * @param[in] cm         Cost model of the compression contexts (NULL = size only).
+ * @param[in] linked     Compress in linked-block mode.
+ * @param[in] trials     Trial-encode every block with each block type.
+ * @param[in] dict       Dictionary (NULL = none).
+ * @param[in] dict_size  Size of `dict`.
+ * @param[in] iterations Number of runs of each direction.
+ * @param[in] level      Compression level.
+ * @param[in] checksum   Checksum flag.
+ * @param[in] block_size Block size (0 = default).
+ * @param[out] dt_c      Total compression time, in seconds.
+ * @param[out] dt_d      Total decompression time, in seconds.
+ * @return 0 on success, -1 if a run failed.
+ */
+static int zxc_bench_pass(uint8_t* ram, size_t in_size, uint8_t* c_dat, size_t c_sz,
+                          int threads, const zxc_cost_model_t* cm, int linked, int trials,
+                          const uint8_t* dict, size_t dict_size, int iterations, int level,
+                          int checksum, size_t block_size, double* dt_c, double* dt_d) {
+    zxc_pool_t* pool = zxc_create_pool(threads);
+    if (!pool) return -1;
+    zxc_pool_set_cost_model(pool, cm);
+    zxc_pool_set_linked_blocks(pool, linked);
+    zxc_pool_set_block_trials(pool, trials);
+    int ret = -1;
+    if (zxc_pool_load_dict(pool, dict, dict_size) != 0) goto pass_end;
+
+    zxc_mem_io_t m = {ram, in_size, 0};
+    zxc_reader_t in = {&m, NULL, zxc_mem_borrow, in_size};
+    double t0 = zxc_now();
+    for (int i = 0; i < iterations; i++) {
+        m.pos = 0;
+        if (zxc_stream_compress_cb_pool(pool, &in, NULL, level, checksum, block_size) < 0)
+            goto pass_end;
+    }
+    *dt_c = zxc_now() - t0;
+
+    zxc_mem_io_t mc = {c_dat, c_sz, 0};
+    zxc_reader_t inc = {&mc, NULL, zxc_mem_borrow, c_sz};
+    t0 = zxc_now();
+    for (int i = 0; i < iterations; i++) {
+        mc.pos = 0;
+        if (zxc_stream_decompress_cb_pool(pool, &inc, NULL, checksum) < 0) goto pass_end;
+    }
+    *dt_d = zxc_now() - t0;
+    ret = 0;
+
+pass_end:
+    zxc_free_pool(pool);
+    return ret;
+}
+
+/**
+ * @brief Prints the estimated decode cycles of every block next to its
+ * measured single-threaded decode time.
+ *
+ * With a well-calibrated model the cycles/ns ratio stays roughly constant
+ * across blocks (close to the CPU clock in GHz); blocks that stand out are
+ * mis-predicted by the model. The frame is decoded once, then each block is
+ * decoded again in place, so a linked block is timed alone.
+ *
+ * @param[in] c_dat      Compressed buffer.
+ * @param[in] c_sz       Size of `c_dat`.
+ * @param[in] raw_sz     Decompressed size.
+ * @param[in] cm         Cost model used for the estimate.
+ * @param[in] dict       Dictionary the frame was compressed with (NULL = none).
+ * @param[in] dict_size  Size of `dict`.
+ * @param[in] iterations Decodes per block (the fastest is kept).
+ * @return 0 on success, -1 on error.
+ */
+static int zxc_cost_report(const uint8_t* c_dat, size_t c_sz, size_t raw_sz,
+                           const zxc_cost_model_t* cm, const uint8_t* dict, size_t dict_size,
+                           int iterations) {
+    static const char* type_names[] = {"RAW", "GLO", "NUM", "GHI", "SEK", "FLT"};
+    size_t n = zxc_estimate_decode_cost(c_dat, c_sz, cm, NULL, 0);
+    if (n == 0) return -1;
+    zxc_block_cost_t* blocks = malloc(n * sizeof(zxc_block_cost_t));
+    uint8_t* frame = malloc(raw_sz ? raw_sz : 1);
+    zxc_dctx_t* dctx = zxc_create_dctx();
+    int ret = -1;
+    if (!blocks || !frame || !dctx || zxc_dctx_load_dict(dctx, dict, dict_size) != 0)
+        goto report_cleanup;
+    zxc_estimate_decode_cost(c_dat, c_sz, cm, blocks, n);
+    if (zxc_decompress_dctx(dctx, c_dat, c_sz, frame, raw_sz, 0) != raw_sz) {
+        zxc_log("Error: Cost report could not decode the frame.\n");
+        goto report_cleanup;
+    }
+
+    uint64_t est_total = 0;
+    double ns_total = 0;
+    printf("%6s %4s %10s %10s %8s %12s %12s %8s\n", "Block", "Type", "Raw", "Comp", "Seqs",
+           "Est.cycles", "Meas.ns", "cyc/ns");
+    for (size_t i = 0; i < n; i++) {
+        const zxc_block_cost_t* b = &blocks[i];
+        double best = 0;
+        for (int k = 0; k <= iterations; k++) {  // First run warms up
+            double t0 = zxc_now();
+            if (zxc_decompress_block_dctx(dctx, c_dat, c_sz, b, frame, raw_sz, 0) !=
+                b->raw_size) {
+                zxc_log("Error: Cost report could not decode block %zu.\n", i);
+                goto report_cleanup;
+            }
+            double dt = (zxc_now() - t0) * 1e9;
+            if (k == 1 || (k > 1 && dt < best)) best = dt;
+        }
+        est_total += b->est_cycles;
+        ns_total += best;
+        printf("%6zu %4s %10u %10u %8u %12llu %12.0f %8.2f\n", i,
+               b->block_type < 6 ? type_names[b->block_type] : "?", b->raw_size, b->comp_size,
+               b->n_sequences, (unsigned long long)b->est_cycles, best,
+               best > 0 ? (double)b->est_cycles / best : 0.0);
+    }
+    printf("%6s %4s %10s %10s %8s %12llu %12.0f %8.2f\n", "Total", "", "", "", "",
+           (unsigned long long)est_total, ns_total, ns_total > 0 ? est_total / ns_total : 0.0);
+    ret = 0;
+
+report_cleanup:
+    zxc_free_dctx(dctx);
+    free(frame);
+    free(blocks);
+    return ret;
+}
+
 void print_help(const char* app) {
     printf("Usage: %s [<options>] [<argument>]...\n\n", app);
     printf(
         "Standard Modes:\n"
         "  -z, --compress    Compress FILE {default}\n"
         "  -d, --decompress  Decompress FILE (or stdin -> stdout)\n"
-        "  -b, --bench       Benchmark in-memory\n\n"
+        "  -b, --bench       Benchmark in-memory\n"
+        "      --scaling     With -b: measure 1, 2, 4.. up to -T threads {all cores}\n"
+        "      --cost-report With -b: estimated vs measured decode cost per block\n"
+        "      --train       Train a dictionary on the input FILEs into -D FILE\n\n"
         "Special Options:\n"
         "  -V, --version     Show version information\n"
         "  -h, --help        Show this help message\n\n"
         "Options:\n"
-        "  -1..-5            Compression level {3}\n"
+        "  -1..-9            Compression level {3} (6-9: optimal parsing)\n"
+        "  -l, --level N     Compression level 1-10 (10: Huffman-coded literals)\n"
         "  -T, --threads N   Number of threads (0=auto)\n"
+        "  -B, --block-size S Block size, power of two in 16K..2M {256K}\n"
+        "      --decode-cost N Levels 6-10 and --trials: trade ratio for decode speed\n"
+        "                    (0=size only) {0}\n"
+        "      --trials      Encode each block as GLO, GHI and NUM and keep the best\n"
+        "      --linked      Let each block reference the previous 64K (better ratio,\n"
+        "                    sequential decompression)\n"
+        "      --no-seek-table Omit the block index used for random access (smaller output)\n"
+        "  -D, --dict FILE   Dictionary (last 64K used) for small inputs\n"
         "  -C, --checksum    Enable checksum\n"
         "  -N, --no-checksum Disable checksum\n"
         "  -k, --keep        Keep input file\n"
@@ -334,9 +642,19 @@ void print_version(void) {
     printf("(%s)\n", sys_info);
 }
 
-typedef enum { MODE_COMPRESS, MODE_DECOMPRESS, MODE_BENCHMARK } zxc_mode_t;
-
-enum { OPT_VERSION = 1000, OPT_HELP };
+typedef enum { MODE_COMPRESS, MODE_DECOMPRESS, MODE_BENCHMARK, MODE_TRAIN } zxc_mode_t;
+
+enum {
+    OPT_VERSION = 1000,
+    OPT_HELP,
+    OPT_SCALING,
+    OPT_DECODE_COST,
+    OPT_COST_REPORT,
+    OPT_LINKED,
+    OPT_TRIALS,
+    OPT_NO_SEEK_TABLE,
+    OPT_TRAIN
+};
 
 /**
  * @brief Main entry point.
@@ -352,6 +670,16 @@ int main(int argc, char** argv) {
     int iterations = 5;
     int checksum = 0;
     int level = 3;
+    size_t block_size = 0;
+    int scaling = 0;
+    int decode_cost = 0;
+    int cost_report = 0;
+    int linked = 0;
+    int trials = 0;
+    int seek_table = 1;
+    const char* dict_path = NULL;
+    uint8_t* dict = NULL;
+    size_t dict_size = 0;
 
     static const struct option long_options[] = {
         {"compress", no_argument, 0, 'z'},    {"decompress", no_argument, 0, 'd'},
@@ -360,10 +688,20 @@ int main(int argc, char** argv) {
         {"stdout", no_argument, 0, 'c'},      {"verbose", no_argument, 0, 'v'},
         {"quiet", no_argument, 0, 'q'},       {"checksum", no_argument, 0, 'C'},
         {"no-checksum", no_argument, 0, 'N'}, {"version", no_argument, 0, 'V'},
-        {"help", no_argument, 0, 'h'},        {0, 0, 0, 0}};
+        {"help", no_argument, 0, 'h'},        {"block-size", required_argument, 0, 'B'},
+        {"scaling", no_argument, 0, OPT_SCALING},
+        {"decode-cost", required_argument, 0, OPT_DECODE_COST},
+        {"cost-report", no_argument, 0, OPT_COST_REPORT},
+        {"linked", no_argument, 0, OPT_LINKED},
+        {"trials", no_argument, 0, OPT_TRIALS},
+        {"no-seek-table", no_argument, 0, OPT_NO_SEEK_TABLE},
+        {"dict", required_argument, 0, 'D'},
+        {"train", no_argument, 0, OPT_TRAIN},
+        {"level", required_argument, 0, 'l'},
+        {0, 0, 0, 0}};
 
     int opt;
-    while ((opt = getopt_long(argc, argv, "12345b::cCdfhkl:NqT:vVz", long_options, NULL)) != -1) {
+    while ((opt = getopt_long(argc, argv, "123456789b::B:cCdD:fhkl:NqT:vVz", long_options, NULL)) != -1) {
         switch (opt) {
             case 'z':
                 mode = MODE_COMPRESS;
@@ -375,16 +713,65 @@ int main(int argc, char** argv) {
                 mode = MODE_BENCHMARK;
                 if (optarg) iterations = atoi(optarg);
                 break;
+            case OPT_SCALING:
+                scaling = 1;
+                break;
+            case OPT_DECODE_COST:
+                decode_cost = atoi(optarg);
+                if (decode_cost < 0) {
+                    zxc_log("Invalid decode cost '%s' (0 or more).\n", optarg);
+                    return 1;
+                }
+                break;
+            case OPT_COST_REPORT:
+                cost_report = 1;
+                break;
+            case OPT_LINKED:
+                linked = 1;
+                break;
+            case OPT_TRIALS:
+                trials = 1;
+                break;
+            case OPT_NO_SEEK_TABLE:
+                seek_table = 0;
+                break;
+            case OPT_TRAIN:
+                mode = MODE_TRAIN;
+                break;
+            case 'D':
+                dict_path = optarg;
+                break;
             case '1':
             case '2':
             case '3':
             case '4':
             case '5':
+            case '6':
+            case '7':
+            case '8':
+            case '9':
                 level = opt - '0';
                 break;
+            case 'l':
+                level = atoi(optarg);
+                if (level < ZXC_LEVEL_FASTEST || level > ZXC_LEVEL_MAX) {
+                    zxc_log("Invalid level '%s' (%d to %d).\n", optarg, ZXC_LEVEL_FASTEST,
+                            ZXC_LEVEL_MAX);
+                    return 1;
+                }
+                break;
             case 'T':
                 num_threads = atoi(optarg);
                 break;
+            case 'B':
+                block_size = zxc_parse_block_size(optarg);
+                if (block_size < ZXC_BLOCK_SIZE_MIN || block_size > ZXC_BLOCK_SIZE_MAX ||
+                    (block_size & (block_size - 1)) != 0) {
+                    zxc_log("Invalid block size '%s' (power of two between 16K and 2M).\n",
+                            optarg);
+                    return 1;
+                }
+                break;
             case 'k':
                 keep_input = 1;
                 break;
@@ -418,6 +805,26 @@ int main(int argc, char** argv) {
         }
     }
 
+    // A zero bias keeps the size-only parser (and its exact output)
+    zxc_cost_model_t cm;
+    zxc_cost_model_init(&cm, decode_cost);
+    const zxc_cost_model_t* cm_ptr = decode_cost > 0 ? &cm : NULL;
+
+    if (mode == MODE_TRAIN) {
+        if (!dict_path || optind >= argc) {
+            zxc_log("Training requires -D FILE and sample files.\n");
+            return 1;
+        }
+        return zxc_train(dict_path, argv + optind, argc - optind, force);
+    }
+    if (dict_path) {
+        dict = zxc_read_file(dict_path, &dict_size);
+        if (!dict) {
+            zxc_log("Error: Invalid dictionary '%s': %s\n", dict_path, strerror(errno));
+            return 1;
+        }
+    }
+
     // Handle positional arguments for mode selection (e.g., "zxc z file")
     if (optind < argc && mode != MODE_BENCHMARK) {
         if (strcmp(argv[optind], "z") == 0) {
@@ -448,6 +855,7 @@ int main(int argc, char** argv) {
         int ret = 1;
         uint8_t* ram = NULL;
         uint8_t* c_dat = NULL;
+        zxc_pool_t* pool = NULL;
         char resolved_path[4096];
         if (zxc_validate_input_path(in_path, resolved_path, sizeof(resolved_path)) != 0) {
             zxc_log("Error: Invalid input file '%s': %s\n", in_path, strerror(errno));
@@ -472,93 +880,70 @@ int main(int argc, char** argv) {
         printf("Input: %s (%zu bytes)\n", in_path, in_size);
         printf("Running %d iterations (Threads: %d)...\n", iterations, num_threads);
 
-#ifdef _WIN32
-        printf("Note: Using tmpfile on Windows (slower than fmemopen).\n");
-        FILE* fm = tmpfile();
-        if (fm) {
-            fwrite(ram, 1, in_size, fm);
-            rewind(fm);
-        }
-#else
-        FILE* fm = fmemopen(ram, in_size, "rb");
-#endif
-        if (!fm) goto bench_cleanup;
-
-        double t0 = zxc_now();
-        for (int i = 0; i < iterations; i++) {
-            rewind(fm);
-            zxc_stream_compress(fm, NULL, num_threads, level, checksum);
-        }
-        double dt_c = zxc_now() - t0;
-        fclose(fm);
-
         size_t max_c = zxc_compress_bound(in_size);
         c_dat = malloc(max_c);
         if (!c_dat) goto bench_cleanup;
 
-#ifdef _WIN32
-        FILE* fm_in = tmpfile();
-        FILE* fm_out = tmpfile();
-        if (!fm_in || !fm_out) {
-            if (fm_in) fclose(fm_in);
-            if (fm_out) fclose(fm_out);
-            goto bench_cleanup;
-        }
-        fwrite(ram, 1, in_size, fm_in);
-        rewind(fm_in);
-#else
-        FILE* fm_in = fmemopen(ram, in_size, "rb");
-        FILE* fm_out = fmemopen(c_dat, max_c, "wb");
-        if (!fm_in || !fm_out) {
-            if (fm_in) fclose(fm_in);
-            if (fm_out) fclose(fm_out);
-            goto bench_cleanup;
-        }
-#endif
-
-        int64_t c_sz = zxc_stream_compress(fm_in, fm_out, num_threads, level, checksum);
-        if (c_sz < 0) {
-            fclose(fm_in);
-            fclose(fm_out);
-            goto bench_cleanup;
-        }
-
-#ifdef _WIN32
-        rewind(fm_out);
-        fread(c_dat, 1, (size_t)c_sz, fm_out);
-#endif
-        fclose(fm_in);
-        fclose(fm_out);
-
-#ifdef _WIN32
-        FILE* fc = tmpfile();
-        if (!fc) goto bench_cleanup;
-        fwrite(c_dat, 1, (size_t)c_sz, fc);
-        rewind(fc);
-#else
-        FILE* fc = fmemopen(c_dat, (size_t)c_sz, "rb");
-        if (!fc) goto bench_cleanup;
-#endif
-
-        t0 = zxc_now();
-        for (int i = 0; i < iterations; i++) {
-            rewind(fc);
-            zxc_stream_decompress(fc, NULL, num_threads, checksum);
-        }
-        double dt_d = zxc_now() - t0;
-        fclose(fc);
+        zxc_mem_io_t m_in = {ram, in_size, 0};
+        zxc_mem_io_t m_out = {c_dat, max_c, 0};
+        zxc_reader_t rd = {&m_in, NULL, zxc_mem_borrow, in_size};
+        zxc_writer_t wr = {&m_out, zxc_mem_write};
+        pool = zxc_create_pool(num_threads);
+        if (!pool) goto bench_cleanup;
+        zxc_pool_set_cost_model(pool, cm_ptr);
+        zxc_pool_set_linked_blocks(pool, linked);
+        zxc_pool_set_block_trials(pool, trials);
+        zxc_pool_set_seek_table(pool, seek_table);
+        if (zxc_pool_load_dict(pool, dict, dict_size) != 0) goto bench_cleanup;
+        int64_t c_sz = zxc_stream_compress_cb_pool(pool, &rd, &wr, level, checksum, block_size);
+        if (c_sz < 0) goto bench_cleanup;
 
         printf("Compressed: %lld bytes (ratio %.3f)\n", (long long)c_sz, (double)in_size / c_sz);
-        printf("Avg Compress  : %.3f MiB/s\n",
-               (double)in_size * iterations / (1024.0 * 1024.0) / dt_c);
-        printf("Avg Decompress: %.3f MiB/s\n",
-               (double)in_size * iterations / (1024.0 * 1024.0) / dt_d);
+        const double mib = (double)in_size * iterations / (1024.0 * 1024.0);
+        double dt_c, dt_d;
+
+        if (cost_report) {
+            zxc_cost_model_t report_cm;
+            zxc_cost_model_init(&report_cm, decode_cost);
+            if (zxc_cost_report(c_dat, (size_t)c_sz, in_size, &report_cm, dict, dict_size,
+                                iterations) != 0)
+                goto bench_cleanup;
+        } else if (!scaling) {
+            if (zxc_bench_pass(ram, in_size, c_dat, (size_t)c_sz, num_threads, cm_ptr, linked,
+                               trials, dict, dict_size, iterations, level, checksum, block_size,
+                               &dt_c, &dt_d) != 0)
+                goto bench_cleanup;
+            printf("Avg Compress  : %.3f MiB/s\n", mib / dt_c);
+            printf("Avg Decompress: %.3f MiB/s\n", mib / dt_d);
+        } else {
+            // Thread scaling: 1, 2, 4, ... up to the requested (or available) count
+            int max_threads = (num_threads > 0) ? num_threads : zxc_cpu_count();
+            double base_c = 0, base_d = 0;
+            printf("%8s %16s %8s %16s %8s\n", "Threads", "Compress MiB/s", "Speedup",
+                   "Decompress MiB/s", "Speedup");
+            for (int t = 1;; t *= 2) {
+                if (t > max_threads) t = max_threads;
+                if (zxc_bench_pass(ram, in_size, c_dat, (size_t)c_sz, t, cm_ptr, linked, trials,
+                                   dict, dict_size, iterations, level, checksum, block_size, &dt_c,
+                                   &dt_d) != 0)
+                    goto bench_cleanup;
+                double sc = mib / dt_c, sd = mib / dt_d;
+                if (t == 1) {
+                    base_c = sc;
+                    base_d = sd;
+                }
+                printf("%8d %16.3f %7.2fx %16.3f %7.2fx\n", t, sc, sc / base_c, sd, sd / base_d);
+                if (t == max_threads) break;
+            }
+        }
         ret = 0;
 
     bench_cleanup:
         if (f_in) fclose(f_in);
+        zxc_free_pool(pool);
         free(ram);
         free(c_dat);
+        free(dict);
         return ret;
     }
 
@@ -698,9 +1083,28 @@ int main(int argc, char** argv) {
     if (g_verbose) zxc_log("Checksum: %s\n", checksum ? "enabled" : "disabled");
 
     double t0 = zxc_now();
-    int64_t bytes = (mode == MODE_COMPRESS)
-                        ? zxc_stream_compress(f_in, f_out, num_threads, level, checksum)
-                        : zxc_stream_decompress(f_in, f_out, num_threads, checksum);
+    int64_t bytes;
+    if ((mode == MODE_COMPRESS && (cm_ptr || linked || trials || !seek_table)) || dict) {
+        // A cost model, the linked-block mode, the block trials, the seek table switch
+        // and a dictionary are settings of the pool
+        zxc_pool_t* pool = zxc_create_pool(num_threads);
+        bytes = -1;
+        if (pool && zxc_pool_load_dict(pool, dict, dict_size) == 0) {
+            zxc_pool_set_cost_model(pool, cm_ptr);
+            zxc_pool_set_linked_blocks(pool, linked);
+            zxc_pool_set_block_trials(pool, trials);
+            zxc_pool_set_seek_table(pool, seek_table);
+            bytes = (mode == MODE_COMPRESS)
+                        ? zxc_stream_compress_pool(pool, f_in, f_out, level, checksum, block_size)
+                        : zxc_stream_decompress_pool(pool, f_in, f_out, checksum);
+        }
+        zxc_free_pool(pool);
+        free(dict);
+    } else {
+        bytes = (mode == MODE_COMPRESS)
+                    ? zxc_stream_compress(f_in, f_out, num_threads, level, checksum, block_size)
+                    : zxc_stream_decompress(f_in, f_out, num_threads, checksum);
+    }
     double dt = zxc_now() - t0;
 
     if (!use_stdin)
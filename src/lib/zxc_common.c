@@ -37,17 +37,21 @@ void zxc_aligned_free(void* ptr) {
 int zxc_cctx_init(zxc_cctx_t* ctx, size_t chunk_size, int mode, int level, int checksum_enabled) {
     ZXC_MEMSET(ctx, 0, sizeof(zxc_cctx_t));
 
-    if (mode == 0) return 0;
+    if (mode == 0) {
+        ctx->chunk_size = chunk_size;
+        return 0;
+    }
 
     size_t max_seq = chunk_size / sizeof(uint32_t) + 256;
     size_t sz_hash = 2 * ZXC_LZ_HASH_SIZE * sizeof(uint32_t);
-    size_t sz_chain = chunk_size * sizeof(uint16_t);
+    size_t sz_chain = (chunk_size + ZXC_LINK_WINDOW) * sizeof(uint32_t);  // + linked prefix
     size_t sz_sequences = max_seq * sizeof(uint32_t);
     size_t sz_tokens = max_seq * sizeof(uint8_t);
     size_t sz_offsets = max_seq * sizeof(uint16_t);
     size_t sz_extras =
         max_seq * 2 *
-        ZXC_VBYTE_ALLOC_LEN;  // Max 3 bytes per LL/ML VByte (sufficient for 256KB block)
+        ZXC_VBYTE_ALLOC_LEN;  // Max 3 bytes per LL/ML VByte (< 2MB blocks); a far offset
+                              // adds 3 bytes per match of 5+ bytes, well within the bound
     size_t sz_lit = chunk_size + ZXC_PAD_SIZE;
 
     // Calculate sizes with alignment padding (64 bytes for cache line alignment)
@@ -67,12 +71,13 @@ int zxc_cctx_init(zxc_cctx_t* ctx, size_t chunk_size, int mode, int level, int c
     size_t off_lit = total_size;
     total_size += (sz_lit + ZXC_ALIGNMENT_MASK) & ~ZXC_ALIGNMENT_MASK;
 
+    ctx->chunk_size = chunk_size;
     uint8_t* mem = (uint8_t*)zxc_aligned_malloc(total_size, ZXC_CACHE_LINE_SIZE);
     if (UNLIKELY(!mem)) return -1;
 
     ctx->memory_block = mem;
     ctx->hash_table = (uint32_t*)(mem + off_hash);
-    ctx->chain_table = (uint16_t*)(mem + off_chain);
+    ctx->chain_table = (uint32_t*)(mem + off_chain);
     ctx->buf_sequences = (uint32_t*)(mem + off_sequences);
     ctx->buf_tokens = (uint8_t*)(mem + off_tokens);
     ctx->buf_offsets = (uint16_t*)(mem + off_offsets);
@@ -87,6 +92,39 @@ int zxc_cctx_init(zxc_cctx_t* ctx, size_t chunk_size, int mode, int level, int c
     return 0;
 }
 
+int zxc_cctx_reserve(zxc_cctx_t* ctx, size_t chunk_size, int mode, int level,
+                     int checksum_enabled) {
+    if (mode == 1 && (!ctx->memory_block || chunk_size > ctx->chunk_size)) {
+        // Settings and the loaded dictionary survive the reallocation
+        zxc_cctx_t keep = *ctx;
+        ctx->dict_buf = NULL;
+        ctx->dict_tables = NULL;
+        zxc_cctx_free(ctx);
+        int res = zxc_cctx_init(ctx, chunk_size, 1, level, checksum_enabled);
+        ctx->cost_model = keep.cost_model;
+        ctx->linked_blocks = keep.linked_blocks;
+        ctx->block_trials = keep.block_trials;
+        ctx->dict_buf = keep.dict_buf;
+        ctx->dict_size = keep.dict_size;
+        ctx->dict_buf_cap = keep.dict_buf_cap;
+        ctx->dict_id = keep.dict_id;
+        ctx->dict_tables = keep.dict_tables;  // The snapshot is still valid, the chains are not
+        ctx->dict_tables_key = keep.dict_tables_key;
+        if (UNLIKELY(res != 0)) return -1;
+    }
+    ctx->compression_level = level;
+    ctx->checksum_enabled = checksum_enabled;
+    return 0;
+}
+
+int zxc_cctx_filter_reserve(zxc_cctx_t* ctx, size_t size) {
+    if (ctx->filter_buf_cap >= size) return 0;
+    free(ctx->filter_buf);
+    ctx->filter_buf = (uint8_t*)malloc(size);
+    ctx->filter_buf_cap = ctx->filter_buf ? size : 0;
+    return ctx->filter_buf ? 0 : -1;
+}
+
 void zxc_cctx_free(zxc_cctx_t* ctx) {
     if (ctx->memory_block) {
         zxc_aligned_free(ctx->memory_block);
@@ -98,6 +136,43 @@ void zxc_cctx_free(zxc_cctx_t* ctx) {
         ctx->lit_buffer = NULL;
     }
 
+    if (ctx->opt_state) {
+        free(ctx->opt_state);
+        ctx->opt_state = NULL;
+    }
+
+    if (ctx->bt_table) {
+        free(ctx->bt_table);
+        ctx->bt_table = NULL;
+    }
+
+    if (ctx->trial_buf) {
+        free(ctx->trial_buf);
+        ctx->trial_buf = NULL;
+    }
+    ctx->trial_buf_cap = 0;
+
+    if (ctx->filter_buf) {
+        free(ctx->filter_buf);
+        ctx->filter_buf = NULL;
+    }
+    ctx->filter_buf_cap = 0;
+
+    if (ctx->dict_buf) {
+        free(ctx->dict_buf);
+        ctx->dict_buf = NULL;
+    }
+    ctx->dict_size = 0;
+    ctx->dict_buf_cap = 0;
+    ctx->dict_id = 0;
+
+    if (ctx->dict_tables) {
+        free(ctx->dict_tables);
+        ctx->dict_tables = NULL;
+    }
+    ctx->dict_tables_key = 0;
+    ctx->dict_live_key = 0;
+
     ctx->hash_table = NULL;
     ctx->chain_table = NULL;
     ctx->buf_sequences = NULL;
@@ -116,27 +191,57 @@ void zxc_cctx_free(zxc_cctx_t* ctx) {
  * Serialization and deserialization of file and block headers.
  */
 
-int zxc_write_file_header(uint8_t* dst, size_t dst_capacity) {
-    if (UNLIKELY(dst_capacity < ZXC_FILE_HEADER_SIZE)) return -1;
+int zxc_write_file_header(uint8_t* dst, size_t dst_capacity, size_t block_size,
+                          uint64_t content_size, int linked, uint32_t dict_id) {
+    int has_size = content_size != ZXC_CONTENT_SIZE_UNKNOWN;
+    size_t h_size = ZXC_FILE_HEADER_SIZE + (has_size ? ZXC_FILE_CONTENT_SIZE_SIZE : 0) +
+                    (dict_id ? ZXC_FILE_DICT_ID_SIZE : 0);
+    if (UNLIKELY(dst_capacity < h_size || block_size == 0 ||
+                 zxc_resolve_block_size(block_size) != block_size))
+        return -1;
 
     zxc_store_le32(dst, ZXC_MAGIC_WORD);
     dst[4] = ZXC_FILE_FORMAT_VERSION;
-    dst[5] = (uint8_t)(ZXC_BLOCK_SIZE / ZXC_BLOCK_UNIT);
-    dst[6] = 0;
+    dst[5] = (uint8_t)zxc_ctz32((uint32_t)block_size);
+    dst[6] = (uint8_t)((has_size ? ZXC_FILE_FLAG_CONTENT_SIZE : 0) |
+                       (linked ? ZXC_FILE_FLAG_LINKED : 0) | (dict_id ? ZXC_FILE_FLAG_DICT_ID : 0));
     dst[7] = 0;
-    return ZXC_FILE_HEADER_SIZE;
+    if (has_size) zxc_store_le64(dst + ZXC_FILE_HEADER_SIZE, content_size);
+    if (dict_id) zxc_store_le32(dst + h_size - ZXC_FILE_DICT_ID_SIZE, dict_id);
+    return (int)h_size;
 }
 
-int zxc_read_file_header(const uint8_t* src, size_t src_size, size_t* out_block_size) {
+int zxc_read_file_header(const uint8_t* src, size_t src_size, size_t* out_block_size,
+                         uint64_t* out_content_size, int* out_linked, uint32_t* out_dict_id) {
     if (UNLIKELY(src_size < ZXC_FILE_HEADER_SIZE || zxc_le32(src) != ZXC_MAGIC_WORD ||
-                 src[4] != ZXC_FILE_FORMAT_VERSION))
+                 src[4] < ZXC_FILE_FORMAT_VERSION_MIN || src[4] > ZXC_FILE_FORMAT_VERSION))
         return -1;
 
-    if (out_block_size) {
+    // Version 3 predates header flags: the byte was always written as 0.
+    int has_size = (src[6] & ZXC_FILE_FLAG_CONTENT_SIZE) != 0;
+    int has_dict = (src[6] & ZXC_FILE_FLAG_DICT_ID) != 0;
+    size_t h_size = ZXC_FILE_HEADER_SIZE + (has_size ? ZXC_FILE_CONTENT_SIZE_SIZE : 0) +
+                    (has_dict ? ZXC_FILE_DICT_ID_SIZE : 0);
+    if (UNLIKELY(src_size < h_size)) return -1;
+    // Dictionary IDs are never 0
+    if (UNLIKELY(has_dict && zxc_le32(src + h_size - ZXC_FILE_DICT_ID_SIZE) == 0)) return -1;
+
+    size_t block_size;
+    if (src[4] == ZXC_FILE_FORMAT_VERSION_MIN) {
         size_t units = src[5] ? src[5] : 64;  // Default to 64 block units (256KB)
-        *out_block_size = units * ZXC_BLOCK_UNIT;
+        block_size = units * ZXC_BLOCK_UNIT;
+    } else {
+        // Version 4+: log2 of the block size
+        if (UNLIKELY(src[5] < ZXC_BLOCK_SIZE_LOG_MIN || src[5] > ZXC_BLOCK_SIZE_LOG_MAX)) return -1;
+        block_size = (size_t)1 << src[5];
     }
-    return 0;
+    if (out_block_size) *out_block_size = block_size;
+    if (out_content_size)
+        *out_content_size =
+            has_size ? zxc_le64(src + ZXC_FILE_HEADER_SIZE) : ZXC_CONTENT_SIZE_UNKNOWN;
+    if (out_linked) *out_linked = (src[6] & ZXC_FILE_FLAG_LINKED) != 0;
+    if (out_dict_id) *out_dict_id = has_dict ? zxc_le32(src + h_size - ZXC_FILE_DICT_ID_SIZE) : 0;
+    return (int)h_size;
 }
 
 int zxc_write_block_header(uint8_t* dst, size_t dst_capacity, const zxc_block_header_t* bh) {
@@ -166,7 +271,8 @@ int zxc_write_num_header(uint8_t* dst, size_t rem, const zxc_num_header_t* nh) {
 
     zxc_store_le64(dst, nh->n_values);
     zxc_store_le16(dst + 8, nh->frame_size);
-    zxc_store_le16(dst + 10, 0);
+    dst[10] = nh->width;
+    dst[11] = 0;
     zxc_store_le32(dst + 12, 0);
     return ZXC_NUM_HEADER_BINARY_SIZE;
 }
@@ -176,6 +282,7 @@ int zxc_read_num_header(const uint8_t* src, size_t src_size, zxc_num_header_t* n
 
     nh->n_values = zxc_le64(src);
     nh->frame_size = zxc_le16(src + 8);
+    nh->width = src[10] ? src[10] : sizeof(uint32_t);
     return 0;
 }
 
@@ -191,9 +298,10 @@ int zxc_write_glo_header_and_desc(uint8_t* dst, size_t rem, const zxc_gnr_header
     dst[8] = gh->enc_lit;
     dst[9] = gh->enc_litlen;
     dst[10] = gh->enc_mlen;
-    dst[11] = gh->enc_off;
+    dst[11] = gh->enc_off | (gh->rep_offsets ? ZXC_OFF_ENC_REP : 0);
+    dst[12] = gh->off_bits;
 
-    zxc_store_le32(dst + 12, 0);
+    dst[13] = dst[14] = dst[15] = 0;
     uint8_t* p = dst + ZXC_GLO_HEADER_BINARY_SIZE;
 
     for (int i = 0; i < ZXC_GLO_SECTIONS; i++) {
@@ -215,7 +323,9 @@ int zxc_read_glo_header_and_desc(const uint8_t* src, size_t len, zxc_gnr_header_
     gh->enc_lit = src[8];
     gh->enc_litlen = src[9];
     gh->enc_mlen = src[10];
-    gh->enc_off = src[11];
+    gh->enc_off = src[11] & ~ZXC_OFF_ENC_REP;
+    gh->rep_offsets = (src[11] & ZXC_OFF_ENC_REP) != 0;
+    gh->off_bits = src[12];
 
     const uint8_t* p = src + ZXC_GLO_HEADER_BINARY_SIZE;
 
@@ -263,6 +373,8 @@ int zxc_read_ghi_header_and_desc(const uint8_t* src, size_t len, zxc_gnr_header_
     gh->enc_litlen = src[9];
     gh->enc_mlen = src[10];
     gh->enc_off = src[11];
+    gh->off_bits = 0;
+    gh->rep_offsets = 0;
 
     const uint8_t* p = src + ZXC_GHI_HEADER_BINARY_SIZE;
 
@@ -273,6 +385,79 @@ int zxc_read_ghi_header_and_desc(const uint8_t* src, size_t len, zxc_gnr_header_
     return 0;
 }
 
+int zxc_huf_build_codes(const uint8_t lens[256], uint16_t codes[256]) {
+    uint32_t count[ZXC_HUF_MAX_BITS + 1] = {0};
+    uint32_t next[ZXC_HUF_MAX_BITS + 1];
+    for (int s = 0; s < 256; s++) {
+        if (UNLIKELY(lens[s] > ZXC_HUF_MAX_BITS)) return -1;
+        count[lens[s]]++;
+    }
+    count[0] = 0;
+
+    uint32_t code = 0;
+    for (int l = 1; l <= ZXC_HUF_MAX_BITS; l++) {
+        code = (code + count[l - 1]) << 1;
+        next[l] = code;
+        // The first code past the last length-l code must still fit in l bits
+        if (UNLIKELY(code + count[l] > (1U << l))) return -1;
+    }
+
+    for (int s = 0; s < 256; s++) {
+        const uint32_t l = lens[s];
+        codes[s] = 0;
+        if (l == 0) continue;
+        uint32_t c = next[l]++, rev = 0;
+        for (uint32_t i = 0; i < l; i++) rev |= ((c >> i) & 1U) << (l - 1 - i);
+        codes[s] = (uint16_t)rev;
+    }
+    return 0;
+}
+
+int zxc_write_seek_table(uint8_t* dst, size_t rem, const zxc_seek_entry_t* entries, uint32_t n) {
+    size_t payload = (size_t)n * ZXC_SEEK_ENTRY_SIZE + ZXC_SEEK_FOOTER_SIZE;
+    if (UNLIKELY(payload > UINT32_MAX || rem < ZXC_BLOCK_HEADER_SIZE + payload)) return -1;
+
+    zxc_block_header_t bh = {.block_type = ZXC_BLOCK_SEK,
+                             .block_flags = ZXC_BLOCK_FLAG_NONE,
+                             .reserved = 0,
+                             .comp_size = (uint32_t)payload,
+                             .raw_size = 0};
+    uint8_t* p = dst + zxc_write_block_header(dst, rem, &bh);
+
+    for (uint32_t i = 0; i < n; i++) {
+        zxc_store_le64(p, entries[i].comp_offset);
+        zxc_store_le64(p + 8, entries[i].raw_offset);
+        zxc_store_le32(p + 16, entries[i].comp_size);
+        zxc_store_le32(p + 20, entries[i].raw_size);
+        p += ZXC_SEEK_ENTRY_SIZE;
+    }
+    zxc_store_le32(p, n);
+    zxc_store_le32(p + 4, ZXC_SEEK_MAGIC);
+    return (int)(ZXC_BLOCK_HEADER_SIZE + payload);
+}
+
+int zxc_find_seek_table(const uint8_t* src, size_t src_size, const uint8_t** entries,
+                        uint32_t* n) {
+    if (UNLIKELY(src_size < ZXC_FILE_HEADER_SIZE + ZXC_BLOCK_HEADER_SIZE + ZXC_SEEK_FOOTER_SIZE))
+        return -1;
+
+    const uint8_t* footer = src + src_size - ZXC_SEEK_FOOTER_SIZE;
+    if (zxc_le32(footer + 4) != ZXC_SEEK_MAGIC) return -1;
+
+    uint32_t count = zxc_le32(footer);
+    uint64_t payload = (uint64_t)count * ZXC_SEEK_ENTRY_SIZE + ZXC_SEEK_FOOTER_SIZE;
+    if (UNLIKELY(payload > src_size - ZXC_FILE_HEADER_SIZE - ZXC_BLOCK_HEADER_SIZE)) return -1;
+
+    const uint8_t* table = src + src_size - (size_t)payload;
+    zxc_block_header_t bh;
+    zxc_read_block_header(table - ZXC_BLOCK_HEADER_SIZE, ZXC_BLOCK_HEADER_SIZE, &bh);
+    if (UNLIKELY(bh.block_type != ZXC_BLOCK_SEK || bh.comp_size != payload)) return -1;
+
+    *entries = table;
+    *n = count;
+    return 0;
+}
+
 /*
  * ============================================================================
  * BITPACKING UTILITIES
@@ -315,6 +500,31 @@ int zxc_bitpack_stream_32(const uint32_t* RESTRICT src, size_t count, uint8_t* R
     return (int)out_bytes;
 }
 
+int zxc_bitpack_stream_64(const uint64_t* RESTRICT src, size_t count, uint8_t* RESTRICT dst,
+                          size_t dst_cap, uint8_t bits) {
+    size_t out_bytes = ((count * bits) + ZXC_BITS_PER_BYTE - 1) / ZXC_BITS_PER_BYTE;
+
+    if (UNLIKELY(dst_cap < out_bytes)) return -1;
+
+    size_t bit_pos = 0;
+    ZXC_MEMSET(dst, 0, out_bytes);
+
+    const uint64_t val_mask = bits < 64 ? (1ULL << bits) - 1 : UINT64_MAX;
+
+    for (size_t i = 0; i < count; i++) {
+        const uint64_t v = src[i] & val_mask;
+        const unsigned shift = bit_pos % ZXC_BITS_PER_BYTE;
+        size_t byte_idx = bit_pos / ZXC_BITS_PER_BYTE;
+
+        // Byte k of the value holds its bits from k * 8 - shift
+        dst[byte_idx] |= (uint8_t)(v << shift);
+        for (unsigned k = ZXC_BITS_PER_BYTE - shift; k < bits; k += ZXC_BITS_PER_BYTE)
+            dst[++byte_idx] |= (uint8_t)(v >> k);
+        bit_pos += bits;
+    }
+    return (int)out_bytes;
+}
+
 /*
  * ============================================================================
  * COMPRESS BOUND CALCULATION
@@ -323,8 +533,10 @@ int zxc_bitpack_stream_32(const uint32_t* RESTRICT src, size_t count, uint8_t* R
 size_t zxc_compress_bound(size_t input_size) {
     if (UNLIKELY(input_size > SIZE_MAX - (SIZE_MAX >> 10))) return 0;
 
-    size_t n = (input_size + ZXC_BLOCK_SIZE - 1) / ZXC_BLOCK_SIZE;
+    // Worst case over all accepted block sizes: the smallest one has the most headers
+    size_t n = (input_size + ZXC_BLOCK_SIZE_MIN - 1) / ZXC_BLOCK_SIZE_MIN;
     if (n == 0) n = 1;
-    return ZXC_FILE_HEADER_SIZE + (n * (ZXC_BLOCK_HEADER_SIZE + ZXC_BLOCK_CHECKSUM_SIZE + 64)) +
-           input_size;
+    return ZXC_FILE_HEADER_MAX_SIZE +
+           (n * (ZXC_BLOCK_HEADER_SIZE + ZXC_BLOCK_CHECKSUM_SIZE + 64 + ZXC_SEEK_ENTRY_SIZE)) +
+           ZXC_BLOCK_HEADER_SIZE + ZXC_SEEK_FOOTER_SIZE + input_size;
 }
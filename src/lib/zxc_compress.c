@@ -22,8 +22,9 @@
 #define ZXC_NUM_FRAME_SIZE \
     128  // Maximum number of frames that can be processed in a single compression operation.
 #define ZXC_EPOCH_BITS \
-    14  // Number of bits reserved for epoch tracking in compressed pointers.
-        // Derived from chunk size: 2^18 = ZXC_BLOCK_SIZE => 32 - 18 = 14 bits.
+    (31 - ZXC_BLOCK_SIZE_LOG_MAX)  // Number of bits reserved for epoch tracking in compressed
+                                   // pointers. Derived from the largest block size plus its
+                                   // linked prefix: 2^21 + 64KB < 2^22 => 32 - 22 = 10 bits.
 #define ZXC_OFFSET_MASK              \
     ((1U << (32 - ZXC_EPOCH_BITS)) - \
      1)  // Mask to extract the offset bits from a compressed pointer.
@@ -91,6 +92,98 @@ static ZXC_ALWAYS_INLINE size_t zxc_write_vbyte(uint8_t* dst, uint32_t val) {
     return count;
 }
 
+/**
+ * @brief Extends a match: counts how many bytes `ip` and `ref` have in common.
+ *
+ * @param[in] ip Current input position.
+ * @param[in] ref Candidate reference (earlier in the buffer).
+ * @param[in] iend End of the input buffer (the match may not run past it).
+ * @param[in] mlen Number of bytes already known to match.
+ * @return The match length.
+ */
+static ZXC_ALWAYS_INLINE uint32_t zxc_lz77_count(const uint8_t* ip, const uint8_t* ref,
+                                                 const uint8_t* iend, uint32_t mlen) {
+    // SIMD match length calculation
+#if defined(ZXC_USE_AVX512)
+    const uint8_t* limit_64 = iend - 64;
+    while (ip + mlen < limit_64) {
+        __m512i v_src = _mm512_loadu_si512((const void*)(ip + mlen));
+        __m512i v_ref = _mm512_loadu_si512((const void*)(ref + mlen));
+        __mmask64 mask = _mm512_cmpeq_epi8_mask(v_src, v_ref);
+        if (mask == 0xFFFFFFFFFFFFFFFF)
+            mlen += 64;
+        else {
+            mlen += (uint32_t)zxc_ctz64(~mask);
+            return mlen;
+        }
+    }
+#elif defined(ZXC_USE_AVX2)
+    const uint8_t* limit_32 = iend - 32;
+    while (ip + mlen < limit_32) {
+        __m256i v_src = _mm256_loadu_si256((const __m256i*)(ip + mlen));
+        __m256i v_ref = _mm256_loadu_si256((const __m256i*)(ref + mlen));
+        __m256i v_cmp = _mm256_cmpeq_epi8(v_src, v_ref);
+        uint32_t mask = (uint32_t)_mm256_movemask_epi8(v_cmp);
+        if (mask == 0xFFFFFFFF)
+            mlen += 32;
+        else {
+            mlen += zxc_ctz32(~mask);
+            return mlen;
+        }
+    }
+#elif defined(ZXC_USE_NEON64) || defined(ZXC_USE_NEON32)
+    const uint8_t* limit_16 = iend - 16;
+    while (ip + mlen < limit_16) {
+        uint8x16_t v_src = vld1q_u8(ip + mlen), v_ref = vld1q_u8(ref + mlen);
+        uint8x16_t v_cmp = vceqq_u8(v_src, v_ref);
+#if defined(ZXC_USE_NEON64)
+        if (vminvq_u8(v_cmp) == 0xFF)
+            mlen += 16;
+        else {
+            uint8x16_t v_diff = vmvnq_u8(v_cmp);
+            uint64_t lo = vgetq_lane_u64(vreinterpretq_u64_u8(v_diff), 0);
+            if (lo != 0)
+                mlen += (zxc_ctz64(lo) >> 3);
+            else
+                mlen += 8 + (zxc_ctz64(vgetq_lane_u64(vreinterpretq_u64_u8(v_diff), 1)) >> 3);
+            return mlen;
+        }
+#else
+        uint8x8_t p1 = vpmin_u8(vget_low_u8(v_cmp), vget_high_u8(v_cmp));
+        uint8x8_t p2 = vpmin_u8(p1, p1);
+        uint8x8_t p3 = vpmin_u8(p2, p2);
+        uint8_t min_val = vget_lane_u8(p3, 0);
+        if (min_val == 0xFF)
+            mlen += 16;
+        else {
+            uint8x16_t v_diff = vmvnq_u8(v_cmp);
+            uint64_t lo = (uint64_t)vgetq_lane_u32(vreinterpretq_u32_u8(v_diff), 0) |
+                          ((uint64_t)vgetq_lane_u32(vreinterpretq_u32_u8(v_diff), 1) << 32);
+            if (lo != 0)
+                mlen += (zxc_ctz64(lo) >> 3);
+            else
+                mlen += 8 + (zxc_ctz64((uint64_t)vgetq_lane_u32(vreinterpretq_u32_u8(v_diff), 2) |
+                                       ((uint64_t)vgetq_lane_u32(vreinterpretq_u32_u8(v_diff), 3)
+                                        << 32)) >>
+                             3);
+            return mlen;
+        }
+#endif
+    }
+#endif
+    const uint8_t* limit_8 = iend - 8;
+    while (ip + mlen < limit_8) {
+        if (zxc_le64(ip + mlen) == zxc_le64(ref + mlen))
+            mlen += 8;
+        else {
+            mlen += (zxc_ctz64(zxc_le64(ip + mlen) ^ zxc_le64(ref + mlen)) >> 3);
+            return mlen;
+        }
+    }
+    while (ip + mlen < iend && ref[mlen] == ip[mlen]) mlen++;
+    return mlen;
+}
+
 /**
  * @brief Structure representing a match found during compression.
  *
@@ -123,17 +216,21 @@ typedef struct {
  * @param[in,out] chain_table Pointer to the chain table for collision handling.
  * @param[in] epoch_mark Current epoch marker for hash table invalidation.
  * @param[in] level Compression level (affects search depth and lazy matching).
- * @param[in] search_depth Maximum number of hash chain entries to search.
- * @param[in] sufficient_len Match length threshold to stop searching.
- * @param[in] use_lazy Flag indicating whether to use lazy matching.
+ * @param[in] p Level parameters (search depth, sufficient length, lazy matching).
+ * @param[in] max_dist Largest offset the block format can store (ZXC_LZ_MAX_DIST,
+ * or ZXC_LZ_FAR_DIST for GLO far offsets). Matches beyond ZXC_LZ_MAX_DIST must
+ * be ZXC_LZ_FAR_PENALTY bytes longer than a nearer one to be preferred.
+ * @param[in] rep Repeat offsets of the block (ZXC_REP_NUM), or NULL. They are
+ * tried before the hash chain, which a long enough one skips, and a chain
+ * candidate must be strictly longer to replace them.
  *
  * @return zxc_match_t Structure containing the best match information
  *         (reference pointer, length of the match, and backtrack distance).
  */
 static ZXC_ALWAYS_INLINE zxc_match_t zxc_lz77_find_best_match(
     const uint8_t* src, const uint8_t* ip, const uint8_t* iend, const uint8_t* mflimit,
-    const uint8_t* anchor, uint32_t* hash_table, uint16_t* chain_table, uint32_t epoch_mark,
-    int level, zxc_lz77_params_t p) {
+    const uint8_t* anchor, uint32_t* hash_table, uint32_t* chain_table, uint32_t epoch_mark,
+    int level, zxc_lz77_params_t p, uint32_t max_dist, const uint32_t* rep) {
     // Track the best match found so far.
     //  ref is the pointer to the start of the match in the history buffer,
     //  len is the match length, and backtrack is the distance from ip to ref.
@@ -170,120 +267,58 @@ static ZXC_ALWAYS_INLINE zxc_match_t zxc_lz77_find_best_match(
 
     hash_table[2 * h] = epoch_mark | cur_pos;
     hash_table[2 * h + 1] = cur_val;
-    chain_table[cur_pos] = (match_idx > 0 && (cur_pos - match_idx) < ZXC_LZ_WINDOW_SIZE)
-                               ? (uint16_t)(cur_pos - match_idx)
-                               : 0;
+    chain_table[cur_pos] = match_idx > 0 ? cur_pos - match_idx : 0;
+
+    // Repeat offsets: no far penalty, as their code replaces the offset
+    if (rep) {
+        for (int r = 0; r < ZXC_REP_NUM; r++) {
+            const uint32_t dist = rep[r];
+            if (dist > cur_pos || dist > max_dist) continue;
+            const uint8_t* ref = ip - dist;
+            if (zxc_le32(ref) != cur_val) continue;
+            uint32_t mlen = zxc_lz77_count(ip, ref, iend, 4);
+            if (mlen > best.len) {
+                best.len = mlen;
+                best.ref = ref;
+            }
+        }
+        if (best.len >= (uint32_t)p.sufficient_len) match_idx = 0;
+    }
 
-    if (match_idx == 0) return best;
+    if (match_idx == 0 && !best.ref) return best;
 
     int attempts = p.search_depth;
     int is_first = 1;
+    uint32_t best_pen = 0;  // ZXC_LZ_FAR_PENALTY while the best match is a far one
 
     while (match_idx > 0 && attempts-- >= 0) {
-        if (UNLIKELY(cur_pos - match_idx > ZXC_LZ_MAX_DIST)) break;
+        uint32_t dist = cur_pos - match_idx;
+        if (UNLIKELY(dist > max_dist)) break;
         const uint8_t* ref = src + match_idx;
         ZXC_PREFETCH_READ(ref);
 
+        // Length this candidate must exceed to beat the best one, offset cost included
+        uint32_t pen = dist > ZXC_LZ_MAX_DIST ? ZXC_LZ_FAR_PENALTY : 0;
+        uint32_t need = best.len + pen - best_pen;
+
         uint32_t ref_val = zxc_le32(ref);
         int tag_match = (ref_val == cur_val);
         // skip_head only matters on first iteration
         int skip_check = is_first & skip_head;
-        int should_compare = tag_match && !skip_check;
-        should_compare &= (ref[best.len] == ip[best.len]);
+        int should_compare = tag_match && !skip_check && ip + need < iend;
+        should_compare = should_compare && (ref[need] == ip[need]);
 
         if (should_compare) {
-            uint32_t mlen = 4;
-            // SIMD match length calculation
-#if defined(ZXC_USE_AVX512)
-            const uint8_t* limit_64 = iend - 64;
-            while (ip + mlen < limit_64) {
-                __m512i v_src = _mm512_loadu_si512((const void*)(ip + mlen));
-                __m512i v_ref = _mm512_loadu_si512((const void*)(ref + mlen));
-                __mmask64 mask = _mm512_cmpeq_epi8_mask(v_src, v_ref);
-                if (mask == 0xFFFFFFFFFFFFFFFF)
-                    mlen += 64;
-                else {
-                    mlen += (uint32_t)zxc_ctz64(~mask);
-                    goto _match_len_done;
-                }
-            }
-#elif defined(ZXC_USE_AVX2)
-            const uint8_t* limit_32 = iend - 32;
-            while (ip + mlen < limit_32) {
-                __m256i v_src = _mm256_loadu_si256((const __m256i*)(ip + mlen));
-                __m256i v_ref = _mm256_loadu_si256((const __m256i*)(ref + mlen));
-                __m256i v_cmp = _mm256_cmpeq_epi8(v_src, v_ref);
-                uint32_t mask = (uint32_t)_mm256_movemask_epi8(v_cmp);
-                if (mask == 0xFFFFFFFF)
-                    mlen += 32;
-                else {
-                    mlen += zxc_ctz32(~mask);
-                    goto _match_len_done;
-                }
-            }
-#elif defined(ZXC_USE_NEON64) || defined(ZXC_USE_NEON32)
-            const uint8_t* limit_16 = iend - 16;
-            while (ip + mlen < limit_16) {
-                uint8x16_t v_src = vld1q_u8(ip + mlen), v_ref = vld1q_u8(ref + mlen);
-                uint8x16_t v_cmp = vceqq_u8(v_src, v_ref);
-#if defined(ZXC_USE_NEON64)
-                if (vminvq_u8(v_cmp) == 0xFF)
-                    mlen += 16;
-                else {
-                    uint8x16_t v_diff = vmvnq_u8(v_cmp);
-                    uint64_t lo = vgetq_lane_u64(vreinterpretq_u64_u8(v_diff), 0);
-                    if (lo != 0)
-                        mlen += (zxc_ctz64(lo) >> 3);
-                    else
-                        mlen +=
-                            8 + (zxc_ctz64(vgetq_lane_u64(vreinterpretq_u64_u8(v_diff), 1)) >> 3);
-                    goto _match_len_done;
-                }
-#else
-                uint8x8_t p1 = vpmin_u8(vget_low_u8(v_cmp), vget_high_u8(v_cmp));
-                uint8x8_t p2 = vpmin_u8(p1, p1);
-                uint8x8_t p3 = vpmin_u8(p2, p2);
-                uint8_t min_val = vget_lane_u8(p3, 0);
-                if (min_val == 0xFF)
-                    mlen += 16;
-                else {
-                    uint8x16_t v_diff = vmvnq_u8(v_cmp);
-                    uint64_t lo = (uint64_t)vgetq_lane_u32(vreinterpretq_u32_u8(v_diff), 0) |
-                                  ((uint64_t)vgetq_lane_u32(vreinterpretq_u32_u8(v_diff), 1) << 32);
-                    if (lo != 0)
-                        mlen += (zxc_ctz64(lo) >> 3);
-                    else
-                        mlen +=
-                            8 +
-                            (zxc_ctz64((uint64_t)vgetq_lane_u32(vreinterpretq_u32_u8(v_diff), 2) |
-                                       ((uint64_t)vgetq_lane_u32(vreinterpretq_u32_u8(v_diff), 3)
-                                        << 32)) >>
-                             3);
-                    goto _match_len_done;
-                }
-#endif
-            }
-#endif
-            const uint8_t* limit_8 = iend - 8;
-            while (ip + mlen < limit_8) {
-                if (zxc_le64(ip + mlen) == zxc_le64(ref + mlen))
-                    mlen += 8;
-                else {
-                    mlen += (zxc_ctz64(zxc_le64(ip + mlen) ^ zxc_le64(ref + mlen)) >> 3);
-                    goto _match_len_done;
-                }
-            }
-            while (ip + mlen < iend && ref[mlen] == ip[mlen]) mlen++;
-
-        _match_len_done:;
-            int better = (mlen > best.len);
+            uint32_t mlen = zxc_lz77_count(ip, ref, iend, 4);
+            int better = (mlen > need);
             best.len = better ? mlen : best.len;
             best.ref = better ? ref : best.ref;
+            best_pen = better ? pen : best_pen;
 
             if (UNLIKELY(best.len >= (uint32_t)p.sufficient_len || ip + best.len >= iend)) break;
         }
 
-        uint16_t delta = chain_table[match_idx];
+        uint32_t delta = chain_table[match_idx];
         uint32_t next_idx = match_idx - delta;
         ZXC_PREFETCH_READ(src + next_idx);
 
@@ -324,7 +359,7 @@ static ZXC_ALWAYS_INLINE zxc_match_t zxc_lz77_find_best_match(
                 while (ip + 1 + l2 < iend && ref2[l2] == ip[1 + l2]) l2++;
                 if (l2 > max_lazy) max_lazy = l2;
             }
-            uint16_t delta = chain_table[next_idx];
+            uint32_t delta = chain_table[next_idx];
             if (UNLIKELY(delta == 0)) break;
             next_idx -= delta;
             is_lazy_first = 0;
@@ -351,7 +386,7 @@ static ZXC_ALWAYS_INLINE zxc_match_t zxc_lz77_find_best_match(
                     while (ip + 2 + l3 < iend && ref3[l3] == ip[2 + l3]) l3++;
                     if (l3 > max_lazy3) max_lazy3 = l3;
                 }
-                uint16_t delta = chain_table[idx3];
+                uint32_t delta = chain_table[idx3];
                 if (UNLIKELY(delta == 0)) break;
                 idx3 -= delta;
                 is_first3 = 0;
@@ -363,18 +398,911 @@ static ZXC_ALWAYS_INLINE zxc_match_t zxc_lz77_find_best_match(
     return best;
 }
 
+/**
+ * @brief Sequence streams of a GLO block being built by a parser.
+ *
+ * Both the greedy/lazy loop and the optimal parser append to these buffers
+ * through zxc_glo_emit_seq(), so they produce the exact same stream layout.
+ */
+typedef struct {
+    uint8_t* literals;    // Literal bytes
+    uint8_t* tokens;      // One token per sequence (LL:4 | ML:4)
+    uint16_t* offsets;    // One offset per sequence
+    uint8_t* extras;      // VByte overflow of LL / ML, and far offsets
+    size_t lit_c;         // Literal bytes written
+    size_t extras_sz;     // Extra bytes written
+    uint32_t seq_c;       // Sequences written
+    uint32_t* dists;      // Full offset of each sequence (selects the offset stream encoding)
+    uint32_t n_rep;       // Sequences whose offset is in the repeat-offset history
+    uint32_t rep[ZXC_REP_NUM];  // Repeat-offset history, most recent first
+} zxc_glo_seqs_t;
+
+/**
+ * @brief Repeat-offset code of `off`, and the history update it implies.
+ *
+ * An offset of the history gets its code (1 to ZXC_REP_NUM) and moves to the
+ * front; any other one gets `off + ZXC_REP_NUM` and is pushed on the history.
+ *
+ * @param[in,out] rep History, most recent first.
+ * @param[in] off Match offset.
+ * @return The code.
+ */
+static ZXC_ALWAYS_INLINE uint32_t zxc_rep_code(uint32_t rep[ZXC_REP_NUM], uint32_t off) {
+    if (off == rep[0]) return 1;
+    uint32_t code = off == rep[1] ? 2 : off == rep[2] ? 3 : off + ZXC_REP_NUM;
+    if (code != 2) rep[2] = rep[1];
+    rep[1] = rep[0];
+    rep[0] = off;
+    return code;
+}
+
+/**
+ * @brief Appends one sequence (literal run + match) to the GLO streams.
+ *
+ * An offset beyond ZXC_LZ_MAX_DIST is stored as 0 in the offset stream and as a
+ * VByte after the sequence's LL / ML extras. The repeat-offset history is kept
+ * up to date for the match finder; whether the block stores repeat-offset codes
+ * is decided once the whole block is parsed.
+ *
+ * @param[in,out] s Sequence streams.
+ * @param[in] anchor Start of the literal run.
+ * @param[in] ll Literal run length.
+ * @param[in] len Match length (>= ZXC_LZ_MIN_MATCH_LEN).
+ * @param[in] off Match offset.
+ */
+static ZXC_ALWAYS_INLINE void zxc_glo_emit_seq(zxc_glo_seqs_t* s, const uint8_t* anchor,
+                                               uint32_t ll, uint32_t len, uint32_t off) {
+    uint32_t ml = len - ZXC_LZ_MIN_MATCH_LEN;
+
+    if (ll > 0) {
+        // The wide copies may read into the match, but not past the end of the input
+        if (ll <= 16 && ll + len >= 16)
+            zxc_copy16(s->literals + s->lit_c, anchor);
+        else if (ll <= 32 && ll + len >= 32)
+            zxc_copy32(s->literals + s->lit_c, anchor);
+        else
+            ZXC_MEMCPY(s->literals + s->lit_c, anchor, ll);
+        s->lit_c += ll;
+    }
+
+    uint8_t ll_code = (ll >= ZXC_TOKEN_LL_MASK) ? ZXC_TOKEN_LL_MASK : (uint8_t)ll;
+    uint8_t ml_code = (ml >= ZXC_TOKEN_ML_MASK) ? ZXC_TOKEN_ML_MASK : (uint8_t)ml;
+    s->tokens[s->seq_c] = (ll_code << ZXC_TOKEN_LIT_BITS) | ml_code;
+    int far = off > ZXC_LZ_MAX_DIST;
+    s->offsets[s->seq_c] = far ? 0 : (uint16_t)off;
+    s->dists[s->seq_c] = off;
+    s->n_rep += zxc_rep_code(s->rep, off) <= ZXC_REP_NUM;
+
+    if (ll >= ZXC_TOKEN_LL_MASK) {
+        s->extras_sz += zxc_write_vbyte(s->extras + s->extras_sz, ll - ZXC_TOKEN_LL_MASK);
+    }
+    if (ml >= ZXC_TOKEN_ML_MASK) {
+        s->extras_sz += zxc_write_vbyte(s->extras + s->extras_sz, ml - ZXC_TOKEN_ML_MASK);
+    }
+    if (UNLIKELY(far)) {
+        s->extras_sz += zxc_write_vbyte(s->extras + s->extras_sz, off);
+    }
+    s->seq_c++;
+}
+
+/*
+ * ============================================================================
+ * OPTIMAL PARSER (levels >= ZXC_LEVEL_OPTIMAL)
+ * ============================================================================
+ * Instead of taking the best match at each position, the optimal parser
+ * collects every useful candidate in a window of up to ZXC_OPT_NUM positions
+ * and runs a shortest-path search over it. The price of a path is the exact
+ * number of bytes the GLO encoding spends on it: literal bytes, one token per
+ * sequence, the offset, and the VByte extras of long literal runs / matches.
+ * With a decode-aware cost model (zxc_cost_model_t), the estimated decode
+ * cycles of each choice are added, so that fewer, longer sequences and fewer
+ * short overlapping offsets are preferred at a small cost in ratio.
+ * The decoder is unchanged: the output is an ordinary GLO block.
+ */
+
+/**
+ * @brief One position of the optimal-parse window (cheapest way to reach it).
+ */
+typedef struct {
+    uint32_t price;   // Encoded bytes from the window start
+    uint32_t litlen;  // Pending literal run when reached by a literal
+    uint32_t mlen;    // 1 = reached by a literal, else length of the match ending here
+    uint32_t off;     // Offset of that match
+} zxc_opt_node_t;
+
+/**
+ * @brief A match candidate (or a chosen sequence while backtracking).
+ */
+typedef struct {
+    uint32_t pos;  // Window position the match starts at
+    uint32_t len;  // Match length
+    uint32_t off;  // Match offset
+} zxc_opt_match_t;
+
+/**
+ * @brief Scratch state of the optimal parser, owned by the context.
+ */
+typedef struct {
+    zxc_opt_node_t nodes[ZXC_OPT_NUM];
+    zxc_opt_match_t matches[ZXC_OPT_MAX_MATCHES];
+    zxc_opt_match_t path[ZXC_OPT_NUM / ZXC_LZ_MIN_MATCH_LEN + 2];
+} zxc_opt_state_t;
+
+/**
+ * @brief Number of bytes zxc_write_vbyte() spends on a value.
+ */
+static ZXC_ALWAYS_INLINE uint32_t zxc_vbyte_len(uint32_t val) {
+    uint32_t n = 1;
+    while (val >= ZXC_VBYTE_MSB) {
+        val >>= 7;
+        n++;
+    }
+    return n;
+}
+
+/**
+ * @brief Price of a run of `ll` literals (bytes + LL extra, and decode cycles).
+ */
+static ZXC_ALWAYS_INLINE uint32_t zxc_opt_lit_price(const zxc_cost_model_t* cm, uint32_t ll) {
+    uint32_t bytes = ll + (ll >= ZXC_TOKEN_LL_MASK ? zxc_vbyte_len(ll - ZXC_TOKEN_LL_MASK) : 0);
+    return cm->byte_weight * bytes + cm->cycle_weight * zxc_lit_decode_cycles(cm, ll);
+}
+
+/**
+ * @brief Price of a match (token + offset + ML extra, and decode cycles).
+ *
+ * The offset is priced at 2 bytes: the 1-byte mode is only chosen when every
+ * offset of the block fits, which is not known while parsing.
+ */
+static ZXC_ALWAYS_INLINE uint32_t zxc_opt_match_price(const zxc_cost_model_t* cm, uint32_t len,
+                                                      uint32_t off) {
+    uint32_t ml = len - ZXC_LZ_MIN_MATCH_LEN;
+    uint32_t bytes = 1 + sizeof(uint16_t) +
+                     (ml >= ZXC_TOKEN_ML_MASK ? zxc_vbyte_len(ml - ZXC_TOKEN_ML_MASK) : 0) +
+                     (off > ZXC_LZ_MAX_DIST ? zxc_vbyte_len(off) : 0);
+    return cm->byte_weight * bytes + cm->cycle_weight * zxc_match_decode_cycles(cm, len, off);
+}
+
+/**
+ * @brief Inserts position `pos` in the hash chain.
+ *
+ * @param[in] src Start of the block.
+ * @param[in] pos Position to insert (each position must be inserted once).
+ * @param[in,out] hash_table Hash table.
+ * @param[in,out] chain_table Chain table.
+ * @param[in] epoch_mark Current epoch marker.
+ * @return The previous head of the bucket (0 if empty).
+ */
+static ZXC_ALWAYS_INLINE uint32_t zxc_lz77_insert(const uint8_t* src, uint32_t pos,
+                                                  uint32_t* hash_table, uint32_t* chain_table,
+                                                  uint32_t epoch_mark) {
+    uint32_t val = zxc_le32(src + pos);
+    uint32_t h = zxc_hash_func(val);
+    uint32_t head = hash_table[2 * h];
+    uint32_t idx = (head & ~ZXC_OFFSET_MASK) == epoch_mark ? (head & ZXC_OFFSET_MASK) : 0;
+
+    hash_table[2 * h] = epoch_mark | pos;
+    hash_table[2 * h + 1] = val;
+    chain_table[pos] = idx > 0 ? pos - idx : 0;
+    return idx;
+}
+
+/**
+ * @brief Indexes the linked prefix of a block (the tail of the previous block).
+ *
+ * Positions `[1, prefix)` are inserted every `stride` bytes, so the block's
+ * first matches can reach back into the previous block.
+ *
+ * @param[in] src Start of the prefix; the block follows it in memory (at least
+ * 4 readable bytes past the prefix).
+ * @param[in] prefix Prefix length.
+ * @param[in] stride Distance between indexed positions (the level's step_base).
+ * @param[in,out] hash_table Hash table.
+ * @param[in,out] chain_table Chain table.
+ * @param[in] epoch_mark Current epoch marker.
+ */
+static void zxc_lz77_load_prefix(const uint8_t* src, uint32_t prefix, uint32_t stride,
+                                 uint32_t* hash_table, uint32_t* chain_table,
+                                 uint32_t epoch_mark) {
+    for (uint32_t pos = 1; pos < prefix; pos += stride)
+        zxc_lz77_insert(src, pos, hash_table, chain_table, epoch_mark);
+}
+
+/**
+ * @brief Inserts `pos` and collects its match candidates.
+ *
+ * Walks the hash chain and keeps every candidate longer than the previous
+ * one, so the list is sorted by increasing length and each entry has the
+ * smallest offset found for its length.
+ *
+ * @param[in] src Start of the block.
+ * @param[in] pos Position to search from.
+ * @param[in] iend End of the block.
+ * @param[in,out] hash_table Hash table.
+ * @param[in,out] chain_table Chain table.
+ * @param[in] epoch_mark Current epoch marker.
+ * @param[in] p Level parameters (search_depth, sufficient_len).
+ * @param[out] matches Candidates (at most ZXC_OPT_MAX_MATCHES).
+ * @return Number of candidates.
+ */
+static int zxc_lz77_find_matches(const uint8_t* src, uint32_t pos, const uint8_t* iend,
+                                 uint32_t* hash_table, uint32_t* chain_table,
+                                 uint32_t epoch_mark, zxc_lz77_params_t p,
+                                 zxc_opt_match_t* matches) {
+    const uint8_t* ip = src + pos;
+    uint32_t cur_val = zxc_le32(ip);
+    uint32_t match_idx = zxc_lz77_insert(src, pos, hash_table, chain_table, epoch_mark);
+    uint32_t best = ZXC_LZ_MIN_MATCH_LEN - 1;
+    int attempts = p.search_depth;
+    int n = 0;
+
+    while (match_idx > 0 && attempts-- > 0) {
+        if (UNLIKELY(pos - match_idx > ZXC_LZ_FAR_DIST)) break;
+        const uint8_t* ref = src + match_idx;
+
+        if (zxc_le32(ref) == cur_val && ref[best] == ip[best]) {
+            uint32_t mlen = zxc_lz77_count(ip, ref, iend, 4);
+            if (mlen > best) {
+                best = mlen;
+                matches[n].len = mlen;
+                matches[n].off = pos - match_idx;
+                if (UNLIKELY(++n == ZXC_OPT_MAX_MATCHES || mlen >= (uint32_t)p.sufficient_len ||
+                             ip + mlen >= iend))
+                    break;
+            }
+        }
+
+        uint32_t delta = chain_table[match_idx];
+        if (delta == 0) break;
+        match_idx -= delta;
+    }
+    return n;
+}
+
+/**
+ * @brief Inserts `pos` in the binary tree of its hash bucket and collects its
+ * match candidates (BT4-style match finder).
+ *
+ * Each bucket is a binary search tree of the earlier positions ordered by the
+ * strings that start there, rooted at the most recent one. The walk from the
+ * old root to a leaf visits the positions that share the longest prefixes with
+ * `pos`, and rebuilds the tree with `pos` as the new root on the way down, so
+ * a search costs O(log n) node visits instead of a walk along the whole chain.
+ * The shorter of the two known prefix lengths (`len0`, `len1`) is skipped at
+ * each node.
+ *
+ * Comparisons stop at `sufficient_len`: a node that matches that far is
+ * replaced by `pos` (which takes over its children), which keeps runs of
+ * identical data cheap. The candidate that reached it is then extended to its
+ * full length.
+ *
+ * @param[in] src Start of the block.
+ * @param[in] pos Position to insert (each position must be inserted once, in
+ * increasing order).
+ * @param[in] iend End of the block.
+ * @param[in,out] hash_table Hash table (roots of the trees).
+ * @param[in,out] bt Tree nodes: children of position `i` at `2 * i` (smaller
+ * strings) and `2 * i + 1` (larger).
+ * @param[in] epoch_mark Current epoch marker.
+ * @param[in] p Level parameters (search_depth in tree nodes, sufficient_len).
+ * @param[out] matches Candidates by increasing length, or NULL to only insert.
+ * @return Number of candidates.
+ */
+static int zxc_bt_find_matches(const uint8_t* src, uint32_t pos, const uint8_t* iend,
+                               uint32_t* hash_table, uint32_t* bt, uint32_t epoch_mark,
+                               zxc_lz77_params_t p, zxc_opt_match_t* matches) {
+    const uint8_t* ip = src + pos;
+    uint32_t val = zxc_le32(ip);
+    uint32_t h = zxc_hash_func(val);
+    uint32_t head = hash_table[2 * h];
+    uint32_t cur = (head & ~ZXC_OFFSET_MASK) == epoch_mark ? (head & ZXC_OFFSET_MASK) : 0;
+    hash_table[2 * h] = epoch_mark | pos;
+    hash_table[2 * h + 1] = val;
+
+    uint32_t* ptr1 = bt + 2 * (size_t)pos;  // Next smaller-string link
+    uint32_t* ptr0 = ptr1 + 1;              // Next larger-string link
+    const uint32_t avail = (uint32_t)(iend - ip);
+    const uint32_t limit = avail < (uint32_t)p.sufficient_len ? avail : (uint32_t)p.sufficient_len;
+    uint32_t len0 = 0, len1 = 0;
+    uint32_t best = ZXC_LZ_MIN_MATCH_LEN - 1;
+    int depth = p.search_depth;
+    int n = 0;
+
+    while (cur > 0 && pos - cur <= ZXC_LZ_FAR_DIST && depth-- > 0) {
+        uint32_t* pair = bt + 2 * (size_t)cur;
+        const uint8_t* ref = src + cur;
+        uint32_t len = zxc_lz77_count(ip, ref, ip + limit, len0 < len1 ? len0 : len1);
+
+        if (len > best) {
+            best = len;
+            if (matches && n < ZXC_OPT_MAX_MATCHES) {
+                matches[n].len = len == limit ? zxc_lz77_count(ip, ref, iend, len) : len;
+                matches[n].off = pos - cur;
+                n++;
+            }
+        }
+        if (len == limit) {
+            // Same string as far as we look: `pos` replaces `cur` in the tree
+            *ptr1 = pair[0];
+            *ptr0 = pair[1];
+            return n;
+        }
+        if (ref[len] < ip[len]) {
+            *ptr1 = cur;
+            ptr1 = pair + 1;
+            cur = *ptr1;
+            len1 = len;
+        } else {
+            *ptr0 = cur;
+            ptr0 = pair;
+            cur = *ptr0;
+            len0 = len;
+        }
+    }
+    *ptr0 = 0;
+    *ptr1 = 0;
+    return n;
+}
+
+/**
+ * @brief Indexes the dictionary in front of a block, or restores the state
+ * saved the first time it was indexed in the same mode.
+ *
+ * Only positions whose bytes (4 for the chains, the whole comparison for the
+ * trees) lie inside the dictionary are indexed, so the saved state depends on
+ * the dictionary alone and serves every later block. Restoring rewrites the
+ * hash heads under the current epoch; the nodes are copied back unless the
+ * chain nodes are still in place from the previous dictionary block (the trees
+ * are rewired by every insertion, so they are always copied).
+ *
+ * @param[in,out] ctx Context (dictionary snapshot fields).
+ * @param[in] base Start of the dictionary; the block follows it.
+ * @param[in] dict_size Dictionary size.
+ * @param[in] key Indexing mode (level, parser, match finder); never 0.
+ * @param[in] stride Distance between indexed positions (chains only).
+ * @param[in] p Level parameters (trees only).
+ * @param[in,out] nodes Chain table, or tree nodes when `tree` is set.
+ * @param[in] tree Non-zero to index binary trees instead of hash chains.
+ * @param[in] epoch_mark Current epoch marker.
+ */
+static void zxc_lz77_load_dict(zxc_cctx_t* ctx, const uint8_t* base, uint32_t dict_size,
+                               uint32_t key, uint32_t stride, zxc_lz77_params_t p,
+                               uint32_t* nodes, int tree, uint32_t epoch_mark) {
+    uint32_t* hash_table = ctx->hash_table;
+    uint32_t* snap = ctx->dict_tables;
+    const size_t n_nodes = (tree ? 2 : 1) * (size_t)dict_size;
+
+    if (snap && ctx->dict_tables_key == key) {
+        for (uint32_t i = 0; i < ZXC_LZ_HASH_SIZE; i++) {
+            if (snap[2 * i]) {
+                hash_table[2 * i] = epoch_mark | snap[2 * i];
+                hash_table[2 * i + 1] = snap[2 * i + 1];
+            }
+        }
+        if (tree || ctx->dict_live_key != key)
+            ZXC_MEMCPY(nodes, snap + 2 * ZXC_LZ_HASH_SIZE, n_nodes * sizeof(uint32_t));
+        ctx->dict_live_key = tree ? 0 : key;
+        return;
+    }
+
+    const uint8_t* const dend = base + dict_size;
+    for (uint32_t pos = 1; pos + sizeof(uint32_t) <= dict_size; pos += tree ? 1 : stride) {
+        if (tree)
+            zxc_bt_find_matches(base, pos, dend, hash_table, nodes, epoch_mark, p, NULL);
+        else
+            zxc_lz77_insert(base, pos, hash_table, nodes, epoch_mark);
+    }
+    ctx->dict_live_key = tree ? 0 : key;
+
+    // Snapshot: positions without the epoch (0 = empty bucket), then the nodes
+    if (!snap) {
+        snap = (uint32_t*)malloc((2 * ZXC_LZ_HASH_SIZE + 2 * (size_t)dict_size) *
+                                 sizeof(uint32_t));
+        ctx->dict_tables = snap;
+        if (UNLIKELY(!snap)) return;
+    }
+    for (uint32_t i = 0; i < ZXC_LZ_HASH_SIZE; i++) {
+        uint32_t head = hash_table[2 * i];
+        snap[2 * i] = (head & ~ZXC_OFFSET_MASK) == epoch_mark ? (head & ZXC_OFFSET_MASK) : 0;
+        snap[2 * i + 1] = hash_table[2 * i + 1];
+    }
+    ZXC_MEMCPY(snap + 2 * ZXC_LZ_HASH_SIZE, nodes, n_nodes * sizeof(uint32_t));
+    ctx->dict_tables_key = key;
+}
+
+/**
+ * @brief Optimal (price-based) LZ77 parse of a block.
+ *
+ * For each window the parser prices every position reachable from the window
+ * start, either by one more literal or by a candidate match of any length
+ * between ZXC_LZ_MIN_MATCH_LEN and the candidate length. The window ends at
+ * the furthest match end seen; it is cut short when a candidate reaches
+ * `sufficient_len` (that match is taken as is). The cheapest path is then
+ * backtracked and emitted.
+ *
+ * Candidates come from the hash chains, or from the binary trees when `bt` is
+ * given; every position of the block (and of its linked prefix) is inserted
+ * exactly once either way.
+ *
+ * @param[in] src Start of the block's linked prefix (of the block without one).
+ * @param[in] prefix Prefix length: the block starts at `src + prefix`.
+ * @param[in] first_ins First position still to index (1, or `prefix` when the
+ * prefix is an already indexed dictionary).
+ * @param[in] src_size Block size.
+ * @param[in,out] hash_table Hash table.
+ * @param[in,out] chain_table Chain table.
+ * @param[in,out] bt Binary-tree nodes, or NULL to use the hash chains.
+ * @param[in] epoch_mark Current epoch marker.
+ * @param[in] p Level parameters.
+ * @param[in] cm Cost model (non-zero weights).
+ * @param[in,out] st Parser scratch state.
+ * @param[in,out] s Sequence streams.
+ * @return The start of the trailing literals.
+ */
+static const uint8_t* zxc_lz77_parse_optimal(const uint8_t* src, uint32_t prefix,
+                                             uint32_t first_ins, size_t src_size,
+                                             uint32_t* hash_table,
+                                             uint32_t* chain_table, uint32_t* bt,
+                                             uint32_t epoch_mark,
+                                             zxc_lz77_params_t p, const zxc_cost_model_t* cm,
+                                             zxc_opt_state_t* st, zxc_glo_seqs_t* s) {
+    const uint8_t *ip = src + prefix, *iend = ip + src_size, *anchor = ip, *mflimit = iend - 12;
+    zxc_opt_node_t* opt = st->nodes;
+    uint32_t next_ins = first_ins;  // Position 0 cannot be referenced (index 0 means "empty")
+    const uint32_t nice = (uint32_t)p.sufficient_len;
+
+    while (LIKELY(ip < mflimit)) {
+        uint32_t base = (uint32_t)(ip - src);
+        for (; next_ins < base; next_ins++) {
+            if (bt)
+                zxc_bt_find_matches(src, next_ins, iend, hash_table, bt, epoch_mark, p, NULL);
+            else
+                zxc_lz77_insert(src, next_ins, hash_table, chain_table, epoch_mark);
+        }
+        if (next_ins == base) next_ins++;
+
+        int nm = bt ? zxc_bt_find_matches(src, base, iend, hash_table, bt, epoch_mark, p,
+                                          st->matches)
+                    : zxc_lz77_find_matches(src, base, iend, hash_table, chain_table,
+                                            epoch_mark, p, st->matches);
+        if (nm == 0) {
+            ip++;
+            continue;
+        }
+
+        uint32_t last = 0;
+        uint32_t n_path = 0;
+        zxc_opt_match_t forced = {0, 0, 0};
+
+        opt[0] = (zxc_opt_node_t){0, (uint32_t)(ip - anchor), 1, 0};
+        for (uint32_t cur = 0;; cur++) {
+            if (cur > 0) {
+                if (cur >= last) break;
+
+                // Literal transition from the previous position
+                const zxc_opt_node_t* prev = &opt[cur - 1];
+                uint32_t lp = prev->price + zxc_opt_lit_price(cm, prev->litlen + 1) -
+                              zxc_opt_lit_price(cm, prev->litlen);
+                if (lp < opt[cur].price) opt[cur] = (zxc_opt_node_t){lp, prev->litlen + 1, 1, 0};
+
+                if (ip + cur >= mflimit) continue;
+                nm = bt ? zxc_bt_find_matches(src, base + cur, iend, hash_table, bt, epoch_mark,
+                                              p, st->matches)
+                        : zxc_lz77_find_matches(src, base + cur, iend, hash_table, chain_table,
+                                                epoch_mark, p, st->matches);
+                next_ins = base + cur + 1;
+            }
+
+            if (nm > 0) {
+                const zxc_opt_match_t* longest = &st->matches[nm - 1];
+                if (longest->len >= nice || cur + longest->len >= ZXC_OPT_NUM) {
+                    forced = (zxc_opt_match_t){cur, longest->len, longest->off};
+                    last = cur;
+                    break;
+                }
+
+                uint32_t len = ZXC_LZ_MIN_MATCH_LEN;
+                for (int i = 0; i < nm; i++) {
+                    const zxc_opt_match_t* m = &st->matches[i];
+                    for (; len <= m->len; len++) {
+                        uint32_t pos = cur + len;
+                        uint32_t price = opt[cur].price + zxc_opt_match_price(cm, len, m->off);
+                        while (last < pos) opt[++last].price = UINT32_MAX;
+                        if (price < opt[pos].price)
+                            opt[pos] = (zxc_opt_node_t){price, 0, len, m->off};
+                    }
+                }
+            }
+            nm = 0;
+        }
+
+        // Backtrack the cheapest path (sequences are collected last to first)
+        if (forced.len) st->path[n_path++] = forced;
+        for (uint32_t pos = last; pos > 0;) {
+            const zxc_opt_node_t* node = &opt[pos];
+            if (node->mlen == 1) {
+                pos--;
+            } else {
+                pos -= node->mlen;
+                st->path[n_path++] = (zxc_opt_match_t){pos, node->mlen, node->off};
+            }
+        }
+
+        while (n_path > 0) {
+            const zxc_opt_match_t* m = &st->path[--n_path];
+            const uint8_t* start = ip + m->pos;
+            zxc_glo_emit_seq(s, anchor, (uint32_t)(start - anchor), m->len, m->off);
+            anchor = start + m->len;
+        }
+        ip = anchor;
+    }
+    return anchor;
+}
+
+/**
+ * @brief Zigzag deltas of a frame of 16-bit values.
+ *
+ * The deltas wrap modulo 2^16, so they always fit in 16 bits after zigzag;
+ * they are widened to 32 bits for zxc_bitpack_stream_32().
+ *
+ * @param[in] in First value of the frame.
+ * @param[in] n Number of values (at least 1).
+ * @param[in] prev Last value of the previous frame (0 for the first one).
+ * @param[out] deltas Zigzag deltas.
+ * @return The bitwise OR of the deltas (same highest bit as their maximum).
+ */
+static uint32_t zxc_num_deltas16(const uint8_t* RESTRICT in, size_t n, uint16_t prev,
+                                 uint32_t* RESTRICT deltas) {
+    uint32_t acc = deltas[0] = zxc_zigzag_encode((int16_t)(uint16_t)(zxc_le16(in) - prev));
+    size_t j = 1;
+
+#if defined(ZXC_USE_AVX512)
+    __m256i v_acc = _mm256_setzero_si256();
+    for (; j + 16 <= n; j += 16) {
+        __m256i vc = _mm256_loadu_si256((const __m256i*)(in + j * 2));
+        __m256i vp = _mm256_loadu_si256((const __m256i*)(in + j * 2 - 2));
+        __m256i diff = _mm256_sub_epi16(vc, vp);
+        // ZigZag encode: (diff << 1) ^ (diff >> 15)
+        __m256i zz = _mm256_xor_si256(_mm256_slli_epi16(diff, 1), _mm256_srai_epi16(diff, 15));
+        _mm512_storeu_si512((void*)&deltas[j], _mm512_cvtepu16_epi32(zz));
+        v_acc = _mm256_or_si256(v_acc, zz);
+    }
+    acc |= (uint32_t)_mm512_reduce_or_epi32(_mm512_cvtepu16_epi32(v_acc));
+#elif defined(ZXC_USE_AVX2)
+    __m128i v_acc = _mm_setzero_si128();
+    for (; j + 8 <= n; j += 8) {
+        __m128i vc = _mm_loadu_si128((const __m128i*)(in + j * 2));
+        __m128i vp = _mm_loadu_si128((const __m128i*)(in + j * 2 - 2));
+        __m128i diff = _mm_sub_epi16(vc, vp);
+        // ZigZag encode: (diff << 1) ^ (diff >> 15)
+        __m128i zz = _mm_xor_si128(_mm_slli_epi16(diff, 1), _mm_srai_epi16(diff, 15));
+        _mm256_storeu_si256((__m256i*)&deltas[j], _mm256_cvtepu16_epi32(zz));
+        v_acc = _mm_or_si128(v_acc, zz);
+    }
+    v_acc = _mm_or_si128(v_acc, _mm_srli_si128(v_acc, 8));
+    v_acc = _mm_or_si128(v_acc, _mm_srli_si128(v_acc, 4));
+    v_acc = _mm_or_si128(v_acc, _mm_srli_si128(v_acc, 2));
+    acc |= (uint32_t)_mm_extract_epi16(v_acc, 0);
+#elif defined(ZXC_USE_NEON64) || defined(ZXC_USE_NEON32)
+    uint16x8_t v_acc = vdupq_n_u16(0);
+    for (; j + 8 <= n; j += 8) {
+        uint16x8_t vc = vld1q_u16((const uint16_t*)(in + j * 2));
+        uint16x8_t vp = vld1q_u16((const uint16_t*)(in + j * 2 - 2));
+        uint16x8_t diff = vsubq_u16(vc, vp);
+        // ZigZag encode: (diff << 1) ^ (diff >> 15)
+        uint16x8_t sign = vreinterpretq_u16_s16(vshrq_n_s16(vreinterpretq_s16_u16(diff), 15));
+        uint16x8_t zz = veorq_u16(vshlq_n_u16(diff, 1), sign);
+        vst1q_u32(&deltas[j], vmovl_u16(vget_low_u16(zz)));
+        vst1q_u32(&deltas[j + 4], vmovl_u16(vget_high_u16(zz)));
+        v_acc = vorrq_u16(v_acc, zz);
+    }
+    uint16x4_t v_or = vorr_u16(vget_low_u16(v_acc), vget_high_u16(v_acc));
+    acc |= (uint32_t)(vget_lane_u16(v_or, 0) | vget_lane_u16(v_or, 1) | vget_lane_u16(v_or, 2) |
+                      vget_lane_u16(v_or, 3));
+#endif
+
+    for (; j < n; j++) {
+        deltas[j] = zxc_zigzag_encode(
+            (int16_t)(uint16_t)(zxc_le16(in + j * 2) - zxc_le16(in + j * 2 - 2)));
+        acc |= deltas[j];
+    }
+    return acc;
+}
+
+/**
+ * @brief Zigzag deltas of a frame of 32-bit values.
+ *
+ * @param[in] in First value of the frame.
+ * @param[in] n Number of values (at least 1).
+ * @param[in] prev Last value of the previous frame (0 for the first one).
+ * @param[out] deltas Zigzag deltas.
+ * @return The largest delta.
+ */
+static uint32_t zxc_num_deltas32(const uint8_t* RESTRICT in, size_t n, uint32_t prev,
+                                 uint32_t* RESTRICT deltas) {
+    uint32_t max_d = deltas[0] = zxc_zigzag_encode((int32_t)(zxc_le32(in) - prev));
+    size_t j = 1;
+
+#if defined(ZXC_USE_AVX512)
+    if (n >= 17) {
+        __m512i v_max_accum = _mm512_setzero_si512();  // Initialize max accumulator to 0
+
+        for (; j + 16 <= n; j += 16) {
+            // Load 16 consecutive integers
+            __m512i vc = _mm512_loadu_si512((const void*)(in + j * 4));
+            // Load 16 integers offset by -1 to get previous values
+            __m512i vp = _mm512_loadu_si512((const void*)(in + j * 4 - 4));
+
+            __m512i diff = _mm512_sub_epi32(vc, vp);  // Compute deltas: curr - prev
+
+            // ZigZag encode: (diff << 1) ^ (diff >> 31)
+            __m512i zigzag =
+                _mm512_xor_si512(_mm512_slli_epi32(diff, 1), _mm512_srai_epi32(diff, 31));
+
+            _mm512_storeu_si512((void*)&deltas[j], zigzag);  // Store results
+            v_max_accum = _mm512_max_epu32(v_max_accum, zigzag);  // Update max value seen so far
+        }
+        uint32_t m = _mm512_reduce_max_epu32(v_max_accum);  // Horizontal max reduction
+        if (m > max_d) max_d = m;
+    }
+#elif defined(ZXC_USE_AVX2)
+    if (n >= 9) {
+        __m256i v_max_accum = _mm256_setzero_si256();  // Initialize max accumulator to 0
+
+        for (; j + 8 <= n; j += 8) {
+            // Load 8 consecutive integers
+            __m256i vc = _mm256_loadu_si256((const __m256i*)(in + j * 4));
+            // Load 8 integers offset by -1
+            __m256i vp = _mm256_loadu_si256((const __m256i*)(in + j * 4 - 4));
+
+            __m256i diff = _mm256_sub_epi32(vc, vp);  // Compute deltas
+
+            // ZigZag encode: (diff << 1) ^ (diff >> 31)
+            __m256i zigzag =
+                _mm256_xor_si256(_mm256_slli_epi32(diff, 1), _mm256_srai_epi32(diff, 31));
+            _mm256_storeu_si256((__m256i*)&deltas[j], zigzag);    // Store results
+            v_max_accum = _mm256_max_epu32(v_max_accum, zigzag);  // Update max accumulator
+        }
+
+        uint32_t m = zxc_mm256_reduce_max_epu32(v_max_accum);  // Horizontal max reduction
+        if (m > max_d) max_d = m;
+    }
+#elif defined(ZXC_USE_NEON64) || defined(ZXC_USE_NEON32)
+    // NEON processes 128-bit vectors (4 uint32 integers)
+    if (n >= 5) {
+        uint32x4_t v_max_accum = vdupq_n_u32(0);  // Initialize vector with zeros
+
+        for (; j + 4 <= n; j += 4) {
+            // Load 4 32-bit integers
+            uint32x4_t vc = vld1q_u32((const uint32_t*)(in + j * 4));
+            uint32x4_t vp = vld1q_u32((const uint32_t*)(in + j * 4 - 4));
+
+            uint32x4_t diff = vsubq_u32(vc, vp);  // Calc deltas
+
+            // ZigZag encode: (diff << 1) ^ (diff >> 31)
+            uint32x4_t z1 = vshlq_n_u32(diff, 1);
+            // Arithmetic shift right to duplicate sign bit
+            uint32x4_t z2 = vreinterpretq_u32_s32(vshrq_n_s32(vreinterpretq_s32_u32(diff), 31));
+            uint32x4_t zigzag = veorq_u32(z1, z2);
+
+            vst1q_u32(&deltas[j], zigzag);                 // Store results
+            v_max_accum = vmaxq_u32(v_max_accum, zigzag);  // Update max accumulator
+        }
+
+        uint32_t m;
+#if defined(ZXC_USE_NEON64)
+        m = vmaxvq_u32(v_max_accum);  // Reduce vector to single max value (AArch64)
+#else
+        // NEON 32-bit (ARMv7) fallback for horizontal max using standard shifts
+        // Reduce 4 elements -> 2
+        uint32x4_t v_swap = vextq_u32(v_max_accum, v_max_accum, 2);  // Swap low/high halves
+        uint32x4_t v_max2 = vmaxq_u32(v_max_accum, v_swap);
+        // Reduce 2 -> 1
+        v_swap = vextq_u32(v_max2, v_max2, 1);  // Shift by 32 bits
+        uint32x4_t v_max1 = vmaxq_u32(v_max2, v_swap);
+        m = vgetq_lane_u32(v_max1, 0);
+#endif
+        if (m > max_d) max_d = m;
+    }
+#endif
+
+    prev = zxc_le32(in + j * 4 - 4);
+    for (; j < n; j++) {
+        uint32_t v = zxc_le32(in + j * 4);
+        uint32_t diff = zxc_zigzag_encode((int32_t)(v - prev));
+        deltas[j] = diff;
+        if (diff > max_d) max_d = diff;
+        prev = v;
+    }
+    return max_d;
+}
+
+/**
+ * @brief Zigzag deltas of a frame of 64-bit values.
+ *
+ * @param[in] in First value of the frame.
+ * @param[in] n Number of values (at least 1).
+ * @param[in] prev Last value of the previous frame (0 for the first one).
+ * @param[out] deltas Zigzag deltas.
+ * @return The bitwise OR of the deltas (same highest bit as their maximum).
+ */
+static uint64_t zxc_num_deltas64(const uint8_t* RESTRICT in, size_t n, uint64_t prev,
+                                 uint64_t* RESTRICT deltas) {
+    uint64_t acc = deltas[0] = zxc_zigzag_encode64((int64_t)(zxc_le64(in) - prev));
+    size_t j = 1;
+
+#if defined(ZXC_USE_AVX512)
+    __m512i v_acc = _mm512_setzero_si512();
+    for (; j + 8 <= n; j += 8) {
+        __m512i vc = _mm512_loadu_si512((const void*)(in + j * 8));
+        __m512i vp = _mm512_loadu_si512((const void*)(in + j * 8 - 8));
+        __m512i diff = _mm512_sub_epi64(vc, vp);
+        // ZigZag encode: (diff << 1) ^ (diff >> 63)
+        __m512i zz = _mm512_xor_si512(_mm512_slli_epi64(diff, 1), _mm512_srai_epi64(diff, 63));
+        _mm512_storeu_si512((void*)&deltas[j], zz);
+        v_acc = _mm512_or_si512(v_acc, zz);
+    }
+    acc |= (uint64_t)_mm512_reduce_or_epi64(v_acc);
+#elif defined(ZXC_USE_AVX2)
+    __m256i v_acc = _mm256_setzero_si256();
+    for (; j + 4 <= n; j += 4) {
+        __m256i vc = _mm256_loadu_si256((const __m256i*)(in + j * 8));
+        __m256i vp = _mm256_loadu_si256((const __m256i*)(in + j * 8 - 8));
+        __m256i diff = _mm256_sub_epi64(vc, vp);
+        // ZigZag encode: (diff << 1) ^ (diff >> 63), the sign from a compare (no srai_epi64)
+        __m256i sign = _mm256_cmpgt_epi64(_mm256_setzero_si256(), diff);
+        __m256i zz = _mm256_xor_si256(_mm256_slli_epi64(diff, 1), sign);
+        _mm256_storeu_si256((__m256i*)&deltas[j], zz);
+        v_acc = _mm256_or_si256(v_acc, zz);
+    }
+    __m128i v_or = _mm_or_si128(_mm256_castsi256_si128(v_acc), _mm256_extracti128_si256(v_acc, 1));
+    acc |= (uint64_t)_mm_cvtsi128_si64(_mm_or_si128(v_or, _mm_srli_si128(v_or, 8)));
+#elif defined(ZXC_USE_NEON64) || defined(ZXC_USE_NEON32)
+    uint64x2_t v_acc = vdupq_n_u64(0);
+    for (; j + 2 <= n; j += 2) {
+        uint64x2_t vc = vld1q_u64((const uint64_t*)(in + j * 8));
+        uint64x2_t vp = vld1q_u64((const uint64_t*)(in + j * 8 - 8));
+        uint64x2_t diff = vsubq_u64(vc, vp);
+        // ZigZag encode: (diff << 1) ^ (diff >> 63)
+        uint64x2_t sign = vreinterpretq_u64_s64(vshrq_n_s64(vreinterpretq_s64_u64(diff), 63));
+        uint64x2_t zz = veorq_u64(vshlq_n_u64(diff, 1), sign);
+        vst1q_u64(&deltas[j], zz);
+        v_acc = vorrq_u64(v_acc, zz);
+    }
+    acc |= vgetq_lane_u64(v_acc, 0) | vgetq_lane_u64(v_acc, 1);
+#endif
+
+    for (; j < n; j++) {
+        const uint64_t d = zxc_le64(in + j * 8) - zxc_le64(in + j * 8 - 8);
+        deltas[j] = zxc_zigzag_encode64((int64_t)d);
+        acc |= deltas[j];
+    }
+    return acc;
+}
+
+/**
+ * @brief XOR of each 32-bit value of a frame with the previous one (FLT blocks).
+ *
+ * @param[in] in First value of the frame.
+ * @param[in] n Number of values (at least 1).
+ * @param[in] prev Last value of the previous frame (0 for the first one).
+ * @param[out] xors XOR residuals.
+ * @return The bitwise OR of the residuals.
+ */
+static uint32_t zxc_flt_xor32(const uint8_t* RESTRICT in, size_t n, uint32_t prev,
+                              uint32_t* RESTRICT xors) {
+    uint32_t acc = xors[0] = zxc_le32(in) ^ prev;
+    size_t j = 1;
+
+#if defined(ZXC_USE_AVX512)
+    __m512i v_acc = _mm512_setzero_si512();
+    for (; j + 16 <= n; j += 16) {
+        __m512i vc = _mm512_loadu_si512((const void*)(in + j * 4));
+        __m512i vp = _mm512_loadu_si512((const void*)(in + j * 4 - 4));
+        __m512i x = _mm512_xor_si512(vc, vp);
+        _mm512_storeu_si512((void*)&xors[j], x);
+        v_acc = _mm512_or_si512(v_acc, x);
+    }
+    acc |= (uint32_t)_mm512_reduce_or_epi32(v_acc);
+#elif defined(ZXC_USE_AVX2)
+    __m256i v_acc = _mm256_setzero_si256();
+    for (; j + 8 <= n; j += 8) {
+        __m256i vc = _mm256_loadu_si256((const __m256i*)(in + j * 4));
+        __m256i vp = _mm256_loadu_si256((const __m256i*)(in + j * 4 - 4));
+        __m256i x = _mm256_xor_si256(vc, vp);
+        _mm256_storeu_si256((__m256i*)&xors[j], x);
+        v_acc = _mm256_or_si256(v_acc, x);
+    }
+    __m128i v_or = _mm_or_si128(_mm256_castsi256_si128(v_acc), _mm256_extracti128_si256(v_acc, 1));
+    v_or = _mm_or_si128(v_or, _mm_srli_si128(v_or, 8));
+    acc |= (uint32_t)_mm_cvtsi128_si32(_mm_or_si128(v_or, _mm_srli_si128(v_or, 4)));
+#elif defined(ZXC_USE_NEON64) || defined(ZXC_USE_NEON32)
+    uint32x4_t v_acc = vdupq_n_u32(0);
+    for (; j + 4 <= n; j += 4) {
+        uint32x4_t vc = vld1q_u32((const uint32_t*)(in + j * 4));
+        uint32x4_t vp = vld1q_u32((const uint32_t*)(in + j * 4 - 4));
+        uint32x4_t x = veorq_u32(vc, vp);
+        vst1q_u32(&xors[j], x);
+        v_acc = vorrq_u32(v_acc, x);
+    }
+    uint32x2_t v_or = vorr_u32(vget_low_u32(v_acc), vget_high_u32(v_acc));
+    acc |= vget_lane_u32(v_or, 0) | vget_lane_u32(v_or, 1);
+#endif
+
+    for (; j < n; j++) {
+        xors[j] = zxc_le32(in + j * 4) ^ zxc_le32(in + j * 4 - 4);
+        acc |= xors[j];
+    }
+    return acc;
+}
+
+/**
+ * @brief XOR of each 64-bit value of a frame with the previous one (FLT blocks).
+ *
+ * @param[in] in First value of the frame.
+ * @param[in] n Number of values (at least 1).
+ * @param[in] prev Last value of the previous frame (0 for the first one).
+ * @param[out] xors XOR residuals.
+ * @return The bitwise OR of the residuals.
+ */
+static uint64_t zxc_flt_xor64(const uint8_t* RESTRICT in, size_t n, uint64_t prev,
+                              uint64_t* RESTRICT xors) {
+    uint64_t acc = xors[0] = zxc_le64(in) ^ prev;
+    size_t j = 1;
+
+#if defined(ZXC_USE_AVX512)
+    __m512i v_acc = _mm512_setzero_si512();
+    for (; j + 8 <= n; j += 8) {
+        __m512i vc = _mm512_loadu_si512((const void*)(in + j * 8));
+        __m512i vp = _mm512_loadu_si512((const void*)(in + j * 8 - 8));
+        __m512i x = _mm512_xor_si512(vc, vp);
+        _mm512_storeu_si512((void*)&xors[j], x);
+        v_acc = _mm512_or_si512(v_acc, x);
+    }
+    acc |= (uint64_t)_mm512_reduce_or_epi64(v_acc);
+#elif defined(ZXC_USE_AVX2)
+    __m256i v_acc = _mm256_setzero_si256();
+    for (; j + 4 <= n; j += 4) {
+        __m256i vc = _mm256_loadu_si256((const __m256i*)(in + j * 8));
+        __m256i vp = _mm256_loadu_si256((const __m256i*)(in + j * 8 - 8));
+        __m256i x = _mm256_xor_si256(vc, vp);
+        _mm256_storeu_si256((__m256i*)&xors[j], x);
+        v_acc = _mm256_or_si256(v_acc, x);
+    }
+    __m128i v_or = _mm_or_si128(_mm256_castsi256_si128(v_acc), _mm256_extracti128_si256(v_acc, 1));
+    acc |= (uint64_t)_mm_cvtsi128_si64(_mm_or_si128(v_or, _mm_srli_si128(v_or, 8)));
+#elif defined(ZXC_USE_NEON64) || defined(ZXC_USE_NEON32)
+    uint64x2_t v_acc = vdupq_n_u64(0);
+    for (; j + 2 <= n; j += 2) {
+        uint64x2_t vc = vld1q_u64((const uint64_t*)(in + j * 8));
+        uint64x2_t vp = vld1q_u64((const uint64_t*)(in + j * 8 - 8));
+        uint64x2_t x = veorq_u64(vc, vp);
+        vst1q_u64(&xors[j], x);
+        v_acc = vorrq_u64(v_acc, x);
+    }
+    acc |= vgetq_lane_u64(v_acc, 0) | vgetq_lane_u64(v_acc, 1);
+#endif
+
+    for (; j < n; j++) {
+        xors[j] = zxc_le64(in + j * 8) ^ zxc_le64(in + j * 8 - 8);
+        acc |= xors[j];
+    }
+    return acc;
+}
+
 /**
  * @brief Encodes a block of numerical data using delta encoding and
  * bit-packing.
  *
- * This function compresses a source buffer of 32-bit integers. It processes the
- * data in frames defined by `ZXC_NUM_FRAME_SIZE`.
+ * This function compresses a source buffer of 16-, 32- or 64-bit integers. It
+ * processes the data in frames defined by `ZXC_NUM_FRAME_SIZE`.
  *
  * **Algorithm Steps:**
- * 1. **Delta Encoding:** Calculates `delta = value[i] - value[i-1]`. This
- * reduces the magnitude of numbers if the data is sequential or correlated.
- *    - **SIMD Optimization:** Uses AVX2 (`_mm256_sub_epi32`) to compute deltas
- * for 8 integers at once.
+ * 1. **Delta Encoding:** Calculates `delta = value[i] - value[i-1]`, modulo the
+ * value width. This reduces the magnitude of numbers if the data is sequential
+ * or correlated.
+ *    - **SIMD Optimization:** zxc_num_deltas16(), zxc_num_deltas32() and
+ * zxc_num_deltas64() compute a vector of deltas at once (AVX-512, AVX2, NEON).
  * 2. **ZigZag Encoding:** Maps signed deltas to unsigned integers (`(n << 1) ^
  * (n >> 31)`). This ensures small negative numbers become small positive
  * numbers (e.g., -1 -> 1, 1 -> 2).
@@ -383,34 +1311,47 @@ static ZXC_ALWAYS_INLINE zxc_match_t zxc_lz77_find_best_match(
  * 4. **Bit Packing:** Packs the ZigZag-encoded deltas into a compact bitstream
  *    using `b` bits per value.
  *
- * @param[in] src Pointer to the source buffer containing raw 32-bit integer data.
- * @param[in] src_size Size of the source buffer in bytes. Must be a multiple of 4
- * and non-zero.
+ * FLT blocks (`flt`, 32- or 64-bit floats) share the layout: the residual of a
+ * value is its XOR with the previous one (zxc_flt_xor32(), zxc_flt_xor64()),
+ * whose identical sign, exponent and high mantissa bits clear the top of the
+ * residuals. The trailing zero bits common to a frame (floats of fewer
+ * significant digits, floats widened to doubles) are shifted out, and their
+ * count stored in the frame header in place of the NUM base value.
+ *
+ * @param[in] src Pointer to the source buffer containing raw integer data.
+ * @param[in] src_size Size of the source buffer in bytes. Must be a multiple of
+ * `width` and non-zero.
  * @param[out] dst Pointer to the destination buffer where compressed data will be
  * written.
  * @param[in] dst_cap Capacity of the destination buffer in bytes.
  * @param[out] out_sz Pointer to a variable where the total size of the compressed
  * output will be stored.
  * @param[in] crc_val The pre-calculated XXH3 value (if checksum is enabled).
+ * @param[in] width Size of each integer in bytes: 2, 4 or 8 (4 or 8 for FLT).
+ * @param[in] flt Writes a FLT block instead of a NUM block.
  *
  * @return 0 on success, or -1 on failure (e.g., invalid input size, destination
  * buffer too small).
  */
 static int zxc_encode_block_num(const zxc_cctx_t* ctx, const uint8_t* RESTRICT src, size_t src_size,
                                 uint8_t* RESTRICT dst, size_t dst_cap, size_t* out_sz,
-                                uint64_t crc_val) {
-    if (UNLIKELY(src_size % 4 != 0 || src_size == 0)) return -1;
+                                uint64_t crc_val, size_t width, int flt) {
+    if (UNLIKELY((width != 2 && width != 4 && width != 8) || (flt && width == 2) ||
+                 src_size % width != 0 || src_size == 0))
+        return -1;
     int chk = ctx->checksum_enabled;
 
-    size_t count = src_size / 4;
+    size_t count = src_size / width;
     size_t h_gap = ZXC_BLOCK_HEADER_SIZE + (chk ? ZXC_BLOCK_CHECKSUM_SIZE : 0);
 
     if (UNLIKELY(dst_cap < h_gap + ZXC_NUM_HEADER_BINARY_SIZE)) return -1;
 
-    zxc_block_header_t bh = {.block_type = ZXC_BLOCK_NUM, .raw_size = (uint32_t)src_size};
+    zxc_block_header_t bh = {.block_type = flt ? ZXC_BLOCK_FLT : ZXC_BLOCK_NUM,
+                             .raw_size = (uint32_t)src_size};
     uint8_t* p_curr = dst + h_gap;
     size_t rem = dst_cap - h_gap;
-    zxc_num_header_t nh = {.n_values = count, .frame_size = ZXC_NUM_FRAME_SIZE};
+    zxc_num_header_t nh = {
+        .n_values = count, .frame_size = ZXC_NUM_FRAME_SIZE, .width = (uint8_t)width};
 
     int hs = zxc_write_num_header(p_curr, rem, &nh);
     if (UNLIKELY(hs < 0)) return -1;
@@ -418,135 +1359,58 @@ static int zxc_encode_block_num(const zxc_cctx_t* ctx, const uint8_t* RESTRICT s
     p_curr += hs;
     rem -= hs;
 
-    uint32_t deltas[ZXC_NUM_FRAME_SIZE];
-    const uint8_t* in_ptr = src;
-    uint32_t prev = 0;
-
-    for (size_t i = 0; i < count; i += ZXC_NUM_FRAME_SIZE) {
-        size_t frames = (count - i < ZXC_NUM_FRAME_SIZE) ? (count - i) : ZXC_NUM_FRAME_SIZE;
-        uint32_t max_d = 0, base = prev;
-        size_t j = 0;
-
-#if defined(ZXC_USE_AVX512)
-        if (frames >= 16) {
-            __m512i v_max_accum = _mm512_setzero_si512();  // Initialize max accumulator to 0
-
-            for (; j < (frames & ~15); j += 16) {
-                if (UNLIKELY(i == 0 && j == 0)) goto _scalar;
-
-                // Load 16 consecutive integers
-                __m512i vc = _mm512_loadu_si512((const void*)(in_ptr + j * 4));
-                // Load 16 integers offset by -1 to get previous values
-                __m512i vp = _mm512_loadu_si512((const void*)(in_ptr + j * 4 - 4));
-
-                __m512i diff = _mm512_sub_epi32(vc, vp);  // Compute deltas: curr - prev
-
-                // ZigZag encode: (diff << 1) ^ (diff >> 31)
-                __m512i zigzag =
-                    _mm512_xor_si512(_mm512_slli_epi32(diff, 1), _mm512_srai_epi32(diff, 31));
-
-                _mm512_storeu_si512((void*)&deltas[j], zigzag);  // Store results
-                v_max_accum =
-                    _mm512_max_epu32(v_max_accum, zigzag);  // Update max value seen so far
-            }
-            max_d = _mm512_reduce_max_epu32(v_max_accum);  // Horizontal max reduction
-
-            if (j > 0) prev = zxc_le32(in_ptr + (j - 1) * 4);
-        }
-#elif defined(ZXC_USE_AVX2)
-        if (frames >= 8) {
-            __m256i v_max_accum = _mm256_setzero_si256();  // Initialize max accumulator to 0
-
-            for (; j < (frames & ~7); j += 8) {
-                if (UNLIKELY(i == 0 && j == 0)) goto _scalar;
-
-                // Load 8 consecutive integers
-                __m256i vc = _mm256_loadu_si256((const __m256i*)(in_ptr + j * 4));
-                // Load 8 integers offset by -1
-                __m256i vp = _mm256_loadu_si256((const __m256i*)(in_ptr + j * 4 - 4));
-
-                __m256i diff = _mm256_sub_epi32(vc, vp);  // Compute deltas
-
-                // ZigZag encode: (diff << 1) ^ (diff >> 31)
-                __m256i zigzag =
-                    _mm256_xor_si256(_mm256_slli_epi32(diff, 1), _mm256_srai_epi32(diff, 31));
-                _mm256_storeu_si256((__m256i*)&deltas[j], zigzag);    // Store results
-                v_max_accum = _mm256_max_epu32(v_max_accum, zigzag);  // Update max accumulator
-            }
-
-            max_d = zxc_mm256_reduce_max_epu32(v_max_accum);  // Horizontal max reduction
-
-            if (j > 0) {
-                prev = zxc_le32(in_ptr + (j - 1) * 4);
-            }
-        }
-#elif defined(ZXC_USE_NEON64) || defined(ZXC_USE_NEON32)
-        // NEON processes 128-bit vectors (4 uint32 integers)
-        if (frames >= 4) {
-            uint32x4_t v_max_accum = vdupq_n_u32(0);  // Initialize vector with zeros
-
-            for (; j < (frames & ~3); j += 4) {
-                if (UNLIKELY(i == 0 && j == 0)) goto _scalar;
-
-                // Load 4 32-bit integers
-                uint32x4_t vc = vld1q_u32((const uint32_t*)(in_ptr + j * 4));
-                uint32x4_t vp = vld1q_u32((const uint32_t*)(in_ptr + j * 4 - 4));
-
-                uint32x4_t diff = vsubq_u32(vc, vp);  // Calc deltas
-
-                // ZigZag encode: (diff << 1) ^ (diff >> 31)
-                uint32x4_t z1 = vshlq_n_u32(diff, 1);
-                // Arithmetic shift right to duplicate sign bit
-                uint32x4_t z2 = vreinterpretq_u32_s32(vshrq_n_s32(vreinterpretq_s32_u32(diff), 31));
-                uint32x4_t zigzag = veorq_u32(z1, z2);
-
-                vst1q_u32(&deltas[j], zigzag);                 // Store results
-                v_max_accum = vmaxq_u32(v_max_accum, zigzag);  // Update max accumulator
-            }
-
-#if defined(ZXC_USE_NEON64)
-            max_d = vmaxvq_u32(v_max_accum);  // Reduce vector to single max value (AArch64)
-#else
-            // NEON 32-bit (ARMv7) fallback for horizontal max using standard shifts
-            // Reduce 4 elements -> 2
-            uint32x4_t v_swap =
-                vextq_u32(v_max_accum, v_max_accum, 2);  // Swap low/high 64-bit halves
-            uint32x4_t v_max2 = vmaxq_u32(v_max_accum, v_swap);
-            // Reduce 2 -> 1
-            v_swap = vextq_u32(v_max2, v_max2, 1);  // Shift by 32 bits
-            uint32x4_t v_max1 = vmaxq_u32(v_max2, v_swap);
-            max_d = vgetq_lane_u32(v_max1, 0);
-#endif
+    uint32_t deltas[ZXC_NUM_FRAME_SIZE];
+    uint64_t deltas64[ZXC_NUM_FRAME_SIZE];
+    const uint8_t* in_ptr = src;
+    uint64_t prev = 0;
 
-            if (j > 0) prev = zxc_le32(in_ptr + (j - 1) * 4);
-        }
-#endif
-#if defined(ZXC_USE_AVX2) || defined(ZXC_USE_AVX512) || defined(ZXC_USE_NEON64) || \
-    defined(ZXC_USE_NEON32)
-    _scalar:
-#endif
-        for (; j < frames; j++) {
-            uint32_t v = zxc_le32(in_ptr + j * 4);
-            uint32_t diff = zxc_zigzag_encode((int32_t)(v - prev));
-            deltas[j] = diff;
-            if (diff > max_d) max_d = diff;
-            prev = v;
+    for (size_t i = 0; i < count; i += ZXC_NUM_FRAME_SIZE) {
+        size_t frames = (count - i < ZXC_NUM_FRAME_SIZE) ? (count - i) : ZXC_NUM_FRAME_SIZE;
+        uint64_t base = prev;
+        uint8_t bits;
+
+        if (flt) {
+            // Residuals shifted right by their common trailing zeros (none if all zero)
+            unsigned shift = 0;
+            if (width == 4) {
+                const uint32_t acc = zxc_flt_xor32(in_ptr, frames, (uint32_t)prev, deltas);
+                if (acc) shift = (unsigned)zxc_ctz32(acc);
+                for (size_t j = 0; j < frames; j++) deltas[j] >>= shift;
+                bits = zxc_highbit32(acc >> shift);
+                prev = zxc_le32(in_ptr + (frames - 1) * 4);
+            } else {
+                const uint64_t acc = zxc_flt_xor64(in_ptr, frames, prev, deltas64);
+                if (acc) shift = (unsigned)zxc_ctz64(acc);
+                for (size_t j = 0; j < frames; j++) deltas64[j] >>= shift;
+                bits = zxc_highbit64(acc >> shift);
+                prev = zxc_le64(in_ptr + (frames - 1) * 8);
+            }
+            base = shift;
+        } else if (width == 2) {
+            bits = zxc_highbit32(zxc_num_deltas16(in_ptr, frames, (uint16_t)prev, deltas));
+            prev = zxc_le16(in_ptr + (frames - 1) * 2);
+        } else if (width == 4) {
+            bits = zxc_highbit32(zxc_num_deltas32(in_ptr, frames, (uint32_t)prev, deltas));
+            prev = zxc_le32(in_ptr + (frames - 1) * 4);
+        } else {
+            bits = zxc_highbit64(zxc_num_deltas64(in_ptr, frames, prev, deltas64));
+            prev = zxc_le64(in_ptr + (frames - 1) * 8);
         }
-        in_ptr += frames * 4;
+        in_ptr += frames * width;
 
-        uint8_t bits = zxc_highbit32(max_d);
         size_t packed = ((frames * bits) + ZXC_BITS_PER_BYTE - 1) / ZXC_BITS_PER_BYTE;
         if (UNLIKELY(rem < 16 + packed)) return -1;
 
         zxc_store_le16(p_curr, (uint16_t)frames);
         zxc_store_le16(p_curr + 2, bits);
-        zxc_store_le64(p_curr + 4, (uint64_t)base);
+        zxc_store_le64(p_curr + 4, base);  // FLT: the shift, in the low byte
         zxc_store_le32(p_curr + 12, (uint32_t)packed);
 
         p_curr += 16;
         rem -= 16;
 
-        int pb = zxc_bitpack_stream_32(deltas, frames, p_curr, rem, bits);
+        int pb = width == 8 ? zxc_bitpack_stream_64(deltas64, frames, p_curr, rem, bits)
+                            : zxc_bitpack_stream_32(deltas, frames, p_curr, rem, bits);
         if (UNLIKELY(pb < 0)) return -1;
         p_curr += pb;
         rem -= pb;
@@ -568,6 +1432,251 @@ static int zxc_encode_block_num(const zxc_cctx_t* ctx, const uint8_t* RESTRICT s
     return 0;
 }
 
+/*
+ * ============================================================================
+ * HUFFMAN LITERALS (level ZXC_LEVEL_DENSE)
+ * ============================================================================
+ * The GLO literal section may be coded with a length-limited canonical Huffman
+ * code. The literals are split into four quarters, each written to its own bit
+ * stream (least significant bit first) so that the decoder can interleave four
+ * independent table lookups.
+ */
+
+/**
+ * @brief Symbol of the Huffman code construction.
+ */
+typedef struct {
+    uint32_t freq;  // Occurrences in the literals
+    uint32_t sym;   // Byte value
+} zxc_huf_sym_t;
+
+/**
+ * @brief Orders symbols by increasing frequency (ties by value).
+ */
+static int zxc_huf_sym_cmp(const void* a, const void* b) {
+    const zxc_huf_sym_t* x = (const zxc_huf_sym_t*)a;
+    const zxc_huf_sym_t* y = (const zxc_huf_sym_t*)b;
+    if (x->freq != y->freq) return x->freq < y->freq ? -1 : 1;
+    return x->sym < y->sym ? -1 : (x->sym > y->sym);
+}
+
+/**
+ * @brief Computes Huffman code lengths limited to ZXC_HUF_MAX_BITS.
+ *
+ * Optimal lengths come from the in-place Moffat-Katajainen algorithm; codes
+ * that are too long are then clamped, and the least frequent codes below the
+ * limit are lengthened until the code space is no longer over-subscribed.
+ * Any room left is given back to the most frequent symbols.
+ *
+ * @param[in] freq Occurrences of each byte value.
+ * @param[out] lens Code length of each byte value (0 = absent).
+ */
+static void zxc_huf_build_lengths(const uint32_t freq[256], uint8_t lens[256]) {
+    zxc_huf_sym_t syms[256];
+    uint32_t a[256];
+    int n = 0;
+    ZXC_MEMSET(lens, 0, 256);
+    for (uint32_t s = 0; s < 256; s++) {
+        if (freq[s]) syms[n++] = (zxc_huf_sym_t){freq[s], s};
+    }
+    if (n == 0) return;
+    if (n == 1) {
+        lens[syms[0].sym] = 1;
+        return;
+    }
+    qsort(syms, (size_t)n, sizeof(syms[0]), zxc_huf_sym_cmp);
+    for (int i = 0; i < n; i++) a[i] = syms[i].freq;
+
+    // Moffat-Katajainen: tree weights, then parent depths, then leaf depths
+    int root = 0, leaf = 0, next;
+    for (next = 0; next < n - 1; next++) {
+        if (leaf >= n || (root < next && a[root] < a[leaf])) {
+            a[next] = a[root];
+            a[root++] = (uint32_t)next;
+        } else {
+            a[next] = a[leaf++];
+        }
+        if (leaf >= n || (root < next && a[root] < a[leaf])) {
+            a[next] += a[root];
+            a[root++] = (uint32_t)next;
+        } else {
+            a[next] += a[leaf++];
+        }
+    }
+    a[n - 2] = 0;
+    for (next = n - 3; next >= 0; next--) a[next] = a[a[next]] + 1;
+    int avail = 1, used = 0;
+    uint32_t depth = 0;
+    root = n - 2;
+    next = n - 1;
+    while (avail > 0) {
+        while (root >= 0 && a[root] == depth) {
+            used++;
+            root--;
+        }
+        while (avail > used) {
+            a[next--] = depth;
+            avail--;
+        }
+        avail = 2 * used;
+        depth++;
+        used = 0;
+    }
+
+    // Length limit: a[i] is now the length of syms[i], non-increasing in i
+    const uint32_t full = 1U << ZXC_HUF_MAX_BITS;
+    uint32_t kraft = 0;
+    for (int i = 0; i < n; i++) {
+        if (a[i] > ZXC_HUF_MAX_BITS) a[i] = ZXC_HUF_MAX_BITS;
+        kraft += full >> a[i];
+    }
+    while (kraft > full) {
+        // Lengthen the least frequent of the longest codes below the limit
+        int best = -1;
+        for (int i = 0; i < n; i++) {
+            if (a[i] < ZXC_HUF_MAX_BITS && (best < 0 || a[i] > a[best])) best = i;
+        }
+        a[best]++;
+        kraft -= full >> a[best];
+    }
+    for (int i = n - 1; i >= 0; i--) {
+        while (a[i] > 1 && kraft + (full >> a[i]) <= full) {
+            kraft += full >> a[i];
+            a[i]--;
+        }
+    }
+    for (int i = 0; i < n; i++) lens[syms[i].sym] = (uint8_t)a[i];
+}
+
+/**
+ * @brief Huffman-codes a literal section.
+ *
+ * @param[in] lit Literals.
+ * @param[in] n Number of literals (at least ZXC_HUF_STREAMS).
+ * @param[out] dst Destination of the section.
+ * @param[in] cap Capacity of `dst`.
+ * @param[in] limit The section is only written if smaller than this.
+ * @return The section size, or 0 if it would not be smaller than `limit` or
+ * does not fit.
+ */
+static size_t zxc_huf_encode(const uint8_t* RESTRICT lit, size_t n, uint8_t* RESTRICT dst,
+                             size_t cap, size_t limit) {
+    uint32_t freq[256] = {0};
+    for (size_t i = 0; i < n; i++) freq[lit[i]]++;
+
+    uint8_t lens[256];
+    uint16_t codes[256];
+    zxc_huf_build_lengths(freq, lens);
+    if (UNLIKELY(zxc_huf_build_codes(lens, codes) != 0)) return 0;
+
+    uint64_t bits = 0;
+    for (int s = 0; s < 256; s++) bits += (uint64_t)freq[s] * lens[s];
+    if (ZXC_HUF_HEADER_SIZE + (size_t)(bits >> 3) >= limit) return 0;
+
+    // Exact size: each stream ends on a byte boundary
+    const size_t quarter = (n + ZXC_HUF_STREAMS - 1) / ZXC_HUF_STREAMS;
+    size_t size = ZXC_HUF_HEADER_SIZE;
+    for (int k = 0; k < ZXC_HUF_STREAMS; k++) {
+        const uint8_t* ip = lit + (size_t)k * quarter;
+        const uint8_t* const iend = k < ZXC_HUF_STREAMS - 1 ? ip + quarter : lit + n;
+        uint64_t k_bits = 0;
+        while (ip < iend) k_bits += lens[*ip++];
+        size += (size_t)((k_bits + 7) >> 3);
+    }
+    if (size >= limit || size > cap) return 0;
+
+    for (int s = 0; s < 256; s += 2) dst[s >> 1] = (uint8_t)(lens[s] | (lens[s + 1] << 4));
+
+    uint8_t* op = dst + ZXC_HUF_HEADER_SIZE;
+    uint8_t* const op_end = dst + cap;
+    for (int k = 0; k < ZXC_HUF_STREAMS; k++) {
+        const uint8_t* ip = lit + (size_t)k * quarter;
+        const uint8_t* const iend = k < ZXC_HUF_STREAMS - 1 ? ip + quarter : lit + n;
+        uint8_t* const start = op;
+        uint64_t acc = 0;
+        uint32_t n_bits = 0;
+        // At most 7 pending bits plus 4 codes of ZXC_HUF_MAX_BITS per flush,
+        // 8-byte stores while they fit in dst
+        while (ip + 4 <= iend && op + sizeof(uint64_t) <= op_end) {
+            for (int j = 0; j < 4; j++) {
+                acc |= (uint64_t)codes[ip[j]] << n_bits;
+                n_bits += lens[ip[j]];
+            }
+            ip += 4;
+            zxc_store_le64(op, acc);
+            op += n_bits >> 3;
+            acc >>= n_bits & ~7U;
+            n_bits &= 7;
+        }
+        // Then byte by byte: the section needs only its exact size
+        while (ip < iend) {
+            acc |= (uint64_t)codes[*ip] << n_bits;
+            n_bits += lens[*ip++];
+            for (; n_bits >= 8; n_bits -= 8, acc >>= 8) *op++ = (uint8_t)acc;
+        }
+        if (n_bits) *op++ = (uint8_t)acc;
+        if (k < ZXC_HUF_STREAMS - 1)
+            zxc_store_le32(dst + 128 + 4 * k, (uint32_t)(op - start));
+    }
+    return size;
+}
+
+/**
+ * @brief Chooses how the offset stream of a GLO block is stored.
+ *
+ * Prices the 1-byte and 2-byte streams and the bit-packed widths from a
+ * histogram of the stored values (offsets, or repeat-offset codes) by highest
+ * set bit. A value that does not fit is escaped: 0 in the stream and a VByte in
+ * the extras. Packing must save 1/32 of the byte-aligned stream, and widths
+ * below ZXC_OFF_PACK_MIN_BITS may escape at most 1/2^ZXC_OFF_PACK_ESC_SHIFT of
+ * the values.
+ *
+ * @param[in] hist Values per highest set bit (index 0 to 32).
+ * @param[in] seq_c Number of sequences.
+ * @param[in] min_bits Narrowest packed width to try.
+ * @param[out] enc_off Offset stream mode (ZXC_OFF_ENC_16, _8 or _FAR).
+ * @param[out] off_bits Packed width, or 0 for a byte-aligned stream.
+ * @return Estimated size in bits of the stream and of its escapes.
+ */
+static uint64_t zxc_glo_plan_offsets(const uint32_t hist[33], uint32_t seq_c, unsigned min_bits,
+                                     uint8_t* enc_off, uint8_t* off_bits) {
+    // Escapes (and their VByte bits) above each width
+    uint64_t esc_bits[33];
+    uint32_t n_esc[33];
+    esc_bits[32] = 0;
+    n_esc[32] = 0;
+    for (int b = 31; b >= 0; b--) {
+        esc_bits[b] = esc_bits[b + 1] + (uint64_t)hist[b + 1] * 8 * ((b + 1 + 6) / 7);
+        n_esc[b] = n_esc[b + 1] + hist[b + 1];
+    }
+
+    const int lane8 = n_esc[8] == 0;
+    const unsigned lane = lane8 ? 8 : 16;
+    uint64_t best = (uint64_t)seq_c * lane + esc_bits[lane];
+    *enc_off = lane8 ? ZXC_OFF_ENC_8 : n_esc[16] ? ZXC_OFF_ENC_FAR : ZXC_OFF_ENC_16;
+    *off_bits = 0;
+
+    if (seq_c >= ZXC_OFF_PACK_MIN_SEQ) {
+        const uint64_t target = best - (best >> 5);
+        uint64_t packed = target;
+        for (unsigned w = lane - 1; w >= min_bits; w--) {
+            if (w < ZXC_OFF_PACK_MIN_BITS &&
+                n_esc[w] - n_esc[16] > (seq_c >> ZXC_OFF_PACK_ESC_SHIFT))
+                break;
+            uint64_t cost = (uint64_t)seq_c * w + esc_bits[w];
+            if (cost < packed) {
+                packed = cost;
+                *off_bits = (uint8_t)w;
+            }
+        }
+        if (*off_bits) {
+            best = packed;
+            *enc_off = n_esc[*off_bits] ? ZXC_OFF_ENC_FAR : ZXC_OFF_ENC_16;
+        }
+    }
+    return best;
+}
+
 /**
  * @brief Encodes a data block using the General (GLO) compression format.
  *
@@ -590,6 +1699,9 @@ static int zxc_encode_block_num(const zxc_cctx_t* ctx, const uint8_t* RESTRICT s
  * verification.
  * 5. **RLE Detection:** Analyzes literals to see if Run-Length Encoding would
  * be beneficial (saving > 10% space).
+ * 6. **Optimal Parsing:** Levels >= ZXC_LEVEL_OPTIMAL replace the greedy/lazy
+ * loop with zxc_lz77_parse_optimal() (the lazy loop remains the fallback if the
+ * parser scratch cannot be allocated).
  *
  * The encoding process consists of:
  * 1. **LZ77 Parsing**: The function iterates through the source data,
@@ -631,91 +1743,99 @@ static int zxc_encode_block_glo(zxc_cctx_t* ctx, const uint8_t* RESTRICT src, si
     const uint32_t epoch_mark = ctx->epoch << (32 - ZXC_EPOCH_BITS);
     const uint8_t *ip = src, *iend = src + src_size, *anchor = ip, *mflimit = iend - 12;
 
+    // Linked block: positions count from the start of the previous block's tail
+    const uint32_t prefix = src_size >= 16 ? (uint32_t)ctx->prefix_len : 0;
+    const uint8_t* const base = src - prefix;
+
     uint32_t* hash_table = ctx->hash_table;
-    uint16_t* chain_table = ctx->chain_table;
+    uint32_t* chain_table = ctx->chain_table;
     uint8_t* literals = ctx->literals;
     uint8_t* buf_tokens = ctx->buf_tokens;
     uint16_t* buf_offsets = ctx->buf_offsets;
     uint8_t* buf_extras = ctx->buf_extras;
 
-    uint32_t seq_c = 0;
-    size_t lit_c = 0;
-    size_t extras_sz = 0;
-    uint16_t max_offset = 0;  // Track max offset for 1-byte/2-byte mode decision
-
-    while (LIKELY(ip < mflimit)) {
-        size_t dist = (size_t)(ip - anchor);
-        size_t step = lzp.step_base + (dist >> lzp.step_shift);
-        if (UNLIKELY(ip + step >= mflimit)) step = 1;
-
-        ZXC_PREFETCH_READ(ip + step * 4 + ZXC_CACHE_LINE_SIZE);
-
-        zxc_match_t m = zxc_lz77_find_best_match(src, ip, iend, mflimit, anchor, hash_table,
-                                                 chain_table, epoch_mark, level, lzp);
-
-        if (m.ref) {
-            ip -= m.backtrack;
-            uint32_t ll = (uint32_t)(ip - anchor);
-            uint32_t ml = (uint32_t)(m.len - ZXC_LZ_MIN_MATCH_LEN);
-            uint32_t off = (uint32_t)(ip - m.ref);
-
-            if (ll > 0) {
-                if (ll <= 16)
-                    zxc_copy16(literals + lit_c, anchor);
-                else if (ll <= 32)
-                    zxc_copy32(literals + lit_c, anchor);
-                else
-                    ZXC_MEMCPY(literals + lit_c, anchor, ll);
-                lit_c += ll;
-            }
-
-            uint8_t ll_code = (ll >= ZXC_TOKEN_LL_MASK) ? ZXC_TOKEN_LL_MASK : (uint8_t)ll;
-            uint8_t ml_code = (ml >= ZXC_TOKEN_ML_MASK) ? ZXC_TOKEN_ML_MASK : (uint8_t)ml;
-            buf_tokens[seq_c] = (ll_code << ZXC_TOKEN_LIT_BITS) | ml_code;
-            buf_offsets[seq_c] = (uint16_t)off;
-            if (off > max_offset) max_offset = (uint16_t)off;
-
-            if (ll >= ZXC_TOKEN_LL_MASK) {
-                extras_sz += zxc_write_vbyte(buf_extras + extras_sz, ll - ZXC_TOKEN_LL_MASK);
-            }
-            if (ml >= ZXC_TOKEN_ML_MASK) {
-                extras_sz += zxc_write_vbyte(buf_extras + extras_sz, ml - ZXC_TOKEN_ML_MASK);
-            }
-            seq_c++;
+    zxc_glo_seqs_t seqs = {literals,
+                           buf_tokens,
+                           buf_offsets,
+                           buf_extras,
+                           0,
+                           0,
+                           0,
+                           ctx->buf_sequences,
+                           0,
+                           {ZXC_REP_INIT_0, ZXC_REP_INIT_1, ZXC_REP_INIT_2}};
+
+    if (lzp.optimal && !ctx->opt_state) ctx->opt_state = malloc(sizeof(zxc_opt_state_t));
+    if (lzp.binary_tree && !ctx->bt_table)
+        ctx->bt_table =
+            (uint32_t*)malloc(2 * (ctx->chunk_size + ZXC_LINK_WINDOW) * sizeof(uint32_t));
+    // If the scratch cannot be allocated, fall back to the hash chains / lazy parser
+    const int opt = lzp.optimal && ctx->opt_state;
+    uint32_t* const bt = opt && lzp.binary_tree ? ctx->bt_table : NULL;
+
+    // Dictionary prefix: indexed up front (or restored), the parsers start after it
+    uint32_t first_ins = 1;
+    if (prefix && ctx->prefix_is_dict) {
+        const uint32_t key = 1U | ((uint32_t)opt << 1) | ((uint32_t)(bt != NULL) << 2) |
+                             ((uint32_t)level << 3);
+        zxc_lz77_load_dict(ctx, base, prefix, key, opt ? 1 : lzp.step_base, lzp,
+                           bt ? bt : chain_table, bt != NULL, epoch_mark);
+        first_ins = prefix;
+    } else {
+        ctx->dict_live_key = 0;
+    }
 
-            if (m.len > 2 && level > 4) {
-                const uint8_t* match_end = ip + m.len;
-                if (match_end < iend - 3) {
-                    uint32_t pos_u = (uint32_t)((match_end - 2) - src);
-                    uint32_t val_u = zxc_le32(match_end - 2);
-                    uint32_t h_u = zxc_hash_func(val_u);
-                    uint32_t prev_head = hash_table[2 * h_u];
-                    uint32_t prev_idx = (prev_head & ~ZXC_OFFSET_MASK) == epoch_mark
-                                            ? (prev_head & ZXC_OFFSET_MASK)
-                                            : 0;
-                    hash_table[2 * h_u] = epoch_mark | pos_u;
-                    hash_table[2 * h_u + 1] = val_u;
-                    chain_table[pos_u] = (prev_idx > 0 && (pos_u - prev_idx) < ZXC_LZ_WINDOW_SIZE)
-                                             ? (uint16_t)(pos_u - prev_idx)
-                                             : 0;
+    if (opt) {
+        zxc_cost_model_t cm = ctx->cost_model;
+        if (cm.byte_weight == 0 && cm.cycle_weight == 0) cm.byte_weight = 1;  // Size only
+        anchor = zxc_lz77_parse_optimal(base, prefix, first_ins, src_size, hash_table,
+                                        chain_table, bt, epoch_mark, lzp, &cm,
+                                        (zxc_opt_state_t*)ctx->opt_state, &seqs);
+    } else {
+        // Far offsets cost the decoder a cache miss each: only the optimal levels use them
+        const uint32_t max_dist = lzp.optimal ? ZXC_LZ_FAR_DIST : ZXC_LZ_MAX_DIST;
+        if (first_ins == 1)
+            zxc_lz77_load_prefix(base, prefix, lzp.step_base, hash_table, chain_table,
+                                 epoch_mark);
+        while (LIKELY(ip < mflimit)) {
+            size_t dist = (size_t)(ip - anchor);
+            size_t step = lzp.step_base + (dist >> lzp.step_shift);
+            if (UNLIKELY(step > ZXC_LZ_MAX_STEP)) step = ZXC_LZ_MAX_STEP;
+            if (UNLIKELY(ip + step >= mflimit)) step = 1;
+
+            ZXC_PREFETCH_READ(ip + step * 4 + ZXC_CACHE_LINE_SIZE);
+
+            zxc_match_t m = zxc_lz77_find_best_match(base, ip, iend, mflimit, anchor, hash_table,
+                                                     chain_table, epoch_mark, level, lzp,
+                                                     max_dist, seqs.rep);
+
+            if (m.ref) {
+                ip -= m.backtrack;
+                zxc_glo_emit_seq(&seqs, anchor, (uint32_t)(ip - anchor), m.len,
+                                 (uint32_t)(ip - m.ref));
+
+                if (m.len > 2 && level > 4) {
+                    const uint8_t* match_end = ip + m.len;
+                    if (match_end < iend - 3)
+                        zxc_lz77_insert(base, (uint32_t)((match_end - 2) - base), hash_table,
+                                        chain_table, epoch_mark);
                 }
+                ip += m.len;
+                anchor = ip;
+            } else {
+                ip += step;
             }
-            ip += m.len;
-            anchor = ip;
-        } else {
-            ip += step;
         }
     }
 
+    uint32_t seq_c = seqs.seq_c;
+    size_t lit_c = seqs.lit_c;
+    size_t extras_sz = seqs.extras_sz;
+
     size_t last_lits = iend - anchor;
     if (last_lits > 0) {
-        if (last_lits <= 16) {
-            zxc_copy16(literals + lit_c, anchor);
-        } else if (last_lits <= 32) {
-            zxc_copy32(literals + lit_c, anchor);
-        } else {
-            ZXC_MEMCPY(literals + lit_c, anchor, last_lits);
-        }
+        // Exact copy: the block may end the caller's buffer
+        ZXC_MEMCPY(literals + lit_c, anchor, last_lits);
         lit_c += last_lits;
     }
 
@@ -935,23 +2055,85 @@ static int zxc_encode_block_glo(zxc_cctx_t* ctx, const uint8_t* RESTRICT src, si
     }
 
     size_t h_gap = ZXC_BLOCK_HEADER_SIZE + (chk ? ZXC_BLOCK_CHECKSUM_SIZE : 0);
+    if (UNLIKELY(dst_cap < h_gap)) return -1;
     zxc_block_header_t bh = {.block_type = ZXC_BLOCK_GLO, .raw_size = (uint32_t)src_size};
     uint8_t* p = dst + h_gap;
     size_t rem = dst_cap - h_gap;
 
-    // Decide offset encoding mode: 1-byte if all offsets <= 255
-    int use_8bit_off = (max_offset <= 255) ? 1 : 0;
-    size_t off_stream_size = use_8bit_off ? seq_c : (seq_c * 2);
+    // --- HUFFMAN LITERALS ---
+    // Coded straight to their place after the headers; kept if ~3% smaller
+    size_t huf_size = 0;
+    const size_t ghs_fixed =
+        ZXC_GLO_HEADER_BINARY_SIZE + ZXC_GLO_SECTIONS * ZXC_SECTION_DESC_BINARY_SIZE;
+    if (level >= ZXC_LEVEL_DENSE && lit_c >= ZXC_HUF_MIN_LITERALS && rem > ghs_fixed) {
+        size_t alt = use_rle ? rle_size : lit_c;
+        huf_size =
+            zxc_huf_encode(literals, lit_c, p + ghs_fixed, rem - ghs_fixed, alt - (alt >> 5));
+    }
+    uint8_t enc_lit = huf_size   ? ZXC_SECTION_ENCODING_HUFFMAN
+                      : use_rle ? ZXC_SECTION_ENCODING_RLE
+                                : ZXC_SECTION_ENCODING_RAW;
+
+    // --- OFFSET STREAM ---
+    // Plain offsets, or repeat-offset codes when they save 1/16 of the stream
+    // (the decoder then resolves a code per sequence). Far offsets, and those
+    // that do not fit the chosen width, are escaped to the extras as a VByte.
+    uint32_t* dists = seqs.dists;
+    uint32_t hist[33] = {0};
+    for (uint32_t i = 0; i < seq_c; i++) hist[zxc_highbit32(dists[i])]++;
+    uint8_t enc_off, off_bits;
+    uint64_t off_cost =
+        zxc_glo_plan_offsets(hist, seq_c, ZXC_OFF_PACK_MIN_BITS, &enc_off, &off_bits);
+
+    int use_rep = 0;
+    if (seq_c >= ZXC_OFF_PACK_MIN_SEQ && seqs.n_rep >= (seq_c >> ZXC_REP_MIN_SHIFT)) {
+        uint32_t rep[ZXC_REP_NUM] = {ZXC_REP_INIT_0, ZXC_REP_INIT_1, ZXC_REP_INIT_2};
+        ZXC_MEMSET(hist, 0, sizeof(hist));
+        for (uint32_t i = 0; i < seq_c; i++) hist[zxc_highbit32(zxc_rep_code(rep, dists[i]))]++;
+        uint8_t r_enc, r_bits;
+        uint64_t r_cost =
+            zxc_glo_plan_offsets(hist, seq_c, ZXC_OFF_PACK_REP_MIN_BITS, &r_enc, &r_bits);
+        if (r_cost < off_cost - (off_cost >> ZXC_REP_GAIN_SHIFT)) {
+            use_rep = 1;
+            enc_off = r_enc;
+            off_bits = r_bits;
+            rep[0] = ZXC_REP_INIT_0;
+            rep[1] = ZXC_REP_INIT_1;
+            rep[2] = ZXC_REP_INIT_2;
+            for (uint32_t i = 0; i < seq_c; i++) {
+                uint32_t code = zxc_rep_code(rep, dists[i]);
+                buf_offsets[i] = code > ZXC_LZ_MAX_DIST ? 0 : (uint16_t)code;
+            }
+        }
+    }
+
+    size_t off_stream_size = off_bits ? ((size_t)seq_c * off_bits + ZXC_BITS_PER_BYTE - 1) /
+                                            ZXC_BITS_PER_BYTE
+                             : enc_off == ZXC_OFF_ENC_8 ? seq_c
+                                                        : (size_t)seq_c * 2;
+    // Escapes change when offsets are packed or coded: the extras are rebuilt,
+    // each escape after the LL / ML extras of its sequence
+    const int rebuild_extras = use_rep || off_bits;
+    if (rebuild_extras) {
+        for (uint32_t i = 0; i < seq_c; i++) {
+            if (dists[i] > ZXC_LZ_MAX_DIST) extras_sz -= zxc_vbyte_len(dists[i]);
+            if (buf_offsets[i] == 0 || (off_bits && buf_offsets[i] >> off_bits))
+                extras_sz += zxc_vbyte_len(dists[i]);
+        }
+    }
 
     zxc_gnr_header_t gh = {.n_sequences = seq_c,
                            .n_literals = (uint32_t)lit_c,
-                           .enc_lit = (uint8_t)use_rle,
+                           .enc_lit = enc_lit,
                            .enc_litlen = 0,
                            .enc_mlen = 0,
-                           .enc_off = (uint8_t)use_8bit_off};
+                           .enc_off = enc_off,
+                           .off_bits = off_bits,
+                           .rep_offsets = (uint8_t)use_rep};
 
     zxc_section_desc_t desc[4] = {0};
-    desc[0].sizes = (uint64_t)(use_rle ? rle_size : lit_c) | ((uint64_t)lit_c << 32);
+    desc[0].sizes =
+        (uint64_t)(huf_size ? huf_size : use_rle ? rle_size : lit_c) | ((uint64_t)lit_c << 32);
     desc[1].sizes = (uint64_t)seq_c | ((uint64_t)seq_c << 32);
     desc[2].sizes = (uint64_t)off_stream_size | ((uint64_t)off_stream_size << 32);
     desc[3].sizes = (uint64_t)extras_sz | ((uint64_t)extras_sz << 32);
@@ -970,7 +2152,9 @@ static int zxc_encode_block_glo(zxc_cctx_t* ctx, const uint8_t* RESTRICT src, si
 
     if (UNLIKELY(rem < sz_lit)) return -1;
 
-    if (use_rle) {
+    if (huf_size) {
+        p_curr += huf_size;  // Already in place
+    } else if (use_rle) {
         // Write RLE - optimized single-pass encoding
         const uint8_t* lit_ptr = literals;
         const uint8_t* const lit_end = literals + lit_c;
@@ -1037,7 +2221,7 @@ static int zxc_encode_block_glo(zxc_cctx_t* ctx, const uint8_t* RESTRICT src, si
 
     if (UNLIKELY(rem < sz_off)) return -1;
 
-    if (use_8bit_off) {
+    if (enc_off == ZXC_OFF_ENC_8) {
         // Write 1-byte offsets - unroll for better throughput
         uint32_t i = 0;
         for (; i + 8 <= seq_c; i += 8) {
@@ -1054,6 +2238,20 @@ static int zxc_encode_block_glo(zxc_cctx_t* ctx, const uint8_t* RESTRICT src, si
         for (; i < seq_c; i++) {
             *p_curr++ = (uint8_t)buf_offsets[i];
         }
+    } else if (off_bits) {
+        // Bit-packed offsets, widened by runs of 64 (a whole number of bytes)
+        uint32_t wide[64];
+        uint8_t* out = p_curr;
+        for (uint32_t i = 0; i < seq_c; i += 64) {
+            const uint32_t n = seq_c - i < 64 ? seq_c - i : 64;
+            for (uint32_t j = 0; j < n; j++)
+                wide[j] = (buf_offsets[i + j] >> off_bits) ? 0 : buf_offsets[i + j];
+            if (UNLIKELY(zxc_bitpack_stream_32(wide, n, out, rem - (size_t)(out - p_curr),
+                                               off_bits) < 0))
+                return -1;
+            out += (size_t)n * off_bits / ZXC_BITS_PER_BYTE;
+        }
+        p_curr += sz_off;
     } else {
         // Write 2-byte offsets
         ZXC_MEMCPY(p_curr, buf_offsets, seq_c * 2);
@@ -1063,8 +2261,28 @@ static int zxc_encode_block_glo(zxc_cctx_t* ctx, const uint8_t* RESTRICT src, si
 
     if (UNLIKELY(rem < sz_ext)) return -1;
 
-    ZXC_MEMCPY(p_curr, buf_extras, extras_sz);
-    p_curr += extras_sz;
+    if (rebuild_extras) {
+        // LL / ML extras are copied, the parser's far offsets replaced by the escapes
+        const uint8_t* e = buf_extras;
+        for (uint32_t i = 0; i < seq_c; i++) {
+            const uint8_t tok = buf_tokens[i];
+            int n_vb = ((tok >> ZXC_TOKEN_LIT_BITS) == ZXC_TOKEN_LL_MASK) +
+                       ((tok & ZXC_TOKEN_ML_MASK) == ZXC_TOKEN_ML_MASK);
+            for (; n_vb > 0; n_vb--) {
+                while (*e & ZXC_VBYTE_MSB) *p_curr++ = *e++;
+                *p_curr++ = *e++;
+            }
+            if (dists[i] > ZXC_LZ_MAX_DIST) {
+                while (*e & ZXC_VBYTE_MSB) e++;
+                e++;
+            }
+            if (buf_offsets[i] == 0 || (off_bits && buf_offsets[i] >> off_bits))
+                p_curr += zxc_write_vbyte(p_curr, dists[i]);
+        }
+    } else {
+        ZXC_MEMCPY(p_curr, buf_extras, extras_sz);
+        p_curr += extras_sz;
+    }
 
     uint32_t p_sz = (uint32_t)(p_curr - (dst + h_gap));
     if (chk) {
@@ -1126,9 +2344,13 @@ static int zxc_encode_block_ghi(zxc_cctx_t* ctx, const uint8_t* RESTRICT src, si
     const uint32_t epoch_mark = ctx->epoch << (32 - ZXC_EPOCH_BITS);
     const uint8_t *ip = src, *iend = src + src_size, *anchor = ip, *mflimit = iend - 12;
 
+    // Linked block: positions count from the start of the previous block's tail
+    const uint32_t prefix = src_size >= 16 ? (uint32_t)ctx->prefix_len : 0;
+    const uint8_t* const base = src - prefix;
+
     uint32_t* hash_table = ctx->hash_table;
     uint8_t* buf_extras = ctx->buf_extras;
-    uint16_t* chain_table = ctx->chain_table;
+    uint32_t* chain_table = ctx->chain_table;
     uint8_t* literals = ctx->literals;
 
     uint32_t seq_c = 0;
@@ -1138,15 +2360,26 @@ static int zxc_encode_block_ghi(zxc_cctx_t* ctx, const uint8_t* RESTRICT src, si
 
     uint32_t* buf_sequences = ctx->buf_sequences;
 
+    if (prefix && ctx->prefix_is_dict) {
+        // Same indexing (and snapshot) as the greedy GLO parser at this level
+        const uint32_t key = 1U | ((uint32_t)level << 3);
+        zxc_lz77_load_dict(ctx, base, prefix, key, lzp.step_base, lzp, chain_table, 0,
+                           epoch_mark);
+    } else {
+        ctx->dict_live_key = 0;
+        zxc_lz77_load_prefix(base, prefix, lzp.step_base, hash_table, chain_table, epoch_mark);
+    }
     while (LIKELY(ip < mflimit)) {
         size_t dist = (size_t)(ip - anchor);
         size_t step = lzp.step_base + (dist >> lzp.step_shift);
+        if (UNLIKELY(step > ZXC_LZ_MAX_STEP)) step = ZXC_LZ_MAX_STEP;
         if (UNLIKELY(ip + step >= mflimit)) step = 1;
 
         ZXC_PREFETCH_READ(ip + step * 4 + 64);
 
-        zxc_match_t m = zxc_lz77_find_best_match(src, ip, iend, mflimit, anchor, hash_table,
-                                                 chain_table, epoch_mark, level, lzp);
+        zxc_match_t m = zxc_lz77_find_best_match(base, ip, iend, mflimit, anchor, hash_table,
+                                                 chain_table, epoch_mark, level, lzp,
+                                                 ZXC_LZ_MAX_DIST, NULL);
 
         if (m.ref) {
             ip -= m.backtrack;
@@ -1155,9 +2388,10 @@ static int zxc_encode_block_ghi(zxc_cctx_t* ctx, const uint8_t* RESTRICT src, si
             uint32_t off = (uint32_t)(ip - m.ref);
 
             if (ll > 0) {
-                if (ll <= 16)
+                // The wide copies may read into the match, but not past the end of the input
+                if (ll <= 16 && ll + m.len >= 16)
                     zxc_copy16(literals + lit_c, anchor);
-                else if (ll <= 32)
+                else if (ll <= 32 && ll + m.len >= 32)
                     zxc_copy32(literals + lit_c, anchor);
                 else
                     ZXC_MEMCPY(literals + lit_c, anchor, ll);
@@ -1182,7 +2416,7 @@ static int zxc_encode_block_ghi(zxc_cctx_t* ctx, const uint8_t* RESTRICT src, si
             if (m.len > 2 && level > 4) {
                 const uint8_t* match_end = ip + m.len;
                 if (match_end < iend - 3) {
-                    uint32_t pos_u = (uint32_t)((match_end - 2) - src);
+                    uint32_t pos_u = (uint32_t)((match_end - 2) - base);
                     uint32_t val_u = zxc_le32(match_end - 2);
                     uint32_t h_u = zxc_hash_func(val_u);
                     uint32_t prev_head = hash_table[2 * h_u];
@@ -1191,9 +2425,7 @@ static int zxc_encode_block_ghi(zxc_cctx_t* ctx, const uint8_t* RESTRICT src, si
                                             : 0;
                     hash_table[2 * h_u] = epoch_mark | pos_u;
                     hash_table[2 * h_u + 1] = val_u;
-                    chain_table[pos_u] = (prev_idx > 0 && (pos_u - prev_idx) < ZXC_LZ_WINDOW_SIZE)
-                                             ? (uint16_t)(pos_u - prev_idx)
-                                             : 0;
+                    chain_table[pos_u] = prev_idx > 0 ? pos_u - prev_idx : 0;
                 }
             }
             ip += m.len;
@@ -1205,17 +2437,13 @@ static int zxc_encode_block_ghi(zxc_cctx_t* ctx, const uint8_t* RESTRICT src, si
 
     size_t last_lits = iend - anchor;
     if (last_lits > 0) {
-        if (last_lits <= 16) {
-            zxc_copy16(literals + lit_c, anchor);
-        } else if (last_lits <= 32) {
-            zxc_copy32(literals + lit_c, anchor);
-        } else {
-            ZXC_MEMCPY(literals + lit_c, anchor, last_lits);
-        }
+        // Exact copy: the block may end the caller's buffer
+        ZXC_MEMCPY(literals + lit_c, anchor, last_lits);
         lit_c += last_lits;
     }
 
     size_t h_gap = ZXC_BLOCK_HEADER_SIZE + (chk ? ZXC_BLOCK_CHECKSUM_SIZE : 0);
+    if (UNLIKELY(dst_cap < h_gap)) return -1;
     zxc_block_header_t bh = {.block_type = ZXC_BLOCK_GHI, .raw_size = (uint32_t)src_size};
     uint8_t* p = dst + h_gap;
     size_t rem = dst_cap - h_gap;
@@ -1323,72 +2551,523 @@ static int zxc_encode_block_raw(const uint8_t* src, size_t src_sz, uint8_t* dst,
     return 0;
 }
 
+// NUM value widths in bytes, in the order the probe and the trials try them
+static const size_t zxc_num_widths[3] = {4, 8, 2};
+#define ZXC_NUM_PROBE_HASH 0x9E3779B97F4A7C15ULL  // Multiplier of the probe's repeat bitmap
+
 /**
- * @brief Checks if the given byte array represents a numeric value.
- *
- * This function examines the provided buffer to determine if it contains
- * only numeric characters (e.g., ASCII digits '0'-'9').
+ * @brief Reads the `i`-th little-endian integer of `width` bytes of `p`.
+ */
+static ZXC_ALWAYS_INLINE uint64_t zxc_num_load(const uint8_t* p, size_t i, size_t width) {
+    if (width == 2) return zxc_le16(p + i * 2);
+    return width == 4 ? zxc_le32(p + i * 4) : zxc_le64(p + i * 8);
+}
+
+/**
+ * @brief Checks if the given byte array looks like an array of integers, and
+ * of which width.
  *
- * Improved heuristic:
- * 1. Must be aligned to 4 bytes.
- * 2. Samples the first 128 integers (more accurate).
+ * Heuristic, for each of the 32-, 64- and 16-bit interpretations:
+ * 1. Must be aligned to the width.
+ * 2. Samples the first 512 bytes (128 32-bit integers).
  * 3. Calculates bit width of deltas (fewer bits = better for NUM).
  * 4. Estimates compression ratio: if NUM would save >20% vs raw, use it.
+ * 5. 16- and 64-bit values (samples, timestamps) also qualify with deltas of
+ *    up to 3/4 of their width, unless many of them repeat: such arrays (text
+ *    in UTF-16, tables of IDs) are better left to LZ.
+ *
+ * The interpretation with the fewest delta bits per value bit wins (ties
+ * keep 32 bits, then 64).
+ *
+ * @param[in] src Pointer to the input byte array to be checked.
+ * @param[in] size The number of bytes in the input array.
+ * @param[out] est_bits Bits per delta of the chosen width in the sample.
+ * @return Size of the integers in bytes (2, 4 or 8), or 0 if the array is not
+ * numeric.
+ */
+static size_t zxc_probe_num_width(const uint8_t* src, size_t size, uint32_t* est_bits) {
+    size_t best = 0;
+    uint32_t best_bits = 0;
+
+    for (size_t w = 0; w < 3; w++) {
+        const size_t width = zxc_num_widths[w];
+        const uint32_t value_bits = (uint32_t)(width * ZXC_BITS_PER_BYTE);
+        if (size % width != 0 || size < 16) continue;
+
+        size_t count = size / width;
+        if (count > 512 / width) count = 512 / width;  // Sample more values for accuracy
+
+        uint64_t or_zigzag = 0;
+        uint32_t small_count = 0;  // Deltas of at most half the value width
+        uint32_t repeats = 0;      // Values hashing to an already seen bucket
+        uint64_t seen[64] = {0};   // 4096-bucket bitmap
+
+        for (size_t i = 1; i < count; i++) {
+            const uint64_t v = zxc_num_load(src, i, width);
+            const uint32_t hv = (uint32_t)((v * ZXC_NUM_PROBE_HASH) >> 52);
+            repeats += (uint32_t)(seen[hv / 64] >> (hv % 64)) & 1;
+            seen[hv / 64] |= 1ULL << (hv % 64);
+
+            uint64_t diff = v - zxc_num_load(src, i - 1, width);
+            if (width < 8) {
+                // Sign-extend the wrapped delta
+                const unsigned sh = 64 - value_bits;
+                diff = (uint64_t)((int64_t)(diff << sh) >> sh);
+            }
+            const uint64_t zigzag = zxc_zigzag_encode64((int64_t)diff);
+            or_zigzag |= zigzag;
+            if ((zigzag >> (value_bits / 2)) == 0) small_count++;
+        }
+
+        // NUM uses ~bits_needed per value, Raw uses value_bits per value
+        // Worth it if bits_needed <= 5/8 of the width (saves >37.5%)
+        const uint32_t bits_needed = zxc_highbit64(or_zigzag);
+        int numeric = bits_needed <= value_bits / 2;
+        if (bits_needed <= value_bits * 5 / 8 && small_count >= (count * 85) / 100) numeric = 1;
+
+        // Fallback: if 90% of deltas are small, still use NUM
+        if (small_count >= (count * 90) / 100) numeric = 1;
+
+        if (width != 4) {
+            if (bits_needed <= value_bits * 3 / 4) numeric = 1;
+            if (repeats > count / 4) numeric = 0;
+        }
+
+        if (numeric && (!best || bits_needed * best < best_bits * width)) {
+            best = width;
+            best_bits = bits_needed;
+        }
+    }
+    *est_bits = best_bits;
+    return best;
+}
+
+// FLT value widths in bytes, in the order the probe and the trials try them
+static const size_t zxc_flt_widths[2] = {4, 8};
+
+/**
+ * @brief Checks if the given byte array looks like an array of floats, and of
+ * which width.
+ *
+ * Heuristic, for the 32- and 64-bit interpretations of the first 512 bytes:
+ * 1. Must be aligned to the width.
+ * 2. At least 90% of the values are normal numbers or zeros (integers and
+ *    bytes rarely have plausible exponents in both widths).
+ * 3. The XOR residuals of a frame, once their common trailing zeros are shifted
+ *    out, fit in 7/8 of the width (FLT saves >12.5%; LZ rarely finds matches
+ *    in mantissas).
+ * 4. Few values repeat: such arrays are better left to LZ.
+ *
+ * The interpretation with the fewest residual bits per value bit wins.
  *
  * @param[in] src Pointer to the input byte array to be checked.
  * @param[in] size The number of bytes in the input array.
- * @return int Returns 1 if the array is numeric, 0 otherwise.
+ * @param[out] est_bits Bits per residual of the chosen width in the sample.
+ * @return Size of the floats in bytes (4 or 8), or 0 if the array does not
+ * look like floats.
+ */
+static size_t zxc_probe_flt_width(const uint8_t* src, size_t size, uint32_t* est_bits) {
+    size_t best = 0;
+    uint32_t best_bits = 0;
+
+    for (size_t w = 0; w < 2; w++) {
+        const size_t width = zxc_flt_widths[w];
+        const uint32_t value_bits = (uint32_t)(width * ZXC_BITS_PER_BYTE);
+        // Exponent field: 8 bits at bit 23 (float), 11 bits at bit 52 (double)
+        const unsigned exp_shift = width == 4 ? 23 : 52;
+        const uint64_t exp_max = width == 4 ? 0xFF : 0x7FF;
+        if (size % width != 0 || size < 16) continue;
+
+        size_t count = size / width;
+        if (count > 512 / width) count = 512 / width;
+
+        uint64_t or_xor = 0;
+        uint32_t plausible = 0;
+        uint32_t repeats = 0;
+        uint64_t seen[64] = {0};
+
+        for (size_t i = 0; i < count; i++) {
+            const uint64_t v = zxc_num_load(src, i, width);
+            const uint64_t e = (v >> exp_shift) & exp_max;
+            plausible += (e != 0 && e != exp_max) || (v << (65 - value_bits)) == 0;
+            if (i == 0) continue;
+
+            const uint32_t hv = (uint32_t)((v * ZXC_NUM_PROBE_HASH) >> 52);
+            repeats += (uint32_t)(seen[hv / 64] >> (hv % 64)) & 1;
+            seen[hv / 64] |= 1ULL << (hv % 64);
+            or_xor |= v ^ zxc_num_load(src, i - 1, width);
+        }
+
+        const uint32_t bits_needed = or_xor ? zxc_highbit64(or_xor >> zxc_ctz64(or_xor)) : 0;
+        if (plausible < (count * 90) / 100 || repeats > count / 4 ||
+            bits_needed > value_bits * 7 / 8)
+            continue;
+
+        if (!best || bits_needed * best < best_bits * width) {
+            best = width;
+            best_bits = bits_needed;
+        }
+    }
+    *est_bits = best_bits;
+    return best;
+}
+
+/**
+ * @brief Finds the record stride of an array of fixed-size records.
+ *
+ * Counts, in the first ZXC_SHUFFLE_PROBE_SIZE bytes, the bytes equal to the one
+ * `s` positions back for every stride `s` up to ZXC_SHUFFLE_MAX_STRIDE. Fields
+ * of the same kind line up at the record stride (and its multiples), so the
+ * smallest stride within 5% of the best count is kept. It must match at least
+ * a quarter of the bytes and twice as many as neighbouring bytes do (runs and
+ * text, which LZ already handles). Four windows of ZXC_SHUFFLE_PRECHECK_SIZE
+ * bytes are counted first, with looser limits, and most other blocks stop there.
+ *
+ * @param[in] src Pointer to the block.
+ * @param[in] size Size of the block.
+ * @return The record stride, or 0 if the block does not look like records.
  */
-static int zxc_probe_is_numeric(const uint8_t* src, size_t size) {
-    if (UNLIKELY(size % 4 != 0 || size < 16)) return 0;
+static size_t zxc_probe_shuffle_stride(const uint8_t* src, size_t size) {
+    const size_t n = size < ZXC_SHUFFLE_PROBE_SIZE ? size : ZXC_SHUFFLE_PROBE_SIZE;
+    if (n < 64 * ZXC_SHUFFLE_MAX_STRIDE) return 0;
+
+    // Pre-check: in 4 windows spread over the sample, some stride matches an
+    // eighth of the bytes and 1.5x as many as stride 1
+    uint32_t eq[ZXC_SHUFFLE_MAX_STRIDE + 1] = {0};
+    uint32_t top = 0;
+    for (size_t s = 1; s <= ZXC_SHUFFLE_MAX_STRIDE; s++) {
+        uint32_t c = 0;
+        for (size_t k = 0; k < 4; k++) {
+            const size_t o = k * (n / 4) + ZXC_SHUFFLE_MAX_STRIDE;
+            for (size_t i = o; i < o + ZXC_SHUFFLE_PRECHECK_SIZE; i++) c += src[i] == src[i - s];
+        }
+        eq[s] = c;
+        if (s >= ZXC_SHUFFLE_MIN_STRIDE && c > top) top = c;
+    }
+    if (top * 8 < 4 * ZXC_SHUFFLE_PRECHECK_SIZE || 2 * top < 3 * eq[1]) return 0;
 
-    size_t count = size / 4;
-    if (count > 128) count = 128;  // Sample more values for accuracy
+    for (size_t s = 1; s <= ZXC_SHUFFLE_MAX_STRIDE; s++) {
+        uint32_t c = 0;
+        for (size_t i = s; i < n; i++) c += src[i] == src[i - s];
+        eq[s] = c;
+    }
 
-    uint32_t prev = zxc_le32(src);
-    const uint8_t* p = src + 4;
+    size_t best = ZXC_SHUFFLE_MIN_STRIDE;
+    for (size_t s = best + 1; s <= ZXC_SHUFFLE_MAX_STRIDE; s++)
+        if (eq[s] > eq[best]) best = s;
+    size_t stride = ZXC_SHUFFLE_MIN_STRIDE;
+    while (eq[stride] * 20 < eq[best] * 19) stride++;
 
-    uint32_t max_zigzag = 0;
-    uint32_t small_count = 0;   // Deltas < 256 (8 bits)
-    uint32_t medium_count = 0;  // Deltas < 65536 (16 bits)
+    if (eq[stride] * 4 < n || eq[stride] < 2 * eq[1]) return 0;
+    return stride;
+}
 
-    for (size_t i = 1; i < count; i++) {
-        uint32_t curr = zxc_le32(p);
-        int32_t diff = (int32_t)(curr - prev);
-        uint32_t zigzag = zxc_zigzag_encode(diff);
+/**
+ * @brief Transposes an array of records into byte planes.
+ *
+ * Byte `k` of record `r` moves to `dst[k * n_rec + r]`; the bytes past the last
+ * whole record are copied as they are.
+ *
+ * @param[in] src Records.
+ * @param[in] size Size of `src`.
+ * @param[in] stride Record size.
+ * @param[out] dst Byte planes (`size` bytes).
+ */
+static void zxc_shuffle_bytes(const uint8_t* RESTRICT src, size_t size, size_t stride,
+                              uint8_t* RESTRICT dst) {
+    const size_t n_rec = size / stride;
+    for (size_t k = 0; k < stride; k++) {
+        uint8_t* const plane = dst + k * n_rec;
+        for (size_t r = 0; r < n_rec; r++) plane[r] = src[r * stride + k];
+    }
+    ZXC_MEMCPY(dst + n_rec * stride, src + n_rec * stride, size - n_rec * stride);
+}
 
-        if (zigzag > max_zigzag) max_zigzag = zigzag;
+/**
+ * @brief Counts the AArch64 BL words of `src` whose target lies within 4 MB.
+ *
+ * @param[in] src Word-aligned bytes.
+ * @param[in] n Number of bytes.
+ * @return The number of such words.
+ */
+static size_t zxc_bcj_count_arm64(const uint8_t* src, size_t n) {
+    size_t arm = 0;
+    for (size_t i = 0; i + 4 <= n; i += 4) {
+        const uint32_t w = zxc_le32(src + i);
+        arm += (w & 0xFC000000U) == 0x94000000U && ((w >> 20) + 1) % 64 < 2;
+    }
+    return arm;
+}
 
-        if (zigzag < 256) {
-            small_count++;
-        } else if (zigzag < 65536) {
-            medium_count++;
+/**
+ * @brief Counts the x86 CALL/JMP rel32 of `src` whose target lies within 16 MB.
+ *
+ * @param[in] src Bytes.
+ * @param[in] n Number of bytes.
+ * @return The number of such branches.
+ */
+static size_t zxc_bcj_count_x86(const uint8_t* src, size_t n) {
+    size_t x86 = 0;
+    for (size_t i = 0; i + 5 <= n; i++) {
+        if ((src[i] & 0xFE) == 0xE8 && (uint8_t)(src[i + 4] + 1) < 2) {
+            x86++;
+            i += 4;
         }
+    }
+    return x86;
+}
+
+/**
+ * @brief Finds the architecture of a block of machine code.
+ *
+ * Counts, in the first ZXC_BCJ_PROBE_SIZE bytes, the branches a filter would
+ * convert whose target lies within 16 MB (x86 CALL/JMP rel32, the top byte of
+ * the displacement 0x00 or 0xFF) or 4 MB (AArch64 BL, word-aligned). Code has
+ * one every few dozen bytes, other data about one per 30 KB. Eight windows of
+ * ZXC_BCJ_PRECHECK_SIZE bytes are counted first, with half the limits, and
+ * most other blocks stop there.
+ *
+ * @param[in] src Pointer to the block.
+ * @param[in] size Size of the block.
+ * @return ZXC_BCJ_ARM64, ZXC_BCJ_X86, or 0 if the block does not look like code.
+ */
+static uint16_t zxc_probe_bcj_arch(const uint8_t* src, size_t size) {
+    const size_t n = size < ZXC_BCJ_PROBE_SIZE ? size : ZXC_BCJ_PROBE_SIZE;
+    if (n < 1024) return 0;
+
+    // Pre-check: at least half the branch density in 8 windows spread over the sample
+    size_t arm = 0, x86 = 0;
+    for (size_t k = 0; k < 8; k++) {
+        const size_t o = (k * (n / 8)) & ~(size_t)3;
+        arm += zxc_bcj_count_arm64(src + o, ZXC_BCJ_PRECHECK_SIZE);
+        x86 += zxc_bcj_count_x86(src + o, ZXC_BCJ_PRECHECK_SIZE);
+    }
+    const size_t m = 8 * ZXC_BCJ_PRECHECK_SIZE;
+    if (arm * 128 < m / 4 && x86 * 256 < m) return 0;
+
+    if (zxc_bcj_count_arm64(src, n) * 64 >= n / 4) return ZXC_BCJ_ARM64;  // >= 1/64 of the words
+    if (zxc_bcj_count_x86(src, n) * 128 >= n) return ZXC_BCJ_X86;  // >= 1/128 of the bytes
+    return 0;
+}
 
-        prev = curr;
-        p += 4;
+/**
+ * @brief Makes the branch targets of a block of machine code absolute.
+ *
+ * The calls to one function then repeat as bytes, which LZ matches. Offsets
+ * are relative to the block start, so the filter needs no other state.
+ * - x86: the 4 bytes after an E8/E9 opcode are skipped, and converted when
+ *   their top byte is 0x00 or 0xFF (a rel32 within 16 MB): the offset of the
+ *   next instruction is added modulo 2^25, sign-extended so that the top byte
+ *   stays 0x00 or 0xFF. Opcodes and top bytes then read the same to the
+ *   inverse, which makes the same choices.
+ * - AArch64: the imm26 of BL words gets the word index added, modulo 2^26.
+ *
+ * @param[in,out] buf Block, converted in place.
+ * @param[in] size Size of the block.
+ * @param[in] arch ZXC_BCJ_X86 or ZXC_BCJ_ARM64.
+ */
+static void zxc_bcj_encode(uint8_t* buf, size_t size, uint16_t arch) {
+    if (arch == ZXC_BCJ_ARM64) {
+        for (size_t i = 0; i + 4 <= size; i += 4) {
+            const uint32_t w = zxc_le32(buf + i);
+            if ((w & 0xFC000000U) != 0x94000000U) continue;
+            zxc_store_le32(buf + i, 0x94000000U | ((w + (uint32_t)(i >> 2)) & 0x03FFFFFFU));
+        }
+        return;
+    }
+    for (size_t i = 0; i + 5 <= size; i++) {
+        if ((buf[i] & 0xFE) != 0xE8) continue;
+        if ((uint8_t)(buf[i + 4] + 1) < 2) {
+            const uint32_t d = (zxc_le32(buf + i + 1) + (uint32_t)(i + 5)) & 0x01FFFFFFU;
+            zxc_store_le32(buf + i + 1, (d ^ 0x01000000U) - 0x01000000U);
+        }
+        i += 4;
     }
+}
 
-    // Calculate bit width needed for max delta
-    uint32_t bits_needed = 0;
-    uint32_t tmp = max_zigzag;
-    while (tmp > 0) {
-        bits_needed++;
-        tmp >>= 1;
+/**
+ * @brief Encodes a block with GLO or GHI after a block filter: the byte
+ * shuffle (see zxc_shuffle_bytes()) or the branch filter (see
+ * zxc_bcj_encode()).
+ *
+ * The block header carries the filter flag and its parameter; the checksum
+ * stays the one of the raw block. Only for independent blocks: the filtered
+ * block cannot reference a linked prefix.
+ *
+ * @param[in,out] ctx Compression context (`prefix_len` must be 0).
+ * @param[in] chunk Raw block.
+ * @param[in] src_sz Size of the block.
+ * @param[in] filter ZXC_BLOCK_FLAG_SHUFFLE or ZXC_BLOCK_FLAG_BCJ.
+ * @param[in] param Record stride (ZXC_SHUFFLE_MIN_STRIDE to ZXC_SHUFFLE_MAX_STRIDE)
+ * or architecture ID (ZXC_BCJ_X86, ZXC_BCJ_ARM64).
+ * @param[in] ghi Non-zero for GHI, zero for GLO.
+ * @param[out] dst Destination buffer.
+ * @param[in] dst_cap Capacity of `dst`.
+ * @param[out] out_sz Size of the encoded block.
+ * @param[in] crc Checksum of the raw block (if enabled).
+ * @return 0 on success, or -1 on failure.
+ */
+static int zxc_encode_block_filtered(zxc_cctx_t* ctx, const uint8_t* chunk, size_t src_sz,
+                                     uint8_t filter, uint16_t param, int ghi, uint8_t* dst,
+                                     size_t dst_cap, size_t* out_sz, uint64_t crc) {
+    if (UNLIKELY(zxc_cctx_filter_reserve(ctx, src_sz + ZXC_PAD_SIZE) != 0)) return -1;
+    if (filter == ZXC_BLOCK_FLAG_SHUFFLE) {
+        zxc_shuffle_bytes(chunk, src_sz, param, ctx->filter_buf);
+    } else {
+        ZXC_MEMCPY(ctx->filter_buf, chunk, src_sz);
+        zxc_bcj_encode(ctx->filter_buf, src_sz, param);
     }
 
-    // Estimate compression ratio:
-    // NUM uses ~bits_needed per value, Raw uses 32 bits per value
-    // Worth it if bits_needed <= 20 (saves >37.5%)
-    if (bits_needed <= 16) return 1;
-    if (bits_needed <= 20 && (small_count + medium_count) >= (count * 85) / 100) return 1;
+    const int res =
+        ghi ? zxc_encode_block_ghi(ctx, ctx->filter_buf, src_sz, dst, dst_cap, out_sz, crc)
+            : zxc_encode_block_glo(ctx, ctx->filter_buf, src_sz, dst, dst_cap, out_sz, crc);
+    if (res != 0) return res;
+    dst[1] |= filter;
+    zxc_store_le16(dst + 2, param);
+    return 0;
+}
 
-    // Fallback: if 90% of deltas are small, still use NUM
-    if ((small_count + medium_count) >= (count * 90) / 100) return 1;
+/**
+ * @brief Picks the block filter worth trying on a block: the branch filter for
+ * machine code, else the byte shuffle for arrays of records.
+ *
+ * @param[in] ctx Compression context (no filter with a linked prefix).
+ * @param[in] chunk Raw block.
+ * @param[in] src_sz Size of the block.
+ * @param[out] param Parameter of the filter.
+ * @return ZXC_BLOCK_FLAG_BCJ, ZXC_BLOCK_FLAG_SHUFFLE, or 0 for no filter.
+ */
+static uint8_t zxc_probe_block_filter(const zxc_cctx_t* ctx, const uint8_t* chunk,
+                                      size_t src_sz, uint16_t* param) {
+    *param = 0;
+    if (ctx->prefix_len != 0) return 0;
+    if ((*param = zxc_probe_bcj_arch(chunk, src_sz)) != 0) return ZXC_BLOCK_FLAG_BCJ;
+    if ((*param = (uint16_t)zxc_probe_shuffle_stride(chunk, src_sz)) != 0)
+        return ZXC_BLOCK_FLAG_SHUFFLE;
+    return 0;
+}
 
+/**
+ * @brief Makes `ctx->trial_buf` hold a candidate block of `cap` bytes.
+ *
+ * @param[in,out] ctx Compression context.
+ * @param[in] cap Required capacity.
+ * @return 0 on success, or -1 if the allocation fails.
+ */
+static int zxc_trial_buf_reserve(zxc_cctx_t* ctx, size_t cap) {
+    if (ctx->trial_buf_cap < cap) {
+        free(ctx->trial_buf);
+        ctx->trial_buf = (uint8_t*)malloc(cap);
+        ctx->trial_buf_cap = ctx->trial_buf ? cap : 0;
+        if (UNLIKELY(!ctx->trial_buf)) return -1;
+    }
     return 0;
 }
 
+/**
+ * @brief Price of an encoded block under the context's cost model.
+ *
+ * @param[in] ctx Compression context (its cost model; all-zero = size only).
+ * @param[in] blk Encoded block, header included.
+ * @param[in] sz Size of the block.
+ * @return `byte_weight * sz + cycle_weight * estimated decode cycles`, or
+ * UINT64_MAX if the estimate fails.
+ */
+static uint64_t zxc_block_price(const zxc_cctx_t* ctx, const uint8_t* blk, size_t sz) {
+    const zxc_cost_model_t* m = &ctx->cost_model;
+    if (m->cycle_weight == 0) return sz;
+
+    uint32_t n_seq;
+    uint64_t cycles = zxc_estimate_block_cycles(blk, sz, m, &n_seq);
+    if (UNLIKELY(cycles == UINT64_MAX)) return UINT64_MAX;
+    return (uint64_t)m->byte_weight * sz + (uint64_t)m->cycle_weight * cycles;
+}
+
+/**
+ * @brief Encodes a block with every block type and keeps the cheapest one.
+ *
+ * The level's LZ format is tried first, then the other one (GLO / GHI), NUM
+ * with 32-, 64- and 16-bit values, FLT with 32- and 64-bit values (when the
+ * block size allows), the cheaper LZ format after a block filter (when the
+ * probes find machine code or records) and RAW; ties keep the earlier
+ * candidate. Candidates get the capacity of a RAW block, so the cheaper LZ
+ * format is known even when `dst` is short; the best one that fits `dst_cap`
+ * wins. Each candidate is written to whichever of two slots does not hold the
+ * best one so far: `ctx->trial_buf`, and `dst` (or the second half of
+ * `ctx->trial_buf` when `dst` is shorter than a RAW block).
+ *
+ * @param[in,out] ctx Compression context.
+ * @param[in] chunk Raw block.
+ * @param[in] src_sz Size of the block.
+ * @param[out] dst Destination buffer.
+ * @param[in] dst_cap Capacity of `dst`.
+ * @param[in] crc Checksum of the block (if enabled).
+ * @return The size of the block written to `dst`, or -1 if no candidate fits
+ * (or the scratch buffer cannot be allocated).
+ */
+static int zxc_encode_block_trials(zxc_cctx_t* ctx, const uint8_t* chunk, size_t src_sz,
+                                   uint8_t* dst, size_t dst_cap, uint64_t crc) {
+    // Larger candidates than a RAW block never win
+    const size_t cap = src_sz + ZXC_BLOCK_HEADER_SIZE + ZXC_BLOCK_CHECKSUM_SIZE;
+    const int dst_fits = dst_cap >= cap;
+    if (UNLIKELY(zxc_trial_buf_reserve(ctx, dst_fits ? cap : 2 * cap) != 0)) return -1;
+    uint8_t* const slot = dst_fits ? dst : ctx->trial_buf + cap;
+    uint16_t param;
+    const uint8_t filter = zxc_probe_block_filter(ctx, chunk, src_sz, &param);
+
+    const int ghi_first = ctx->compression_level <= 2;
+    uint8_t* best_buf = NULL;
+    size_t best_sz = 0;
+    uint64_t best = UINT64_MAX;
+    // The filtered block uses the cheaper of the two LZ formats
+    int ghi_best = ghi_first;
+    uint64_t lz_best = UINT64_MAX;
+
+    for (int t = 0; t < 9; t++) {
+        uint8_t* out = best_buf == slot ? ctx->trial_buf : slot;
+        size_t w = 0;
+        int res;
+        if (t < 2) {
+            res = (t == 0) == ghi_first
+                      ? zxc_encode_block_ghi(ctx, chunk, src_sz, out, cap, &w, crc)
+                      : zxc_encode_block_glo(ctx, chunk, src_sz, out, cap, &w, crc);
+        } else if (t < 5) {
+            const size_t width = zxc_num_widths[t - 2];
+            if (src_sz % width != 0 || src_sz < 16) continue;
+            res = zxc_encode_block_num(ctx, chunk, src_sz, out, cap, &w, crc, width, 0);
+        } else if (t < 7) {
+            const size_t width = zxc_flt_widths[t - 5];
+            if (src_sz % width != 0 || src_sz < 16) continue;
+            res = zxc_encode_block_num(ctx, chunk, src_sz, out, cap, &w, crc, width, 1);
+        } else if (t < 8) {
+            if (!filter) continue;
+            res = zxc_encode_block_filtered(ctx, chunk, src_sz, filter, param, ghi_best, out,
+                                            cap, &w, crc);
+        } else {
+            res = zxc_encode_block_raw(chunk, src_sz, out, cap, &w, ctx->checksum_enabled, crc);
+        }
+        if (res != 0) continue;
+
+        uint64_t price = zxc_block_price(ctx, out, w);
+        // A size-only model does not see the inverse filter pass: a filtered
+        // block must save 1/32 of the block over the other candidates to pay for it
+        if (t == 7 && ctx->cost_model.cycle_weight == 0) price += src_sz >> 5;
+        if (t < 2 && price < lz_best) {
+            lz_best = price;
+            ghi_best = (t == 0) == ghi_first;
+        }
+        if (w <= dst_cap && price < best) {
+            best = price;
+            best_buf = out;
+            best_sz = w;
+        }
+    }
+
+    if (UNLIKELY(!best_buf)) return -1;
+    if (best_buf != dst) ZXC_MEMCPY(dst, best_buf, best_sz);
+    return (int)best_sz;
+}
+
 // cppcheck-suppress unusedFunction
 int zxc_compress_chunk_wrapper(zxc_cctx_t* ctx, const uint8_t* chunk, size_t src_sz, uint8_t* dst,
                                size_t dst_cap) {
@@ -1397,19 +3076,36 @@ int zxc_compress_chunk_wrapper(zxc_cctx_t* ctx, const uint8_t* chunk, size_t src
     size_t w = 0;
     uint64_t crc = 0;
     int res = -1;
-    int try_num = 0;
+    size_t try_num = 0;
+    size_t try_flt = 0;
 
     if (chk) crc = zxc_checksum(chunk, src_sz, ZXC_CHECKSUM_RAPIDHASH);
 
-    if (zxc_probe_is_numeric(chunk, src_sz)) try_num = 1;
+    if (ctx->block_trials) {
+        res = zxc_encode_block_trials(ctx, chunk, src_sz, dst, dst_cap, crc);
+        if (LIKELY(res >= 0)) return res;
+    }
+
+    // Both probes may accept an array (floats of slow-moving series): NUM goes
+    // first unless FLT needs fewer bits per value bit in the sample
+    uint32_t num_bits = 0, flt_bits = 0;
+    try_num = zxc_probe_num_width(chunk, src_sz, &num_bits);
+    try_flt = zxc_probe_flt_width(chunk, src_sz, &flt_bits);
+    if (try_num && try_flt && flt_bits * try_num < num_bits * try_flt) try_num = 0;
 
     if (try_num) {
-        res = zxc_encode_block_num(ctx, chunk, src_sz, dst, dst_cap, &w, crc);
+        res = zxc_encode_block_num(ctx, chunk, src_sz, dst, dst_cap, &w, crc, try_num, 0);
         if (res != 0 || w > (src_sz - (src_sz >> 2)))  // w > 75% of src_sz
-            try_num = 0;  // NUM didn't compress well, try GLO/GHI instead
+            try_num = 0;  // NUM didn't compress well, try FLT or GLO/GHI instead
+    }
+
+    if (!try_num && try_flt) {
+        res = zxc_encode_block_num(ctx, chunk, src_sz, dst, dst_cap, &w, crc, try_flt, 1);
+        if (res != 0 || w > (src_sz - (src_sz >> 3)))  // w > 87.5% of src_sz
+            try_flt = 0;  // FLT didn't compress well, try GLO/GHI instead
     }
 
-    if (!try_num) {
+    if (!try_num && !try_flt) {
         if (ctx->compression_level <= 2) {
             res = zxc_encode_block_ghi(ctx, chunk, src_sz, dst, dst_cap, &w, crc);
         } else {
@@ -1417,6 +3113,25 @@ int zxc_compress_chunk_wrapper(zxc_cctx_t* ctx, const uint8_t* chunk, size_t src
         }
     }
 
+    // Machine code or arrays of records (FLT also accepts smooth vertices): also
+    // encode the filtered block, keep the smaller one. It gets the full capacity,
+    // so the choice does not depend on dst_cap.
+    uint16_t param;
+    const uint8_t filter = zxc_probe_block_filter(ctx, chunk, src_sz, &param);
+    if (filter) {
+        const size_t cap_s = src_sz + ZXC_BLOCK_HEADER_SIZE + ZXC_BLOCK_CHECKSUM_SIZE;
+        size_t ws = 0;
+        if (zxc_trial_buf_reserve(ctx, cap_s) == 0 &&
+            zxc_encode_block_filtered(ctx, chunk, src_sz, filter, param,
+                                      ctx->compression_level <= 2, ctx->trial_buf, cap_s, &ws,
+                                      crc) == 0 &&
+            ws <= dst_cap && (res != 0 || ws < w)) {
+            ZXC_MEMCPY(dst, ctx->trial_buf, ws);
+            w = ws;
+            res = 0;
+        }
+    }
+
     if (UNLIKELY(res != 0 || w >= src_sz)) {
         res = zxc_encode_block_raw(chunk, src_sz, dst, dst_cap, &w, chk, crc);
         if (UNLIKELY(res != 0)) return res;
@@ -19,7 +19,8 @@
 #define zxc_decompress_chunk_wrapper ZXC_CAT(zxc_decompress_chunk_wrapper, ZXC_FUNCTION_SUFFIX)
 #endif
 
-#define ZXC_DEC_BATCH 32  // Number of sequences to decode in a batch
+#define ZXC_NUM_SIMD_MAX_BITS 25    // Widest 16/32-bit NUM delta unpacked by the SIMD paths
+#define ZXC_NUM_SIMD_MAX_BITS64 57  // Widest 64-bit NUM delta unpacked by the SIMD paths
 
 /**
  * @brief Consumes a specified number of bits from the bit reader buffer without
@@ -236,6 +237,20 @@ static ZXC_ALWAYS_INLINE uint32x4_t zxc_neon_prefix_sum_u32(uint32x4_t v) {
 
     return v;
 }
+
+/**
+ * @brief Computes the prefix XOR of a uint32x4_t vector (see
+ * zxc_neon_prefix_sum_u32()): `[a, a^b, a^b^c, a^b^c^d]`.
+ *
+ * @param[in] v The input vector containing four 32-bit unsigned integers.
+ * @return A uint32x4_t vector containing the prefix XORs.
+ */
+static ZXC_ALWAYS_INLINE uint32x4_t zxc_neon_prefix_xor_u32(uint32x4_t v) {
+    const uint8x16_t zero = vdupq_n_u8(0);
+    v = veorq_u32(v, vreinterpretq_u32_u8(vextq_u8(zero, vreinterpretq_u8_u32(v), 12)));
+    v = veorq_u32(v, vreinterpretq_u32_u8(vextq_u8(zero, vreinterpretq_u8_u32(v), 8)));
+    return v;
+}
 #endif
 
 #if defined(ZXC_USE_AVX2)
@@ -268,6 +283,22 @@ static ZXC_ALWAYS_INLINE __m256i zxc_mm256_prefix_sum_epi32(__m256i v) {
 
     return _mm256_add_epi32(v, v_bridge);  // Add bridge value to upper lane
 }
+
+/**
+ * @brief Computes the prefix XOR of the eight 32-bit integers of a 256-bit
+ * vector (see zxc_mm256_prefix_sum_epi32()).
+ *
+ * @param[in] v The input 256-bit vector containing eight 32-bit integers.
+ * @return A 256-bit vector containing the prefix XORs of the input elements.
+ */
+// codeql[cpp/unused-static-function] : Used conditionally when ZXC_USE_AVX2 is defined
+static ZXC_ALWAYS_INLINE __m256i zxc_mm256_prefix_xor_epi32(__m256i v) {
+    v = _mm256_xor_si256(v, _mm256_slli_si256(v, 4));
+    v = _mm256_xor_si256(v, _mm256_slli_si256(v, 8));
+    // XOR the last element of the lower 128-bit lane into the upper lane
+    __m256i v_bridge = _mm256_shuffle_epi32(_mm256_permute2x128_si256(v, v, 0x00), 0xFF);
+    return _mm256_xor_si256(v, _mm256_blend_epi32(_mm256_setzero_si256(), v_bridge, 0xF0));
+}
 #endif
 
 #if defined(ZXC_USE_AVX512)
@@ -306,8 +337,441 @@ static ZXC_ALWAYS_INLINE __m512i zxc_mm512_prefix_sum_epi32(__m512i v) {
 
     return v;
 }
+
+/**
+ * @brief Computes the prefix XOR of the sixteen 32-bit integers of a 512-bit
+ * vector (see zxc_mm512_prefix_sum_epi32()).
+ *
+ * @param[in] v The input 512-bit vector containing sixteen 32-bit integers.
+ * @return A 512-bit vector containing the prefix XORs of the input elements.
+ */
+static ZXC_ALWAYS_INLINE __m512i zxc_mm512_prefix_xor_epi32(__m512i v) {
+    v = _mm512_xor_si512(v, _mm512_bslli_epi128(v, 4));
+    v = _mm512_xor_si512(v, _mm512_bslli_epi128(v, 8));
+    // Lane j takes the last element of lane j - 1, then of lane j - 2 (zero below lane 0)
+    const __m512i v_prev1 =
+        _mm512_setr_epi32(0, 0, 0, 0, 3, 3, 3, 3, 7, 7, 7, 7, 11, 11, 11, 11);
+    const __m512i v_prev2 =
+        _mm512_setr_epi32(0, 0, 0, 0, 0, 0, 0, 0, 3, 3, 3, 3, 7, 7, 7, 7);
+    v = _mm512_xor_si512(v, _mm512_maskz_permutexvar_epi32(0xFFF0, v_prev1, v));
+    v = _mm512_xor_si512(v, _mm512_maskz_permutexvar_epi32(0xFF00, v_prev2, v));
+    return v;
+}
+#endif
+
+/**
+ * @brief Decodes one NUM frame of 16- or 32-bit values: bit unpacking, zigzag
+ * decoding and prefix sum in a single pass.
+ *
+ * Four values of up to ZXC_NUM_SIMD_MAX_BITS bits span at most 13 bytes from
+ * the byte holding the first one, so every 128-bit lane of the SIMD paths is
+ * one 16-byte load spread over four 32-bit lanes, shifted by each value's bit
+ * position and masked. Eight (AVX2 / NEON) or sixteen (AVX-512) values take a
+ * whole number of bytes, so the shuffles and shifts are set once per frame.
+ * Wider values, and the last ones of the block, take the scalar loop, which
+ * never reads past the section. 16-bit values are summed in 32-bit lanes (the
+ * low halves are exact modulo 2^16) and narrowed on store.
+ *
+ * FLT frames (`flt`) replace the zigzag decoding and prefix sum by a shift left
+ * of `xor_shift` bits and a prefix XOR: the unpacked values are XOR residuals.
+ *
+ * @param[in] src Packed deltas of the frame.
+ * @param[in] src_size Size of the packed section.
+ * @param[in] src_avail Readable bytes from `src` (rest of the block), for the
+ * SIMD loads that overrun the section.
+ * @param[out] dst Destination of the `n` values.
+ * @param[in] n Number of values.
+ * @param[in] bits Width of each delta (0-32).
+ * @param[in,out] running Last value of the previous frame, then of this one.
+ * @param[in] width Size of the values in bytes (2 or 4).
+ * @param[in] flt Decodes a FLT frame (32-bit values only).
+ * @param[in] xor_shift Trailing zero bits of the FLT residuals (`bits + xor_shift` <= 32).
+ * @return 0 on success, or -1 if the section is too short.
+ */
+static ZXC_ALWAYS_INLINE int zxc_num_decode_frame(const uint8_t* RESTRICT src, size_t src_size,
+                                                  size_t src_avail, uint8_t* RESTRICT dst,
+                                                  size_t n, unsigned bits, uint32_t* running,
+                                                  size_t width, int flt, unsigned xor_shift) {
+    if (UNLIKELY(((uint64_t)n * bits + ZXC_BITS_PER_BYTE - 1) / ZXC_BITS_PER_BYTE > src_size))
+        return -1;
+    const uint32_t mask = bits < 32 ? (1U << bits) - 1 : UINT32_MAX;
+    uint32_t running_val = *running;
+    size_t i = 0;
+
+#if defined(ZXC_USE_AVX2) || defined(ZXC_USE_AVX512) || defined(ZXC_USE_NEON64)
+    if (bits <= ZXC_NUM_SIMD_MAX_BITS) {
+        // Lane j of group g = j / 4 loads from byte 4 * g * bits / 8 of the step: its
+        // value starts at bit first = (4 * g * bits) % 8 + (j % 4) * bits of the load
+        const size_t g1 = (4 * bits) / ZXC_BITS_PER_BYTE;
+
+#if defined(ZXC_USE_AVX512)
+        const size_t g2 = (8 * bits) / ZXC_BITS_PER_BYTE, g3 = (12 * bits) / ZXC_BITS_PER_BYTE;
+        const __m512i v_lane =
+            _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+        const __m512i v_bits = _mm512_set1_epi32((int)bits);
+        const __m512i v_three = _mm512_set1_epi32(3), v_seven = _mm512_set1_epi32(7);
+        const __m512i v_first = _mm512_add_epi32(
+            _mm512_and_si512(_mm512_mullo_epi32(_mm512_andnot_si512(v_three, v_lane), v_bits),
+                             v_seven),
+            _mm512_mullo_epi32(_mm512_and_si512(v_lane, v_three), v_bits));
+        // Bytes first / 8 .. first / 8 + 3 of the load, shifted right by first % 8
+        const __m512i v_shuf =
+            _mm512_add_epi32(_mm512_mullo_epi32(_mm512_srli_epi32(v_first, 3),
+                                                _mm512_set1_epi32(0x01010101)),
+                             _mm512_set1_epi32(0x03020100));
+        const __m512i v_shift = _mm512_and_si512(v_first, v_seven);
+        const __m512i v_mask = _mm512_set1_epi32((int)mask);
+        const __m512i v_one = _mm512_set1_epi32(1);
+        const __m512i v_last = _mm512_set1_epi32(15);
+        const __m128i v_flt_shift = _mm_cvtsi32_si128((int)xor_shift);
+        __m512i v_run = _mm512_set1_epi32((int)running_val);
+        for (; i + 16 <= n && (i * bits) / ZXC_BITS_PER_BYTE + g3 + 16 <= src_avail; i += 16) {
+            const uint8_t* in = src + (i * bits) / ZXC_BITS_PER_BYTE;
+            __m512i v = _mm512_castsi128_si512(_mm_loadu_si128((const __m128i*)in));
+            v = _mm512_inserti32x4(v, _mm_loadu_si128((const __m128i*)(in + g1)), 1);
+            v = _mm512_inserti32x4(v, _mm_loadu_si128((const __m128i*)(in + g2)), 2);
+            v = _mm512_inserti32x4(v, _mm_loadu_si128((const __m128i*)(in + g3)), 3);
+            v = _mm512_and_si512(_mm512_srlv_epi32(_mm512_shuffle_epi8(v, v_shuf), v_shift),
+                                 v_mask);
+            if (flt) {
+                v = _mm512_sll_epi32(v, v_flt_shift);
+                v = _mm512_xor_si512(zxc_mm512_prefix_xor_epi32(v), v_run);
+            } else {
+                // Zigzag: (v >> 1) ^ -(v & 1)
+                v = _mm512_xor_si512(_mm512_srli_epi32(v, 1),
+                                     _mm512_sub_epi32(_mm512_setzero_si512(),
+                                                      _mm512_and_si512(v, v_one)));
+                v = _mm512_add_epi32(zxc_mm512_prefix_sum_epi32(v), v_run);
+            }
+            if (width == 2)
+                _mm256_storeu_si256((__m256i*)(dst + 2 * i), _mm512_cvtepi32_epi16(v));
+            else
+                _mm512_storeu_si512((void*)(dst + 4 * i), v);
+            v_run = _mm512_permutexvar_epi32(v_last, v);
+        }
+        running_val = (uint32_t)_mm_cvtsi128_si32(_mm512_castsi512_si128(v_run));
+#elif defined(ZXC_USE_AVX2)
+        const __m256i v_lane = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+        const __m256i v_bits = _mm256_set1_epi32((int)bits);
+        const __m256i v_three = _mm256_set1_epi32(3), v_seven = _mm256_set1_epi32(7);
+        const __m256i v_first = _mm256_add_epi32(
+            _mm256_and_si256(_mm256_mullo_epi32(_mm256_andnot_si256(v_three, v_lane), v_bits),
+                             v_seven),
+            _mm256_mullo_epi32(_mm256_and_si256(v_lane, v_three), v_bits));
+        // Bytes first / 8 .. first / 8 + 3 of the load, shifted right by first % 8
+        const __m256i v_shuf =
+            _mm256_add_epi32(_mm256_mullo_epi32(_mm256_srli_epi32(v_first, 3),
+                                                _mm256_set1_epi32(0x01010101)),
+                             _mm256_set1_epi32(0x03020100));
+        const __m256i v_shift = _mm256_and_si256(v_first, v_seven);
+        const __m256i v_mask = _mm256_set1_epi32((int)mask);
+        const __m256i v_one = _mm256_set1_epi32(1);
+        const __m256i v_last = _mm256_set1_epi32(7);
+        const __m128i v_flt_shift = _mm_cvtsi32_si128((int)xor_shift);
+        // Low 16 bits of each 32-bit lane, packed in the low 8 bytes of each 128-bit lane
+        const __m256i v_narrow = _mm256_setr_epi8(0, 1, 4, 5, 8, 9, 12, 13, -1, -1, -1, -1, -1, -1,
+                                                  -1, -1, 0, 1, 4, 5, 8, 9, 12, 13, -1, -1, -1, -1,
+                                                  -1, -1, -1, -1);
+        __m256i v_run = _mm256_set1_epi32((int)running_val);
+        for (; i + 8 <= n && (i * bits) / ZXC_BITS_PER_BYTE + g1 + 16 <= src_avail; i += 8) {
+            const uint8_t* in = src + (i * bits) / ZXC_BITS_PER_BYTE;
+            __m256i v = _mm256_inserti128_si256(
+                _mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)in)),
+                _mm_loadu_si128((const __m128i*)(in + g1)), 1);
+            v = _mm256_and_si256(_mm256_srlv_epi32(_mm256_shuffle_epi8(v, v_shuf), v_shift),
+                                 v_mask);
+            if (flt) {
+                v = _mm256_sll_epi32(v, v_flt_shift);
+                v = _mm256_xor_si256(zxc_mm256_prefix_xor_epi32(v), v_run);
+            } else {
+                // Zigzag: (v >> 1) ^ -(v & 1)
+                v = _mm256_xor_si256(_mm256_srli_epi32(v, 1),
+                                     _mm256_sub_epi32(_mm256_setzero_si256(),
+                                                      _mm256_and_si256(v, v_one)));
+                v = _mm256_add_epi32(zxc_mm256_prefix_sum_epi32(v), v_run);
+            }
+            if (width == 2) {
+                const __m256i n16 = _mm256_shuffle_epi8(v, v_narrow);
+                _mm_storeu_si128((__m128i*)(dst + 2 * i),
+                                 _mm256_castsi256_si128(_mm256_permute4x64_epi64(n16, 0x08)));
+            } else {
+                _mm256_storeu_si256((__m256i*)(dst + 4 * i), v);
+            }
+            v_run = _mm256_permutevar8x32_epi32(v, v_last);
+        }
+        running_val = (uint32_t)_mm256_cvtsi256_si32(v_run);
+#else
+        static const uint32_t lane[4] = {0, 1, 2, 3};
+        const uint32x4_t first_lo = vmulq_n_u32(vld1q_u32(lane), bits);
+        const uint32x4_t first_hi =
+            vaddq_u32(first_lo, vdupq_n_u32((4 * bits) % ZXC_BITS_PER_BYTE));
+        // Bytes first / 8 .. first / 8 + 3 of the load, shifted right by first % 8
+        const uint32x4_t v_bytes = vdupq_n_u32(0x03020100);
+        const uint8x16_t v_shuf_lo = vreinterpretq_u8_u32(
+            vmlaq_n_u32(v_bytes, vshrq_n_u32(first_lo, 3), 0x01010101));
+        const uint8x16_t v_shuf_hi = vreinterpretq_u8_u32(
+            vmlaq_n_u32(v_bytes, vshrq_n_u32(first_hi, 3), 0x01010101));
+        const int32x4_t v_shift_lo =
+            vnegq_s32(vreinterpretq_s32_u32(vandq_u32(first_lo, vdupq_n_u32(7))));
+        const int32x4_t v_shift_hi =
+            vnegq_s32(vreinterpretq_s32_u32(vandq_u32(first_hi, vdupq_n_u32(7))));
+        const uint32x4_t v_mask = vdupq_n_u32(mask);
+        const uint32x4_t v_one = vdupq_n_u32(1);
+        const int32x4_t v_flt_shift = vdupq_n_s32((int32_t)xor_shift);
+        uint32x4_t v_run = vdupq_n_u32(running_val);
+        for (; i + 8 <= n && (i * bits) / ZXC_BITS_PER_BYTE + g1 + 16 <= src_avail; i += 8) {
+            const uint8_t* in = src + (i * bits) / ZXC_BITS_PER_BYTE;
+            uint32x4_t lo = vreinterpretq_u32_u8(vqtbl1q_u8(vld1q_u8(in), v_shuf_lo));
+            uint32x4_t hi = vreinterpretq_u32_u8(vqtbl1q_u8(vld1q_u8(in + g1), v_shuf_hi));
+            lo = vandq_u32(vshlq_u32(lo, v_shift_lo), v_mask);
+            hi = vandq_u32(vshlq_u32(hi, v_shift_hi), v_mask);
+            if (flt) {
+                lo = veorq_u32(zxc_neon_prefix_xor_u32(vshlq_u32(lo, v_flt_shift)), v_run);
+                v_run = vdupq_laneq_u32(lo, 3);
+                hi = veorq_u32(zxc_neon_prefix_xor_u32(vshlq_u32(hi, v_flt_shift)), v_run);
+                v_run = vdupq_laneq_u32(hi, 3);
+            } else {
+                // Zigzag: (v >> 1) ^ -(v & 1)
+                lo = veorq_u32(vshrq_n_u32(lo, 1),
+                               vreinterpretq_u32_s32(vnegq_s32(vreinterpretq_s32_u32(
+                                   vandq_u32(lo, v_one)))));
+                hi = veorq_u32(vshrq_n_u32(hi, 1),
+                               vreinterpretq_u32_s32(vnegq_s32(vreinterpretq_s32_u32(
+                                   vandq_u32(hi, v_one)))));
+                lo = vaddq_u32(zxc_neon_prefix_sum_u32(lo), v_run);
+                v_run = vdupq_laneq_u32(lo, 3);
+                hi = vaddq_u32(zxc_neon_prefix_sum_u32(hi), v_run);
+                v_run = vdupq_laneq_u32(hi, 3);
+            }
+            if (width == 2) {
+                vst1q_u16((uint16_t*)(dst + 2 * i), vcombine_u16(vmovn_u32(lo), vmovn_u32(hi)));
+            } else {
+                vst1q_u32((uint32_t*)(dst + 4 * i), lo);
+                vst1q_u32((uint32_t*)(dst + 4 * i + 16), hi);
+            }
+        }
+        running_val = vgetq_lane_u32(v_run, 0);
+#endif
+    }
+#else
+    (void)src_avail;
+#endif
+
+    for (; i < n; i++) {
+        const size_t pos = i * bits;
+        const size_t b = pos / ZXC_BITS_PER_BYTE;
+        uint64_t v = 0;
+        if (LIKELY(b + sizeof(uint64_t) <= src_size)) {
+            v = zxc_le64(src + b);
+        } else {
+            for (size_t k = 0; b + k < src_size && k < sizeof(uint64_t); k++)
+                v |= (uint64_t)src[b + k] << (8 * k);
+        }
+        const uint32_t delta = (uint32_t)(v >> (pos % ZXC_BITS_PER_BYTE)) & mask;
+        if (flt)
+            running_val ^= delta << xor_shift;
+        else
+            running_val += (uint32_t)zxc_zigzag_decode(delta);
+        if (width == 2)
+            zxc_store_le16(dst + 2 * i, (uint16_t)running_val);
+        else
+            zxc_store_le32(dst + 4 * i, running_val);
+    }
+    *running = running_val;
+    return 0;
+}
+
+/**
+ * @brief Decodes one NUM frame of 64-bit values (see zxc_num_decode_frame()).
+ *
+ * Two values of up to ZXC_NUM_SIMD_MAX_BITS64 bits fit in the 16 bytes from
+ * the byte holding the first one, so every 128-bit lane is one load spread
+ * over two 64-bit lanes. Eight values take a whole number of bytes: each step
+ * decodes four such groups, whose shuffles and shifts are set once per frame.
+ *
+ * @param[in] src Packed deltas of the frame.
+ * @param[in] src_size Size of the packed section.
+ * @param[in] src_avail Readable bytes from `src` (rest of the block), for the
+ * SIMD loads that overrun the section.
+ * @param[out] dst Destination of the `n` 64-bit values.
+ * @param[in] n Number of values.
+ * @param[in] bits Width of each delta (0-64).
+ * @param[in,out] running Last value of the previous frame, then of this one.
+ * @param[in] flt Decodes a FLT frame.
+ * @param[in] xor_shift Trailing zero bits of the FLT residuals (`bits + xor_shift` <= 64).
+ * @return 0 on success, or -1 if the section is too short.
+ */
+static ZXC_ALWAYS_INLINE int zxc_num_decode_frame64(const uint8_t* RESTRICT src, size_t src_size,
+                                                    size_t src_avail, uint8_t* RESTRICT dst,
+                                                    size_t n, unsigned bits, uint64_t* running,
+                                                    int flt, unsigned xor_shift) {
+    if (UNLIKELY(((uint64_t)n * bits + ZXC_BITS_PER_BYTE - 1) / ZXC_BITS_PER_BYTE > src_size))
+        return -1;
+    const uint64_t mask = bits < 64 ? (1ULL << bits) - 1 : UINT64_MAX;
+    uint64_t running_val = *running;
+    size_t i = 0;
+
+#if defined(ZXC_USE_AVX2) || defined(ZXC_USE_AVX512) || defined(ZXC_USE_NEON64)
+    if (bits <= ZXC_NUM_SIMD_MAX_BITS64) {
+        // Lane j of group g = j / 2 loads from byte goff[g] = 2 * g * bits / 8 of the
+        // step: it gathers the 8 bytes holding its value, shifted right by its bit offset
+        ZXC_ALIGN(64) uint8_t shuf[64];
+        ZXC_ALIGN(64) uint64_t shift[8];
+        size_t goff[4];
+        for (unsigned j = 0; j < 8; j++) {
+            const unsigned g = j / 2;
+            const unsigned first = (2 * g * bits) % ZXC_BITS_PER_BYTE + (j % 2) * bits;
+            for (unsigned k = 0; k < 8; k++)
+                shuf[8 * j + k] = (uint8_t)(first / ZXC_BITS_PER_BYTE + k);
+            shift[j] = first % ZXC_BITS_PER_BYTE;
+            goff[g] = (2 * g * bits) / ZXC_BITS_PER_BYTE;
+        }
+
+#if defined(ZXC_USE_AVX512)
+        const __m512i v_shuf = _mm512_load_si512((const void*)shuf);
+        const __m512i v_shift = _mm512_load_si512((const void*)shift);
+        const __m512i v_mask = _mm512_set1_epi64((long long)mask);
+        const __m512i v_one = _mm512_set1_epi64(1);
+        // Lane j takes lane j - 1, j - 2, j - 4 (zero below lane 0)
+        const __m512i v_prev1 = _mm512_setr_epi64(0, 0, 1, 2, 3, 4, 5, 6);
+        const __m512i v_prev2 = _mm512_setr_epi64(0, 0, 0, 1, 2, 3, 4, 5);
+        const __m512i v_prev4 = _mm512_setr_epi64(0, 0, 0, 0, 0, 1, 2, 3);
+        const __m512i v_last = _mm512_set1_epi64(7);
+        const __m128i v_flt_shift = _mm_cvtsi32_si128((int)xor_shift);
+        __m512i v_run = _mm512_set1_epi64((long long)running_val);
+        for (; i + 8 <= n && (i * bits) / ZXC_BITS_PER_BYTE + goff[3] + 16 <= src_avail; i += 8) {
+            const uint8_t* in = src + (i * bits) / ZXC_BITS_PER_BYTE;
+            __m512i v = _mm512_castsi128_si512(_mm_loadu_si128((const __m128i*)in));
+            v = _mm512_inserti32x4(v, _mm_loadu_si128((const __m128i*)(in + goff[1])), 1);
+            v = _mm512_inserti32x4(v, _mm_loadu_si128((const __m128i*)(in + goff[2])), 2);
+            v = _mm512_inserti32x4(v, _mm_loadu_si128((const __m128i*)(in + goff[3])), 3);
+            v = _mm512_and_si512(_mm512_srlv_epi64(_mm512_shuffle_epi8(v, v_shuf), v_shift),
+                                 v_mask);
+            if (flt) {
+                v = _mm512_sll_epi64(v, v_flt_shift);
+                v = _mm512_xor_si512(v, _mm512_maskz_permutexvar_epi64(0xFE, v_prev1, v));
+                v = _mm512_xor_si512(v, _mm512_maskz_permutexvar_epi64(0xFC, v_prev2, v));
+                v = _mm512_xor_si512(v, _mm512_maskz_permutexvar_epi64(0xF0, v_prev4, v));
+                v = _mm512_xor_si512(v, v_run);
+            } else {
+                // Zigzag: (v >> 1) ^ -(v & 1)
+                v = _mm512_xor_si512(_mm512_srli_epi64(v, 1),
+                                     _mm512_sub_epi64(_mm512_setzero_si512(),
+                                                      _mm512_and_si512(v, v_one)));
+                v = _mm512_add_epi64(v, _mm512_maskz_permutexvar_epi64(0xFE, v_prev1, v));
+                v = _mm512_add_epi64(v, _mm512_maskz_permutexvar_epi64(0xFC, v_prev2, v));
+                v = _mm512_add_epi64(v, _mm512_maskz_permutexvar_epi64(0xF0, v_prev4, v));
+                v = _mm512_add_epi64(v, v_run);
+            }
+            _mm512_storeu_si512((void*)(dst + 8 * i), v);
+            v_run = _mm512_permutexvar_epi64(v_last, v);
+        }
+        running_val = (uint64_t)_mm_cvtsi128_si64(_mm512_castsi512_si128(v_run));
+#elif defined(ZXC_USE_AVX2)
+        const __m256i v_shuf_lo = _mm256_load_si256((const __m256i*)shuf);
+        const __m256i v_shuf_hi = _mm256_load_si256((const __m256i*)(shuf + 32));
+        const __m256i v_shift_lo = _mm256_load_si256((const __m256i*)shift);
+        const __m256i v_shift_hi = _mm256_load_si256((const __m256i*)(shift + 4));
+        const __m256i v_mask = _mm256_set1_epi64x((long long)mask);
+        const __m256i v_one = _mm256_set1_epi64x(1);
+        const __m256i v_zero = _mm256_setzero_si256();
+        const __m128i v_flt_shift = _mm_cvtsi32_si128((int)xor_shift);
+        __m256i v_run = _mm256_set1_epi64x((long long)running_val);
+        for (; i + 8 <= n && (i * bits) / ZXC_BITS_PER_BYTE + goff[3] + 16 <= src_avail; i += 8) {
+            const uint8_t* in = src + (i * bits) / ZXC_BITS_PER_BYTE;
+            __m256i v[2];
+            v[0] = _mm256_inserti128_si256(
+                _mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)in)),
+                _mm_loadu_si128((const __m128i*)(in + goff[1])), 1);
+            v[1] = _mm256_inserti128_si256(
+                _mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)(in + goff[2]))),
+                _mm_loadu_si128((const __m128i*)(in + goff[3])), 1);
+            v[0] = _mm256_srlv_epi64(_mm256_shuffle_epi8(v[0], v_shuf_lo), v_shift_lo);
+            v[1] = _mm256_srlv_epi64(_mm256_shuffle_epi8(v[1], v_shuf_hi), v_shift_hi);
+            for (int h = 0; h < 2; h++) {
+                __m256i x = _mm256_and_si256(v[h], v_mask);
+                if (flt) {
+                    // Prefix XOR: XOR lane j - 1, then lane j - 2 (zero below lane 0)
+                    x = _mm256_sll_epi64(x, v_flt_shift);
+                    x = _mm256_xor_si256(
+                        x, _mm256_blend_epi32(_mm256_permute4x64_epi64(x, 0x90), v_zero, 0x03));
+                    x = _mm256_xor_si256(
+                        x, _mm256_blend_epi32(_mm256_permute4x64_epi64(x, 0x40), v_zero, 0x0F));
+                    x = _mm256_xor_si256(x, v_run);
+                } else {
+                    // Zigzag: (x >> 1) ^ -(x & 1)
+                    x = _mm256_xor_si256(_mm256_srli_epi64(x, 1),
+                                         _mm256_sub_epi64(v_zero, _mm256_and_si256(x, v_one)));
+                    // Prefix sum: add lane j - 1, then lane j - 2 (zero below lane 0)
+                    x = _mm256_add_epi64(
+                        x, _mm256_blend_epi32(_mm256_permute4x64_epi64(x, 0x90), v_zero, 0x03));
+                    x = _mm256_add_epi64(
+                        x, _mm256_blend_epi32(_mm256_permute4x64_epi64(x, 0x40), v_zero, 0x0F));
+                    x = _mm256_add_epi64(x, v_run);
+                }
+                _mm256_storeu_si256((__m256i*)(dst + 8 * i + 32 * h), x);
+                v_run = _mm256_permute4x64_epi64(x, 0xFF);
+            }
+        }
+        running_val = (uint64_t)_mm_cvtsi128_si64(_mm256_castsi256_si128(v_run));
+#else
+        const uint64x2_t v_mask = vdupq_n_u64(mask);
+        const uint64x2_t v_one = vdupq_n_u64(1);
+        const uint64x2_t v_zero = vdupq_n_u64(0);
+        const int64x2_t v_flt_shift = vdupq_n_s64((int64_t)xor_shift);
+        uint64x2_t v_run = vdupq_n_u64(running_val);
+        for (; i + 8 <= n && (i * bits) / ZXC_BITS_PER_BYTE + goff[3] + 16 <= src_avail; i += 8) {
+            const uint8_t* in = src + (i * bits) / ZXC_BITS_PER_BYTE;
+            for (unsigned g = 0; g < 4; g++) {
+                uint64x2_t x = vreinterpretq_u64_u8(
+                    vqtbl1q_u8(vld1q_u8(in + goff[g]), vld1q_u8(shuf + 16 * g)));
+                const int64x2_t sh = vnegq_s64(vreinterpretq_s64_u64(vld1q_u64(shift + 2 * g)));
+                x = vandq_u64(vshlq_u64(x, sh), v_mask);
+                if (flt) {
+                    x = vshlq_u64(x, v_flt_shift);
+                    x = veorq_u64(x, vextq_u64(v_zero, x, 1));
+                    x = veorq_u64(x, v_run);
+                } else {
+                    // Zigzag: (x >> 1) ^ -(x & 1)
+                    x = veorq_u64(vshrq_n_u64(x, 1), vsubq_u64(v_zero, vandq_u64(x, v_one)));
+                    x = vaddq_u64(x, vextq_u64(v_zero, x, 1));
+                    x = vaddq_u64(x, v_run);
+                }
+                vst1q_u64((uint64_t*)(dst + 8 * i + 16 * g), x);
+                v_run = vdupq_laneq_u64(x, 1);
+            }
+        }
+        running_val = vgetq_lane_u64(v_run, 0);
+#endif
+    }
+#else
+    (void)src_avail;
 #endif
 
+    for (; i < n; i++) {
+        const size_t pos = i * bits;
+        const size_t b = pos / ZXC_BITS_PER_BYTE;
+        const unsigned s = pos % ZXC_BITS_PER_BYTE;
+        uint64_t v = 0;
+        if (LIKELY(b + sizeof(uint64_t) <= src_size)) {
+            v = zxc_le64(src + b);
+        } else {
+            for (size_t k = 0; b + k < src_size && k < sizeof(uint64_t); k++)
+                v |= (uint64_t)src[b + k] << (8 * k);
+        }
+        v >>= s;
+        // A value of more than 64 - s bits continues into a ninth byte
+        if (s + bits > 64) v |= (uint64_t)src[b + 8] << (64 - s);
+        if (flt)
+            running_val ^= (v & mask) << xor_shift;
+        else
+            running_val += zxc_zigzag_decode64(v & mask);
+        zxc_store_le64(dst + 8 * i, running_val);
+    }
+    *running = running_val;
+    return 0;
+}
+
 /**
  * @brief Decodes a block of numerical data compressed with the ZXC format.
  *
@@ -317,15 +781,17 @@ static ZXC_ALWAYS_INLINE __m512i zxc_mm512_prefix_sum_epi32(__m512i v) {
  *
  * **Algorithm Details:**
  * 1. **Header Parsing:** Reads the `zxc_num_header_t` to get the count of
- * values.
- * 2. **Bit Unpacking:** For each chunk of values, it initializes a bit reader.
- *    - **Unrolling:** The main loop is unrolled 4x to minimize branch overhead
- *      and maximize instruction throughput.
+ * values and their width (16, 32 or 64 bits).
+ * 2. **Bit Unpacking:** Each frame is unpacked by zxc_num_decode_frame() or
+ * zxc_num_decode_frame64(), several values per SIMD step.
  * 3. **ZigZag Decoding:** Converts the unsigned unpacked value back to a signed
  * delta using `(n >> 1) ^ -(n & 1)`.
  * 4. **Delta Reconstruction:** Adds the signed delta to a `running_val`
  * accumulator to recover the original integer sequence.
  *
+ * FLT blocks (`flt`) hold 32- or 64-bit XOR residuals instead, shifted right
+ * by the count of trailing zeros stored in byte 4 of each frame header.
+ *
  * @param[in] src Pointer to the source buffer containing compressed data.
  * @param[in] src_size Size of the source buffer in bytes.
  * @param[out] dst Pointer to the destination buffer where decompressed data will be
@@ -333,13 +799,14 @@ static ZXC_ALWAYS_INLINE __m512i zxc_mm512_prefix_sum_epi32(__m512i v) {
  * @param[in] dst_capacity Maximum capacity of the destination buffer in bytes.
  * @param[in] expected_raw_size Expected size of the uncompressed data (unused in
  * current implementation).
+ * @param[in] flt Decodes a FLT block.
  *
  * @return The number of bytes written to the destination buffer on success,
  *         or -1 if an error occurs (e.g., buffer overflow, invalid header,
  *         or malformed compressed stream).
  */
 static int zxc_decode_block_num(const uint8_t* RESTRICT src, size_t src_size, uint8_t* RESTRICT dst,
-                                size_t dst_capacity, uint32_t expected_raw_size) {
+                                size_t dst_capacity, uint32_t expected_raw_size, int flt) {
     (void)expected_raw_size;
 
     zxc_num_header_t nh;
@@ -350,118 +817,220 @@ static int zxc_decode_block_num(const uint8_t* RESTRICT src, size_t src_size, ui
     uint8_t* d_ptr = dst;
     const uint8_t* const d_end = dst + dst_capacity;
     uint64_t vals_remaining = nh.n_values;
+    const size_t width = nh.width;
     uint32_t running_val = 0;
+    uint64_t running_val64 = 0;
 
-    ZXC_ALIGN(ZXC_CACHE_LINE_SIZE)
-    uint32_t deltas[ZXC_DEC_BATCH];
+    if (UNLIKELY((width != 2 || flt) && width != 4 && width != 8)) return -1;
 
     while (vals_remaining > 0) {
         if (UNLIKELY(p + 16 > p_end)) return -1;
         uint16_t nvals = zxc_le16(p + 0);
         uint16_t bits = zxc_le16(p + 2);
         uint32_t psize = zxc_le32(p + 12);
+        const unsigned shift = flt ? p[4] : 0;
         p += 16;
-        if (UNLIKELY(p + psize > p_end || d_ptr + nvals * 4 > d_end ||
-                     bits > (sizeof(uint32_t) * ZXC_BITS_PER_BYTE)))
+        if (UNLIKELY(p + psize > p_end || nvals > vals_remaining ||
+                     (size_t)(d_end - d_ptr) < (size_t)nvals * width ||
+                     bits + shift > width * ZXC_BITS_PER_BYTE ||
+                     shift >= width * ZXC_BITS_PER_BYTE))
             return -1;
 
-        zxc_bit_reader_t br;
-        zxc_br_init(&br, p, psize);
-        size_t i = 0;
-
-        for (; i + ZXC_DEC_BATCH <= nvals; i += ZXC_DEC_BATCH) {
-            for (int k = 0; k < ZXC_DEC_BATCH; k += 4) {
-                zxc_br_ensure(&br, bits);
-                deltas[k + 0] = zxc_zigzag_decode(zxc_br_consume_fast(&br, (uint8_t)bits));
-                zxc_br_ensure(&br, bits);
-                deltas[k + 1] = zxc_zigzag_decode(zxc_br_consume_fast(&br, (uint8_t)bits));
-                zxc_br_ensure(&br, bits);
-                deltas[k + 2] = zxc_zigzag_decode(zxc_br_consume_fast(&br, (uint8_t)bits));
-                zxc_br_ensure(&br, bits);
-                deltas[k + 3] = zxc_zigzag_decode(zxc_br_consume_fast(&br, (uint8_t)bits));
-            }
-
-            uint32_t* batch_dst = (uint32_t*)d_ptr;
-
-#if defined(ZXC_USE_AVX512)
-            for (int k = 0; k < ZXC_DEC_BATCH; k += 16) {
-                __m512i v_deltas = _mm512_load_si512((void*)&deltas[k]);  // Load 16 deltas
-                __m512i v_run = _mm512_set1_epi32(running_val);  // Broadcast current running total
-
-                __m512i v_sum = zxc_mm512_prefix_sum_epi32(v_deltas);  // Compute local prefix sums
-                v_sum = _mm512_add_epi32(v_sum, v_run);                // Add base running total
-
-                _mm512_storeu_si512((void*)&batch_dst[k],
-                                    v_sum);  // Store decoded values
-
-                // Extract the last value (15th element) to update running_val for next
-                // batch
-                __m128i v_last128 = _mm512_extracti32x4_epi32(v_sum, 3);
-                running_val = (uint32_t)_mm_cvtsi128_si32(_mm_shuffle_epi32(v_last128, 0xFF));
-            }
-
-#elif defined(ZXC_USE_AVX2)
-            for (int k = 0; k < ZXC_DEC_BATCH; k += 8) {
-                __m256i v_deltas = _mm256_load_si256((const __m256i*)&deltas[k]);  // Load 8 deltas
-                __m256i v_run = _mm256_set1_epi32(running_val);  // Broadcast running total
-
-                __m256i v_sum = zxc_mm256_prefix_sum_epi32(v_deltas);  // Compute local prefix sums
-                v_sum = _mm256_add_epi32(v_sum, v_run);                // Add base
-
-                _mm256_storeu_si256((__m256i*)&batch_dst[k],
-                                    v_sum);                   // Store decoded values
-                running_val = ((uint32_t*)&batch_dst[k])[7];  // Update running_val
-            }
+        const size_t avail = (size_t)(p_end - p);
+        int res;
+        if (flt && width == 4)
+            res = zxc_num_decode_frame(p, psize, avail, d_ptr, nvals, bits, &running_val, 4, 1,
+                                       shift);
+        else if (flt)
+            res = zxc_num_decode_frame64(p, psize, avail, d_ptr, nvals, bits, &running_val64, 1,
+                                         shift);
+        else if (width == 2)
+            res = zxc_num_decode_frame(p, psize, avail, d_ptr, nvals, bits, &running_val, 2, 0, 0);
+        else if (width == 4)
+            res = zxc_num_decode_frame(p, psize, avail, d_ptr, nvals, bits, &running_val, 4, 0, 0);
+        else
+            res = zxc_num_decode_frame64(p, psize, avail, d_ptr, nvals, bits, &running_val64, 0,
+                                         0);
+        if (UNLIKELY(res != 0)) return -1;
+        d_ptr += (size_t)nvals * width;
 
-#elif defined(ZXC_USE_NEON64)
-            uint32x4_t v_run = vdupq_n_u32(running_val);  // Broadcast running total
-            for (int k = 0; k < ZXC_DEC_BATCH; k += 4) {
-                uint32x4_t v_deltas = vld1q_u32(&deltas[k]);  // Load 4 deltas
-
-                uint32x4_t v_sum = zxc_neon_prefix_sum_u32(v_deltas);  // Compute local prefix sums
-                v_sum = vaddq_u32(v_sum, v_run);                       // Add base
-
-                vst1q_u32(&batch_dst[k], v_sum);  // Store decoded values
-
-                running_val = vgetq_lane_u32(v_sum, 3);  // Extract last element
-                v_run = vdupq_n_u32(running_val);        // Update vector for next iter
-            }
+        p += psize;
+        vals_remaining -= nvals;
+    }
+    return (int)(d_ptr - dst);
+}
 
-#elif defined(ZXC_USE_NEON32)
-            uint32x4_t v_run = vdupq_n_u32(running_val);
-            for (int k = 0; k < ZXC_DEC_BATCH; k += 4) {
-                uint32x4_t v_deltas = vld1q_u32(&deltas[k]);
+/**
+ * @brief Unpacks bit-packed GLO offsets (ZXC_SECTION_ENCODING_BITPACK) into
+ * 16-bit little-endian offsets.
+ *
+ * Eight offsets of `bits` bits start on a byte boundary and span at most 15
+ * bytes, so the SIMD paths spread one 16-byte load over eight 32-bit lanes
+ * (three bytes each), shift every lane by its bit position and narrow to 16
+ * bits. The scalar loop finishes the last values without reading past `src`.
+ *
+ * @param[in] src Packed offsets.
+ * @param[in] src_size Size of the packed section.
+ * @param[out] dst Destination of the `n` 16-bit offsets.
+ * @param[in] n Number of offsets.
+ * @param[in] bits Width of each offset (1-15).
+ * @return 0 on success, or -1 if the section is too short.
+ */
+static int zxc_unpack_offsets(const uint8_t* RESTRICT src, size_t src_size, uint8_t* RESTRICT dst,
+                              size_t n, unsigned bits) {
+    if (UNLIKELY((n * bits + ZXC_BITS_PER_BYTE - 1) / ZXC_BITS_PER_BYTE > src_size)) return -1;
+    const uint32_t mask = (1U << bits) - 1;
+    size_t i = 0;
+
+#if defined(ZXC_USE_AVX2) || defined(ZXC_USE_AVX512) || defined(ZXC_USE_NEON64)
+    // Lane j gathers the 3 bytes holding value j, shifted right by its bit offset
+    ZXC_ALIGN(32) uint8_t shuf[32];
+    ZXC_ALIGN(32) int32_t shift[8];
+    for (unsigned j = 0; j < 8; j++) {
+        const unsigned first = j * bits;
+        for (unsigned k = 0; k < 4; k++)
+            shuf[(j & 3) * 4 + k + (j >> 2) * 16] =
+                k < 3 ? (uint8_t)(first / ZXC_BITS_PER_BYTE + k) : 0xFF;
+        shift[j] = (int32_t)(first % ZXC_BITS_PER_BYTE);
+    }
+#if defined(ZXC_USE_AVX2) || defined(ZXC_USE_AVX512)
+    const __m256i v_shuf = _mm256_load_si256((const __m256i*)shuf);
+    const __m256i v_shift = _mm256_load_si256((const __m256i*)shift);
+    const __m256i v_mask = _mm256_set1_epi32((int)mask);
+    for (; i + 8 <= n && (i * bits) / ZXC_BITS_PER_BYTE + 16 <= src_size; i += 8) {
+        __m128i in = _mm_loadu_si128((const __m128i*)(src + (i * bits) / ZXC_BITS_PER_BYTE));
+        __m256i v = _mm256_shuffle_epi8(_mm256_broadcastsi128_si256(in), v_shuf);
+        v = _mm256_and_si256(_mm256_srlv_epi32(v, v_shift), v_mask);
+        v = _mm256_permute4x64_epi64(_mm256_packus_epi32(v, v), 0x08);
+        _mm_storeu_si128((__m128i*)(dst + 2 * i), _mm256_castsi256_si128(v));
+    }
+#else
+    const uint8x16_t v_shuf_lo = vld1q_u8(shuf);
+    const uint8x16_t v_shuf_hi = vld1q_u8(shuf + 16);
+    const int32x4_t v_shift_lo = vnegq_s32(vld1q_s32(shift));
+    const int32x4_t v_shift_hi = vnegq_s32(vld1q_s32(shift + 4));
+    const uint32x4_t v_mask = vdupq_n_u32(mask);
+    for (; i + 8 <= n && (i * bits) / ZXC_BITS_PER_BYTE + 16 <= src_size; i += 8) {
+        uint8x16_t in = vld1q_u8(src + (i * bits) / ZXC_BITS_PER_BYTE);
+        uint32x4_t lo = vreinterpretq_u32_u8(vqtbl1q_u8(in, v_shuf_lo));
+        uint32x4_t hi = vreinterpretq_u32_u8(vqtbl1q_u8(in, v_shuf_hi));
+        lo = vandq_u32(vshlq_u32(lo, v_shift_lo), v_mask);
+        hi = vandq_u32(vshlq_u32(hi, v_shift_hi), v_mask);
+        vst1q_u8(dst + 2 * i, vreinterpretq_u8_u16(vcombine_u16(vmovn_u32(lo), vmovn_u32(hi))));
+    }
+#endif
+#endif
 
-                uint32x4_t v_sum = zxc_neon_prefix_sum_u32(v_deltas);
-                v_sum = vaddq_u32(v_sum, v_run);
+    for (; i < n; i++) {
+        const size_t pos = i * bits;
+        const size_t b = pos / ZXC_BITS_PER_BYTE;
+        uint32_t v = 0;
+        if (LIKELY(b + sizeof(uint32_t) <= src_size)) {
+            v = zxc_le32(src + b);
+        } else {
+            for (size_t k = 0; b + k < src_size; k++) v |= (uint32_t)src[b + k] << (8 * k);
+        }
+        zxc_store_le16(dst + 2 * i, (uint16_t)((v >> (pos % ZXC_BITS_PER_BYTE)) & mask));
+    }
+    return 0;
+}
 
-                vst1q_u32(&batch_dst[k], v_sum);
+/**
+ * @brief Decodes one Huffman symbol from a bit stream.
+ *
+ * The reader must hold at least ZXC_HUF_MAX_BITS bits for the symbol to be
+ * valid; over-consumption shows as a negative bit count.
+ *
+ * @param[in,out] br Bit reader of the stream.
+ * @param[in] table Decode table: symbol in the low byte, code length above.
+ * @return The decoded byte.
+ */
+static ZXC_ALWAYS_INLINE uint8_t zxc_huf_decode_sym(zxc_bit_reader_t* br,
+                                                    const uint16_t* RESTRICT table) {
+    const uint32_t e = table[br->accum & (ZXC_HUF_TABLE_SIZE - 1)];
+    br->accum >>= e >> 8;
+    br->bits -= (int)(e >> 8);
+    return (uint8_t)e;
+}
 
-                running_val = vgetq_lane_u32(v_sum, 3);
-                v_run = vdupq_n_u32(running_val);
-            }
+/**
+ * @brief Decodes a Huffman-coded literal section (ZXC_SECTION_ENCODING_HUFFMAN).
+ *
+ * Builds the single-level decode table from the code lengths, then decodes the
+ * four streams in lockstep, five symbols per refill, so that the four lookups
+ * of a round are independent.
+ *
+ * @param[in] src Literal section.
+ * @param[in] src_size Size of the section.
+ * @param[out] dst Destination of the `n` literals.
+ * @param[in] n Number of literals.
+ * @return 0 on success, or -1 if the section is malformed.
+ */
+static int zxc_huf_decode(const uint8_t* RESTRICT src, size_t src_size, uint8_t* RESTRICT dst,
+                          size_t n) {
+    const size_t quarter = (n + ZXC_HUF_STREAMS - 1) / ZXC_HUF_STREAMS;
+    if (UNLIKELY(src_size < ZXC_HUF_HEADER_SIZE || (ZXC_HUF_STREAMS - 1) * quarter > n))
+        return -1;
+
+    uint8_t lens[256];
+    uint16_t codes[256];
+    for (int s = 0; s < 256; s += 2) {
+        lens[s] = src[s >> 1] & 0x0F;
+        lens[s + 1] = src[s >> 1] >> 4;
+    }
+    if (UNLIKELY(zxc_huf_build_codes(lens, codes) != 0)) return -1;
+
+    // Every entry whose low bits are a symbol's code decodes to it; holes left
+    // by an incomplete code decode to a zero-length symbol 0
+    uint16_t table[ZXC_HUF_TABLE_SIZE];
+    ZXC_MEMSET(table, 0, sizeof(table));
+    for (int s = 0; s < 256; s++) {
+        if (!lens[s]) continue;
+        const uint16_t e = (uint16_t)(s | (lens[s] << 8));
+        for (uint32_t c = codes[s]; c < ZXC_HUF_TABLE_SIZE; c += 1U << lens[s]) table[c] = e;
+    }
 
-#else
-            for (int k = 0; k < ZXC_DEC_BATCH; k++) {
-                running_val += deltas[k];
-                batch_dst[k] = running_val;
-            }
-#endif
-            d_ptr += ZXC_DEC_BATCH * 4;
+    zxc_bit_reader_t br[ZXC_HUF_STREAMS];
+    const uint8_t* ip = src + ZXC_HUF_HEADER_SIZE;
+    size_t left = src_size - ZXC_HUF_HEADER_SIZE;
+    for (int k = 0; k < ZXC_HUF_STREAMS - 1; k++) {
+        size_t sz = zxc_le32(src + 128 + 4 * k);
+        if (UNLIKELY(sz > left)) return -1;
+        zxc_br_init(&br[k], ip, sz);
+        ip += sz;
+        left -= sz;
+    }
+    zxc_br_init(&br[ZXC_HUF_STREAMS - 1], ip, left);
+
+    uint8_t* const o0 = dst;
+    uint8_t* const o1 = dst + quarter;
+    uint8_t* const o2 = dst + 2 * quarter;
+    uint8_t* const o3 = dst + 3 * quarter;
+    const size_t last = n - 3 * quarter;  // The last stream is the shortest
+
+    size_t i = 0;
+    for (; i + 5 <= last; i += 5) {
+        zxc_br_ensure(&br[0], 5 * ZXC_HUF_MAX_BITS);
+        zxc_br_ensure(&br[1], 5 * ZXC_HUF_MAX_BITS);
+        zxc_br_ensure(&br[2], 5 * ZXC_HUF_MAX_BITS);
+        zxc_br_ensure(&br[3], 5 * ZXC_HUF_MAX_BITS);
+        for (size_t j = i; j < i + 5; j++) {
+            o0[j] = zxc_huf_decode_sym(&br[0], table);
+            o1[j] = zxc_huf_decode_sym(&br[1], table);
+            o2[j] = zxc_huf_decode_sym(&br[2], table);
+            o3[j] = zxc_huf_decode_sym(&br[3], table);
         }
-
-        for (; i < nvals; i++) {
-            zxc_br_ensure(&br, bits);
-            uint32_t delta = zxc_zigzag_decode(zxc_br_consume_fast(&br, (uint8_t)bits));
-            running_val += delta;
-            zxc_store_le32(d_ptr, running_val);
-            d_ptr += 4;
+    }
+    for (int k = 0; k < ZXC_HUF_STREAMS; k++) {
+        uint8_t* const o = dst + (size_t)k * quarter;
+        const size_t count = k < ZXC_HUF_STREAMS - 1 ? quarter : last;
+        for (size_t j = i; j < count; j++) {
+            zxc_br_ensure(&br[k], ZXC_HUF_MAX_BITS);
+            o[j] = zxc_huf_decode_sym(&br[k], table);
         }
-
-        p += psize;
-        vals_remaining -= nvals;
+        if (UNLIKELY(br[k].bits < 0)) return -1;
     }
-    return (int)(d_ptr - dst);
+    return 0;
 }
 
 /**
@@ -501,24 +1070,31 @@ static int zxc_decode_block_glo(zxc_cctx_t* ctx, const uint8_t* RESTRICT src, si
 
     size_t lit_stream_size = (size_t)(desc[0].sizes & ZXC_SECTION_SIZE_MASK);
 
-    if (gh.enc_lit == 1) {
+    // Scratch: expanded literals (RLE / Huffman), then unpacked offsets (bit-packed)
+    const int lit_expanded =
+        gh.enc_lit == ZXC_SECTION_ENCODING_RLE || gh.enc_lit == ZXC_SECTION_ENCODING_HUFFMAN;
+    const size_t lit_scratch = lit_expanded ? (size_t)(desc[0].sizes >> 32) + ZXC_PAD_SIZE : 0;
+    const size_t off_scratch = gh.off_bits ? (size_t)gh.n_sequences * sizeof(uint16_t) : 0;
+    if (lit_scratch + off_scratch > 0) {
+        if (UNLIKELY(lit_scratch > dst_capacity + ZXC_PAD_SIZE || gh.n_sequences > src_size))
+            return -1;
+        if (ctx->lit_buffer_cap < lit_scratch + off_scratch) {
+            uint8_t* new_buf = (uint8_t*)realloc(ctx->lit_buffer, lit_scratch + off_scratch);
+            if (UNLIKELY(!new_buf)) {
+                free(ctx->lit_buffer);
+                ctx->lit_buffer = NULL;
+                ctx->lit_buffer_cap = 0;
+                return -1;
+            }
+            ctx->lit_buffer = new_buf;
+            ctx->lit_buffer_cap = lit_scratch + off_scratch;
+        }
+    }
+
+    if (lit_expanded) {
         size_t required_size = (size_t)(desc[0].sizes >> 32);
 
         if (required_size > 0) {
-            if (UNLIKELY(required_size > dst_capacity)) return -1;
-
-            if (ctx->lit_buffer_cap < required_size + ZXC_PAD_SIZE) {
-                uint8_t* new_buf = (uint8_t*)realloc(ctx->lit_buffer, required_size + ZXC_PAD_SIZE);
-                if (UNLIKELY(!new_buf)) {
-                    free(ctx->lit_buffer);
-                    ctx->lit_buffer = NULL;
-                    ctx->lit_buffer_cap = 0;
-                    return -1;
-                }
-                ctx->lit_buffer = new_buf;
-                ctx->lit_buffer_cap = required_size + ZXC_PAD_SIZE;
-            }
-
             rle_buf = ctx->lit_buffer;
             if (UNLIKELY(!rle_buf || lit_stream_size > (size_t)(src + src_size - p_curr)))
                 return -1;
@@ -528,6 +1104,11 @@ static int zxc_decode_block_glo(zxc_cctx_t* ctx, const uint8_t* RESTRICT src, si
             uint8_t* w_ptr = rle_buf;
             const uint8_t* const w_end = rle_buf + required_size;
 
+            if (gh.enc_lit == ZXC_SECTION_ENCODING_HUFFMAN) {
+                if (UNLIKELY(zxc_huf_decode(r_ptr, lit_stream_size, rle_buf, required_size) != 0))
+                    return -1;
+                w_ptr = rle_buf + required_size;
+            }
             while (r_ptr < r_end && w_ptr < w_end) {
                 uint8_t token = *r_ptr++;
                 if (LIKELY(!(token & ZXC_LIT_RLE_FLAG))) {
@@ -580,6 +1161,7 @@ static int zxc_decode_block_glo(zxc_cctx_t* ctx, const uint8_t* RESTRICT src, si
             l_end = p_curr;
         }
     } else {
+        if (UNLIKELY(gh.enc_lit != ZXC_SECTION_ENCODING_RAW)) return -1;
         l_ptr = p_curr;
         l_end = p_curr + lit_stream_size;
     }
@@ -592,8 +1174,15 @@ static int zxc_decode_block_glo(zxc_cctx_t* ctx, const uint8_t* RESTRICT src, si
     size_t sz_extras = (size_t)(desc[3].sizes & ZXC_SECTION_SIZE_MASK);
 
     // Validate stream sizes match sequence count (early rejection of malformed data)
+    if (UNLIKELY(gh.enc_off > ZXC_OFF_ENC_FAR ||
+                 (gh.off_bits && (gh.enc_off == ZXC_OFF_ENC_8 || gh.off_bits >= 16))))
+        return -1;
+    const int far_offsets = (gh.enc_off == ZXC_OFF_ENC_FAR);
     size_t expected_off_size =
-        (gh.enc_off == 1) ? (size_t)gh.n_sequences : (size_t)gh.n_sequences * 2;
+        gh.off_bits ? ((size_t)gh.n_sequences * gh.off_bits + ZXC_BITS_PER_BYTE - 1) /
+                          ZXC_BITS_PER_BYTE
+        : (gh.enc_off == 1) ? (size_t)gh.n_sequences
+                            : (size_t)gh.n_sequences * 2;
 
     if (UNLIKELY(sz_tokens < gh.n_sequences || sz_offsets < expected_off_size)) return -1;
 
@@ -605,6 +1194,15 @@ static int zxc_decode_block_glo(zxc_cctx_t* ctx, const uint8_t* RESTRICT src, si
     // Validate streams don't overflow source buffer
     if (UNLIKELY(e_end != src + src_size)) return -1;
 
+    // Bit-packed offsets are widened once; the loops below read them as 16-bit offsets
+    if (gh.off_bits) {
+        uint8_t* wide = ctx->lit_buffer + lit_scratch;
+        if (UNLIKELY(zxc_unpack_offsets(o_ptr, sz_offsets, wide, gh.n_sequences, gh.off_bits) !=
+                     0))
+            return -1;
+        o_ptr = wide;
+    }
+
     uint8_t* d_ptr = dst;
     const uint8_t* const d_end = dst + dst_capacity;
     const uint8_t* const d_end_safe = d_end - 128;
@@ -615,7 +1213,51 @@ static int zxc_decode_block_glo(zxc_cctx_t* ctx, const uint8_t* RESTRICT src, si
     // For 1-byte offsets (enc_off==1): validate until 256 bytes written (max 8-bit offset)
     // For 2-byte offsets (enc_off==0): validate until 65536 bytes written (max 16-bit offset)
     // After threshold, all offsets are guaranteed valid (can't exceed written bytes)
-    size_t written = 0;
+    // Far offsets (enc_off==2) are validated one by one as they are read
+    // A linked prefix (the previous block's tail before `dst`) counts as written
+    const size_t prefix = ctx->prefix_len;
+    size_t written = prefix;
+
+    // Repeat offsets: the history only ever holds offsets already validated (or
+    // the small initial ones, checked like any offset until the threshold)
+    const int rep_offsets = gh.rep_offsets;
+    uint32_t rep0 = ZXC_REP_INIT_0, rep1 = ZXC_REP_INIT_1, rep2 = ZXC_REP_INIT_2;
+
+// Far offset: a 0 in the offset stream is followed by the offset in the extras
+// stream (after the sequence's LL / ML extras). Must not reach before the prefix.
+#define DECODE_FAR_OFFSET(off, ll)                                               \
+    do {                                                                         \
+        if (UNLIKELY(off == 0)) {                                                \
+            if (UNLIKELY(!far_offsets)) return -1;                               \
+            off = zxc_read_vbyte(&e_ptr, e_end);                                 \
+            if (UNLIKELY(off == 0 || off > (size_t)(d_ptr - dst) + prefix + ll)) \
+                return -1;                                                       \
+        }                                                                        \
+    } while (0)
+
+// Offset code: with repeat offsets, codes 1-3 select rep0-rep2 (moved to the
+// front), other offsets are stored + ZXC_REP_NUM (or escaped) and pushed
+#define DECODE_OFFSET(off, ll)                             \
+    do {                                                   \
+        if (UNLIKELY(rep_offsets)) {                       \
+            if (off == 1) {                                \
+                off = rep0;                                \
+            } else if (off != 0 && off <= ZXC_REP_NUM) {   \
+                const uint32_t r = off == 2 ? rep1 : rep2; \
+                if (off == 3) rep2 = rep1;                 \
+                rep1 = rep0;                               \
+                off = rep0 = r;                            \
+            } else {                                       \
+                if (off != 0) off -= ZXC_REP_NUM;          \
+                DECODE_FAR_OFFSET(off, ll);                \
+                rep2 = rep1;                               \
+                rep1 = rep0;                               \
+                rep0 = off;                                \
+            }                                              \
+        } else {                                           \
+            DECODE_FAR_OFFSET(off, ll);                    \
+        }                                                  \
+    } while (0)
 
 // Macro for copy literal + match (uses 32-byte wild copies)
 // SAFE version: validates offset against written bytes
@@ -788,14 +1430,12 @@ static int zxc_decode_block_glo(zxc_cctx_t* ctx, const uint8_t* RESTRICT src, si
             off4 = (uint32_t)((offsets >> 48) & 0xFFFF);
         }
 
-        // Reject zero offsets
-        if (UNLIKELY((off1 == 0) | (off2 == 0) | (off3 == 0) | (off4 == 0))) return -1;
-
         uint32_t ll1 = (tokens & 0x0F0) >> 4;
         uint32_t ml1 = (tokens & 0x00F);
         if (UNLIKELY(ll1 == ZXC_TOKEN_LL_MASK)) ll1 += zxc_read_vbyte(&e_ptr, e_end);
         if (UNLIKELY(ml1 == ZXC_TOKEN_ML_MASK)) ml1 += zxc_read_vbyte(&e_ptr, e_end);
         ml1 += ZXC_LZ_MIN_MATCH_LEN;
+        DECODE_OFFSET(off1, ll1);
         if (UNLIKELY(d_ptr + ll1 + ml1 > d_end)) return -1;
         DECODE_SEQ_SAFE(ll1, ml1, off1);
 
@@ -804,6 +1444,7 @@ static int zxc_decode_block_glo(zxc_cctx_t* ctx, const uint8_t* RESTRICT src, si
         if (UNLIKELY(ll2 == ZXC_TOKEN_LL_MASK)) ll2 += zxc_read_vbyte(&e_ptr, e_end);
         if (UNLIKELY(ml2 == ZXC_TOKEN_ML_MASK)) ml2 += zxc_read_vbyte(&e_ptr, e_end);
         ml2 += ZXC_LZ_MIN_MATCH_LEN;
+        DECODE_OFFSET(off2, ll2);
         if (UNLIKELY(d_ptr + ll2 + ml2 > d_end)) return -1;
         DECODE_SEQ_SAFE(ll2, ml2, off2);
 
@@ -812,6 +1453,7 @@ static int zxc_decode_block_glo(zxc_cctx_t* ctx, const uint8_t* RESTRICT src, si
         if (UNLIKELY(ll3 == ZXC_TOKEN_LL_MASK)) ll3 += zxc_read_vbyte(&e_ptr, e_end);
         if (UNLIKELY(ml3 == ZXC_TOKEN_ML_MASK)) ml3 += zxc_read_vbyte(&e_ptr, e_end);
         ml3 += ZXC_LZ_MIN_MATCH_LEN;
+        DECODE_OFFSET(off3, ll3);
         if (UNLIKELY(d_ptr + ll3 + ml3 > d_end)) return -1;
         DECODE_SEQ_SAFE(ll3, ml3, off3);
 
@@ -820,6 +1462,7 @@ static int zxc_decode_block_glo(zxc_cctx_t* ctx, const uint8_t* RESTRICT src, si
         if (UNLIKELY(ll4 == ZXC_TOKEN_LL_MASK)) ll4 += zxc_read_vbyte(&e_ptr, e_end);
         if (UNLIKELY(ml4 == ZXC_TOKEN_ML_MASK)) ml4 += zxc_read_vbyte(&e_ptr, e_end);
         ml4 += ZXC_LZ_MIN_MATCH_LEN;
+        DECODE_OFFSET(off4, ll4);
         if (UNLIKELY(d_ptr + ll4 + ml4 > d_end)) return -1;
         DECODE_SEQ_SAFE(ll4, ml4, off4);
 
@@ -855,6 +1498,7 @@ static int zxc_decode_block_glo(zxc_cctx_t* ctx, const uint8_t* RESTRICT src, si
         if (UNLIKELY(ll1 == ZXC_TOKEN_LL_MASK)) ll1 += zxc_read_vbyte(&e_ptr, e_end);
         if (UNLIKELY(ml1 == ZXC_TOKEN_ML_MASK)) ml1 += zxc_read_vbyte(&e_ptr, e_end);
         ml1 += ZXC_LZ_MIN_MATCH_LEN;
+        DECODE_OFFSET(off1, ll1);
         if (UNLIKELY(d_ptr + ll1 + ml1 > d_end)) return -1;
         DECODE_SEQ_FAST(ll1, ml1, off1);
 
@@ -863,6 +1507,7 @@ static int zxc_decode_block_glo(zxc_cctx_t* ctx, const uint8_t* RESTRICT src, si
         if (UNLIKELY(ll2 == ZXC_TOKEN_LL_MASK)) ll2 += zxc_read_vbyte(&e_ptr, e_end);
         if (UNLIKELY(ml2 == ZXC_TOKEN_ML_MASK)) ml2 += zxc_read_vbyte(&e_ptr, e_end);
         ml2 += ZXC_LZ_MIN_MATCH_LEN;
+        DECODE_OFFSET(off2, ll2);
         if (UNLIKELY(d_ptr + ll2 + ml2 > d_end)) return -1;
         DECODE_SEQ_FAST(ll2, ml2, off2);
 
@@ -871,6 +1516,7 @@ static int zxc_decode_block_glo(zxc_cctx_t* ctx, const uint8_t* RESTRICT src, si
         if (UNLIKELY(ll3 == ZXC_TOKEN_LL_MASK)) ll3 += zxc_read_vbyte(&e_ptr, e_end);
         if (UNLIKELY(ml3 == ZXC_TOKEN_ML_MASK)) ml3 += zxc_read_vbyte(&e_ptr, e_end);
         ml3 += ZXC_LZ_MIN_MATCH_LEN;
+        DECODE_OFFSET(off3, ll3);
         if (UNLIKELY(d_ptr + ll3 + ml3 > d_end)) return -1;
         DECODE_SEQ_FAST(ll3, ml3, off3);
 
@@ -879,6 +1525,7 @@ static int zxc_decode_block_glo(zxc_cctx_t* ctx, const uint8_t* RESTRICT src, si
         if (UNLIKELY(ll4 == ZXC_TOKEN_LL_MASK)) ll4 += zxc_read_vbyte(&e_ptr, e_end);
         if (UNLIKELY(ml4 == ZXC_TOKEN_ML_MASK)) ml4 += zxc_read_vbyte(&e_ptr, e_end);
         ml4 += ZXC_LZ_MIN_MATCH_LEN;
+        DECODE_OFFSET(off4, ll4);
         if (UNLIKELY(d_ptr + ll4 + ml4 > d_end)) return -1;
         DECODE_SEQ_FAST(ll4, ml4, off4);
 
@@ -912,6 +1559,7 @@ static int zxc_decode_block_glo(zxc_cctx_t* ctx, const uint8_t* RESTRICT src, si
         if (UNLIKELY(ll == ZXC_TOKEN_LL_MASK)) ll += zxc_read_vbyte(&e_ptr, e_end);
         if (UNLIKELY(ml == ZXC_TOKEN_ML_MASK)) ml += zxc_read_vbyte(&e_ptr, e_end);
         ml += ZXC_LZ_MIN_MATCH_LEN;
+        DECODE_OFFSET(offset, ll);
 
         // Check bounds before wild copies - if too close to end, fall back to Safe Path
         if (UNLIKELY(d_ptr + ll + ml + ZXC_PAD_SIZE > d_end)) {
@@ -994,6 +1642,7 @@ static int zxc_decode_block_glo(zxc_cctx_t* ctx, const uint8_t* RESTRICT src, si
         if (UNLIKELY(ll == ZXC_TOKEN_LL_MASK)) ll += zxc_read_vbyte(&e_ptr, e_end);
         if (UNLIKELY(ml == ZXC_TOKEN_ML_MASK)) ml += zxc_read_vbyte(&e_ptr, e_end);
         ml += ZXC_LZ_MIN_MATCH_LEN;
+        DECODE_OFFSET(offset, ll);
 
         if (UNLIKELY(d_ptr + ll > d_end)) return -1;
         ZXC_MEMCPY(d_ptr, l_ptr, ll);
@@ -1001,7 +1650,7 @@ static int zxc_decode_block_glo(zxc_cctx_t* ctx, const uint8_t* RESTRICT src, si
         d_ptr += ll;
 
         const uint8_t* match_src = d_ptr - offset;
-        if (UNLIKELY(match_src < dst || d_ptr + ml > d_end)) return -1;
+        if (UNLIKELY(offset > (size_t)(d_ptr - dst) + prefix || d_ptr + ml > d_end)) return -1;
 
         if (offset < ml) {
             for (size_t i = 0; i < ml; i++) d_ptr[i] = match_src[i];
@@ -1012,6 +1661,9 @@ static int zxc_decode_block_glo(zxc_cctx_t* ctx, const uint8_t* RESTRICT src, si
         n_seq--;
     }
 
+#undef DECODE_OFFSET
+#undef DECODE_FAR_OFFSET
+
     // --- Trailing Literals ---
     size_t generated = d_ptr - dst;
     if (generated < expected_raw_size) {
@@ -1044,7 +1696,6 @@ static int zxc_decode_block_glo(zxc_cctx_t* ctx, const uint8_t* RESTRICT src, si
 static int zxc_decode_block_ghi(zxc_cctx_t* ctx, const uint8_t* RESTRICT src, size_t src_size,
                                 uint8_t* RESTRICT dst, size_t dst_capacity,
                                 uint32_t expected_raw_size) {
-    (void)ctx;
     zxc_gnr_header_t gh;
     zxc_section_desc_t desc[ZXC_GHI_SECTIONS];
 
@@ -1082,7 +1733,9 @@ static int zxc_decode_block_ghi(zxc_cctx_t* ctx, const uint8_t* RESTRICT src, si
     // For 1-byte offsets (enc_off==1): validate until 256 bytes written (max 8-bit offset)
     // For 2-byte offsets (enc_off==0): validate until 65536 bytes written (max 16-bit offset)
     // After threshold, all offsets are guaranteed valid (can't exceed written bytes)
-    size_t written = 0;
+    // A linked prefix (the previous block's tail before `dst`) counts as written
+    const size_t prefix = ctx->prefix_len;
+    size_t written = prefix;
 
 // Macro for copy literal + match (uses 32-byte wild copies)
 // SAFE version: validates offset against written bytes
@@ -1257,7 +1910,8 @@ static int zxc_decode_block_ghi(zxc_cctx_t* ctx, const uint8_t* RESTRICT src, si
 
             if (UNLIKELY(offset == 0 || offset > written)) return -1;
             const uint8_t* match_src = d_ptr - offset;
-            if (UNLIKELY(match_src < dst || d_ptr + ml > d_end)) return -1;  // Bounds check
+            if (UNLIKELY(offset > (size_t)(d_ptr - dst) + prefix || d_ptr + ml > d_end))
+                return -1;  // Bounds check
 
             if (offset < ml) {
                 for (size_t i = 0; i < ml; i++) d_ptr[i] = match_src[i];
@@ -1448,7 +2102,8 @@ static int zxc_decode_block_ghi(zxc_cctx_t* ctx, const uint8_t* RESTRICT src, si
         d_ptr += ll;
 
         const uint8_t* match_src = d_ptr - offset;
-        if (UNLIKELY(offset == 0 || match_src < dst || d_ptr + ml > d_end)) return -1;
+        if (UNLIKELY(offset == 0 || offset > (size_t)(d_ptr - dst) + prefix || d_ptr + ml > d_end))
+            return -1;
 
         if (offset < ml) {
             for (size_t i = 0; i < ml; i++) d_ptr[i] = match_src[i];
@@ -1474,6 +2129,206 @@ static int zxc_decode_block_ghi(zxc_cctx_t* ctx, const uint8_t* RESTRICT src, si
     return (int)(d_ptr - dst);
 }
 
+/**
+ * @brief Transposes byte planes back into records (inverse of the encoder's
+ * zxc_shuffle_bytes()): `dst[r * stride + k] = src[k * n_rec + r]`.
+ *
+ * The SIMD paths take 16 records at a time: one 16-byte load per plane (the
+ * missing planes up to 16 are zero), a 16x16 byte transpose in four unpack
+ * stages, then one 16-byte store per record, each overwriting the spill of the
+ * previous one. The last records, whose spill would cross the end of the
+ * records, and the bytes past them take the scalar loop.
+ *
+ * @param[in] src Byte planes.
+ * @param[in] size Size of `src` and `dst`.
+ * @param[in] stride Record size (ZXC_SHUFFLE_MIN_STRIDE to ZXC_SHUFFLE_MAX_STRIDE).
+ * @param[out] dst Records.
+ */
+static void zxc_unshuffle_bytes(const uint8_t* RESTRICT src, size_t size, size_t stride,
+                                uint8_t* RESTRICT dst) {
+    const size_t n_rec = size / stride;
+    size_t r = 0;
+
+#if defined(ZXC_USE_AVX2) || defined(ZXC_USE_AVX512)
+    // Record r0 + 15 is stored 16 bytes wide: stay within the records
+    for (; r + 16 <= n_rec && (r + 15) * stride + 16 <= n_rec * stride; r += 16) {
+        __m128i a[16], b[16];
+        for (size_t k = 0; k < 16; k++)
+            a[k] = k < stride ? _mm_loadu_si128((const __m128i*)(src + k * n_rec + r))
+                              : _mm_setzero_si128();
+        // Rows (planes) 2i, 2i + 1 interleaved: 16-bit units hold one column (record)
+        for (int i = 0; i < 8; i++) {
+            b[2 * i] = _mm_unpacklo_epi8(a[2 * i], a[2 * i + 1]);
+            b[2 * i + 1] = _mm_unpackhi_epi8(a[2 * i], a[2 * i + 1]);
+        }
+        // Rows 4j .. 4j + 3: 32-bit units, columns 0-3, 4-7, 8-11, 12-15
+        for (int j = 0; j < 4; j++) {
+            a[4 * j] = _mm_unpacklo_epi16(b[4 * j], b[4 * j + 2]);
+            a[4 * j + 1] = _mm_unpackhi_epi16(b[4 * j], b[4 * j + 2]);
+            a[4 * j + 2] = _mm_unpacklo_epi16(b[4 * j + 1], b[4 * j + 3]);
+            a[4 * j + 3] = _mm_unpackhi_epi16(b[4 * j + 1], b[4 * j + 3]);
+        }
+        // Rows 8m .. 8m + 7: 64-bit units, columns 2t, 2t + 1
+        for (int m = 0; m < 2; m++) {
+            for (int t = 0; t < 4; t++) {
+                b[8 * m + 2 * t] = _mm_unpacklo_epi32(a[8 * m + t], a[8 * m + 4 + t]);
+                b[8 * m + 2 * t + 1] = _mm_unpackhi_epi32(a[8 * m + t], a[8 * m + 4 + t]);
+            }
+        }
+        // Rows 0 .. 15 of columns 2u and 2u + 1: whole records
+        for (int u = 0; u < 8; u++) {
+            _mm_storeu_si128((__m128i*)(dst + (r + 2 * u) * stride),
+                             _mm_unpacklo_epi64(b[u], b[8 + u]));
+            _mm_storeu_si128((__m128i*)(dst + (r + 2 * u + 1) * stride),
+                             _mm_unpackhi_epi64(b[u], b[8 + u]));
+        }
+    }
+#elif defined(ZXC_USE_NEON64)
+    for (; r + 16 <= n_rec && (r + 15) * stride + 16 <= n_rec * stride; r += 16) {
+        uint8x16_t a[16], b[16];
+        for (size_t k = 0; k < 16; k++)
+            a[k] = k < stride ? vld1q_u8(src + k * n_rec + r) : vdupq_n_u8(0);
+        for (int i = 0; i < 8; i++) {
+            b[2 * i] = vzip1q_u8(a[2 * i], a[2 * i + 1]);
+            b[2 * i + 1] = vzip2q_u8(a[2 * i], a[2 * i + 1]);
+        }
+        for (int j = 0; j < 4; j++) {
+            for (int h = 0; h < 2; h++) {
+                const uint16x8_t x = vreinterpretq_u16_u8(b[4 * j + h]);
+                const uint16x8_t y = vreinterpretq_u16_u8(b[4 * j + h + 2]);
+                a[4 * j + 2 * h] = vreinterpretq_u8_u16(vzip1q_u16(x, y));
+                a[4 * j + 2 * h + 1] = vreinterpretq_u8_u16(vzip2q_u16(x, y));
+            }
+        }
+        for (int m = 0; m < 2; m++) {
+            for (int t = 0; t < 4; t++) {
+                const uint32x4_t x = vreinterpretq_u32_u8(a[8 * m + t]);
+                const uint32x4_t y = vreinterpretq_u32_u8(a[8 * m + 4 + t]);
+                b[8 * m + 2 * t] = vreinterpretq_u8_u32(vzip1q_u32(x, y));
+                b[8 * m + 2 * t + 1] = vreinterpretq_u8_u32(vzip2q_u32(x, y));
+            }
+        }
+        for (int u = 0; u < 8; u++) {
+            const uint64x2_t x = vreinterpretq_u64_u8(b[u]);
+            const uint64x2_t y = vreinterpretq_u64_u8(b[8 + u]);
+            vst1q_u8(dst + (r + 2 * u) * stride, vreinterpretq_u8_u64(vzip1q_u64(x, y)));
+            vst1q_u8(dst + (r + 2 * u + 1) * stride, vreinterpretq_u8_u64(vzip2q_u64(x, y)));
+        }
+    }
+#endif
+
+    for (; r < n_rec; r++)
+        for (size_t k = 0; k < stride; k++) dst[r * stride + k] = src[k * n_rec + r];
+    ZXC_MEMCPY(dst + n_rec * stride, src + n_rec * stride, size - n_rec * stride);
+}
+
+/**
+ * @brief Undoes the x86 branch filter on the displacement after the E8/E9 byte
+ * at `p`, unless `p` lies inside the previous displacement (`p < *next`).
+ *
+ * Branch-free (the matches are unpredictable): the 4 bytes are always
+ * rewritten, with their own value when nothing is converted.
+ *
+ * @param[in,out] buf Decoded block.
+ * @param[in] p Offset of an E8/E9 byte, at least 5 bytes before the end.
+ * @param[in,out] next First offset that may hold an opcode, updated.
+ */
+static ZXC_ALWAYS_INLINE void zxc_bcj_x86_undo(uint8_t* buf, size_t p, size_t* next) {
+    const size_t opcode = 0 - (size_t)(p >= *next);
+    const uint32_t x = zxc_le32(buf + p + 1);
+    // Top byte 0x00 or 0xFF: ((x >> 24) + 1) & 0xFE is 0
+    const uint32_t near = 0U - (((((x >> 24) + 1) & 0xFE) - 1U) >> 31);
+    const uint32_t d = (x - (uint32_t)(p + 5)) & 0x01FFFFFFU;
+    const uint32_t rel = (d ^ 0x01000000U) - 0x01000000U;
+    zxc_store_le32(buf + p + 1, x ^ ((rel ^ x) & near & (uint32_t)opcode));
+    *next += (p + 5 - *next) & opcode;
+}
+
+#if defined(ZXC_USE_AVX2) || defined(ZXC_USE_AVX512) || defined(ZXC_USE_NEON64)
+/**
+ * @brief Finds the E8/E9 bytes among 64 bytes.
+ *
+ * @param[in] p Pointer to 64 readable bytes.
+ * @return Bit `k` set if `p[k]` is E8 or E9.
+ */
+static ZXC_ALWAYS_INLINE uint64_t zxc_bcj_x86_mask64(const uint8_t* p) {
+#if defined(ZXC_USE_AVX2) || defined(ZXC_USE_AVX512)
+    const __m256i v_fe = _mm256_set1_epi8((char)0xFE);
+    const __m256i v_e8 = _mm256_set1_epi8((char)0xE8);
+    const __m256i lo = _mm256_and_si256(_mm256_loadu_si256((const __m256i*)p), v_fe);
+    const __m256i hi = _mm256_and_si256(_mm256_loadu_si256((const __m256i*)(p + 32)), v_fe);
+    return (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, v_e8)) |
+           (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, v_e8)) << 32;
+#else
+    // Byte k of a vector keeps bit k % 8, then 3 pairwise additions gather the bits
+    static const uint8_t bits[16] = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+    const uint8x16_t v_bits = vld1q_u8(bits);
+    const uint8x16_t v_fe = vdupq_n_u8(0xFE);
+    const uint8x16_t v_e8 = vdupq_n_u8(0xE8);
+    uint8x16_t t[4];
+    for (int k = 0; k < 4; k++)
+        t[k] = vandq_u8(vceqq_u8(vandq_u8(vld1q_u8(p + 16 * k), v_fe), v_e8), v_bits);
+    uint8x16_t sum = vpaddq_u8(vpaddq_u8(t[0], t[1]), vpaddq_u8(t[2], t[3]));
+    sum = vpaddq_u8(sum, sum);
+    return vgetq_lane_u64(vreinterpretq_u64_u8(sum), 0);
+#endif
+}
+#endif
+
+/**
+ * @brief Restores the relative branch targets of a block of machine code
+ * (inverse of the encoder's zxc_bcj_encode()), in place.
+ *
+ * x86: the encoder left the opcodes and the top displacement bytes as they
+ * read here, so the scan skips and converts the same bytes. The SIMD paths
+ * list the E8/E9 offsets of a window 64 bytes at a time (4 unconditional
+ * writes per mask, a loop for more), then visit them in one loop; the matches
+ * are unpredictable, so neither step branches on them.
+ * AArch64: one branch-free pass over the words, which the compiler vectorizes.
+ *
+ * @param[in,out] buf Decoded block.
+ * @param[in] size Size of the block.
+ * @param[in] arch ZXC_BCJ_X86 or ZXC_BCJ_ARM64.
+ */
+static void zxc_bcj_decode(uint8_t* buf, size_t size, uint16_t arch) {
+    if (arch == ZXC_BCJ_ARM64) {
+        for (size_t i = 0; i + 4 <= size; i += 4) {
+            const uint32_t w = zxc_le32(buf + i);
+            const uint32_t v = 0x94000000U | ((w - (uint32_t)(i >> 2)) & 0x03FFFFFFU);
+            zxc_store_le32(buf + i, (w & 0xFC000000U) == 0x94000000U ? v : w);
+        }
+        return;
+    }
+
+    size_t i = 0;     // First offset that may hold an opcode
+    size_t base = 0;  // Start of the next window
+#if defined(ZXC_USE_AVX2) || defined(ZXC_USE_AVX512) || defined(ZXC_USE_NEON64)
+    // Every match of a window has its 4 displacement bytes within the block
+    uint32_t pos[ZXC_BCJ_WINDOW + 4];
+    for (; base + ZXC_BCJ_WINDOW + 4 <= size; base += ZXC_BCJ_WINDOW) {
+        size_t n = 0;
+        for (uint32_t off = 0; off < ZXC_BCJ_WINDOW; off += 64) {
+            uint64_t m = zxc_bcj_x86_mask64(buf + base + off);
+            // Population count (SWAR), so that `n` does not wait for the writes
+            uint64_t c = m - ((m >> 1) & 0x5555555555555555ULL);
+            c = (c & 0x3333333333333333ULL) + ((c >> 2) & 0x3333333333333333ULL);
+            c = (((c + (c >> 4)) & 0x0F0F0F0F0F0F0F0FULL) * 0x0101010101010101ULL) >> 56;
+            // The top bit keeps zxc_ctz64() off its branch for 0 (spare writes)
+            for (size_t k = 0; k < 4; k++, m &= m - 1)
+                pos[n + k] = off + (uint32_t)zxc_ctz64(m | (1ULL << 63));
+            if (UNLIKELY(c > 4))
+                for (size_t k = 4; k < c; k++, m &= m - 1)
+                    pos[n + k] = off + (uint32_t)zxc_ctz64(m);
+            n += (size_t)c;
+        }
+        for (size_t k = 0; k < n; k++) zxc_bcj_x86_undo(buf, base + pos[k], &i);
+    }
+#endif
+
+    for (size_t p = base; p + 5 <= size; p++)
+        if ((buf[p] & 0xFE) == 0xE8) zxc_bcj_x86_undo(buf, p, &i);
+}
+
 // cppcheck-suppress unusedFunction
 int zxc_decompress_chunk_wrapper(zxc_cctx_t* ctx, const uint8_t* src, size_t src_sz, uint8_t* dst,
                                  size_t dst_cap) {
@@ -1492,12 +2347,33 @@ int zxc_decompress_chunk_wrapper(zxc_cctx_t* ctx, const uint8_t* src, size_t src
     const uint8_t* data = src + header_len;
     int decoded_sz = -1;
 
+    // Byte-shuffled LZ block: decode the planes to scratch, without linked prefix
+    const size_t stride = (flags & ZXC_BLOCK_FLAG_SHUFFLE) ? zxc_le16(src + 2) : 0;
+    const uint16_t bcj = (flags & ZXC_BLOCK_FLAG_BCJ) ? zxc_le16(src + 2) : 0;
+    uint8_t* out = dst;
+    size_t out_cap = dst_cap;
+    const size_t prefix = ctx->prefix_len;
+    if (UNLIKELY((flags & ZXC_BLOCK_FLAG_BCJ) &&
+                 ((type != ZXC_BLOCK_GLO && type != ZXC_BLOCK_GHI) || stride ||
+                  (bcj != ZXC_BCJ_X86 && bcj != ZXC_BCJ_ARM64))))
+        return -1;
+    if (stride) {
+        if (UNLIKELY((type != ZXC_BLOCK_GLO && type != ZXC_BLOCK_GHI) ||
+                     stride < ZXC_SHUFFLE_MIN_STRIDE || stride > ZXC_SHUFFLE_MAX_STRIDE ||
+                     raw_sz > dst_cap ||
+                     zxc_cctx_filter_reserve(ctx, (size_t)raw_sz + ZXC_PAD_SIZE) != 0))
+            return -1;
+        out = ctx->filter_buf;
+        out_cap = (size_t)raw_sz + ZXC_PAD_SIZE;
+        ctx->prefix_len = 0;
+    }
+
     switch (type) {
         case ZXC_BLOCK_GLO:
-            decoded_sz = zxc_decode_block_glo(ctx, data, comp_sz, dst, dst_cap, raw_sz);
+            decoded_sz = zxc_decode_block_glo(ctx, data, comp_sz, out, out_cap, raw_sz);
             break;
         case ZXC_BLOCK_GHI:
-            decoded_sz = zxc_decode_block_ghi(ctx, data, comp_sz, dst, dst_cap, raw_sz);
+            decoded_sz = zxc_decode_block_ghi(ctx, data, comp_sz, out, out_cap, raw_sz);
             break;
         case ZXC_BLOCK_RAW:
             if (UNLIKELY(raw_sz > dst_cap || raw_sz > comp_sz)) return -1;
@@ -1505,12 +2381,22 @@ int zxc_decompress_chunk_wrapper(zxc_cctx_t* ctx, const uint8_t* src, size_t src
             decoded_sz = (int)raw_sz;
             break;
         case ZXC_BLOCK_NUM:
-            decoded_sz = zxc_decode_block_num(data, comp_sz, dst, dst_cap, raw_sz);
+            decoded_sz = zxc_decode_block_num(data, comp_sz, dst, dst_cap, raw_sz, 0);
+            break;
+        case ZXC_BLOCK_FLT:
+            decoded_sz = zxc_decode_block_num(data, comp_sz, dst, dst_cap, raw_sz, 1);
             break;
         default:
             return -1;
     }
 
+    if (stride) {
+        ctx->prefix_len = prefix;
+        if (UNLIKELY(decoded_sz != (int)raw_sz)) return -1;
+        zxc_unshuffle_bytes(out, raw_sz, stride, dst);
+    }
+    if (bcj && decoded_sz >= 0) zxc_bcj_decode(dst, (size_t)decoded_sz, bcj);
+
     if (decoded_sz >= 0 && has_crc && ctx->checksum_enabled) {
         uint8_t algo = flags & ZXC_CHECKSUM_TYPE_MASK;
         uint64_t stored = zxc_le64(src + ZXC_BLOCK_HEADER_SIZE);
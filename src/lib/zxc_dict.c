@@ -0,0 +1,266 @@
+/*
+ * Copyright (c) 2025-2026, Bertrand Lebonnois
+ * All rights reserved.
+ *
+ * This source code is licensed under the BSD-style license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+/**
+ * @file zxc_dict.c
+ * @brief Dictionaries: identification, loading, dictionary-prefixed blocks and
+ * training.
+ *
+ * A dictionary is plain content placed in front of the first block of a frame,
+ * which may reference it like a linked prefix. The encoder indexes it once per
+ * context and mode and restores the indexed state for later frames; the
+ * decoder decodes the block right behind a copy of it.
+ */
+
+#include "../../include/zxc_buffer.h"
+#include "zxc_internal.h"
+
+/*
+ * ============================================================================
+ * IDENTIFICATION & LOADING
+ * ============================================================================
+ */
+
+// cppcheck-suppress unusedFunction
+uint32_t zxc_dict_id(const void* dict, size_t dict_size) {
+    if (UNLIKELY(!dict || dict_size == 0)) return 0;
+    if (dict_size > ZXC_DICT_SIZE_MAX) {
+        dict = (const uint8_t*)dict + dict_size - ZXC_DICT_SIZE_MAX;
+        dict_size = ZXC_DICT_SIZE_MAX;
+    }
+    uint32_t id = (uint32_t)zxc_checksum(dict, dict_size, ZXC_CHECKSUM_RAPIDHASH);
+    return id ? id : 1;
+}
+
+// cppcheck-suppress unusedFunction
+uint32_t zxc_get_dict_id(const void* src, size_t src_size) {
+    uint32_t dict_id = 0;
+    if (UNLIKELY(!src ||
+                 zxc_read_file_header((const uint8_t*)src, src_size, NULL, NULL, NULL,
+                                      &dict_id) < 0))
+        return 0;
+    return dict_id;
+}
+
+/**
+ * @brief Grows the dictionary buffer so that a block of `block_size` bytes
+ * (plus padding) fits behind the dictionary.
+ *
+ * @return 0 on success, -1 if memory allocation fails.
+ */
+static int zxc_dict_reserve(zxc_cctx_t* ctx, size_t block_size) {
+    size_t need = ctx->dict_size + block_size + ZXC_PAD_SIZE;
+    if (need <= ctx->dict_buf_cap) return 0;
+    uint8_t* buf = (uint8_t*)realloc(ctx->dict_buf, need);
+    if (UNLIKELY(!buf)) return -1;
+    ctx->dict_buf = buf;
+    ctx->dict_buf_cap = need;
+    return 0;
+}
+
+// cppcheck-suppress unusedFunction
+int zxc_cctx_load_dict(zxc_cctx_t* cctx, const void* dict, size_t dict_size) {
+    if (UNLIKELY(!cctx)) return -1;
+    free(cctx->dict_buf);
+    free(cctx->dict_tables);
+    cctx->dict_buf = NULL;
+    cctx->dict_tables = NULL;
+    cctx->dict_size = 0;
+    cctx->dict_buf_cap = 0;
+    cctx->dict_id = 0;
+    cctx->dict_tables_key = 0;
+    cctx->dict_live_key = 0;
+    if (!dict || dict_size == 0) return 0;
+
+    if (dict_size > ZXC_DICT_SIZE_MAX) {
+        dict = (const uint8_t*)dict + dict_size - ZXC_DICT_SIZE_MAX;
+        dict_size = ZXC_DICT_SIZE_MAX;
+    }
+    cctx->dict_size = dict_size;
+    if (UNLIKELY(zxc_dict_reserve(cctx, 0) != 0)) {
+        cctx->dict_size = 0;
+        return -1;
+    }
+    ZXC_MEMCPY(cctx->dict_buf, dict, dict_size);
+    cctx->dict_id = zxc_dict_id(dict, dict_size);
+    return 0;
+}
+
+// cppcheck-suppress unusedFunction
+int zxc_dctx_load_dict(zxc_dctx_t* dctx, const void* dict, size_t dict_size) {
+    return zxc_cctx_load_dict(dctx, dict, dict_size);
+}
+
+/*
+ * ============================================================================
+ * DICTIONARY-PREFIXED BLOCKS
+ * ============================================================================
+ */
+
+int zxc_compress_dict_block(zxc_cctx_t* ctx, const uint8_t* chunk, size_t src_sz, uint8_t* dst,
+                            size_t dst_cap) {
+    if (UNLIKELY(zxc_dict_reserve(ctx, src_sz) != 0)) return -1;
+    uint8_t* stage = ctx->dict_buf + ctx->dict_size;
+    ZXC_MEMCPY(stage, chunk, src_sz);
+
+    const size_t prefix = ctx->prefix_len;
+    ctx->prefix_len = ctx->dict_size;
+    ctx->prefix_is_dict = 1;
+    int res = zxc_compress_chunk_wrapper(ctx, stage, src_sz, dst, dst_cap);
+    ctx->prefix_is_dict = 0;
+    ctx->prefix_len = prefix;
+    return res;
+}
+
+int zxc_decompress_dict_block(zxc_cctx_t* ctx, const uint8_t* src, size_t src_sz, uint8_t* dst,
+                              size_t dst_cap) {
+    zxc_block_header_t bh;
+    if (UNLIKELY(zxc_read_block_header(src, src_sz, &bh) != 0 || bh.raw_size > dst_cap ||
+                 zxc_dict_reserve(ctx, bh.raw_size) != 0))
+        return -1;
+    uint8_t* stage = ctx->dict_buf + ctx->dict_size;
+
+    const size_t prefix = ctx->prefix_len;
+    ctx->prefix_len = ctx->dict_size;
+    int res = zxc_decompress_chunk_wrapper(ctx, src, src_sz, stage,
+                                           ctx->dict_buf_cap - ctx->dict_size);
+    ctx->prefix_len = prefix;
+    if (UNLIKELY(res < 0 || (size_t)res > dst_cap)) return -1;
+    ZXC_MEMCPY(dst, stage, (size_t)res);
+    return res;
+}
+
+/*
+ * ============================================================================
+ * TRAINING
+ * ============================================================================
+ * Simplified COVER selection: every 8-byte substring (d-mer) is weighted by
+ * the number of samples it occurs in; the samples are split into as many
+ * epochs as the dictionary has segments, and the best segment of each epoch
+ * (highest sum of distinct d-mer weights) is kept. The d-mers of a kept
+ * segment lose their weight, so later segments bring new content.
+ */
+
+#define ZXC_TRAIN_DMER 8           // Substring length weighted
+#define ZXC_TRAIN_SEGMENT 256      // Length of a kept segment
+#define ZXC_TRAIN_HASH_BITS 20     // d-mer table: 1M buckets
+#define ZXC_TRAIN_NONE UINT32_MAX  // No d-mer at this position
+
+/**
+ * @brief A selected segment of the samples.
+ */
+typedef struct {
+    size_t pos;      // Offset in the samples
+    uint64_t score;  // Sum of the weights of its distinct d-mers
+} zxc_train_seg_t;
+
+/**
+ * @brief Orders segments by increasing score (ties by position).
+ */
+static int zxc_train_seg_cmp(const void* a, const void* b) {
+    const zxc_train_seg_t* x = (const zxc_train_seg_t*)a;
+    const zxc_train_seg_t* y = (const zxc_train_seg_t*)b;
+    if (x->score != y->score) return x->score < y->score ? -1 : 1;
+    return x->pos < y->pos ? -1 : (x->pos > y->pos);
+}
+
+// cppcheck-suppress unusedFunction
+size_t zxc_train_dict(void* dict, size_t dict_capacity, const void* samples,
+                      const size_t* sample_sizes, size_t n_samples) {
+    if (UNLIKELY(!dict || !samples || !sample_sizes || n_samples == 0 || dict_capacity == 0))
+        return 0;
+    const uint8_t* src = (const uint8_t*)samples;
+    uint8_t* out = (uint8_t*)dict;
+    const size_t cap = dict_capacity < ZXC_DICT_SIZE_MAX ? dict_capacity : ZXC_DICT_SIZE_MAX;
+
+    size_t total = 0;
+    for (size_t i = 0; i < n_samples; i++) total += sample_sizes[i];
+    if (UNLIKELY(total == 0)) return 0;
+    if (total <= cap) {
+        ZXC_MEMCPY(out, src, total);
+        return total;
+    }
+
+    const size_t n_buckets = (size_t)1 << ZXC_TRAIN_HASH_BITS;
+    uint32_t* weight = (uint32_t*)calloc(n_buckets, sizeof(uint32_t));
+    uint32_t* seen = (uint32_t*)calloc(n_buckets, sizeof(uint32_t));
+    uint32_t* dmer = (uint32_t*)malloc(total * sizeof(uint32_t));
+    size_t n_segs = cap / ZXC_TRAIN_SEGMENT;
+    zxc_train_seg_t* segs = (zxc_train_seg_t*)malloc((n_segs ? n_segs : 1) * sizeof(*segs));
+    size_t out_size = 0;
+    if (UNLIKELY(!weight || !seen || !dmer || !segs)) goto train_end;
+
+    // d-mer of every position (none across a sample boundary), counted once per sample
+    size_t pos = 0;
+    for (size_t i = 0; i < n_samples; i++) {
+        const size_t end = pos + sample_sizes[i];
+        for (; pos < end; pos++) {
+            if (end - pos < ZXC_TRAIN_DMER) {
+                dmer[pos] = ZXC_TRAIN_NONE;
+                continue;
+            }
+            uint32_t h = (uint32_t)((zxc_le64(src + pos) * 0x9E3779B97F4A7C15ULL) >>
+                                    (64 - ZXC_TRAIN_HASH_BITS));
+            dmer[pos] = h;
+            if (seen[h] != (uint32_t)i + 1) {
+                seen[h] = (uint32_t)i + 1;
+                weight[h]++;
+            }
+        }
+    }
+
+    // Best segment of each epoch; `seen` now counts the d-mers in the window
+    ZXC_MEMSET(seen, 0, n_buckets * sizeof(uint32_t));
+    const size_t seg_len = ZXC_TRAIN_SEGMENT;
+    const size_t epoch = total / (n_segs ? n_segs : 1);
+    size_t n_kept = 0;
+    for (size_t e = 0; e < n_segs && epoch >= seg_len; e++) {
+        const size_t lo = e * epoch, hi = lo + epoch;
+        uint64_t score = 0, best = 0;
+        size_t best_pos = lo;
+        for (size_t p = lo; p < hi; p++) {
+            uint32_t h = dmer[p];
+            if (h != ZXC_TRAIN_NONE && seen[h]++ == 0) score += weight[h];
+            if (p >= lo + seg_len) {
+                uint32_t g = dmer[p - seg_len];
+                if (g != ZXC_TRAIN_NONE && --seen[g] == 0) score -= weight[g];
+            }
+            if (p + 1 >= lo + seg_len && score > best) {
+                best = score;
+                best_pos = p + 1 - seg_len;
+            }
+        }
+        for (size_t p = (hi > lo + seg_len ? hi - seg_len : lo); p < hi; p++) {
+            if (dmer[p] != ZXC_TRAIN_NONE) seen[dmer[p]] = 0;  // Empty the window
+        }
+        if (best == 0) continue;
+        for (size_t p = best_pos; p < best_pos + seg_len; p++) {
+            if (dmer[p] != ZXC_TRAIN_NONE) weight[dmer[p]] = 0;
+        }
+        segs[n_kept++] = (zxc_train_seg_t){best_pos, best};
+    }
+
+    // Most valuable segments last: closest to the data, at the smallest offsets
+    qsort(segs, n_kept, sizeof(*segs), zxc_train_seg_cmp);
+    for (size_t i = 0; i < n_kept; i++) {
+        ZXC_MEMCPY(out + out_size, src + segs[i].pos, seg_len);
+        out_size += seg_len;
+    }
+    // Nothing shared between the samples: keep their most recent content
+    if (out_size == 0) {
+        ZXC_MEMCPY(out, src + total - cap, cap);
+        out_size = cap;
+    }
+
+train_end:
+    free(weight);
+    free(seen);
+    free(dmer);
+    free(segs);
+    return out_size;
+}
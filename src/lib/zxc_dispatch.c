@@ -6,6 +6,7 @@
  * LICENSE file in the root directory of this source tree.
  */
 
+#include "../../include/zxc_buffer.h"
 #include "zxc_internal.h"
 #if defined(_MSC_VER)
 #include <intrin.h>
@@ -251,97 +252,671 @@ int zxc_compress_chunk_wrapper(zxc_cctx_t* ctx, const uint8_t* src, size_t src_s
  * allocation and looping over blocks. They call the dispatched wrappers above.
  */
 
-// cppcheck-suppress unusedFunction
-size_t zxc_compress(const void* src, size_t src_size, void* dst, size_t dst_capacity, int level,
-                    int checksum_enabled) {
-    if (UNLIKELY(!src || !dst || src_size == 0 || dst_capacity == 0)) return 0;
-
-    const uint8_t* ip = (const uint8_t*)src;
-    uint8_t* op = (uint8_t*)dst;
+/**
+ * @brief Compresses a whole buffer (file header + blocks) with a prepared context.
+ *
+ * With `ctx->linked_blocks` set, every block after the first may reference the
+ * last ZXC_LINK_WINDOW bytes of the previous one, which precede it in `src`.
+ * With a dictionary loaded, the first block references it instead.
+ *
+ * @param[in,out] ctx Compression context (mode 1), level and checksum already set.
+ * @param[in] src Source buffer.
+ * @param[in] src_size Size of the source data in bytes.
+ * @param[out] dst Destination buffer.
+ * @param[in] dst_capacity Capacity of the destination buffer.
+ * @param[in] block_size Validated block size (at most `ctx->chunk_size`).
+ * @return The number of bytes written, or 0 on error.
+ */
+static size_t zxc_compress_frame(zxc_cctx_t* ctx, const uint8_t* src, size_t src_size,
+                                 uint8_t* dst, size_t dst_capacity, size_t block_size) {
+    const uint8_t* ip = src;
+    uint8_t* op = dst;
     const uint8_t* op_start = op;
     const uint8_t* op_end = op + dst_capacity;
 
-    zxc_cctx_t ctx;
-    if (zxc_cctx_init(&ctx, ZXC_BLOCK_SIZE, 1, level, checksum_enabled) != 0) return 0;
-
-    int h_size = zxc_write_file_header(op, (size_t)(op_end - op));
-    if (UNLIKELY(h_size < 0)) {
-        zxc_cctx_free(&ctx);
-        return 0;
-    }
+    int h_size = zxc_write_file_header(op, (size_t)(op_end - op), block_size,
+                                       (uint64_t)src_size, ctx->linked_blocks, ctx->dict_id);
+    if (UNLIKELY(h_size < 0)) return 0;
     op += h_size;
 
+    const size_t link = block_size < ZXC_LINK_WINDOW ? block_size : ZXC_LINK_WINDOW;
     size_t pos = 0;
     while (pos < src_size) {
-        size_t chunk_len = (src_size - pos > ZXC_BLOCK_SIZE) ? ZXC_BLOCK_SIZE : (src_size - pos);
+        size_t chunk_len = (src_size - pos > block_size) ? block_size : (src_size - pos);
         size_t rem_cap = (size_t)(op_end - op);
 
-        int res = zxc_compress_chunk_wrapper(&ctx, ip + pos, chunk_len, op, rem_cap);
-        if (UNLIKELY(res < 0)) {
-            zxc_cctx_free(&ctx);
-            return 0;
-        }
+        ctx->prefix_len = (ctx->linked_blocks && pos > 0) ? link : 0;
+        int res = (pos == 0 && ctx->dict_size > 0)
+                      ? zxc_compress_dict_block(ctx, ip, chunk_len, op, rem_cap)
+                      : zxc_compress_chunk_wrapper(ctx, ip + pos, chunk_len, op, rem_cap);
+        if (UNLIKELY(res < 0)) return 0;
 
         op += res;
         pos += chunk_len;
     }
+    ctx->prefix_len = 0;
 
-    zxc_cctx_free(&ctx);
     return (size_t)(op - op_start);
 }
 
-// cppcheck-suppress unusedFunction
-size_t zxc_decompress(const void* src, size_t src_size, void* dst, size_t dst_capacity,
-                      int checksum_enabled) {
-    if (UNLIKELY(!src || !dst || src_size < ZXC_FILE_HEADER_SIZE)) return 0;
-
-    const uint8_t* ip = (const uint8_t*)src;
+/**
+ * @brief Decompresses a whole buffer (file header + blocks) with a prepared context.
+ *
+ * Linked frames are decoded in place: the previous block's output is right
+ * before the current one in `dst`. A frame compressed with a dictionary needs
+ * the same one loaded in `ctx`.
+ *
+ * @param[in,out] ctx Decompression context (mode 0), checksum flag already set.
+ * @param[in] src Source buffer.
+ * @param[in] src_size Size of the compressed data in bytes.
+ * @param[out] dst Destination buffer.
+ * @param[in] dst_capacity Capacity of the destination buffer.
+ * @return The number of bytes written, or 0 on error.
+ */
+static size_t zxc_decompress_frame(zxc_cctx_t* ctx, const uint8_t* src, size_t src_size,
+                                   uint8_t* dst, size_t dst_capacity) {
+    const uint8_t* ip = src;
     const uint8_t* ip_end = ip + src_size;
-    uint8_t* op = (uint8_t*)dst;
+    uint8_t* op = dst;
     const uint8_t* op_start = op;
     const uint8_t* op_end = op + dst_capacity;
-    size_t runtime_chunk_size = 0;
+    uint64_t content_size = ZXC_CONTENT_SIZE_UNKNOWN;
+    int linked = 0;
+    uint32_t dict_id = 0;
+    ctx->prefix_len = 0;
 
     // File header verification
-    if (zxc_read_file_header(ip, src_size, &runtime_chunk_size) != 0) return 0;
+    int h_size = zxc_read_file_header(ip, src_size, NULL, &content_size, &linked, &dict_id);
+    if (h_size < 0 || (dict_id && dict_id != ctx->dict_id)) return 0;
 
-    zxc_cctx_t ctx;
-    if (zxc_cctx_init(&ctx, runtime_chunk_size, 0, 0, checksum_enabled) != 0) return 0;
+    // Known content size: reject undersized destinations before decoding anything
+    if (content_size != ZXC_CONTENT_SIZE_UNKNOWN && content_size > dst_capacity) return 0;
 
-    ip += ZXC_FILE_HEADER_SIZE;
+    ip += h_size;
 
     // Block decompression loop
     while (ip < ip_end) {
         size_t rem_src = (size_t)(ip_end - ip);
         zxc_block_header_t bh;
         // Read the block header to determine the compressed size
-        if (zxc_read_block_header(ip, rem_src, &bh) != 0) {
-            zxc_cctx_free(&ctx);
-            return 0;
-        }
+        if (zxc_read_block_header(ip, rem_src, &bh) != 0) return 0;
+
+        // Trailing seek table: end of the block chain
+        if (bh.block_type == ZXC_BLOCK_SEK) break;
 
         // Safety check: ensure the block (header + data + checksum) fits in the input buffer
         size_t checksum_sz =
             (bh.block_flags & ZXC_BLOCK_FLAG_CHECKSUM) ? ZXC_BLOCK_CHECKSUM_SIZE : 0;
         size_t total_block_sz = ZXC_BLOCK_HEADER_SIZE + bh.comp_size + checksum_sz;
 
-        if (UNLIKELY(total_block_sz > rem_src)) {
-            zxc_cctx_free(&ctx);
-            return 0;
-        }
+        if (UNLIKELY(total_block_sz > rem_src)) return 0;
 
         size_t rem_cap = (size_t)(op_end - op);
-        int res = zxc_decompress_chunk_wrapper(&ctx, ip, rem_src, op, rem_cap);
-        if (UNLIKELY(res < 0)) {
-            zxc_cctx_free(&ctx);
+        int res = (dict_id && op == op_start)
+                      ? zxc_decompress_dict_block(ctx, ip, rem_src, op, rem_cap)
+                      : zxc_decompress_chunk_wrapper(ctx, ip, rem_src, op, rem_cap);
+        if (UNLIKELY(res < 0)) return 0;
+
+        ip += total_block_sz;
+        op += res;
+        if (linked)
+            ctx->prefix_len = (size_t)res < ZXC_LINK_WINDOW ? (size_t)res : ZXC_LINK_WINDOW;
+    }
+    if (UNLIKELY(content_size != ZXC_CONTENT_SIZE_UNKNOWN &&
+                 content_size != (uint64_t)(op - op_start)))
+        return 0;
+    return (size_t)(op - op_start);
+}
+
+// cppcheck-suppress unusedFunction
+size_t zxc_compress(const void* src, size_t src_size, void* dst, size_t dst_capacity, int level,
+                    int checksum_enabled, size_t block_size) {
+    block_size = zxc_resolve_block_size(block_size);
+    if (UNLIKELY(!src || !dst || src_size == 0 || dst_capacity == 0 || block_size == 0)) return 0;
+
+    zxc_cctx_t ctx;
+    if (zxc_cctx_init(&ctx, block_size, 1, level, checksum_enabled) != 0) return 0;
+
+    size_t res = zxc_compress_frame(&ctx, (const uint8_t*)src, src_size, (uint8_t*)dst,
+                                    dst_capacity, block_size);
+    zxc_cctx_free(&ctx);
+    return res;
+}
+
+// cppcheck-suppress unusedFunction
+size_t zxc_decompress(const void* src, size_t src_size, void* dst, size_t dst_capacity,
+                      int checksum_enabled) {
+    if (UNLIKELY(!src || !dst || src_size < ZXC_FILE_HEADER_SIZE)) return 0;
+
+    zxc_cctx_t ctx;
+    if (zxc_cctx_init(&ctx, ZXC_BLOCK_SIZE, 0, 0, checksum_enabled) != 0) return 0;
+
+    size_t res = zxc_decompress_frame(&ctx, (const uint8_t*)src, src_size, (uint8_t*)dst,
+                                      dst_capacity);
+    zxc_cctx_free(&ctx);
+    return res;
+}
+
+/*
+ * ============================================================================
+ * REUSABLE CONTEXT API
+ * ============================================================================
+ * Same operations as above, but the context (and its ~1 MB working memory for
+ * compression, the RLE literal scratch for decompression) outlives the call.
+ * The hash table is not cleared between calls: the per-block epoch already
+ * invalidates stale entries lazily.
+ */
+
+// cppcheck-suppress unusedFunction
+zxc_cctx_t* zxc_create_cctx(void) {
+    zxc_cctx_t* cctx = (zxc_cctx_t*)malloc(sizeof(zxc_cctx_t));
+    if (UNLIKELY(!cctx)) return NULL;
+    if (zxc_cctx_init(cctx, ZXC_BLOCK_SIZE, 1, 0, 0) != 0) {
+        free(cctx);
+        return NULL;
+    }
+    return cctx;
+}
+
+// cppcheck-suppress unusedFunction
+size_t zxc_compress_cctx(zxc_cctx_t* cctx, const void* src, size_t src_size, void* dst,
+                         size_t dst_capacity, int level, int checksum_enabled,
+                         size_t block_size) {
+    block_size = zxc_resolve_block_size(block_size);
+    if (UNLIKELY(!cctx || !src || !dst || src_size == 0 || dst_capacity == 0 || block_size == 0))
+        return 0;
+
+    // Grow the working buffers if a larger block size is requested
+    if (UNLIKELY(zxc_cctx_reserve(cctx, block_size, 1, level, checksum_enabled) != 0)) return 0;
+
+    return zxc_compress_frame(cctx, (const uint8_t*)src, src_size, (uint8_t*)dst, dst_capacity,
+                              block_size);
+}
+
+// cppcheck-suppress unusedFunction
+void zxc_free_cctx(zxc_cctx_t* cctx) {
+    if (!cctx) return;
+    zxc_cctx_free(cctx);
+    free(cctx);
+}
+
+// cppcheck-suppress unusedFunction
+zxc_dctx_t* zxc_create_dctx(void) {
+    zxc_dctx_t* dctx = (zxc_dctx_t*)malloc(sizeof(zxc_dctx_t));
+    if (UNLIKELY(!dctx)) return NULL;
+    zxc_cctx_init(dctx, ZXC_BLOCK_SIZE, 0, 0, 0);
+    return dctx;
+}
+
+// cppcheck-suppress unusedFunction
+size_t zxc_decompress_dctx(zxc_dctx_t* dctx, const void* src, size_t src_size, void* dst,
+                           size_t dst_capacity, int checksum_enabled) {
+    if (UNLIKELY(!dctx || !src || !dst || src_size < ZXC_FILE_HEADER_SIZE)) return 0;
+
+    dctx->checksum_enabled = checksum_enabled;
+    return zxc_decompress_frame(dctx, (const uint8_t*)src, src_size, (uint8_t*)dst,
+                                dst_capacity);
+}
+
+// cppcheck-suppress unusedFunction
+void zxc_free_dctx(zxc_dctx_t* dctx) {
+    if (!dctx) return;
+    zxc_cctx_free(dctx);
+    free(dctx);
+}
+
+/**
+ * @brief Decompresses a byte range of a frame with a prepared context.
+ *
+ * The first block of a frame compressed with a dictionary is decoded with the
+ * dictionary loaded in `ctx`; without it, ranges that need that block fail
+ * (in a linked frame, every range does).
+ *
+ * @param[in,out] ctx Decompression context (mode 0), checksum flag already set.
+ * @param[in] base Source buffer.
+ * @param[in] src_size Size of the compressed data in bytes.
+ * @param[in] raw_offset Offset of the first requested byte in the decompressed data.
+ * @param[in] len Number of bytes requested (non-zero).
+ * @param[out] dst Destination buffer (at least `len` bytes).
+ * @return The number of bytes written, or 0 on error.
+ */
+static size_t zxc_decompress_range_ctx(zxc_cctx_t* ctx, const uint8_t* base, size_t src_size,
+                                       size_t raw_offset, size_t len, uint8_t* dst) {
+    const uint8_t* ip_end = base + src_size;
+    size_t runtime_chunk_size = 0;
+    int linked = 0;
+    uint32_t dict_id = 0;
+
+    int h_size =
+        zxc_read_file_header(base, src_size, &runtime_chunk_size, NULL, &linked, &dict_id);
+    if (h_size < 0) return 0;
+
+    // Locate the block covering raw_offset: O(log n) with the seek table,
+    // otherwise fall back to walking the block headers (no decoding).
+    // Linked blocks depend on their predecessors: decoding starts at the first one.
+    const uint8_t* ip = base + h_size;
+    size_t block_raw_start = 0;
+    const uint8_t* entries;
+    uint32_t n_entries;
+
+    if (linked) {
+        // Every block up to the range is decoded, through the scratch buffer
+    } else if (zxc_find_seek_table(base, src_size, &entries, &n_entries) == 0) {
+        if (UNLIKELY(n_entries == 0)) return 0;
+        uint32_t lo = 0, hi = n_entries - 1;
+        while (lo < hi) {
+            uint32_t mid = lo + (hi - lo + 1) / 2;
+            zxc_seek_entry_t e;
+            zxc_read_seek_entry(entries, mid, &e);
+            if (e.raw_offset <= raw_offset)
+                lo = mid;
+            else
+                hi = mid - 1;
+        }
+        zxc_seek_entry_t e;
+        zxc_read_seek_entry(entries, lo, &e);
+        if (UNLIKELY(e.raw_offset > raw_offset || e.comp_offset < (uint64_t)h_size ||
+                     e.comp_offset >= src_size))
             return 0;
+        ip = base + e.comp_offset;
+        block_raw_start = (size_t)e.raw_offset;
+    } else {
+        while (ip < ip_end) {
+            zxc_block_header_t bh;
+            if (zxc_read_block_header(ip, (size_t)(ip_end - ip), &bh) != 0) return 0;
+            if (bh.block_type == ZXC_BLOCK_SEK) return 0;
+            if (raw_offset - block_raw_start < bh.raw_size) break;
+            size_t checksum_sz =
+                (bh.block_flags & ZXC_BLOCK_FLAG_CHECKSUM) ? ZXC_BLOCK_CHECKSUM_SIZE : 0;
+            size_t total_block_sz = ZXC_BLOCK_HEADER_SIZE + bh.comp_size + checksum_sz;
+            if (UNLIKELY(total_block_sz > (size_t)(ip_end - ip))) return 0;
+            ip += total_block_sz;
+            block_raw_start += bh.raw_size;
         }
+    }
 
-        ip += ZXC_BLOCK_HEADER_SIZE + bh.comp_size;
-        ip += (bh.block_flags & ZXC_BLOCK_FLAG_CHECKSUM) ? ZXC_BLOCK_CHECKSUM_SIZE : 0;
-        op += res;
+    ctx->prefix_len = 0;
+    uint8_t* op = dst;
+    uint8_t* tmp = NULL;
+    size_t skip = raw_offset - block_raw_start;
+    size_t done = 0;
+    // Linked blocks: the scratch keeps the previous block's tail in front of the output
+    const size_t hist = linked ? ZXC_LINK_WINDOW : 0;
+
+    while (done < len && ip < ip_end) {
+        size_t rem_src = (size_t)(ip_end - ip);
+        zxc_block_header_t bh;
+        if (zxc_read_block_header(ip, rem_src, &bh) != 0) goto _range_fail;
+        if (bh.block_type == ZXC_BLOCK_SEK) break;
+
+        size_t checksum_sz =
+            (bh.block_flags & ZXC_BLOCK_FLAG_CHECKSUM) ? ZXC_BLOCK_CHECKSUM_SIZE : 0;
+        size_t total_block_sz = ZXC_BLOCK_HEADER_SIZE + bh.comp_size + checksum_sz;
+        if (UNLIKELY(total_block_sz > rem_src)) goto _range_fail;
+        // The first block of a dictionary frame needs the dictionary
+        const int dict_block = dict_id && ip == base + h_size;
+        if (UNLIKELY(dict_block && dict_id != ctx->dict_id)) goto _range_fail;
+
+        size_t want = len - done;
+        if (!linked && skip == 0 && bh.raw_size <= want) {
+            // Block fully inside the range: decode in place.
+            int res = dict_block ? zxc_decompress_dict_block(ctx, ip, rem_src, op + done, want)
+                                 : zxc_decompress_chunk_wrapper(ctx, ip, rem_src, op + done, want);
+            if (UNLIKELY(res < 0)) goto _range_fail;
+            done += (size_t)res;
+        } else {
+            // Edge block: decode to scratch and copy the requested slice.
+            if (!tmp) {
+                tmp = (uint8_t*)malloc(hist + runtime_chunk_size + ZXC_PAD_SIZE);
+                if (UNLIKELY(!tmp)) goto _range_fail;
+            }
+            uint8_t* out = tmp + hist;
+            int res =
+                dict_block
+                    ? zxc_decompress_dict_block(ctx, ip, rem_src, out, runtime_chunk_size)
+                    : zxc_decompress_chunk_wrapper(ctx, ip, rem_src, out, runtime_chunk_size);
+            if (UNLIKELY(res < 0)) goto _range_fail;
+            if (skip < (size_t)res) {
+                size_t n = (size_t)res - skip;
+                if (n > want) n = want;
+                ZXC_MEMCPY(op + done, out + skip, n);
+                done += n;
+                skip = 0;
+            } else {
+                skip -= (size_t)res;
+            }
+            if (linked) {
+                size_t keep = (size_t)res < hist ? (size_t)res : hist;
+                memmove(out - keep, out + res - keep, keep);
+                ctx->prefix_len = keep;
+            }
+        }
+        ip += total_block_sz;
     }
 
+    free(tmp);
+    ctx->prefix_len = 0;
+    return done;
+
+_range_fail:
+    free(tmp);
+    ctx->prefix_len = 0;
+    return 0;
+}
+
+// cppcheck-suppress unusedFunction
+size_t zxc_decompress_range(const void* src, size_t src_size, size_t raw_offset, size_t len,
+                            void* dst) {
+    if (UNLIKELY(!src || !dst || len == 0 || src_size < ZXC_FILE_HEADER_SIZE)) return 0;
+
+    zxc_cctx_t ctx;
+    if (zxc_cctx_init(&ctx, 0, 0, 0, 1) != 0) return 0;
+    size_t res = zxc_decompress_range_ctx(&ctx, (const uint8_t*)src, src_size, raw_offset, len,
+                                          (uint8_t*)dst);
     zxc_cctx_free(&ctx);
-    return (size_t)(op - op_start);
+    return res;
+}
+
+// cppcheck-suppress unusedFunction
+size_t zxc_decompress_range_dctx(zxc_dctx_t* dctx, const void* src, size_t src_size,
+                                 size_t raw_offset, size_t len, void* dst, int checksum_enabled) {
+    if (UNLIKELY(!dctx || !src || !dst || len == 0 || src_size < ZXC_FILE_HEADER_SIZE)) return 0;
+
+    dctx->checksum_enabled = checksum_enabled;
+    return zxc_decompress_range_ctx(dctx, (const uint8_t*)src, src_size, raw_offset, len,
+                                    (uint8_t*)dst);
+}
+
+// cppcheck-suppress unusedFunction
+size_t zxc_get_decompressed_size(const void* src, size_t src_size) {
+    if (UNLIKELY(!src)) return 0;
+
+    const uint8_t* ip = (const uint8_t*)src;
+    uint64_t content_size = ZXC_CONTENT_SIZE_UNKNOWN;
+    if (zxc_read_file_header(ip, src_size, NULL, &content_size, NULL, NULL) < 0) return 0;
+
+    // Older writers and unsized streams: the seek table also knows the total
+    if (content_size == ZXC_CONTENT_SIZE_UNKNOWN) {
+        const uint8_t* entries;
+        uint32_t n_entries;
+        if (zxc_find_seek_table(ip, src_size, &entries, &n_entries) != 0) return 0;
+        if (n_entries == 0) return 0;
+        zxc_seek_entry_t last;
+        zxc_read_seek_entry(entries, n_entries - 1, &last);
+        content_size = last.raw_offset + last.raw_size;
+    }
+
+    return (content_size > SIZE_MAX) ? 0 : (size_t)content_size;
+}
+
+/*
+ * ============================================================================
+ * DECODE COST MODEL
+ * ============================================================================
+ * The optimal parser can trade ratio for decode speed. The same per-sequence
+ * cycle estimate (zxc_match_decode_cycles() / zxc_lit_decode_cycles()) is used
+ * to price parse choices and to report the expected cost of existing blocks.
+ */
+
+// cppcheck-suppress unusedFunction
+void zxc_cost_model_init(zxc_cost_model_t* model, int decode_bias) {
+    if (UNLIKELY(!model)) return;
+    model->byte_weight = ZXC_COST_BYTE_WEIGHT;
+    model->cycle_weight = decode_bias > 0 ? (uint32_t)decode_bias : 0;
+    model->seq_cycles = ZXC_COST_SEQ_CYCLES;
+    model->copy_cycles = ZXC_COST_COPY_CYCLES;
+    model->short_off_cycles = ZXC_COST_SHORT_OFF_CYCLES;
+    model->long_lit_cycles = ZXC_COST_LONG_LIT_CYCLES;
+}
+
+// cppcheck-suppress unusedFunction
+void zxc_cctx_set_cost_model(zxc_cctx_t* cctx, const zxc_cost_model_t* model) {
+    if (UNLIKELY(!cctx)) return;
+    if (model)
+        cctx->cost_model = *model;
+    else
+        ZXC_MEMSET(&cctx->cost_model, 0, sizeof(cctx->cost_model));
+}
+
+// cppcheck-suppress unusedFunction
+void zxc_cctx_set_linked_blocks(zxc_cctx_t* cctx, int enabled) {
+    if (UNLIKELY(!cctx)) return;
+    cctx->linked_blocks = enabled != 0;
+}
+
+// cppcheck-suppress unusedFunction
+void zxc_cctx_set_block_trials(zxc_cctx_t* cctx, int enabled) {
+    if (UNLIKELY(!cctx)) return;
+    cctx->block_trials = enabled != 0;
+}
+
+/**
+ * @brief Bounds-checked VByte read for the cost estimator.
+ *
+ * @return 0 and sets `*ptr` to NULL if the value runs past `end`.
+ */
+static uint32_t zxc_cost_read_vbyte(const uint8_t** ptr, const uint8_t* end) {
+    const uint8_t* p = *ptr;
+    uint32_t val = 0;
+    for (int shift = 0; p && p < end && shift < 7 * ZXC_VBYTE_MAX_LEN; shift += 7) {
+        uint8_t b = *p++;
+        val |= (uint32_t)(b & ZXC_VBYTE_MASK) << shift;
+        if (!(b & ZXC_VBYTE_MSB)) {
+            *ptr = p;
+            return val;
+        }
+    }
+    *ptr = NULL;
+    return 0;
+}
+
+/**
+ * @brief Estimated decode cycles of a GLO or GHI block payload.
+ *
+ * @param[in] data Block payload (after the block header and checksum).
+ * @param[in] size Payload size.
+ * @param[in] type ZXC_BLOCK_GLO or ZXC_BLOCK_GHI.
+ * @param[in] raw_size Decompressed size of the block.
+ * @param[in] m Cost model.
+ * @param[out] n_seq Number of sequences.
+ * @return The estimate, or UINT64_MAX if the payload is malformed.
+ */
+static uint64_t zxc_estimate_lz_block(const uint8_t* data, size_t size, uint8_t type,
+                                      uint32_t raw_size, const zxc_cost_model_t* m,
+                                      uint32_t* n_seq) {
+    zxc_gnr_header_t gh;
+    zxc_section_desc_t desc[ZXC_GLO_SECTIONS];
+    const uint8_t *t_ptr, *o_ptr = NULL, *o_end = NULL, *e_ptr, *e_end;
+    uint64_t cycles = 0;
+
+    if (type == ZXC_BLOCK_GLO) {
+        if (zxc_read_glo_header_and_desc(data, size, &gh, desc) != 0) return UINT64_MAX;
+        t_ptr = data + ZXC_GLO_HEADER_BINARY_SIZE +
+                ZXC_GLO_SECTIONS * ZXC_SECTION_DESC_BINARY_SIZE +
+                (size_t)(desc[0].sizes & ZXC_SECTION_SIZE_MASK);
+        o_ptr = t_ptr + (size_t)(desc[1].sizes & ZXC_SECTION_SIZE_MASK);
+        e_ptr = o_end = o_ptr + (size_t)(desc[2].sizes & ZXC_SECTION_SIZE_MASK);
+        e_end = e_ptr + (size_t)(desc[3].sizes & ZXC_SECTION_SIZE_MASK);
+        size_t off_sz = gh.off_bits ? ((size_t)gh.n_sequences * gh.off_bits + 7) / 8
+                        : gh.enc_off == ZXC_OFF_ENC_8 ? gh.n_sequences
+                                                      : (size_t)gh.n_sequences * 2;
+        if (UNLIKELY(e_end != data + size || (size_t)(o_ptr - t_ptr) < gh.n_sequences ||
+                     (size_t)(e_ptr - o_ptr) < off_sz))
+            return UINT64_MAX;
+        // RLE and Huffman literals are expanded in a separate pass
+        if (gh.enc_lit == ZXC_SECTION_ENCODING_HUFFMAN)
+            cycles += (uint64_t)ZXC_COST_HUF_LIT_CYCLES * gh.n_literals;
+        else if (gh.enc_lit)
+            cycles += (uint64_t)m->copy_cycles * ((gh.n_literals + 31) / 32);
+    } else {
+        if (zxc_read_ghi_header_and_desc(data, size, &gh, desc) != 0) return UINT64_MAX;
+        t_ptr = data + ZXC_GHI_HEADER_BINARY_SIZE +
+                ZXC_GHI_SECTIONS * ZXC_SECTION_DESC_BINARY_SIZE +
+                (size_t)(desc[0].sizes & ZXC_SECTION_SIZE_MASK);
+        e_ptr = t_ptr + (size_t)(desc[1].sizes & ZXC_SECTION_SIZE_MASK);
+        e_end = e_ptr + (size_t)(desc[2].sizes & ZXC_SECTION_SIZE_MASK);
+        if (UNLIKELY(e_end != data + size || (size_t)(e_ptr - t_ptr) / 4 < gh.n_sequences))
+            return UINT64_MAX;
+    }
+
+    uint64_t produced = 0;
+    uint32_t rep[ZXC_REP_NUM] = {ZXC_REP_INIT_0, ZXC_REP_INIT_1, ZXC_REP_INIT_2};
+    for (uint32_t i = 0; i < gh.n_sequences; i++) {
+        uint32_t ll, ml, off;
+        if (type == ZXC_BLOCK_GLO) {
+            uint8_t token = t_ptr[i];
+            ll = token >> ZXC_TOKEN_LIT_BITS;
+            ml = token & ZXC_TOKEN_ML_MASK;
+            if (gh.off_bits) {
+                const size_t pos = (size_t)i * gh.off_bits;
+                off = 0;
+                for (size_t k = 0; k < 3 && o_ptr + pos / 8 + k < o_end; k++)
+                    off |= (uint32_t)o_ptr[pos / 8 + k] << (8 * k);
+                off = (off >> (pos % 8)) & ((1U << gh.off_bits) - 1);
+            } else {
+                off = gh.enc_off == ZXC_OFF_ENC_8 ? o_ptr[i] : zxc_le16(o_ptr + 2 * (size_t)i);
+            }
+            if (ll == ZXC_TOKEN_LL_MASK) ll += zxc_cost_read_vbyte(&e_ptr, e_end);
+            if (e_ptr && ml == ZXC_TOKEN_ML_MASK) ml += zxc_cost_read_vbyte(&e_ptr, e_end);
+            if (gh.rep_offsets && off > 0 && off <= ZXC_REP_NUM) {
+                const uint32_t r = rep[off - 1];
+                for (uint32_t k = off - 1; k > 0; k--) rep[k] = rep[k - 1];
+                off = rep[0] = r;
+            } else {
+                if (gh.rep_offsets && off > 0) off -= ZXC_REP_NUM;
+                if (e_ptr && off == 0 && gh.enc_off == ZXC_OFF_ENC_FAR)
+                    off = zxc_cost_read_vbyte(&e_ptr, e_end);
+                if (gh.rep_offsets) {
+                    rep[2] = rep[1];
+                    rep[1] = rep[0];
+                    rep[0] = off;
+                }
+            }
+        } else {
+            uint32_t seq = zxc_le32(t_ptr + 4 * (size_t)i);
+            ll = seq >> 24;
+            ml = (seq >> 16) & 0xFF;
+            off = seq & 0xFFFF;
+            if (ll == ZXC_SEQ_LL_MASK) ll += zxc_cost_read_vbyte(&e_ptr, e_end);
+            if (e_ptr && ml == ZXC_SEQ_ML_MASK) ml += zxc_cost_read_vbyte(&e_ptr, e_end);
+        }
+        if (UNLIKELY(!e_ptr)) return UINT64_MAX;
+        ml += ZXC_LZ_MIN_MATCH_LEN;
+        cycles += zxc_lit_decode_cycles(m, ll) + zxc_match_decode_cycles(m, ml, off);
+        produced += (uint64_t)ll + ml;
+    }
+    if (UNLIKELY(produced > raw_size)) return UINT64_MAX;
+
+    // Trailing literals: one exact copy
+    cycles += (uint64_t)m->copy_cycles * ((raw_size - produced + 31) / 32);
+    *n_seq = gh.n_sequences;
+    return cycles;
+}
+
+uint64_t zxc_estimate_block_cycles(const uint8_t* block, size_t size,
+                                   const zxc_cost_model_t* m, uint32_t* n_seq) {
+    zxc_block_header_t bh;
+    *n_seq = 0;
+    if (zxc_read_block_header(block, size, &bh) != 0) return UINT64_MAX;
+    const size_t checksum_sz =
+        (bh.block_flags & ZXC_BLOCK_FLAG_CHECKSUM) ? ZXC_BLOCK_CHECKSUM_SIZE : 0;
+    if (UNLIKELY(ZXC_BLOCK_HEADER_SIZE + checksum_sz + bh.comp_size > size)) return UINT64_MAX;
+
+    if (bh.block_type == ZXC_BLOCK_GLO || bh.block_type == ZXC_BLOCK_GHI) {
+        const uint64_t lz = zxc_estimate_lz_block(block + ZXC_BLOCK_HEADER_SIZE + checksum_sz,
+                                                  bh.comp_size, bh.block_type, bh.raw_size, m,
+                                                  n_seq);
+        // Block filter: one more pass over the block to undo it
+        if (lz == UINT64_MAX ||
+            !(bh.block_flags & (ZXC_BLOCK_FLAG_SHUFFLE | ZXC_BLOCK_FLAG_BCJ)))
+            return lz;
+        return lz + (uint64_t)m->copy_cycles * ((bh.raw_size + 31) / 32);
+    }
+    if (bh.block_type == ZXC_BLOCK_RAW || bh.block_type == ZXC_BLOCK_NUM ||
+        bh.block_type == ZXC_BLOCK_FLT)
+        return (uint64_t)m->copy_cycles * ((bh.raw_size + 31) / 32);
+    return UINT64_MAX;
+}
+
+// cppcheck-suppress unusedFunction
+size_t zxc_estimate_decode_cost(const void* src, size_t src_size,
+                                const zxc_cost_model_t* model, zxc_block_cost_t* blocks,
+                                size_t max_blocks) {
+    if (UNLIKELY(!src || (!blocks && max_blocks > 0))) return 0;
+
+    zxc_cost_model_t def;
+    if (!model) {
+        zxc_cost_model_init(&def, 0);
+        model = &def;
+    }
+
+    const uint8_t* base = (const uint8_t*)src;
+    const uint8_t* ip_end = base + src_size;
+    int h_size = zxc_read_file_header(base, src_size, NULL, NULL, NULL, NULL);
+    if (h_size < 0) return 0;
+
+    const uint8_t* ip = base + h_size;
+    size_t raw_offset = 0;
+    size_t n = 0;
+
+    while (ip < ip_end) {
+        zxc_block_header_t bh;
+        if (zxc_read_block_header(ip, (size_t)(ip_end - ip), &bh) != 0) return 0;
+        if (bh.block_type == ZXC_BLOCK_SEK) break;
+
+        size_t checksum_sz =
+            (bh.block_flags & ZXC_BLOCK_FLAG_CHECKSUM) ? ZXC_BLOCK_CHECKSUM_SIZE : 0;
+        size_t total_block_sz = ZXC_BLOCK_HEADER_SIZE + bh.comp_size + checksum_sz;
+        if (UNLIKELY(total_block_sz > (size_t)(ip_end - ip))) return 0;
+
+        zxc_block_cost_t bc = {(size_t)(ip - base), raw_offset, bh.raw_size, bh.comp_size,
+                               0, bh.block_type, 0};
+        bc.est_cycles = zxc_estimate_block_cycles(ip, total_block_sz, model, &bc.n_sequences);
+        if (UNLIKELY(bc.est_cycles == UINT64_MAX)) return 0;
+
+        if (n < max_blocks) blocks[n] = bc;
+        n++;
+        raw_offset += bh.raw_size;
+        ip += total_block_sz;
+    }
+    return n;
+}
+
+// cppcheck-suppress unusedFunction
+size_t zxc_decompress_block_dctx(zxc_dctx_t* dctx, const void* src, size_t src_size,
+                                 const zxc_block_cost_t* block, void* frame, size_t frame_size,
+                                 int checksum_enabled) {
+    if (UNLIKELY(!dctx || !src || !block || !frame)) return 0;
+
+    const uint8_t* base = (const uint8_t*)src;
+    size_t runtime_chunk_size = 0;
+    int linked = 0;
+    uint32_t dict_id = 0;
+    int h_size =
+        zxc_read_file_header(base, src_size, &runtime_chunk_size, NULL, &linked, &dict_id);
+    if (h_size < 0 || (dict_id && dict_id != dctx->dict_id)) return 0;
+    if (UNLIKELY(block->comp_offset < (size_t)h_size || block->comp_offset >= src_size ||
+                 block->raw_offset > frame_size))
+        return 0;
+
+    // Only the first block starts the frame; a linked block reads the tail of
+    // the previous one (a full block) right before it in `frame`
+    const int first = block->comp_offset == (size_t)h_size;
+    if (UNLIKELY(first != (block->raw_offset == 0))) return 0;
+    size_t prefix = 0;
+    if (linked && !first) {
+        prefix = runtime_chunk_size < ZXC_LINK_WINDOW ? runtime_chunk_size : ZXC_LINK_WINDOW;
+        if (prefix > block->raw_offset) prefix = block->raw_offset;
+    }
+
+    const uint8_t* ip = base + block->comp_offset;
+    const size_t rem_src = src_size - block->comp_offset;
+    uint8_t* op = (uint8_t*)frame + block->raw_offset;
+    const size_t rem_cap = frame_size - block->raw_offset;
+    dctx->checksum_enabled = checksum_enabled;
+    dctx->prefix_len = prefix;
+    int res = (dict_id && first) ? zxc_decompress_dict_block(dctx, ip, rem_src, op, rem_cap)
+                                 : zxc_decompress_chunk_wrapper(dctx, ip, rem_src, op, rem_cap);
+    dctx->prefix_len = 0;
+    return res < 0 ? 0 : (size_t)res;
 }
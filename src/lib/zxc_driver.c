@@ -89,16 +89,554 @@ static int pthread_join(pthread_t thread, void** retval) {
 #define sysconf(x) zxc_get_num_procs()
 #define _SC_NPROCESSORS_ONLN 0
 
+#define fseeko _fseeki64
+#define ftello _ftelli64
+
+#include <io.h>
+
 #else
 #include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <unistd.h>
 #endif
 
+/*
+ * ============================================================================
+ * ATOMICS & SPIN-THEN-PARK WAITING
+ * ============================================================================
+ * The streaming engine hands jobs between threads through atomic slot states
+ * and a lock-free queue. A thread that finds nothing to do spins briefly (the
+ * common case at high throughput, where the next job is microseconds away) and
+ * only then parks on a condition variable. Notifiers skip the mutex entirely
+ * unless someone is actually parked.
+ */
+// All operations are sequentially consistent: the spin-then-park protocol relies
+// on a store/load ordering that acquire/release alone does not provide.
+#if ZXC_USE_C11_ATOMICS
+#define ZXC_ATOMIC_LOAD(p) atomic_load(p)
+#define ZXC_ATOMIC_STORE(p, v) atomic_store((p), (v))
+#define ZXC_ATOMIC_ADD(p, v) atomic_fetch_add((p), (v))
+#define ZXC_ATOMIC_CAS(p, e, d) atomic_compare_exchange_weak((p), (e), (d))
+#elif defined(_MSC_VER)
+// Full-barrier Interlocked operations: all atomics used here are 32-bit wide.
+#define ZXC_ATOMIC_LOAD(p) _InterlockedOr((volatile long*)(p), 0)
+#define ZXC_ATOMIC_STORE(p, v) _InterlockedExchange((volatile long*)(p), (long)(v))
+#define ZXC_ATOMIC_ADD(p, v) _InterlockedExchangeAdd((volatile long*)(p), (long)(v))
+#define ZXC_ATOMIC_CAS(p, e, d) zxc_msvc_cas32((volatile long*)(p), (long*)(e), (long)(d))
+static int zxc_msvc_cas32(volatile long* p, long* expected, long desired) {
+    long prev = _InterlockedCompareExchange(p, desired, *expected);
+    if (prev == *expected) return 1;
+    *expected = prev;
+    return 0;
+}
+#else
+#define ZXC_ATOMIC_LOAD(p) __atomic_load_n((p), __ATOMIC_SEQ_CST)
+#define ZXC_ATOMIC_STORE(p, v) __atomic_store_n((p), (v), __ATOMIC_SEQ_CST)
+#define ZXC_ATOMIC_ADD(p, v) __atomic_fetch_add((p), (v), __ATOMIC_SEQ_CST)
+#define ZXC_ATOMIC_CAS(p, e, d) \
+    __atomic_compare_exchange_n((p), (e), (d), 1, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST)
+#endif
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define ZXC_CPU_RELAX() _mm_pause()
+#elif defined(_MSC_VER) && (defined(_M_ARM64) || defined(_M_ARM))
+#define ZXC_CPU_RELAX() __yield()
+#elif defined(__GNUC__) && (defined(__aarch64__) || defined(__arm__))
+#define ZXC_CPU_RELAX() __asm__ __volatile__("yield" ::: "memory")
+#else
+#define ZXC_CPU_RELAX() ((void)0)
+#endif
+
+/**
+ * @brief Number of polls (each followed by a CPU pause) before a waiter parks.
+ * Covers a hand-off that is already in flight; longer waits (a whole block
+ * being processed) are better spent asleep. Disabled on single-CPU machines.
+ */
+#define ZXC_SPIN_COUNT 256
+
+/**
+ * @typedef zxc_wait_pred_t
+ * @brief Condition a parked thread is waiting for. Must only read atomics.
+ */
+typedef int (*zxc_wait_pred_t)(const void* arg);
+
+/**
+ * @struct zxc_parker_t
+ * @brief Parking spot for threads waiting on a lock-free condition.
+ *
+ * @var zxc_parker_t::waiters
+ *      Number of threads currently parked (or about to park). Lets notifiers
+ * skip the mutex when nobody sleeps.
+ * @var zxc_parker_t::spin
+ *      Number of polls before parking.
+ * @var zxc_parker_t::lock
+ *      Mutex paired with `cond`; only taken on the slow path.
+ * @var zxc_parker_t::cond
+ *      Condition variable parked threads sleep on.
+ */
+typedef struct {
+    ZXC_ATOMIC int waiters;
+    int spin;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+} zxc_parker_t;
+
+static void zxc_parker_init(zxc_parker_t* p, int spin) {
+    ZXC_ATOMIC_STORE(&p->waiters, 0);
+    p->spin = spin;
+    pthread_mutex_init(&p->lock, NULL);
+    pthread_cond_init(&p->cond, NULL);
+}
+
+static void zxc_parker_destroy(zxc_parker_t* p) {
+    pthread_mutex_destroy(&p->lock);
+    pthread_cond_destroy(&p->cond);
+}
+
+/**
+ * @brief Blocks until `ready(arg)` holds: spins first, then parks.
+ *
+ * The waiter publishes itself in `waiters` before its final check, while the
+ * notifier publishes the state change before reading `waiters` in
+ * `zxc_unpark`. With sequentially consistent atomics one of the two is
+ * guaranteed to see the other, so a wake-up cannot be lost.
+ *
+ * @param[in] p     Parking spot shared with the notifying thread(s).
+ * @param[in] ready Predicate to wait for.
+ * @param[in] arg   Argument forwarded to `ready`.
+ */
+static void zxc_park_until(zxc_parker_t* p, zxc_wait_pred_t ready, const void* arg) {
+    for (int i = 0; i < p->spin; i++) {
+        if (ready(arg)) return;
+        ZXC_CPU_RELAX();
+    }
+    pthread_mutex_lock(&p->lock);
+    ZXC_ATOMIC_ADD(&p->waiters, 1);
+    while (!ready(arg)) pthread_cond_wait(&p->cond, &p->lock);
+    ZXC_ATOMIC_ADD(&p->waiters, -1);
+    pthread_mutex_unlock(&p->lock);
+}
+
+/**
+ * @brief Wakes threads parked on `p`. Call after publishing the state change.
+ *
+ * @param[in] p   Parking spot.
+ * @param[in] all Wake every parked thread (1) or a single one (0).
+ */
+static void zxc_unpark(zxc_parker_t* p, int all) {
+    if (LIKELY(ZXC_ATOMIC_LOAD(&p->waiters) == 0)) return;
+    pthread_mutex_lock(&p->lock);
+    if (all)
+        pthread_cond_broadcast(&p->cond);
+    else
+        pthread_cond_signal(&p->cond);
+    pthread_mutex_unlock(&p->lock);
+}
+
+/*
+ * ============================================================================
+ * LOCK-FREE MPMC QUEUE
+ * ============================================================================
+ * Bounded multi-producer / multi-consumer queue of job indices using
+ * sequence-numbered slots. Each slot carries a sequence counter telling
+ * producers and consumers whose turn it is, so a push or a pop costs a
+ * single CAS on the shared position and never blocks.
+ */
+
+/**
+ * @struct zxc_mpmc_cell_t
+ * @brief One queue slot, padded to a cache line.
+ *
+ * @var zxc_mpmc_cell_t::seq
+ *      Equals the position when the slot is free for that push, position + 1
+ * once it holds data for that pop.
+ * @var zxc_mpmc_cell_t::job
+ *      The queued job index.
+ */
+typedef struct {
+    ZXC_ATOMIC uint32_t seq;
+    int job;
+    char pad[ZXC_CACHE_LINE_SIZE - sizeof(uint32_t) - sizeof(int)];
+} zxc_mpmc_cell_t;
+
+/**
+ * @struct zxc_mpmc_queue_t
+ * @brief Queue state. Positions are free-running 32-bit counters; the head
+ * and tail live on separate cache lines.
+ */
+typedef struct {
+    zxc_mpmc_cell_t* cells;
+    uint32_t mask;
+    char pad0[ZXC_CACHE_LINE_SIZE];
+    ZXC_ATOMIC uint32_t enq_pos;
+    char pad1[ZXC_CACHE_LINE_SIZE];
+    ZXC_ATOMIC uint32_t deq_pos;
+    char pad2[ZXC_CACHE_LINE_SIZE];
+} zxc_mpmc_queue_t;
+
+/**
+ * @brief Initializes a queue over `cap` caller-provided cells.
+ * @param[in] cap Number of cells; must be a power of two.
+ */
+static void zxc_mpmc_init(zxc_mpmc_queue_t* q, zxc_mpmc_cell_t* cells, uint32_t cap) {
+    q->cells = cells;
+    q->mask = cap - 1;
+    for (uint32_t i = 0; i < cap; i++) ZXC_ATOMIC_STORE(&cells[i].seq, i);
+    ZXC_ATOMIC_STORE(&q->enq_pos, 0);
+    ZXC_ATOMIC_STORE(&q->deq_pos, 0);
+}
+
+/**
+ * @brief Enqueues a job index.
+ * @return 1 on success, 0 if the queue is full.
+ */
+static int zxc_mpmc_push(zxc_mpmc_queue_t* q, int job) {
+    uint32_t pos = ZXC_ATOMIC_LOAD(&q->enq_pos);
+    zxc_mpmc_cell_t* cell;
+    for (;;) {
+        cell = &q->cells[pos & q->mask];
+        int32_t dif = (int32_t)(ZXC_ATOMIC_LOAD(&cell->seq) - pos);
+        if (dif == 0) {
+            if (ZXC_ATOMIC_CAS(&q->enq_pos, &pos, pos + 1)) break;
+        } else if (dif < 0) {
+            return 0;
+        } else {
+            pos = ZXC_ATOMIC_LOAD(&q->enq_pos);
+        }
+    }
+    cell->job = job;
+    ZXC_ATOMIC_STORE(&cell->seq, pos + 1);
+    return 1;
+}
+
+/**
+ * @brief Dequeues a job index.
+ * @param[out] job Receives the index on success.
+ * @return 1 on success, 0 if the queue is empty.
+ */
+static int zxc_mpmc_pop(zxc_mpmc_queue_t* q, int* job) {
+    uint32_t pos = ZXC_ATOMIC_LOAD(&q->deq_pos);
+    zxc_mpmc_cell_t* cell;
+    for (;;) {
+        cell = &q->cells[pos & q->mask];
+        int32_t dif = (int32_t)(ZXC_ATOMIC_LOAD(&cell->seq) - (pos + 1));
+        if (dif == 0) {
+            if (ZXC_ATOMIC_CAS(&q->deq_pos, &pos, pos + 1)) break;
+        } else if (dif < 0) {
+            return 0;
+        } else {
+            pos = ZXC_ATOMIC_LOAD(&q->deq_pos);
+        }
+    }
+    *job = cell->job;
+    ZXC_ATOMIC_STORE(&cell->seq, pos + q->mask + 1);
+    return 1;
+}
+
+/**
+ * @brief Non-destructive emptiness check (may report a stale "not empty").
+ */
+static int zxc_mpmc_has_items(zxc_mpmc_queue_t* q) {
+    uint32_t pos = ZXC_ATOMIC_LOAD(&q->deq_pos);
+    return (int32_t)(ZXC_ATOMIC_LOAD(&q->cells[pos & q->mask].seq) - (pos + 1)) >= 0;
+}
+
+/*
+ * ============================================================================
+ * PERSISTENT THREAD POOL
+ * ============================================================================
+ * Threads sleep between operations and are handed a task (a function run once
+ * per participating thread). Each thread owns a compression context that
+ * survives across tasks, so repeated operations neither spawn threads nor
+ * reallocate working memory. Dispatch happens once per operation, so a plain
+ * mutex and condition variables are enough here.
+ */
+
+/**
+ * @typedef zxc_pool_task_t
+ * @brief Work run on a pool thread.
+ *
+ * @param arg  Task argument shared by all participating threads.
+ * @param cctx Context owned by the executing thread.
+ * @param tid  Index of the executing thread, in `[0, n_threads)`.
+ */
+typedef void (*zxc_pool_task_t)(void* arg, zxc_cctx_t* cctx, int tid);
+
+/**
+ * @struct zxc_pool_slot_t
+ * @brief Per-thread state of a pool, padded to avoid false sharing.
+ */
+typedef struct {
+    zxc_cctx_t cctx;
+    zxc_pool_t* pool;
+    pthread_t thread;
+    int tid;
+    char pad[ZXC_CACHE_LINE_SIZE];
+} zxc_pool_slot_t;
+
+/**
+ * @struct zxc_pool_s
+ * @brief Persistent thread pool (see zxc_pool.h).
+ *
+ * @var zxc_pool_s::slots
+ *      Per-thread contexts and handles.
+ * @var zxc_pool_s::n_threads
+ *      Number of pool threads.
+ * @var zxc_pool_s::call_lock
+ *      Serializes operations submitted by different callers.
+ * @var zxc_pool_s::lock
+ *      Protects the dispatch fields below.
+ * @var zxc_pool_s::cond_start
+ *      Signaled when a new task is published (or on shutdown).
+ * @var zxc_pool_s::cond_done
+ *      Signaled when the last participating thread finishes the task.
+ * @var zxc_pool_s::task
+ *      Current task.
+ * @var zxc_pool_s::task_arg
+ *      Argument of the current task.
+ * @var zxc_pool_s::task_threads
+ *      Number of threads taking part in the current task (lowest indices).
+ * @var zxc_pool_s::generation
+ *      Incremented for every task; lets threads detect new work.
+ * @var zxc_pool_s::running
+ *      Participating threads that have not finished the current task.
+ * @var zxc_pool_s::shutdown
+ *      Set by zxc_free_pool() to stop the threads.
+ * @var zxc_pool_s::ring
+ *      Scratch memory (job ring of the streaming engine, block list of the
+ * parallel buffer calls), kept for the next call.
+ * @var zxc_pool_s::ring_cap
+ *      Size of `ring` in bytes.
+ * @var zxc_pool_s::cost_model
+ *      Cost model handed to every context (see zxc_pool_set_cost_model()).
+ * @var zxc_pool_s::linked_blocks
+ *      Linked-block mode of the compressions (see zxc_pool_set_linked_blocks()).
+ * @var zxc_pool_s::block_trials
+ *      Per-block trial encoding of the compressions (see zxc_pool_set_block_trials()).
+ * @var zxc_pool_s::seek_table
+ *      Seek table after the stream compressions (see zxc_pool_set_seek_table()).
+ */
+struct zxc_pool_s {
+    zxc_pool_slot_t* slots;
+    int n_threads;
+    pthread_mutex_t call_lock;
+    pthread_mutex_t lock;
+    pthread_cond_t cond_start, cond_done;
+    zxc_pool_task_t task;
+    void* task_arg;
+    int task_threads;
+    uint64_t generation;
+    int running;
+    int shutdown;
+    uint8_t* ring;
+    size_t ring_cap;
+    zxc_cost_model_t cost_model;
+    int linked_blocks;
+    int block_trials;
+    int seek_table;
+};
+
+/**
+ * @brief Pool thread entry point: waits for tasks until shutdown.
+ */
+static void* zxc_pool_thread(void* arg) {
+    zxc_pool_slot_t* slot = (zxc_pool_slot_t*)arg;
+    zxc_pool_t* pool = slot->pool;
+    uint64_t seen = 0;
+
+    pthread_mutex_lock(&pool->lock);
+    while (1) {
+        while (pool->generation == seen && !pool->shutdown)
+            pthread_cond_wait(&pool->cond_start, &pool->lock);
+        if (pool->shutdown) break;
+        seen = pool->generation;
+        if (slot->tid >= pool->task_threads) continue;
+
+        zxc_pool_task_t task = pool->task;
+        void* task_arg = pool->task_arg;
+        pthread_mutex_unlock(&pool->lock);
+        task(task_arg, &slot->cctx, slot->tid);
+        pthread_mutex_lock(&pool->lock);
+        if (--pool->running == 0) pthread_cond_signal(&pool->cond_done);
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return NULL;
+}
+
+/**
+ * @brief Starts `task` on threads `[0, n)` of the pool and returns immediately.
+ *
+ * The caller must hold `call_lock` and call zxc_pool_wait() before submitting
+ * another task.
+ */
+static void zxc_pool_start(zxc_pool_t* pool, zxc_pool_task_t task, void* arg, int n) {
+    pthread_mutex_lock(&pool->lock);
+    pool->task = task;
+    pool->task_arg = arg;
+    pool->task_threads = n;
+    pool->running = n;
+    pool->generation++;
+    pthread_cond_broadcast(&pool->cond_start);
+    pthread_mutex_unlock(&pool->lock);
+}
+
+/**
+ * @brief Blocks until every thread taking part in the current task is done.
+ */
+static void zxc_pool_wait(zxc_pool_t* pool) {
+    pthread_mutex_lock(&pool->lock);
+    while (pool->running > 0) pthread_cond_wait(&pool->cond_done, &pool->lock);
+    pthread_mutex_unlock(&pool->lock);
+}
+
+/**
+ * @brief Returns at least `size` bytes of scratch memory owned by the pool,
+ * reusing the previous allocation when it is large enough.
+ *
+ * The caller must hold `call_lock`. Contents are not preserved.
+ *
+ * @return The scratch memory (cache-line aligned), or NULL on allocation failure.
+ */
+static uint8_t* zxc_pool_scratch(zxc_pool_t* pool, size_t size) {
+    if (pool->ring_cap < size) {
+        zxc_aligned_free(pool->ring);
+        pool->ring_cap = 0;
+        pool->ring = (uint8_t*)zxc_aligned_malloc(size, ZXC_CACHE_LINE_SIZE);
+        if (UNLIKELY(!pool->ring)) return NULL;
+        pool->ring_cap = size;
+    }
+    return pool->ring;
+}
+
+/**
+ * @brief Prepares the context of pool thread `i` and hands it the pool's cost
+ * model, linked-block mode and block trials.
+ *
+ * @return 0 on success, -1 if the context could not be allocated.
+ */
+static int zxc_pool_reserve(zxc_pool_t* pool, int i, size_t chunk_size, int mode, int level,
+                            int checksum_enabled) {
+    if (UNLIKELY(zxc_cctx_reserve(&pool->slots[i].cctx, chunk_size, mode, level,
+                                  checksum_enabled) != 0))
+        return -1;
+    pool->slots[i].cctx.cost_model = pool->cost_model;
+    pool->slots[i].cctx.linked_blocks = pool->linked_blocks;
+    pool->slots[i].cctx.block_trials = pool->block_trials;
+    return 0;
+}
+
+zxc_pool_t* zxc_create_pool(int n_threads) {
+    int n = (n_threads > 0) ? n_threads : (int)sysconf(_SC_NPROCESSORS_ONLN);
+    // The streaming engine needs at least one worker next to its writer.
+    if (n < 2) n = 2;
+
+    zxc_pool_t* pool = (zxc_pool_t*)calloc(1, sizeof(zxc_pool_t));
+    if (UNLIKELY(!pool)) return NULL;
+    pool->slots = (zxc_pool_slot_t*)calloc((size_t)n, sizeof(zxc_pool_slot_t));
+    if (UNLIKELY(!pool->slots)) {
+        free(pool);
+        return NULL;
+    }
+
+    pool->seek_table = 1;
+    pthread_mutex_init(&pool->call_lock, NULL);
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->cond_start, NULL);
+    pthread_cond_init(&pool->cond_done, NULL);
+
+    for (int i = 0; i < n; i++) {
+        pool->slots[i].pool = pool;
+        pool->slots[i].tid = i;
+        if (UNLIKELY(pthread_create(&pool->slots[i].thread, NULL, zxc_pool_thread,
+                                    &pool->slots[i]) != 0)) {
+            zxc_free_pool(pool);
+            return NULL;
+        }
+        pool->n_threads = i + 1;
+    }
+    return pool;
+}
+
+void zxc_free_pool(zxc_pool_t* pool) {
+    if (!pool) return;
+
+    pthread_mutex_lock(&pool->lock);
+    pool->shutdown = 1;
+    pthread_cond_broadcast(&pool->cond_start);
+    pthread_mutex_unlock(&pool->lock);
+
+    for (int i = 0; i < pool->n_threads; i++) {
+        pthread_join(pool->slots[i].thread, NULL);
+        zxc_cctx_free(&pool->slots[i].cctx);
+    }
+
+    zxc_aligned_free(pool->ring);
+    pthread_mutex_destroy(&pool->call_lock);
+    pthread_mutex_destroy(&pool->lock);
+    pthread_cond_destroy(&pool->cond_start);
+    pthread_cond_destroy(&pool->cond_done);
+    free(pool->slots);
+    free(pool);
+}
+
+// cppcheck-suppress unusedFunction
+void zxc_pool_set_cost_model(zxc_pool_t* pool, const zxc_cost_model_t* model) {
+    if (UNLIKELY(!pool)) return;
+    pthread_mutex_lock(&pool->call_lock);
+    if (model)
+        pool->cost_model = *model;
+    else
+        ZXC_MEMSET(&pool->cost_model, 0, sizeof(pool->cost_model));
+    pthread_mutex_unlock(&pool->call_lock);
+}
+
+// cppcheck-suppress unusedFunction
+void zxc_pool_set_linked_blocks(zxc_pool_t* pool, int enabled) {
+    if (UNLIKELY(!pool)) return;
+    pthread_mutex_lock(&pool->call_lock);
+    pool->linked_blocks = enabled != 0;
+    pthread_mutex_unlock(&pool->call_lock);
+}
+
+// cppcheck-suppress unusedFunction
+void zxc_pool_set_block_trials(zxc_pool_t* pool, int enabled) {
+    if (UNLIKELY(!pool)) return;
+    pthread_mutex_lock(&pool->call_lock);
+    pool->block_trials = enabled != 0;
+    pthread_mutex_unlock(&pool->call_lock);
+}
+
+// cppcheck-suppress unusedFunction
+void zxc_pool_set_seek_table(zxc_pool_t* pool, int enabled) {
+    if (UNLIKELY(!pool)) return;
+    pthread_mutex_lock(&pool->call_lock);
+    pool->seek_table = enabled != 0;
+    pthread_mutex_unlock(&pool->call_lock);
+}
+
+// cppcheck-suppress unusedFunction
+int zxc_pool_load_dict(zxc_pool_t* pool, const void* dict, size_t dict_size) {
+    if (UNLIKELY(!pool)) return -1;
+    int res = 0;
+    pthread_mutex_lock(&pool->call_lock);
+    for (int i = 0; i < pool->n_threads; i++) {
+        if (UNLIKELY(zxc_cctx_load_dict(&pool->slots[i].cctx, dict, dict_size) != 0)) res = -1;
+    }
+    if (UNLIKELY(res != 0)) {
+        for (int i = 0; i < pool->n_threads; i++) zxc_cctx_load_dict(&pool->slots[i].cctx, NULL, 0);
+    }
+    pthread_mutex_unlock(&pool->call_lock);
+    return res;
+}
+
 /*
  * ============================================================================
  * STREAMING ENGINE (Producer / Worker / Consumer)
  * ============================================================================
  * Implements a Ring Buffer architecture to parallelize block processing.
+ * Slot ownership is handed over through atomic status transitions and the
+ * lock-free worker queue; no lock is taken while work keeps flowing.
  */
 
 /**
@@ -127,7 +665,9 @@ typedef enum { JOB_STATUS_FREE, JOB_STATUS_FILLED, JOB_STATUS_PROCESSED } job_st
  * lines to prevent false sharing in a multi-threaded environment.
  *
  * @var zxc_stream_job_t::in_buf
- *      Pointer to the buffer containing raw input data.
+ *      Pointer to the job's own input buffer.
+ * @var zxc_stream_job_t::in_ptr
+ *      Input data of the job: `in_buf`, or memory borrowed from the reader.
  * @var zxc_stream_job_t::in_cap
  *      The total allocated capacity of the input buffer.
  * @var zxc_stream_job_t::in_sz
@@ -139,10 +679,22 @@ typedef enum { JOB_STATUS_FREE, JOB_STATUS_FILLED, JOB_STATUS_PROCESSED } job_st
  *      The total allocated capacity of the output buffer.
  * @var zxc_stream_job_t::result_sz
  *      The actual size of the valid data produced in the output buffer.
+ * @var zxc_stream_job_t::prefix_sz
+ *      Linked blocks: size of the previous block's tail, stored right before
+ * the block (before `in_ptr` when compressing, before `out_buf` when
+ * decompressing).
+ * @var zxc_stream_job_t::prev_raw
+ *      Linked decompression: decoded size of the previous block, whose tail is
+ * the prefix. Taken from its header, as the previous slot may already carry
+ * the end marker.
+ * @var zxc_stream_job_t::dict
+ *      The prefix is the dictionary (first block of a dictionary stream).
  * @var zxc_stream_job_t::job_id
  *      A unique identifier for the job, often used for ordering or debugging.
  * @var zxc_stream_job_t::status
- *      The current state of this job (Free, Filled, or Processed).
+ *      The current state of this job (a `job_status_t`). Stored atomically
+ * after the buffers are updated and loaded before they are used, so it doubles
+ * as the hand-off barrier between threads.
  * @var zxc_stream_job_t::pad
  *      Padding bytes to ensure the structure size aligns with typical cache
  * lines (64 bytes), minimizing cache contention between threads accessing
@@ -150,11 +702,14 @@ typedef enum { JOB_STATUS_FREE, JOB_STATUS_FILLED, JOB_STATUS_PROCESSED } job_st
  */
 typedef struct {
     uint8_t* in_buf;
+    const uint8_t* in_ptr;
     size_t in_cap, in_sz;
     uint8_t* out_buf;
     size_t out_cap, result_sz;
+    size_t prefix_sz, prev_raw;
+    int dict;
     int job_id;
-    job_status_t status;
+    ZXC_ATOMIC int status;
     char pad[ZXC_CACHE_LINE_SIZE];  // Prevent False Sharing
 } zxc_stream_job_t;
 
@@ -185,8 +740,8 @@ typedef int (*zxc_chunk_processor_t)(zxc_cctx_t* ctx, const uint8_t* in, size_t
  * compression/decompression state.
  *
  * This structure orchestrates the producer-consumer workflow. It manages the
- * ring buffer of jobs, the worker queue, synchronization primitives (mutexes
- * and condition variables), and configuration settings for the compression
+ * ring buffer of jobs, the lock-free worker queue, the parking spots used when
+ * a thread runs out of work, and configuration settings for the compression
  * algorithm.
  *
  * @var zxc_stream_ctx_t::jobs
@@ -194,25 +749,15 @@ typedef int (*zxc_chunk_processor_t)(zxc_cctx_t* ctx, const uint8_t* in, size_t
  * @var zxc_stream_ctx_t::ring_size
  *      The total number of slots in the jobs array.
  * @var zxc_stream_ctx_t::worker_queue
- *      A circular queue containing indices of jobs ready to be picked up by
- * worker threads.
- * @var zxc_stream_ctx_t::wq_head
- *      Index of the head of the worker queue (where workers take jobs).
- * @var zxc_stream_ctx_t::wq_tail
- *      Index of the tail of the worker queue (where the writer adds jobs).
- * @var zxc_stream_ctx_t::wq_count
- *      Current number of items in the worker queue.
- * @var zxc_stream_ctx_t::lock
- *      Mutex used to protect access to shared resources (queue indices, status
- * changes).
- * @var zxc_stream_ctx_t::cond_reader
- *      Condition variable to signal the output thread (reader) that processed
- * data is available.
- * @var zxc_stream_ctx_t::cond_worker
- *      Condition variable to signal worker threads that new work is available.
- * @var zxc_stream_ctx_t::cond_writer
- *      Condition variable to signal the input thread (writer) that job slots
- * are free.
+ *      Lock-free MPMC queue containing indices of jobs ready to be picked up
+ * by worker threads.
+ * @var zxc_stream_ctx_t::park_reader
+ *      Where the main thread (reader) waits for a job slot to become free.
+ * @var zxc_stream_ctx_t::park_worker
+ *      Where idle worker threads wait for new work.
+ * @var zxc_stream_ctx_t::park_writer
+ *      Where the writer thread waits for the next job in order to be
+ * processed.
  * @var zxc_stream_ctx_t::shutdown_workers
  *      Flag indicating that worker threads should terminate.
  * @var zxc_stream_ctx_t::compression_mode
@@ -222,30 +767,31 @@ typedef int (*zxc_chunk_processor_t)(zxc_cctx_t* ctx, const uint8_t* in, size_t
  * @var zxc_stream_ctx_t::processor
  *      Function pointer or object responsible for the actual chunk processing
  * logic.
- * @var zxc_stream_ctx_t::write_idx
- *      The index of the next job slot to be written to by the main thread.
  * @var zxc_stream_ctx_t::checksum_enabled
  *      Flag indicating whether checksum verification/generation is active.
  * @var zxc_stream_ctx_t::compression_level
  *      The configured level of compression (trading off speed vs. ratio).
  * @var zxc_stream_ctx_t::chunk_size
  *      The size of each data chunk to be processed.
+ * @var zxc_stream_ctx_t::linked
+ *      Blocks are linked: each one may reference the previous block's tail.
+ * @var zxc_stream_ctx_t::seek_table
+ *      Compression: a seek table follows the last block.
  */
 typedef struct {
     zxc_stream_job_t* jobs;
     int ring_size;
-    int* worker_queue;
-    int wq_head, wq_tail, wq_count;
-    pthread_mutex_t lock;
-    pthread_cond_t cond_reader, cond_worker, cond_writer;
-    int shutdown_workers;
+    zxc_mpmc_queue_t worker_queue;
+    zxc_parker_t park_reader, park_worker, park_writer;
+    ZXC_ATOMIC int shutdown_workers;
     int compression_mode;
     ZXC_ATOMIC int io_error;
     zxc_chunk_processor_t processor;
-    int write_idx;
     int checksum_enabled;
     int compression_level;
     size_t chunk_size;
+    int linked;
+    int seek_table;
 } zxc_stream_ctx_t;
 
 /**
@@ -260,197 +806,514 @@ typedef struct {
  * Pointer to the ZXC stream context, holding the state of the
  * compression/decompression stream.
  *
- * @var writer_args_t::f
- * Pointer to the output file stream where data will be written.
+ * @var writer_args_t::out
+ * Output sink, or NULL to discard the output.
  *
  * @var writer_args_t::total_bytes
  * Accumulator for the total number of bytes written to the file so far.
+ *
+ * @var writer_args_t::raw_bytes
+ * Accumulator for the total number of uncompressed bytes covered by the
+ * blocks written so far (compression mode only).
+ *
+ * @var writer_args_t::seek
+ * Growable array of seek entries, one per written block (compression mode only).
+ *
+ * @var writer_args_t::seek_count
+ * Number of valid entries in `seek`.
+ *
+ * @var writer_args_t::seek_cap
+ * Allocated capacity of `seek`, in entries.
  */
 typedef struct {
     zxc_stream_ctx_t* ctx;
-    FILE* f;
+    const zxc_writer_t* out;
     int64_t total_bytes;
+    uint64_t raw_bytes;
+    zxc_seek_entry_t* seek;
+    uint32_t seek_count, seek_cap;
 } writer_args_t;
 
 /**
- * @brief Worker thread function for parallel stream processing.
+ * @brief Wait predicate: a job is queued or the workers are shutting down.
+ */
+static int zxc_work_available(const void* arg) {
+    zxc_stream_ctx_t* ctx = (zxc_stream_ctx_t*)arg;
+    return zxc_mpmc_has_items(&ctx->worker_queue) || ZXC_ATOMIC_LOAD(&ctx->shutdown_workers);
+}
+
+/**
+ * @brief Wait predicate: the job has been processed by a worker.
+ */
+static int zxc_job_is_processed(const void* arg) {
+    zxc_stream_job_t* job = (zxc_stream_job_t*)arg;
+    return ZXC_ATOMIC_LOAD(&job->status) == JOB_STATUS_PROCESSED;
+}
+
+/**
+ * @brief Wait predicate: the job slot has been released by the writer.
+ */
+static int zxc_job_is_free(const void* arg) {
+    zxc_stream_job_t* job = (zxc_stream_job_t*)arg;
+    return ZXC_ATOMIC_LOAD(&job->status) == JOB_STATUS_FREE;
+}
+
+/**
+ * @brief Copies the previous block's tail in front of a job's output (linked
+ * decompression).
  *
- * This function serves as the entry point for worker threads in the ZXC
- * streaming compression/decompression context. It continuously retrieves jobs
- * from a shared work queue, processes them using a thread-local compression
- * context (`zxc_cctx_t`), and signals the writer thread upon completion.
+ * Linked streams are decoded by a single worker, so jobs are processed in
+ * order: the previous job is complete and its output buffer is not reused
+ * before this job is done.
+ *
+ * @return 0 on success, -1 if the previous block does not fit its buffer.
+ */
+static int zxc_stream_link_output(zxc_stream_ctx_t* ctx, int jid) {
+    zxc_stream_job_t* job = &ctx->jobs[jid];
+    const zxc_stream_job_t* prev = &ctx->jobs[(jid + ctx->ring_size - 1) % ctx->ring_size];
+    if (UNLIKELY(job->prev_raw > prev->out_cap)) return -1;
+    ZXC_MEMCPY(job->out_buf - job->prefix_sz, prev->out_buf + job->prev_raw - job->prefix_sz,
+               job->prefix_sz);
+    return 0;
+}
+
+/**
+ * @brief Worker loop for parallel stream processing.
+ *
+ * Runs on a pool thread for the duration of one stream operation. It
+ * continuously retrieves jobs from a shared work queue, processes them using
+ * the thread's own compression context (`zxc_cctx_t`), and signals the writer
+ * thread upon completion.
  *
  * **Worker Lifecycle & Synchronization:**
- * 1. **Initialization:** Allocates a thread-local `zxc_cctx_t` to avoid lock
- * contention during compression/decompression.
- * 2. **Wait Loop:** Uses `pthread_cond_wait` on `cond_worker` to sleep until a
- * job is available in the `worker_queue`.
- * 3. **Job Retrieval:** Dequeues a job ID from the ring buffer. The
- * `worker_queue` acts as a load balancer.
- * 4. **Processing:** Calls `ctx->processor` (the compression/decompression
+ * 1. **Initialization:** The pool slot's `zxc_cctx_t` has already been sized
+ * for this stream by the caller; it is private to this thread, so there is no
+ * lock contention during compression/decompression.
+ * 2. **Job Retrieval:** Pops a job ID from the lock-free `worker_queue`, which
+ * acts as a load balancer. When it is empty, the worker spins briefly and then
+ * parks on `park_worker`.
+ * 3. **Processing:** Calls `ctx->processor` (the compression/decompression
  * function) on the job's data. This is the CPU-intensive part and runs in
  * parallel.
- * 5. **Completion:** Updates `job->status` to `JOB_STATUS_PROCESSED`.
- * 6. **Signaling:** If the processed job is the *next* one expected by the
- * writer
- *    (`jid == ctx->write_idx`), it signals `cond_writer`. This optimization
- * prevents unnecessary wake-ups of the writer thread for out-of-order
- * completions.
+ * 4. **Completion:** Publishes `JOB_STATUS_PROCESSED` with an atomic store and
+ * wakes the writer if it is parked.
  *
- * @param[in] arg A pointer to the shared stream context (`zxc_stream_ctx_t`).
- * @return Always returns NULL.
+ * @param[in] ctx  The shared stream context.
+ * @param[in,out] cctx The executing thread's context.
  */
-static void* zxc_stream_worker(void* arg) {
-    zxc_stream_ctx_t* ctx = (zxc_stream_ctx_t*)arg;
-    zxc_cctx_t cctx;
-
-    if (zxc_cctx_init(&cctx, ctx->chunk_size, ctx->compression_mode, ctx->compression_level,
-                      ctx->checksum_enabled) != 0) {
-        zxc_cctx_free(&cctx);
-        return NULL;
-    }
-
-    cctx.checksum_enabled = ctx->checksum_enabled;
-    cctx.compression_level = ctx->compression_level;
-
+static void zxc_stream_worker(zxc_stream_ctx_t* ctx, zxc_cctx_t* cctx) {
     while (1) {
-        zxc_stream_job_t* job = NULL;
-        pthread_mutex_lock(&ctx->lock);
-        while (ctx->wq_count == 0 && !ctx->shutdown_workers) {
-            pthread_cond_wait(&ctx->cond_worker, &ctx->lock);
-        }
-        if (ctx->shutdown_workers && ctx->wq_count == 0) {
-            pthread_mutex_unlock(&ctx->lock);
-            break;
+        int jid;
+        if (!zxc_mpmc_pop(&ctx->worker_queue, &jid)) {
+            // Jobs are all drained before shutdown is requested.
+            if (ZXC_ATOMIC_LOAD(&ctx->shutdown_workers)) break;
+            zxc_park_until(&ctx->park_worker, zxc_work_available, ctx);
+            continue;
         }
-        int jid = ctx->worker_queue[ctx->wq_tail];
-        ctx->wq_tail = (ctx->wq_tail + 1) % ctx->ring_size;
-        ctx->wq_count--;
-        job = &ctx->jobs[jid];
-        pthread_mutex_unlock(&ctx->lock);
-
-        int res = ctx->processor(&cctx, job->in_buf, job->in_sz, job->out_buf, job->out_cap);
-        pthread_mutex_lock(&ctx->lock);
+        zxc_stream_job_t* job = &ctx->jobs[jid];
 
+        int res = -1;
+        cctx->prefix_len = job->prefix_sz;
+        cctx->prefix_is_dict = job->dict;
+        if (ctx->compression_mode == 1 || job->prefix_sz == 0 || job->dict ||
+            zxc_stream_link_output(ctx, jid) == 0)
+            res = ctx->processor(cctx, job->in_ptr, job->in_sz, job->out_buf, job->out_cap);
+        cctx->prefix_is_dict = 0;
         if (UNLIKELY(res < 0)) {
             ctx->io_error = 1;
             job->result_sz = 0;
-            job->status = JOB_STATUS_PROCESSED;
-            pthread_cond_broadcast(&ctx->cond_writer);
-            pthread_cond_broadcast(&ctx->cond_reader);
         } else {
             job->result_sz = (size_t)res;
-            job->status = JOB_STATUS_PROCESSED;
-            if (jid == ctx->write_idx) pthread_cond_broadcast(&ctx->cond_writer);
         }
-        pthread_mutex_unlock(&ctx->lock);
+        ZXC_ATOMIC_STORE(&job->status, JOB_STATUS_PROCESSED);
+        zxc_unpark(&ctx->park_writer, 0);
     }
-    zxc_cctx_free(&cctx);
-    return NULL;
 }
 
 /**
- * @brief Asynchronous writer thread function.
+ * @brief Asynchronous writer loop.
  *
- * This function runs as a separate thread responsible for writing processed
+ * This function runs on a dedicated pool thread and is responsible for writing processed
  * data chunks to the output file. It operates on a ring buffer of jobs shared
  * with the reader and worker threads.
  *
  * **Ordering Enforcement:**
  * The writer MUST write blocks in the exact order they were read. Even if
  * worker threads finish jobs out of order (e.g., job 2 finishes before job 1),
- * the writer waits for `ctx->write_idx` (job 1) to be `JOB_STATUS_PROCESSED`.
+ * the writer waits for the next slot in sequence (job 1) to be
+ * `JOB_STATUS_PROCESSED`.
  *
  * **Workflow:**
- * 1. **Wait:** Sleeps on `cond_writer` until the job at `ctx->write_idx` is
- * ready.
+ * 1. **Wait:** Spins, then parks on `park_writer`, until the next job in
+ * sequence is ready.
  * 2. **Write:** Writes the `out_buf` to the file.
- * 3. **Release:** Sets the job status to `JOB_STATUS_FREE` and signals
- * `cond_reader`, allowing the main thread to reuse this slot for new input.
- * 4. **Advance:** Increments `ctx->write_idx` to wait for the next sequential
- * block.
+ * 3. **Release:** Sets the job status to `JOB_STATUS_FREE` and wakes the
+ * reader, allowing the main thread to reuse this slot for new input.
+ * 4. **Advance:** Moves on to the next sequential slot.
+ *
+ * Once an error has been raised, the writer keeps releasing slots without
+ * writing them, so the reader and workers always drain and reach the end
+ * marker.
  *
- * @param[in] arg Pointer to a `writer_args_t` structure containing the stream
- * context, the output file handle, and a counter for total bytes written.
- * @return Always returns NULL.
+ * In compression mode with a seek table, the writer also records a seek entry
+ * for every block it emits; the table is appended to the output once the
+ * stream is complete.
+ *
+ * @param[in,out] args Stream context, output file handle, and the counters
+ * and seek entries accumulated while writing.
  */
-static void* zxc_async_writer(void* arg) {
-    writer_args_t* args = (writer_args_t*)arg;
+static void zxc_async_writer(writer_args_t* args) {
     zxc_stream_ctx_t* ctx = args->ctx;
+    int write_idx = 0;
     while (1) {
-        zxc_stream_job_t* job = &ctx->jobs[ctx->write_idx];
-        pthread_mutex_lock(&ctx->lock);
-        while (job->status != JOB_STATUS_PROCESSED)
-            pthread_cond_wait(&ctx->cond_writer, &ctx->lock);
-
-        if (job->result_sz == (size_t)-1) {
-            pthread_mutex_unlock(&ctx->lock);
-            break;
-        }
-        pthread_mutex_unlock(&ctx->lock);
+        zxc_stream_job_t* job = &ctx->jobs[write_idx];
+        zxc_park_until(&ctx->park_writer, zxc_job_is_processed, job);
+        if (job->result_sz == (size_t)-1) break;
 
-        if (args->f && job->result_sz > 0) {
-            if (fwrite(job->out_buf, 1, job->result_sz, args->f) != job->result_sz) {
+        if (args->out && job->result_sz > 0 && LIKELY(!ctx->io_error)) {
+            if (args->out->write(args->out->opaque, job->out_buf, job->result_sz) != 0) {
                 ctx->io_error = 1;
             }
+            if (ctx->seek_table && !ctx->io_error) {
+                if (args->seek_count == args->seek_cap) {
+                    uint32_t cap = args->seek_cap ? args->seek_cap * 2 : 64;
+                    zxc_seek_entry_t* grown = realloc(args->seek, cap * sizeof(zxc_seek_entry_t));
+                    if (UNLIKELY(!grown)) {
+                        ctx->io_error = 1;
+                    } else {
+                        args->seek = grown;
+                        args->seek_cap = cap;
+                    }
+                }
+                if (LIKELY(!ctx->io_error)) {
+                    zxc_seek_entry_t* e = &args->seek[args->seek_count++];
+                    e->comp_offset = (uint64_t)args->total_bytes;
+                    e->raw_offset = args->raw_bytes;
+                    e->comp_size = (uint32_t)job->result_sz;
+                    e->raw_size = (uint32_t)job->in_sz;
+                    args->raw_bytes += job->in_sz;
+                }
+            }
         }
-        if (UNLIKELY(ctx->io_error)) {
-            pthread_mutex_lock(&ctx->lock);
-            job->status = JOB_STATUS_FREE;
-            pthread_cond_signal(&ctx->cond_reader);
-            pthread_mutex_unlock(&ctx->lock);
-            break;
+        if (LIKELY(!ctx->io_error)) args->total_bytes += (int64_t)job->result_sz;
+
+        ZXC_ATOMIC_STORE(&job->status, JOB_STATUS_FREE);
+        zxc_unpark(&ctx->park_reader, 0);
+        write_idx = (write_idx + 1) % ctx->ring_size;
+    }
+}
+
+/**
+ * @brief Pool task of a stream operation: thread 0 is the writer, all other
+ * participating threads are workers.
+ */
+static void zxc_stream_task(void* arg, zxc_cctx_t* cctx, int tid) {
+    writer_args_t* args = (writer_args_t*)arg;
+    if (tid == 0)
+        zxc_async_writer(args);
+    else
+        zxc_stream_worker(args->ctx, cctx);
+}
+
+/**
+ * @brief Pulls up to `len` bytes from a reader, without copying if it can
+ * lend them.
+ *
+ * @param[in] in Input source.
+ * @param[in] buf Fallback buffer of at least `len` bytes.
+ * @param[in] len Number of bytes requested.
+ * @param[out] data Receives the location of the data: borrowed memory or `buf`.
+ * @return The number of bytes obtained (less than `len` only at the end of the
+ * input), or -1 on error.
+ */
+static int64_t zxc_io_pull(const zxc_reader_t* in, uint8_t* buf, size_t len,
+                           const uint8_t** data) {
+    if (in->borrow) {
+        size_t avail = 0;
+        const void* p = in->borrow(in->opaque, len, &avail);
+        if (p) {
+            *data = (const uint8_t*)p;
+            return avail <= len ? (int64_t)avail : -1;
         }
-        args->total_bytes += (int64_t)job->result_sz;
+    }
+    *data = buf;
+    if (UNLIKELY(!in->read)) return -1;
+    int64_t n = in->read(in->opaque, buf, len);
+    return n <= (int64_t)len ? n : -1;
+}
+
+/**
+ * @brief Same as zxc_io_pull(), but always delivers the data into `buf`.
+ */
+static int64_t zxc_io_pull_copy(const zxc_reader_t* in, uint8_t* buf, size_t len) {
+    const uint8_t* data;
+    int64_t n = zxc_io_pull(in, buf, len, &data);
+    if (n > 0 && data != buf) ZXC_MEMCPY(buf, data, (size_t)n);
+    return n;
+}
+
+/** @brief `zxc_reader_t::read` over a stdio stream. */
+static int64_t zxc_file_read(void* opaque, void* buf, size_t len) {
+    FILE* f = (FILE*)opaque;
+    size_t n = fread(buf, 1, len, f);
+    return (n < len && ferror(f)) ? -1 : (int64_t)n;
+}
+
+/** @brief `zxc_writer_t::write` over a stdio stream. */
+static int zxc_file_write(void* opaque, const void* buf, size_t len) {
+    return fwrite(buf, 1, len, (FILE*)opaque) == len ? 0 : -1;
+}
+
+/**
+ * @brief Determines how many bytes remain to be read from an input stream.
+ *
+ * Works for seekable streams (regular files, memory streams) by seeking to the
+ * end and back; pipes and terminals report an unknown size.
+ *
+ * @param[in] f Input stream, positioned where compression will start.
+ * @param[out] out_size Receives the remaining size in bytes, or
+ * `ZXC_CONTENT_SIZE_UNKNOWN` if the stream is not seekable.
+ * @return 0 on success, or -1 if the original position could not be restored.
+ */
+static int zxc_stream_remaining_size(FILE* f, uint64_t* out_size) {
+    *out_size = ZXC_CONTENT_SIZE_UNKNOWN;
+    int64_t pos = (int64_t)ftello(f);
+    if (pos < 0 || fseeko(f, 0, SEEK_END) != 0) return 0;
+
+    int64_t end = (int64_t)ftello(f);
+    if (fseeko(f, pos, SEEK_SET) != 0) return -1;
+    if (end >= pos) *out_size = (uint64_t)(end - pos);
+    return 0;
+}
+
+/*
+ * ============================================================================
+ * MEMORY-MAPPED INPUT
+ * ============================================================================
+ * When the input of a FILE-based call is a regular file, its remaining bytes
+ * are mapped and lent to the engine through `zxc_reader_t::borrow`. Workers
+ * then fault the pages in and read blocks in place: no chunk is copied into
+ * the ring, and the reader thread only hands out pointers.
+ */
+
+// Read-ahead window requested from the kernel ahead of the borrow position
+#define ZXC_MAP_READAHEAD (8 * 1024 * 1024)
+
+/**
+ * @struct zxc_map_src_t
+ * @brief Mapped view of the remaining part of an input file.
+ *
+ * @var zxc_map_src_t::base
+ *      Start of the mapping (aligned down to the mapping granularity).
+ * @var zxc_map_src_t::map_len
+ *      Length of the mapping.
+ * @var zxc_map_src_t::data
+ *      Byte of the file at the stream position when the mapping was made.
+ * @var zxc_map_src_t::size
+ *      Number of bytes available from `data`.
+ * @var zxc_map_src_t::pos
+ *      Number of bytes handed out so far.
+ * @var zxc_map_src_t::advised
+ *      Offset (from `data`) up to which read-ahead has been requested.
+ * @var zxc_map_src_t::start
+ *      File offset corresponding to `data`.
+ */
+typedef struct {
+    uint8_t* base;
+    size_t map_len;
+    const uint8_t* data;
+    size_t size;
+    size_t pos;
+    size_t advised;
+    int64_t start;
+} zxc_map_src_t;
 
-        pthread_mutex_lock(&ctx->lock);
-        job->status = JOB_STATUS_FREE;
-        ctx->write_idx = (ctx->write_idx + 1) % ctx->ring_size;
-        pthread_cond_signal(&ctx->cond_reader);
-        pthread_mutex_unlock(&ctx->lock);
+/**
+ * @brief Maps the rest of `f` from its current position.
+ *
+ * @param[in] f Input stream.
+ * @param[out] m Mapping descriptor, zeroed on failure.
+ * @return 0 if the input is mapped, or -1 if it must be read normally (not a
+ * regular file, nothing left to read, or mapping unavailable).
+ */
+static int zxc_map_open(FILE* f, zxc_map_src_t* m) {
+    ZXC_MEMSET(m, 0, sizeof(*m));
+    // Push pending writes and sync the descriptor with the stream position
+    if (fflush(f) != 0) return -1;
+    int64_t pos = (int64_t)ftello(f);
+    if (pos < 0) return -1;
+#if defined(_WIN32)
+    HANDLE fh = (HANDLE)_get_osfhandle(_fileno(f));
+    LARGE_INTEGER fsz;
+    if (fh == INVALID_HANDLE_VALUE || GetFileType(fh) != FILE_TYPE_DISK ||
+        !GetFileSizeEx(fh, &fsz) || fsz.QuadPart <= pos ||
+        (uint64_t)(fsz.QuadPart - pos) > SIZE_MAX / 2)
+        return -1;
+    SYSTEM_INFO si;
+    GetSystemInfo(&si);
+    int64_t off = pos - pos % (int64_t)si.dwAllocationGranularity;
+    size_t len = (size_t)(fsz.QuadPart - off);
+    HANDLE mh = CreateFileMappingA(fh, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (!mh) return -1;
+    void* p = MapViewOfFile(mh, FILE_MAP_READ, (DWORD)((uint64_t)off >> 32), (DWORD)off, len);
+    CloseHandle(mh);  // The view keeps the mapping alive
+    if (!p) return -1;
+    int64_t end = fsz.QuadPart;
+#else
+    struct stat st;
+    if (fstat(fileno(f), &st) != 0 || !S_ISREG(st.st_mode) || st.st_size <= pos ||
+        (uint64_t)(st.st_size - pos) > SIZE_MAX / 2)
+        return -1;
+    long page = sysconf(_SC_PAGESIZE);
+    int64_t off = pos - pos % (page > 0 ? page : 4096);
+    size_t len = (size_t)(st.st_size - off);
+    void* p = mmap(NULL, len, PROT_READ, MAP_PRIVATE, fileno(f), (off_t)off);
+    if (p == MAP_FAILED) return -1;
+    madvise(p, len, MADV_SEQUENTIAL);
+    int64_t end = (int64_t)st.st_size;
+#endif
+    m->base = (uint8_t*)p;
+    m->map_len = len;
+    m->data = m->base + (pos - off);
+    m->size = (size_t)(end - pos);
+    m->start = pos;
+    return 0;
+}
+
+/**
+ * @brief Unmaps the input and moves `f` past the bytes that were consumed,
+ * as if they had been read with fread().
+ */
+static void zxc_map_close(FILE* f, zxc_map_src_t* m) {
+    if (!m->base) return;
+#if defined(_WIN32)
+    UnmapViewOfFile(m->base);
+#else
+    munmap(m->base, m->map_len);
+#endif
+    fseeko(f, m->start + (int64_t)m->pos, SEEK_SET);
+    m->base = NULL;
+}
+
+/** @brief `zxc_reader_t::borrow` over a mapped file. */
+static const void* zxc_map_borrow(void* opaque, size_t len, size_t* avail) {
+    zxc_map_src_t* m = (zxc_map_src_t*)opaque;
+    size_t n = m->size - m->pos;
+    if (n > len) n = len;
+#if !defined(_WIN32)
+    // Keep the kernel a window ahead of the workers
+    if (m->pos + n + ZXC_MAP_READAHEAD / 2 > m->advised && m->advised < m->size) {
+        size_t from = m->advised > m->pos ? m->advised : m->pos;
+        size_t to = from + ZXC_MAP_READAHEAD;
+        if (to > m->size) to = m->size;
+        uintptr_t a = (uintptr_t)(m->data + from) & ~(uintptr_t)(sysconf(_SC_PAGESIZE) - 1);
+        madvise((void*)a, (size_t)((uintptr_t)(m->data + to) - a), MADV_WILLNEED);
+        m->advised = to;
     }
-    return NULL;
+#endif
+    const uint8_t* p = m->data + m->pos;
+    m->pos += n;
+    *avail = n;
+    return p;
+}
+
+/**
+ * @struct zxc_file_io_t
+ * @brief Callback I/O over the stdio streams of the FILE-based API.
+ */
+typedef struct {
+    zxc_reader_t in;
+    zxc_writer_t out;
+    zxc_map_src_t map;
+} zxc_file_io_t;
+
+/**
+ * @brief Wraps stdio streams into callback I/O, mapping `f_in` if possible.
+ *
+ * @param[out] io I/O adapters. Release with zxc_file_io_close().
+ * @param[in] f_in Input stream.
+ * @param[in] f_out Output stream, or NULL.
+ * @param[out] content_size If not NULL, receives the remaining size of `f_in`
+ * (see zxc_stream_remaining_size()).
+ * @return 0 on success, or -1 if `f_in` could not be restored to its position.
+ */
+static int zxc_file_io_open(zxc_file_io_t* io, FILE* f_in, FILE* f_out, uint64_t* content_size) {
+    io->out.opaque = f_out;
+    io->out.write = zxc_file_write;
+    io->in.content_size = 0;
+    if (zxc_map_open(f_in, &io->map) == 0) {
+        io->in.opaque = &io->map;
+        io->in.read = NULL;
+        io->in.borrow = zxc_map_borrow;
+        if (content_size) *content_size = io->map.size;
+        return 0;
+    }
+    io->in.opaque = f_in;
+    io->in.read = zxc_file_read;
+    io->in.borrow = NULL;
+    return content_size ? zxc_stream_remaining_size(f_in, content_size) : 0;
 }
 
+/** @brief Releases the adapters set up by zxc_file_io_open(). */
+static void zxc_file_io_close(zxc_file_io_t* io, FILE* f_in) { zxc_map_close(f_in, &io->map); }
+
 /**
  * @brief Orchestrates the multithreaded streaming compression or decompression
  * engine.
  *
- * This function initializes the stream context, allocates the necessary ring
- * buffer memory for jobs and I/O buffers, and spawns the worker threads and the
- * asynchronous writer thread. It acts as the main "producer" (reader) loop.
+ * This function initializes the stream context, sets up the ring buffer memory
+ * for jobs and I/O buffers (reused from the pool when large enough), and starts
+ * the worker loops and the asynchronous writer on the pool threads. It acts as
+ * the main "producer" (reader) loop.
  *
  * **Architecture: Producer-Consumer with Ring Buffer**
  * - **Ring Buffer:** A fixed-size array of `zxc_stream_job_t` structures.
- * - **Producer (Main Thread):** Reads chunks from `f_in` and fills "Free" slots
+ * - **Producer (Main Thread):** Reads chunks from `in` and fills "Free" slots
  *   in the ring buffer. It blocks if no slots are free (backpressure).
- * - **Workers:** Pick up "Filled" jobs from a queue, process them, and mark
- * them as "Processed".
+ * - **Workers:** Pick up "Filled" jobs from a lock-free queue, process them,
+ * and mark them as "Processed".
  * - **Consumer (Writer Thread):** Waits for the *next sequential* job to be
- *   "Processed", writes it to `f_out`, and marks the slot as "Free".
+ *   "Processed", writes it to `out`, and marks the slot as "Free".
  *
  * **Double-Buffering & Zero-Copy:**
  * We allocate `alloc_in` and `alloc_out` buffers for each job. The reader reads
  * directly into `in_buf`, and the writer writes directly from `out_buf`,
- * minimizing memory copies.
+ * minimizing memory copies. When the source can lend resident memory
+ * (`zxc_reader_t::borrow`), jobs point straight at it and `in_buf` is unused.
+ *
+ * **Content Size:**
+ * In compression mode, `content_size` (when known) is recorded in the file
+ * header. Both modes fail if the amount of data actually processed
+ * does not match a recorded size.
+ *
+ * **Seek Table:**
+ * In compression mode, a trailing SEK block indexing every data block is
+ * appended after the last block. In decompression mode, reaching a SEK block
+ * ends the stream.
  *
- * @param[in] f_in      Pointer to the input file stream (source).
- * @param[out] f_out     Pointer to the output file stream (destination).
- * @param[in] n_threads Number of worker threads to spawn. If set to 0 or less, the
- * function automatically detects the number of online processors.
+ * @param[in,out] pool  Thread pool running the writer (thread 0) and the
+ * workers (all other threads). The caller holds its `call_lock`.
+ * @param[in] in        Input source.
+ * @param[out] out      Output sink, or NULL to discard the output.
+ * @param[in] content_size Size of the input (compression mode only), or
+ * `ZXC_CONTENT_SIZE_UNKNOWN`.
  * @param[in] mode      Operation mode: 1 for compression, 0 for decompression.
  * @param[in] level     Compression level to be applied (relevant for compression
  * mode).
  * @param[in] checksum_enabled  Flag indicating whether to enable checksum
  * generation/verification.
+ * @param[in] block_size Validated block size (compression mode only; the
+ * decompressor takes it from the file header).
  * @param[in] func      Function pointer to the chunk processor (compression or
  * decompression logic).
  *
  * @return The total number of bytes written to the output stream on success, or
  * -1 if an initialization or I/O error occurred.
  */
-static int64_t zxc_stream_engine_run(FILE* f_in, FILE* f_out, int n_threads, int mode, int level,
-                                     int checksum_enabled, zxc_chunk_processor_t func) {
+static int64_t zxc_stream_engine_run(zxc_pool_t* pool, const zxc_reader_t* in,
+                                     const zxc_writer_t* out, uint64_t content_size, int mode,
+                                     int level, int checksum_enabled, size_t block_size,
+                                     zxc_chunk_processor_t func) {
     zxc_stream_ctx_t ctx;
     ZXC_MEMSET(&ctx, 0, sizeof(ctx));
 
@@ -459,111 +1322,173 @@ static int64_t zxc_stream_engine_run(FILE* f_in, FILE* f_out, int n_threads, int
     ctx.io_error = 0;
     ctx.checksum_enabled = checksum_enabled;
     ctx.compression_level = level;
+    ctx.linked = mode == 1 && pool->linked_blocks;
+    ctx.seek_table = mode == 1 && pool->seek_table;
 
-    int num_threads = (n_threads > 0) ? n_threads : (int)sysconf(_SC_NPROCESSORS_ONLN);
-    // Reserve 1 thread for Writer/Reader overhead if possible
-    int num_workers = (num_threads > 1) ? num_threads - 1 : 1;
-    ctx.ring_size = num_workers * 4;
-
-    size_t runtime_chunk_sz = ZXC_BLOCK_SIZE;
+    size_t runtime_chunk_sz = block_size;
+    const zxc_cctx_t* dict = &pool->slots[0].cctx;  // Dictionary of the pool
+    uint32_t dict_id = mode == 1 ? dict->dict_id : 0;
     if (mode == 0) {
-        uint8_t h[ZXC_FILE_HEADER_SIZE];
-        if (fread(h, 1, ZXC_FILE_HEADER_SIZE, f_in) != ZXC_FILE_HEADER_SIZE ||
-            zxc_read_file_header(h, ZXC_FILE_HEADER_SIZE, &runtime_chunk_sz) != 0)
+        uint8_t h[ZXC_FILE_HEADER_MAX_SIZE];
+        if (zxc_io_pull_copy(in, h, ZXC_FILE_HEADER_SIZE) != ZXC_FILE_HEADER_SIZE) return -1;
+        size_t h_len = ZXC_FILE_HEADER_SIZE;
+        if (h[6] & ZXC_FILE_FLAG_CONTENT_SIZE) {
+            if (zxc_io_pull_copy(in, h + h_len, ZXC_FILE_CONTENT_SIZE_SIZE) !=
+                ZXC_FILE_CONTENT_SIZE_SIZE)
+                return -1;
+            h_len += ZXC_FILE_CONTENT_SIZE_SIZE;
+        }
+        if (h[6] & ZXC_FILE_FLAG_DICT_ID) {
+            if (zxc_io_pull_copy(in, h + h_len, ZXC_FILE_DICT_ID_SIZE) != ZXC_FILE_DICT_ID_SIZE)
+                return -1;
+            h_len += ZXC_FILE_DICT_ID_SIZE;
+        }
+        if (zxc_read_file_header(h, h_len, &runtime_chunk_sz, &content_size, &ctx.linked,
+                                 &dict_id) < 0 ||
+            (dict_id && dict_id != dict->dict_id))
             return -1;
     }
     ctx.chunk_size = runtime_chunk_sz;
+    // Dictionary: placed in front of the first block, like a linked prefix
+    const size_t dict_sz = dict_id ? dict->dict_size : 0;
+
+    // Pool thread 0 is the writer, the others are workers. Linked blocks are
+    // decoded in order, by a single worker.
+    int num_workers = (mode == 0 && ctx.linked) ? 1 : pool->n_threads - 1;
+    ctx.ring_size = num_workers * 4;
+
+    // Linked blocks and dictionaries: room for the previous block's tail (or
+    // the dictionary) in front of the input (compression) or of the output
+    // (decompression) of every job
+    size_t link = runtime_chunk_sz < ZXC_LINK_WINDOW ? runtime_chunk_sz : ZXC_LINK_WINDOW;
+    const int margin = ctx.linked || dict_sz > 0;
+    size_t margin_in = (margin && mode == 1) ? ZXC_LINK_WINDOW : 0;
+    size_t margin_out = (margin && mode == 0) ? ZXC_LINK_WINDOW : 0;
 
     size_t max_out = zxc_compress_bound(runtime_chunk_sz);
-    size_t raw_alloc_in = ((mode) ? runtime_chunk_sz : max_out) + ZXC_PAD_SIZE;
+    size_t raw_alloc_in = margin_in + ((mode) ? runtime_chunk_sz : max_out) + ZXC_PAD_SIZE;
     size_t alloc_in = (raw_alloc_in + ZXC_ALIGNMENT_MASK) & ~ZXC_ALIGNMENT_MASK;
 
-    size_t raw_alloc_out = ((mode) ? max_out : runtime_chunk_sz) + ZXC_PAD_SIZE;
+    size_t raw_alloc_out = margin_out + ((mode) ? max_out : runtime_chunk_sz) + ZXC_PAD_SIZE;
     size_t alloc_out = (raw_alloc_out + ZXC_ALIGNMENT_MASK) & ~ZXC_ALIGNMENT_MASK;
 
-    size_t alloc_size =
-        ctx.ring_size * (sizeof(zxc_stream_job_t) + sizeof(int) + alloc_in + alloc_out);
-    uint8_t* mem_block = zxc_aligned_malloc(alloc_size, ZXC_CACHE_LINE_SIZE);
+    // The queue never holds more than ring_size entries; round up to a power of two.
+    uint32_t q_cap = 1;
+    while (q_cap < (uint32_t)ctx.ring_size) q_cap <<= 1;
+
+    size_t ctrl_size = q_cap * sizeof(zxc_mpmc_cell_t) + ctx.ring_size * sizeof(zxc_stream_job_t);
+    size_t alloc_size = ctrl_size + ctx.ring_size * (alloc_in + alloc_out);
+    uint8_t* mem_block = zxc_pool_scratch(pool, alloc_size);
     if (UNLIKELY(!mem_block)) return -1;
-    ZXC_MEMSET(mem_block, 0, alloc_size);
+    ZXC_MEMSET(mem_block, 0, ctrl_size);  // Data buffers are always written before being read
+
+    for (int i = 1; i <= num_workers; i++) {
+        if (UNLIKELY(zxc_pool_reserve(pool, i, runtime_chunk_sz, mode, level,
+                                      checksum_enabled) != 0))
+            return -1;
+    }
 
     uint8_t* ptr = mem_block;
+    zxc_mpmc_init(&ctx.worker_queue, (zxc_mpmc_cell_t*)ptr, q_cap);
+    ptr += q_cap * sizeof(zxc_mpmc_cell_t);
     ctx.jobs = (zxc_stream_job_t*)ptr;
     ptr += ctx.ring_size * sizeof(zxc_stream_job_t);
-    ctx.worker_queue = (int*)ptr;
-    ptr += ctx.ring_size * sizeof(int);
     uint8_t* buf_in = ptr;
     ptr += ctx.ring_size * alloc_in;
     uint8_t* buf_out = ptr;
 
     for (int i = 0; i < ctx.ring_size; i++) {
         ctx.jobs[i].job_id = i;
-        ctx.jobs[i].status = JOB_STATUS_FREE;
-        ctx.jobs[i].in_buf = buf_in + (i * alloc_in);
-        ctx.jobs[i].in_cap = alloc_in - ZXC_PAD_SIZE;
-        ctx.jobs[i].out_buf = buf_out + (i * alloc_out);
-        ctx.jobs[i].out_cap = alloc_out - ZXC_PAD_SIZE;
+        ZXC_ATOMIC_STORE(&ctx.jobs[i].status, JOB_STATUS_FREE);
+        ctx.jobs[i].in_buf = buf_in + (i * alloc_in) + margin_in;
+        ctx.jobs[i].in_cap = alloc_in - ZXC_PAD_SIZE - margin_in;
+        ctx.jobs[i].out_buf = buf_out + (i * alloc_out) + margin_out;
+        ctx.jobs[i].out_cap = alloc_out - ZXC_PAD_SIZE - margin_out;
         ctx.jobs[i].result_sz = 0;
     }
 
-    pthread_mutex_init(&ctx.lock, NULL);
-    pthread_cond_init(&ctx.cond_reader, NULL);
-    pthread_cond_init(&ctx.cond_worker, NULL);
-    pthread_cond_init(&ctx.cond_writer, NULL);
-
-    pthread_t* workers = malloc(num_workers * sizeof(pthread_t));
-    if (UNLIKELY(!workers)) {
-        zxc_aligned_free(mem_block);
-        return -1;
-    }
-    for (int i = 0; i < num_workers; i++)
-        pthread_create(&workers[i], NULL, zxc_stream_worker, &ctx);
-
-    writer_args_t w_args = {&ctx, f_out, 0};
-    if (mode == 1 && f_out) {
-        uint8_t h[8];
-        zxc_write_file_header(h, 8);
-        if (fwrite(h, 1, 8, f_out) != 8) {
+    // Spinning only pays off when the thread being waited for has its own core.
+    int spin = (sysconf(_SC_NPROCESSORS_ONLN) > 1) ? ZXC_SPIN_COUNT : 0;
+    zxc_parker_init(&ctx.park_reader, spin);
+    zxc_parker_init(&ctx.park_worker, spin);
+    zxc_parker_init(&ctx.park_writer, spin);
+    writer_args_t w_args = {&ctx, out, 0, 0, NULL, 0, 0};
+    if (mode == 1 && out) {
+        uint8_t h[ZXC_FILE_HEADER_MAX_SIZE];
+        int h_len =
+            zxc_write_file_header(h, sizeof(h), runtime_chunk_sz, content_size, ctx.linked,
+                                  dict_id);
+        if (out->write(out->opaque, h, (size_t)h_len) != 0) {
             ctx.io_error = 1;
         }
-        w_args.total_bytes = 8;
+        w_args.total_bytes = h_len;
     }
-    pthread_t writer_th;
-    pthread_create(&writer_th, NULL, zxc_async_writer, &w_args);
+    zxc_pool_start(pool, zxc_stream_task, &w_args, num_workers + 1);
 
     int read_idx = 0;
     int read_eof = 0;
+    uint64_t total_read = 0;
+    const uint8_t* prev_data = NULL;  // Linked blocks: the previous block (compression)
+    size_t prev_raw = 0;              // Linked blocks: raw size of the previous block
+    int first = 1;                    // Next job is the first block
 
     // Reader Loop: Reads from file, prepares jobs, pushes to worker queue.
     while (!read_eof && !ctx.io_error) {
         zxc_stream_job_t* job = &ctx.jobs[read_idx];
-        pthread_mutex_lock(&ctx.lock);
-        while (job->status != JOB_STATUS_FREE) pthread_cond_wait(&ctx.cond_reader, &ctx.lock);
-        pthread_mutex_unlock(&ctx.lock);
+        zxc_park_until(&ctx.park_reader, zxc_job_is_free, job);
 
         if (UNLIKELY(ctx.io_error)) break;
 
         size_t read_sz = 0;
+        const uint8_t* data = job->in_buf;
+        job->prefix_sz = prev_raw < link ? prev_raw : link;
+        job->prev_raw = prev_raw;
+        job->dict = first && dict_sz > 0;
+        if (job->dict) {
+            job->prefix_sz = dict_sz;
+            if (mode == 0) ZXC_MEMCPY(job->out_buf - dict_sz, dict->dict_buf, dict_sz);
+        }
+        first = 0;
         if (mode == 1) {
-            read_sz = fread(job->in_buf, 1, ZXC_BLOCK_SIZE, f_in);
+            // Linked blocks (and the block after the dictionary) are copied
+            // next to their prefix, never borrowed
+            int64_t n = (ctx.linked || job->dict)
+                            ? zxc_io_pull_copy(in, job->in_buf, runtime_chunk_sz)
+                            : zxc_io_pull(in, job->in_buf, runtime_chunk_sz, &data);
+            if (UNLIKELY(n < 0)) {
+                ctx.io_error = 1;
+                break;
+            }
+            read_sz = (size_t)n;
+            total_read += read_sz;
             if (read_sz == 0) read_eof = 1;
+            if (job->dict) ZXC_MEMCPY(job->in_buf - dict_sz, dict->dict_buf, dict_sz);
+            if (ctx.linked) {
+                if (job->prefix_sz > 0 && !job->dict)
+                    ZXC_MEMCPY(job->in_buf - job->prefix_sz,
+                               prev_data + prev_raw - job->prefix_sz, job->prefix_sz);
+                prev_data = job->in_buf;
+                prev_raw = read_sz;
+            }
         } else {
-            uint8_t bh_buf[ZXC_BLOCK_HEADER_SIZE + ZXC_BLOCK_CHECKSUM_SIZE];
-            size_t h_read = fread(bh_buf, 1, ZXC_BLOCK_HEADER_SIZE, f_in);
-            if (UNLIKELY(h_read < ZXC_BLOCK_HEADER_SIZE)) {
+            const uint8_t* hp;
+            int64_t n = zxc_io_pull(in, job->in_buf, ZXC_BLOCK_HEADER_SIZE, &hp);
+            if (UNLIKELY(n < 0)) {
+                ctx.io_error = 1;
+                break;
+            }
+            if (UNLIKELY(n < ZXC_BLOCK_HEADER_SIZE)) {
                 read_eof = 1;
             } else {
                 zxc_block_header_t bh;
-                zxc_read_block_header(bh_buf, ZXC_BLOCK_HEADER_SIZE, &bh);
-
-                int has_crc = (bh.block_flags & ZXC_BLOCK_FLAG_CHECKSUM);
-                if (has_crc) {
-                    if (fread(bh_buf + ZXC_BLOCK_HEADER_SIZE, 1, ZXC_BLOCK_CHECKSUM_SIZE, f_in) !=
-                        ZXC_BLOCK_CHECKSUM_SIZE) {
-                        read_eof = 1;
-                    }
+                zxc_read_block_header(hp, ZXC_BLOCK_HEADER_SIZE, &bh);
+                if (bh.block_type == ZXC_BLOCK_SEK) {
+                    // Seek table: end of the block chain, nothing to decode.
+                    read_eof = 1;
+                    break;
                 }
 
+                int has_crc = (bh.block_flags & ZXC_BLOCK_FLAG_CHECKSUM);
                 size_t header_len = ZXC_BLOCK_HEADER_SIZE + (has_crc ? ZXC_BLOCK_CHECKSUM_SIZE : 0);
 
                 if (UNLIKELY(bh.comp_size > job->in_cap - header_len)) {
@@ -571,61 +1496,523 @@ static int64_t zxc_stream_engine_run(FILE* f_in, FILE* f_out, int n_threads, int
                     break;
                 }
 
-                ZXC_MEMCPY(job->in_buf, bh_buf, header_len);
-                size_t body_read = fread(job->in_buf + header_len, 1, bh.comp_size, f_in);
-                read_sz = header_len + body_read;
-                if (UNLIKELY(body_read != bh.comp_size)) read_eof = 1;
+                // Checksum and payload in one pull. If the reader lent both
+                // pieces from one contiguous region, the job uses it in place.
+                const uint8_t* bp;
+                size_t rest = header_len - ZXC_BLOCK_HEADER_SIZE + bh.comp_size;
+                n = zxc_io_pull(in, job->in_buf + ZXC_BLOCK_HEADER_SIZE, rest, &bp);
+                if (UNLIKELY(n < 0)) {
+                    ctx.io_error = 1;
+                    break;
+                }
+                if (bp == hp + ZXC_BLOCK_HEADER_SIZE) {
+                    data = hp;
+                } else {
+                    if (hp != job->in_buf) ZXC_MEMCPY(job->in_buf, hp, ZXC_BLOCK_HEADER_SIZE);
+                    if (bp != job->in_buf + ZXC_BLOCK_HEADER_SIZE && n > 0)
+                        ZXC_MEMCPY(job->in_buf + ZXC_BLOCK_HEADER_SIZE, bp, (size_t)n);
+                }
+                read_sz = ZXC_BLOCK_HEADER_SIZE + (size_t)n;
+                if (UNLIKELY((size_t)n != rest)) read_eof = 1;
+                if (ctx.linked) prev_raw = bh.raw_size;
             }
         }
         if (read_eof && read_sz == 0) break;
 
+        job->in_ptr = data;
         job->in_sz = read_sz;
-        pthread_mutex_lock(&ctx.lock);
-        job->status = JOB_STATUS_FILLED;
-        ctx.worker_queue[ctx.wq_head] = read_idx;
-        ctx.wq_head = (ctx.wq_head + 1) % ctx.ring_size;
-        ctx.wq_count++;
+        ZXC_ATOMIC_STORE(&job->status, JOB_STATUS_FILLED);
+        zxc_mpmc_push(&ctx.worker_queue, read_idx);  // Cannot fail: q_cap >= ring_size
+        zxc_unpark(&ctx.park_worker, 0);
         read_idx = (read_idx + 1) % ctx.ring_size;
-        pthread_cond_signal(&ctx.cond_worker);
-        pthread_mutex_unlock(&ctx.lock);
 
-        if (read_sz < ZXC_BLOCK_SIZE && mode == 1) read_eof = 1;
+        if (read_sz < runtime_chunk_sz && mode == 1) read_eof = 1;
     }
 
     zxc_stream_job_t* end_job = &ctx.jobs[read_idx];
-    pthread_mutex_lock(&ctx.lock);
-    while (end_job->status != JOB_STATUS_FREE) pthread_cond_wait(&ctx.cond_reader, &ctx.lock);
+    zxc_park_until(&ctx.park_reader, zxc_job_is_free, end_job);
     end_job->result_sz = -1;
-    end_job->status = JOB_STATUS_PROCESSED;
-    pthread_cond_broadcast(&ctx.cond_writer);
-    pthread_mutex_unlock(&ctx.lock);
+    ZXC_ATOMIC_STORE(&end_job->status, JOB_STATUS_PROCESSED);
+    zxc_unpark(&ctx.park_writer, 0);
+
+    // Every job has been queued: idle workers may leave once the queue is drained.
+    ZXC_ATOMIC_STORE(&ctx.shutdown_workers, 1);
+    zxc_unpark(&ctx.park_worker, 1);
+    zxc_pool_wait(pool);
 
-    pthread_join(writer_th, NULL);
-    pthread_mutex_lock(&ctx.lock);
-    ctx.shutdown_workers = 1;
-    pthread_cond_broadcast(&ctx.cond_worker);
-    pthread_mutex_unlock(&ctx.lock);
-    for (int i = 0; i < num_workers; i++) pthread_join(workers[i], NULL);
+    if (ctx.seek_table && out && !ctx.io_error) {
+        size_t seek_sz = ZXC_BLOCK_HEADER_SIZE + (size_t)w_args.seek_count * ZXC_SEEK_ENTRY_SIZE +
+                         ZXC_SEEK_FOOTER_SIZE;
+        uint8_t* seek_buf = malloc(seek_sz);
+        if (UNLIKELY(!seek_buf) ||
+            zxc_write_seek_table(seek_buf, seek_sz, w_args.seek, w_args.seek_count) < 0 ||
+            out->write(out->opaque, seek_buf, seek_sz) != 0)
+            ctx.io_error = 1;
+        else
+            w_args.total_bytes += (int64_t)seek_sz;
+        free(seek_buf);
+    }
+    free(w_args.seek);
 
-    free(workers);
-    zxc_aligned_free(mem_block);
+    zxc_parker_destroy(&ctx.park_reader);
+    zxc_parker_destroy(&ctx.park_worker);
+    zxc_parker_destroy(&ctx.park_writer);
 
     if (UNLIKELY(ctx.io_error)) return -1;
 
+    // The header promised an exact size: a mismatch means the input changed
+    // under us (compression) or the stream is truncated/corrupt (decompression).
+    if (content_size != ZXC_CONTENT_SIZE_UNKNOWN &&
+        content_size != (mode == 1 ? total_read : (uint64_t)w_args.total_bytes))
+        return -1;
+
     return w_args.total_bytes;
 }
 
+/**
+ * @brief Runs one stream operation on a pool, serialized with other callers.
+ */
+static int64_t zxc_stream_run_pool(zxc_pool_t* pool, const zxc_reader_t* in,
+                                   const zxc_writer_t* out, uint64_t content_size, int mode,
+                                   int level, int checksum_enabled, size_t block_size,
+                                   zxc_chunk_processor_t func) {
+    pthread_mutex_lock(&pool->call_lock);
+    int64_t res = zxc_stream_engine_run(pool, in, out, content_size, mode, level,
+                                        checksum_enabled, block_size, func);
+    pthread_mutex_unlock(&pool->call_lock);
+    return res;
+}
+
+/**
+ * @brief Runs one stream operation on a temporary pool of `n_threads` threads.
+ */
+static int64_t zxc_stream_run_once(int n_threads, const zxc_reader_t* in,
+                                   const zxc_writer_t* out, uint64_t content_size, int mode,
+                                   int level, int checksum_enabled, size_t block_size,
+                                   zxc_chunk_processor_t func) {
+    zxc_pool_t* pool = zxc_create_pool(n_threads);
+    if (UNLIKELY(!pool)) return -1;
+    int64_t res = zxc_stream_engine_run(pool, in, out, content_size, mode, level,
+                                        checksum_enabled, block_size, func);
+    zxc_free_pool(pool);
+    return res;
+}
+
 int64_t zxc_stream_compress(FILE* f_in, FILE* f_out, int n_threads, int level,
-                            int checksum_enabled) {
-    if (UNLIKELY(!f_in)) return -1;
+                            int checksum_enabled, size_t block_size) {
+    block_size = zxc_resolve_block_size(block_size);
+    if (UNLIKELY(!f_in || block_size == 0)) return -1;
 
-    return zxc_stream_engine_run(f_in, f_out, n_threads, 1, level, checksum_enabled,
-                                 zxc_compress_chunk_wrapper);
+    zxc_file_io_t io;
+    uint64_t content_size;
+    if (zxc_file_io_open(&io, f_in, f_out, &content_size) != 0) return -1;
+    int64_t res = zxc_stream_run_once(n_threads, &io.in, f_out ? &io.out : NULL, content_size, 1,
+                                      level, checksum_enabled, block_size,
+                                      zxc_compress_chunk_wrapper);
+    zxc_file_io_close(&io, f_in);
+    return res;
 }
 
 int64_t zxc_stream_decompress(FILE* f_in, FILE* f_out, int n_threads, int checksum_enabled) {
     if (UNLIKELY(!f_in)) return -1;
 
-    return zxc_stream_engine_run(f_in, f_out, n_threads, 0, 0, checksum_enabled,
-                                 (zxc_chunk_processor_t)zxc_decompress_chunk_wrapper);
+    zxc_file_io_t io;
+    zxc_file_io_open(&io, f_in, f_out, NULL);
+    int64_t res = zxc_stream_run_once(n_threads, &io.in, f_out ? &io.out : NULL,
+                                      ZXC_CONTENT_SIZE_UNKNOWN, 0, 0, checksum_enabled, 0,
+                                      (zxc_chunk_processor_t)zxc_decompress_chunk_wrapper);
+    zxc_file_io_close(&io, f_in);
+    return res;
+}
+
+int64_t zxc_stream_compress_pool(zxc_pool_t* pool, FILE* f_in, FILE* f_out, int level,
+                                 int checksum_enabled, size_t block_size) {
+    block_size = zxc_resolve_block_size(block_size);
+    if (UNLIKELY(!pool || !f_in || block_size == 0)) return -1;
+
+    zxc_file_io_t io;
+    uint64_t content_size;
+    if (zxc_file_io_open(&io, f_in, f_out, &content_size) != 0) return -1;
+    int64_t res = zxc_stream_run_pool(pool, &io.in, f_out ? &io.out : NULL, content_size, 1,
+                                      level, checksum_enabled, block_size,
+                                      zxc_compress_chunk_wrapper);
+    zxc_file_io_close(&io, f_in);
+    return res;
+}
+
+int64_t zxc_stream_decompress_pool(zxc_pool_t* pool, FILE* f_in, FILE* f_out,
+                                   int checksum_enabled) {
+    if (UNLIKELY(!pool || !f_in)) return -1;
+
+    zxc_file_io_t io;
+    zxc_file_io_open(&io, f_in, f_out, NULL);
+    int64_t res = zxc_stream_run_pool(pool, &io.in, f_out ? &io.out : NULL,
+                                      ZXC_CONTENT_SIZE_UNKNOWN, 0, 0, checksum_enabled, 0,
+                                      (zxc_chunk_processor_t)zxc_decompress_chunk_wrapper);
+    zxc_file_io_close(&io, f_in);
+    return res;
+}
+
+/*
+ * ============================================================================
+ * CALLBACK STREAM API
+ * ============================================================================
+ */
+
+// cppcheck-suppress unusedFunction
+int64_t zxc_stream_compress_cb(const zxc_reader_t* in, const zxc_writer_t* out, int n_threads,
+                               int level, int checksum_enabled, size_t block_size) {
+    block_size = zxc_resolve_block_size(block_size);
+    if (UNLIKELY(!in || (!in->read && !in->borrow) || (out && !out->write) || block_size == 0))
+        return -1;
+
+    uint64_t content_size = in->content_size ? in->content_size : ZXC_CONTENT_SIZE_UNKNOWN;
+    return zxc_stream_run_once(n_threads, in, out, content_size, 1, level, checksum_enabled,
+                               block_size, zxc_compress_chunk_wrapper);
+}
+
+// cppcheck-suppress unusedFunction
+int64_t zxc_stream_decompress_cb(const zxc_reader_t* in, const zxc_writer_t* out, int n_threads,
+                                 int checksum_enabled) {
+    if (UNLIKELY(!in || (!in->read && !in->borrow) || (out && !out->write))) return -1;
+
+    return zxc_stream_run_once(n_threads, in, out, ZXC_CONTENT_SIZE_UNKNOWN, 0, 0,
+                               checksum_enabled, 0,
+                               (zxc_chunk_processor_t)zxc_decompress_chunk_wrapper);
+}
+
+// cppcheck-suppress unusedFunction
+int64_t zxc_stream_compress_cb_pool(zxc_pool_t* pool, const zxc_reader_t* in,
+                                    const zxc_writer_t* out, int level, int checksum_enabled,
+                                    size_t block_size) {
+    block_size = zxc_resolve_block_size(block_size);
+    if (UNLIKELY(!pool || !in || (!in->read && !in->borrow) || (out && !out->write) ||
+                 block_size == 0))
+        return -1;
+
+    uint64_t content_size = in->content_size ? in->content_size : ZXC_CONTENT_SIZE_UNKNOWN;
+    return zxc_stream_run_pool(pool, in, out, content_size, 1, level, checksum_enabled,
+                               block_size, zxc_compress_chunk_wrapper);
+}
+
+// cppcheck-suppress unusedFunction
+int64_t zxc_stream_decompress_cb_pool(zxc_pool_t* pool, const zxc_reader_t* in,
+                                      const zxc_writer_t* out, int checksum_enabled) {
+    if (UNLIKELY(!pool || !in || (!in->read && !in->borrow) || (out && !out->write)))
+        return -1;
+
+    return zxc_stream_run_pool(pool, in, out, ZXC_CONTENT_SIZE_UNKNOWN, 0, 0, checksum_enabled,
+                               0, (zxc_chunk_processor_t)zxc_decompress_chunk_wrapper);
+}
+
+/*
+ * ============================================================================
+ * POOLED BUFFER API
+ * ============================================================================
+ * Blocks are independent, so whole buffers are processed in parallel: the
+ * pool threads claim blocks in order, each with its own context.
+ *
+ * - Decompression: one pass over the block headers gives every block's
+ *   destination offset (from its decoded size), and each block is decoded
+ *   straight into its final place.
+ * - Compression: each block is compressed into a provisional slot of `dst`
+ *   sized for its worst case; a prefix sum over the compressed sizes then
+ *   compacts the slots in place.
+ *
+ * Neither direction needs an intermediate buffer or an ordered writer.
+ */
+
+/**
+ * @struct zxc_buf_block_t
+ * @brief One block of a parallel buffer operation.
+ *
+ * @var zxc_buf_block_t::src
+ *      Input of the block: raw chunk, or compressed block (header included).
+ * @var zxc_buf_block_t::src_size
+ *      Size of `src`.
+ * @var zxc_buf_block_t::dst_off
+ *      Offset of the block's output in the destination buffer.
+ * @var zxc_buf_block_t::dst_size
+ *      Capacity available at `dst_off`.
+ * @var zxc_buf_block_t::out_size
+ *      Number of bytes produced.
+ * @var zxc_buf_block_t::prefix
+ *      Linked blocks: bytes of history in front of `src` (compression only).
+ * @var zxc_buf_block_t::dict
+ *      The block is processed behind the dictionary (first block of a
+ * dictionary frame).
+ */
+typedef struct {
+    const uint8_t* src;
+    size_t src_size;
+    size_t dst_off;
+    size_t dst_size;
+    size_t out_size;
+    size_t prefix;
+    int dict;
+} zxc_buf_block_t;
+
+/**
+ * @struct zxc_buf_task_t
+ * @brief Shared state of a parallel buffer operation.
+ *
+ * @var zxc_buf_task_t::blocks
+ *      Block list.
+ * @var zxc_buf_task_t::n_blocks
+ *      Number of entries in `blocks`.
+ * @var zxc_buf_task_t::dst
+ *      Destination buffer.
+ * @var zxc_buf_task_t::func
+ *      Chunk processor (compression or decompression).
+ * @var zxc_buf_task_t::dict_func
+ *      Processor of the block placed behind the dictionary.
+ * @var zxc_buf_task_t::next
+ *      Index of the next block to claim.
+ * @var zxc_buf_task_t::error
+ *      Set by any thread that fails; the others stop claiming blocks.
+ */
+typedef struct {
+    zxc_buf_block_t* blocks;
+    int n_blocks;
+    uint8_t* dst;
+    zxc_chunk_processor_t func;
+    zxc_chunk_processor_t dict_func;
+    ZXC_ATOMIC int next;
+    ZXC_ATOMIC int error;
+} zxc_buf_task_t;
+
+/**
+ * @brief Pool task: claims blocks in order and processes each one in place.
+ *
+ * A block never gets more output capacity than its own region of `dst`, which
+ * keeps the decoder's wild copies away from neighbouring blocks.
+ */
+static void zxc_buf_blocks_task(void* arg, zxc_cctx_t* cctx, int tid) {
+    (void)tid;
+    zxc_buf_task_t* t = (zxc_buf_task_t*)arg;
+    while (!ZXC_ATOMIC_LOAD(&t->error)) {
+        int i = ZXC_ATOMIC_ADD(&t->next, 1);
+        if (i >= t->n_blocks) break;
+        zxc_buf_block_t* b = &t->blocks[i];
+        cctx->prefix_len = b->prefix;
+        zxc_chunk_processor_t f = b->dict ? t->dict_func : t->func;
+        int res = f(cctx, b->src, b->src_size, t->dst + b->dst_off, b->dst_size);
+        if (UNLIKELY(res < 0)) {
+            ZXC_ATOMIC_STORE(&t->error, 1);
+            break;
+        }
+        b->out_size = (size_t)res;
+    }
+}
+
+/**
+ * @brief Runs `func` over every block on up to `pool->n_threads` threads.
+ *
+ * The caller holds `call_lock`.
+ *
+ * @return 0 on success, -1 if a context could not be prepared or a block
+ * failed.
+ */
+static int zxc_buf_run(zxc_pool_t* pool, zxc_buf_block_t* blocks, int n_blocks, uint8_t* dst,
+                       zxc_chunk_processor_t func, zxc_chunk_processor_t dict_func,
+                       size_t chunk_size, int mode, int level, int checksum_enabled) {
+    int n = n_blocks < pool->n_threads ? n_blocks : pool->n_threads;
+    for (int i = 0; i < n; i++) {
+        if (UNLIKELY(zxc_pool_reserve(pool, i, chunk_size, mode, level, checksum_enabled) != 0))
+            return -1;
+    }
+
+    zxc_buf_task_t task;
+    task.blocks = blocks;
+    task.n_blocks = n_blocks;
+    task.dst = dst;
+    task.func = func;
+    task.dict_func = dict_func;
+    ZXC_ATOMIC_STORE(&task.next, 0);
+    ZXC_ATOMIC_STORE(&task.error, 0);
+    if (n > 1) {
+        zxc_pool_start(pool, zxc_buf_blocks_task, &task, n);
+        zxc_pool_wait(pool);
+    } else if (n == 1) {
+        // A single block is not worth a thread hand-off
+        zxc_buf_blocks_task(&task, &pool->slots[0].cctx, 0);
+    }
+    return ZXC_ATOMIC_LOAD(&task.error) ? -1 : 0;
+}
+
+/**
+ * @brief Parallel buffer compression; the caller holds `call_lock`.
+ */
+static size_t zxc_compress_pool_locked(zxc_pool_t* pool, const uint8_t* src, size_t src_size,
+                                       uint8_t* dst, size_t dst_capacity, int level,
+                                       int checksum_enabled, size_t block_size) {
+    const uint32_t dict_id = pool->slots[0].cctx.dict_id;
+    int h_size = zxc_write_file_header(dst, dst_capacity, block_size, (uint64_t)src_size,
+                                       pool->linked_blocks, dict_id);
+    if (UNLIKELY(h_size < 0)) return 0;
+
+    // Provisional slot of a block: room for a stored (RAW) block plus the same
+    // margin as zxc_compress_bound(), so the slots fit in a dst of that size.
+    const size_t slot_extra = ZXC_BLOCK_HEADER_SIZE + ZXC_BLOCK_CHECKSUM_SIZE + 64;
+    size_t n_blocks = (src_size + block_size - 1) / block_size;
+    if (UNLIKELY(n_blocks > INT32_MAX || dst_capacity - (size_t)h_size < src_size ||
+                 (dst_capacity - (size_t)h_size - src_size) / slot_extra < n_blocks)) {
+        // Too tight for the slot layout: compress sequentially
+        pool->slots[0].cctx.cost_model = pool->cost_model;
+        pool->slots[0].cctx.linked_blocks = pool->linked_blocks;
+        pool->slots[0].cctx.block_trials = pool->block_trials;
+        return zxc_compress_cctx(&pool->slots[0].cctx, src, src_size, dst, dst_capacity, level,
+                                 checksum_enabled, block_size);
+    }
+
+    zxc_buf_block_t* blocks =
+        (zxc_buf_block_t*)zxc_pool_scratch(pool, n_blocks * sizeof(zxc_buf_block_t));
+    if (UNLIKELY(!blocks)) return 0;
+    // Linked blocks: the source is contiguous, so the history of a block is
+    // simply the tail of the previous one
+    const size_t link = block_size < ZXC_LINK_WINDOW ? block_size : ZXC_LINK_WINDOW;
+    size_t slot_off = (size_t)h_size;
+    for (size_t i = 0; i < n_blocks; i++) {
+        size_t pos = i * block_size;
+        size_t len = (src_size - pos > block_size) ? block_size : (src_size - pos);
+        blocks[i].src = src + pos;
+        blocks[i].src_size = len;
+        blocks[i].dst_off = slot_off;
+        blocks[i].dst_size = len + slot_extra;
+        blocks[i].prefix = (pool->linked_blocks && i > 0) ? link : 0;
+        blocks[i].dict = dict_id && i == 0;
+        slot_off += len + slot_extra;
+    }
+
+    if (zxc_buf_run(pool, blocks, (int)n_blocks, dst, zxc_compress_chunk_wrapper,
+                    zxc_compress_dict_block, block_size, 1, level, checksum_enabled) != 0)
+        return 0;
+
+    // Compaction: every block moves down (or stays), so in-order moves never
+    // overwrite a block that has not been moved yet.
+    size_t op = (size_t)h_size;
+    for (size_t i = 0; i < n_blocks; i++) {
+        if (blocks[i].dst_off != op)
+            memmove(dst + op, dst + blocks[i].dst_off, blocks[i].out_size);
+        op += blocks[i].out_size;
+    }
+    return op;
+}
+
+/**
+ * @brief Parallel buffer decompression; the caller holds `call_lock`.
+ */
+static size_t zxc_decompress_pool_locked(zxc_pool_t* pool, const uint8_t* src, size_t src_size,
+                                         uint8_t* dst, size_t dst_capacity,
+                                         int checksum_enabled) {
+    size_t chunk_size = 0;
+    uint64_t content_size = ZXC_CONTENT_SIZE_UNKNOWN;
+    int linked = 0;
+    uint32_t dict_id = 0;
+    int h_size =
+        zxc_read_file_header(src, src_size, &chunk_size, &content_size, &linked, &dict_id);
+    if (h_size < 0 || (dict_id && dict_id != pool->slots[0].cctx.dict_id)) return 0;
+    if (content_size != ZXC_CONTENT_SIZE_UNKNOWN && content_size > dst_capacity) return 0;
+    // Linked blocks depend on their predecessor: decode them in order
+    if (linked)
+        return zxc_decompress_dctx(&pool->slots[0].cctx, src, src_size, dst, dst_capacity,
+                                   checksum_enabled);
+
+    // Upper bound on the block count: each block takes at least a header
+    const uint8_t* ip = src + h_size;
+    const uint8_t* ip_end = src + src_size;
+    size_t max_blocks = (size_t)(ip_end - ip) / ZXC_BLOCK_HEADER_SIZE;
+    if (UNLIKELY(max_blocks > INT32_MAX)) return 0;
+    zxc_buf_block_t* blocks = (zxc_buf_block_t*)zxc_pool_scratch(
+        pool, (max_blocks ? max_blocks : 1) * sizeof(zxc_buf_block_t));
+    if (UNLIKELY(!blocks)) return 0;
+
+    // Header pass: destination offset of every block
+    int n_blocks = 0;
+    size_t total = 0;
+    while (ip < ip_end) {
+        zxc_block_header_t bh;
+        if (zxc_read_block_header(ip, (size_t)(ip_end - ip), &bh) != 0) return 0;
+        if (bh.block_type == ZXC_BLOCK_SEK) break;
+
+        size_t checksum_sz =
+            (bh.block_flags & ZXC_BLOCK_FLAG_CHECKSUM) ? ZXC_BLOCK_CHECKSUM_SIZE : 0;
+        size_t total_block_sz = ZXC_BLOCK_HEADER_SIZE + bh.comp_size + checksum_sz;
+        if (UNLIKELY(total_block_sz > (size_t)(ip_end - ip) || bh.raw_size > chunk_size ||
+                     bh.raw_size > dst_capacity - total))
+            return 0;
+
+        blocks[n_blocks].src = ip;
+        blocks[n_blocks].src_size = total_block_sz;
+        blocks[n_blocks].dst_off = total;
+        blocks[n_blocks].dst_size = bh.raw_size;
+        blocks[n_blocks].prefix = 0;
+        blocks[n_blocks].dict = dict_id && n_blocks == 0;
+        n_blocks++;
+        total += bh.raw_size;
+        ip += total_block_sz;
+    }
+    if (UNLIKELY(content_size != ZXC_CONTENT_SIZE_UNKNOWN && content_size != (uint64_t)total))
+        return 0;
+
+    if (zxc_buf_run(pool, blocks, n_blocks, dst,
+                    (zxc_chunk_processor_t)zxc_decompress_chunk_wrapper,
+                    (zxc_chunk_processor_t)zxc_decompress_dict_block, chunk_size, 0, 0,
+                    checksum_enabled) != 0)
+        return 0;
+    for (int i = 0; i < n_blocks; i++) {
+        if (UNLIKELY(blocks[i].out_size != blocks[i].dst_size)) return 0;
+    }
+    return total;
+}
+
+// cppcheck-suppress unusedFunction
+size_t zxc_compress_pool(zxc_pool_t* pool, const void* src, size_t src_size, void* dst,
+                         size_t dst_capacity, int level, int checksum_enabled,
+                         size_t block_size) {
+    block_size = zxc_resolve_block_size(block_size);
+    if (UNLIKELY(!pool || !src || !dst || src_size == 0 || dst_capacity == 0 || block_size == 0))
+        return 0;
+    pthread_mutex_lock(&pool->call_lock);
+    size_t res = zxc_compress_pool_locked(pool, (const uint8_t*)src, src_size, (uint8_t*)dst,
+                                          dst_capacity, level, checksum_enabled, block_size);
+    pthread_mutex_unlock(&pool->call_lock);
+    return res;
+}
+
+// cppcheck-suppress unusedFunction
+size_t zxc_decompress_pool(zxc_pool_t* pool, const void* src, size_t src_size, void* dst,
+                           size_t dst_capacity, int checksum_enabled) {
+    if (UNLIKELY(!pool || !src || !dst || src_size < ZXC_FILE_HEADER_SIZE)) return 0;
+    pthread_mutex_lock(&pool->call_lock);
+    size_t res = zxc_decompress_pool_locked(pool, (const uint8_t*)src, src_size, (uint8_t*)dst,
+                                            dst_capacity, checksum_enabled);
+    pthread_mutex_unlock(&pool->call_lock);
+    return res;
+}
+
+// cppcheck-suppress unusedFunction
+size_t zxc_compress_mt(const void* src, size_t src_size, void* dst, size_t dst_capacity,
+                       int n_threads, int level, int checksum_enabled, size_t block_size) {
+    block_size = zxc_resolve_block_size(block_size);
+    if (UNLIKELY(!src || !dst || src_size == 0 || dst_capacity == 0 || block_size == 0))
+        return 0;
+    zxc_pool_t* pool = zxc_create_pool(n_threads);
+    if (UNLIKELY(!pool)) return 0;
+    size_t res = zxc_compress_pool_locked(pool, (const uint8_t*)src, src_size, (uint8_t*)dst,
+                                          dst_capacity, level, checksum_enabled, block_size);
+    zxc_free_pool(pool);
+    return res;
+}
+
+// cppcheck-suppress unusedFunction
+size_t zxc_decompress_mt(const void* src, size_t src_size, void* dst, size_t dst_capacity,
+                         int n_threads, int checksum_enabled) {
+    if (UNLIKELY(!src || !dst || src_size < ZXC_FILE_HEADER_SIZE)) return 0;
+    zxc_pool_t* pool = zxc_create_pool(n_threads);
+    if (UNLIKELY(!pool)) return 0;
+    size_t res = zxc_decompress_pool_locked(pool, (const uint8_t*)src, src_size, (uint8_t*)dst,
+                                            dst_capacity, checksum_enabled);
+    zxc_free_pool(pool);
+    return res;
 }
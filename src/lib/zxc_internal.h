@@ -17,6 +17,7 @@
 #include <string.h>
 
 #include "../../include/rapidhash.h"
+#include "../../include/zxc_constants.h"
 #include "../../include/zxc_sans_io.h"
 
 #ifdef __cplusplus
@@ -122,9 +123,12 @@ extern "C" {
  */
 
 #define ZXC_MAGIC_WORD 0x0043585AU            // Magic signature "ZXC0" (Little Endian)
-#define ZXC_FILE_FORMAT_VERSION 3             // Current file format version
+#define ZXC_FILE_FORMAT_VERSION 4             // Current file format version
+#define ZXC_FILE_FORMAT_VERSION_MIN 3         // Oldest readable version (no header flags)
 #define ZXC_BLOCK_UNIT (4 * 1024)             // Block size unit (4KB)
-#define ZXC_BLOCK_SIZE (64 * ZXC_BLOCK_UNIT)  // Size of data blocks processed by threads (256KB)
+#define ZXC_BLOCK_SIZE (64 * ZXC_BLOCK_UNIT)  // Default size of data blocks (256KB)
+#define ZXC_BLOCK_SIZE_LOG_MIN 14             // log2(ZXC_BLOCK_SIZE_MIN)
+#define ZXC_BLOCK_SIZE_LOG_MAX 21             // log2(ZXC_BLOCK_SIZE_MAX)
 #define ZXC_IO_BUFFER_SIZE (1024 * 1024)      // Size of stdio buffers
 #define ZXC_PAD_SIZE 32                       // Padding size for buffer overruns
 #define ZXC_BITS_PER_BYTE 8                   // Number of bits per byte
@@ -134,30 +138,63 @@ extern "C" {
 #define ZXC_VBYTE_ALLOC_LEN 3  // Max length for allocation (sufficient for < 2MB blocks)
 
 // Binary Header Sizes
-#define ZXC_FILE_HEADER_SIZE 8  // Magic (4 bytes) + Version (1 byte) + Reserved (3 bytes)
+#define ZXC_FILE_HEADER_SIZE \
+    8  // Magic (4 bytes) + Version (1 byte) + Chunk (1 byte) + Flags (1 byte) + Reserved (1 byte)
+#define ZXC_FILE_CONTENT_SIZE_SIZE 8  // Optional content size field following the header
+#define ZXC_FILE_DICT_ID_SIZE 4       // Optional dictionary ID following the content size
+#define ZXC_FILE_HEADER_MAX_SIZE \
+    (ZXC_FILE_HEADER_SIZE + ZXC_FILE_CONTENT_SIZE_SIZE + ZXC_FILE_DICT_ID_SIZE)
 #define ZXC_BLOCK_HEADER_SIZE \
     12  // Type (1) + Flags (1) + Reserved (2) + Comp Size (4) + Raw Size (4)
 #define ZXC_BLOCK_CHECKSUM_SIZE 8      // Size of checksum field in bytes
-#define ZXC_NUM_HEADER_BINARY_SIZE 16  // Num Header: N Values (8) + Frame Size (2) + Reserved (6)
+#define ZXC_NUM_HEADER_BINARY_SIZE \
+    16  // Num Header: N Values (8) + Frame Size (2) + Element Width (1) + Reserved (5)
 #define ZXC_GLO_HEADER_BINARY_SIZE \
-    16  // GLO Header: N Sequences (4) + N Literals (4) + 4 x 1-byte Encoding Types
+    16  // GLO Header: N Sequences (4) + N Literals (4) + 4 x 1-byte Encoding Types +
+        // Offset Width (1) + Reserved (3)
 #define ZXC_GHI_HEADER_BINARY_SIZE \
     16  // GHI Header: N Sequences (4) + N Literals (4) + 4 x 1-byte Encoding Types
 
+// Seek Table (trailing SEK block)
+#define ZXC_SEEK_MAGIC 0x4B45535AU  // Seek table footer signature "ZSEK" (Little Endian)
+#define ZXC_SEEK_ENTRY_SIZE \
+    24  // Seek Entry: Comp Offset (8) + Raw Offset (8) + Comp Size (4) + Raw Size (4)
+#define ZXC_SEEK_FOOTER_SIZE 8  // Seek Footer: N Entries (4) + Magic (4)
+
 // Section Descriptor Sizes
 #define ZXC_SECTION_DESC_BINARY_SIZE 8     // Section Desc: Comp Size (4) + Raw Size (4)
 #define ZXC_SECTION_SIZE_MASK 0xFFFFFFFFU  // Mask to extract 32-bit size from descriptor
 #define ZXC_GLO_SECTIONS 4                 // Number of sections in GLO blocks
 #define ZXC_GHI_SECTIONS 3                 // Number of sections in GHI blocks
 
+// File Header Flags
+#define ZXC_FILE_FLAG_CONTENT_SIZE 0x01U  // 8-byte original content size follows the header
+#define ZXC_FILE_FLAG_LINKED 0x02U        // Blocks may reference the previous block's tail
+#define ZXC_FILE_FLAG_DICT_ID 0x04U       // 4-byte dictionary ID follows (first block uses it)
+
 // Block Flags
 #define ZXC_BLOCK_FLAG_NONE 0U         // No flags
 #define ZXC_BLOCK_FLAG_CHECKSUM 0x80U  // Block has a checksum (8 bytes after header)
+#define ZXC_BLOCK_FLAG_SHUFFLE 0x40U   // LZ payload holds byte planes (record stride in Reserved)
+#define ZXC_BLOCK_FLAG_BCJ 0x20U       // LZ payload has absolute branch targets (arch in Reserved)
 #define ZXC_CHECKSUM_TYPE_MASK 0x0FU   // Lower 4 bits for algorithm ID
 
 // Checksum Algorithms
 #define ZXC_CHECKSUM_RAPIDHASH 0x00U  // Default: rapidhash algorithm
 
+// Byte-shuffle filter (ZXC_BLOCK_FLAG_SHUFFLE)
+#define ZXC_SHUFFLE_MIN_STRIDE 2     // Smallest record stride
+#define ZXC_SHUFFLE_MAX_STRIDE 16    // Largest record stride (one 16-byte vector per record)
+#define ZXC_SHUFFLE_PROBE_SIZE 4096  // Bytes sampled by the stride probe
+#define ZXC_SHUFFLE_PRECHECK_SIZE 128  // Bytes of each of the 4 windows sampled before the full probe
+
+// Branch filter (ZXC_BLOCK_FLAG_BCJ), architecture IDs in Reserved
+#define ZXC_BCJ_X86 1U            // x86 / x86-64: CALL (E8) and JMP (E9) with rel32
+#define ZXC_BCJ_ARM64 2U          // AArch64: BL with imm26
+#define ZXC_BCJ_PROBE_SIZE 16384  // Bytes sampled by the architecture probe
+#define ZXC_BCJ_PRECHECK_SIZE 128  // Bytes of each of the 8 windows sampled before the full probe
+#define ZXC_BCJ_WINDOW 1024       // Bytes whose x86 opcodes are listed at once (decoder)
+
 // Token Format Constants
 // Sequence Format Constants (GLO Token - 4-bit LL, 4-bit ML, 16-bit Offset)
 #define ZXC_TOKEN_LIT_BITS 4  // Number of bits for Literal Length in token
@@ -184,18 +221,74 @@ extern "C" {
 #define ZXC_LIT_LEN_MASK \
     (ZXC_LIT_RLE_FLAG - 1)  // Mask to extract length from RLE/Literal token (127)
 
+// Huffman-coded literals (ZXC_SECTION_ENCODING_HUFFMAN): 4-bit code lengths of
+// the 256 byte values, the sizes of the first three bit streams, then the four
+// streams, each coding a quarter of the literals
+#define ZXC_HUF_MAX_BITS 11                           // Longest code
+#define ZXC_HUF_TABLE_SIZE (1U << ZXC_HUF_MAX_BITS)   // Single-level decode table entries
+#define ZXC_HUF_STREAMS 4                             // Interleaved bit streams
+#define ZXC_HUF_HEADER_SIZE (128 + 4 * (ZXC_HUF_STREAMS - 1))  // Lengths + stream sizes
+#define ZXC_HUF_MIN_LITERALS 1024                     // Below this, literals stay RAW/RLE
+
 // LZ77 Constants
 // The hash table uses 13 bits for addressing, resulting in 8192 (2^13) entries.
 // The hash table uses 2x entries (load factor < 0.5) to reduce collisions.
-// Each hash table entry stores: (epoch << 18) | offset.
+// Each hash table entry stores: (epoch << 21) | offset.
 // Total memory footprint: 64KB (8192 entries * 2 * 4 bytes each).
 #define ZXC_LZ_HASH_BITS 13                        // (2*(2^13) * 4 bytes = 64KB)
 #define ZXC_LZ_HASH_SIZE (1U << ZXC_LZ_HASH_BITS)  // Hash table size
-#define ZXC_LZ_WINDOW_SIZE (1U << 16)              // 64KB sliding window
-// Note: sliding window of 64KB allows chain_table to use uint16_t for valid offsets (since any
-// match > 64KB is invalid).
+#define ZXC_LZ_WINDOW_SIZE (1U << 16)              // 64KB window of the 16-bit offsets
+// Note: GHI blocks and the greedy/lazy levels keep to the 64KB window; GLO blocks of the
+// optimal levels reach the whole block through far offsets (enc_off = ZXC_OFF_ENC_FAR), so
+// chain_table stores 32-bit deltas.
 #define ZXC_LZ_MIN_MATCH_LEN 5                    // Minimum match length
-#define ZXC_LZ_MAX_DIST (ZXC_LZ_WINDOW_SIZE - 1)  // Maximum offset distance
+#define ZXC_LZ_MAX_DIST (ZXC_LZ_WINDOW_SIZE - 1)  // Maximum 16-bit offset distance
+#define ZXC_LZ_FAR_DIST (ZXC_BLOCK_SIZE_MAX - 1)  // Maximum far offset distance (GLO)
+#define ZXC_LZ_FAR_PENALTY \
+    3  // Extra bytes of a far offset (its VByte in the extras stream); a far
+       // match must beat a near one by more than this to be taken
+#define ZXC_LINK_WINDOW \
+    ZXC_LZ_WINDOW_SIZE  // Linked blocks: bytes at the end of the previous block that a block
+                        // may reference (all of it when the previous block is smaller)
+#define ZXC_LZ_MAX_STEP \
+    256  // Cap on literal skipping, so a long incompressible run cannot hide
+         // the compressible data that follows it in large blocks
+
+// GLO offset stream encodings (zxc_gnr_header_t::enc_off)
+#define ZXC_OFF_ENC_16 0   // 16-bit offsets
+#define ZXC_OFF_ENC_8 1    // 8-bit offsets (all offsets <= 255)
+#define ZXC_OFF_ENC_FAR 2  // 16-bit offsets; 0 = far offset, VByte in the extras stream
+#define ZXC_OFF_ENC_REP \
+    0x04  // Flag on top of the modes above: codes 1-3 name a repeat offset, and
+          // other offsets are stored + ZXC_REP_NUM (zxc_gnr_header_t::rep_offsets)
+
+// Repeat offsets (GLO): the last ZXC_REP_NUM distinct uses, most recent first
+#define ZXC_REP_NUM 3
+#define ZXC_REP_INIT_0 1  // Initial history (before the first sequence of a block)
+#define ZXC_REP_INIT_1 4
+#define ZXC_REP_INIT_2 8
+#define ZXC_REP_MIN_SHIFT 3   // Repeat codes tried when at least 1/8 of the sequences reuse one
+#define ZXC_REP_GAIN_SHIFT 4  // ... and kept when they save 1/16 of the offset stream
+
+// Bit-packed GLO offsets (zxc_gnr_header_t::off_bits)
+#define ZXC_OFF_PACK_MIN_SEQ 64  // Fewer sequences keep byte-aligned offsets
+#define ZXC_OFF_PACK_MIN_BITS 8  // Narrowest width tried
+#define ZXC_OFF_PACK_ESC_SHIFT \
+    4  // Below a byte, at most 1/16 of the offsets escaped (each one a VByte read)
+#define ZXC_OFF_PACK_REP_MIN_BITS \
+    2  // Narrowest width tried with repeat offsets (holds the escape and the 3 codes)
+
+// Optimal parser (levels >= ZXC_LEVEL_OPTIMAL)
+#define ZXC_OPT_NUM 4096        // Positions priced per optimal-parse window
+#define ZXC_OPT_MAX_MATCHES 64  // Candidates kept per position (increasing length)
+
+// Default decode cost model (zxc_cost_model_init), in estimated cycles
+#define ZXC_COST_BYTE_WEIGHT 16      // Weight of one encoded byte (decode_bias is per cycle)
+#define ZXC_COST_SEQ_CYCLES 8        // Token, extras, first literal and match copy
+#define ZXC_COST_COPY_CYCLES 2       // Each further wild copy
+#define ZXC_COST_SHORT_OFF_CYCLES 6  // Overlap copy (offset < 16)
+#define ZXC_COST_LONG_LIT_CYCLES 6   // Literal run leaving the single-copy path
+#define ZXC_COST_HUF_LIT_CYCLES 1    // Huffman-decoded literal (4 streams in flight)
 
 /**
  * @struct zxc_lz77_params_t
@@ -208,6 +301,8 @@ typedef struct {
     int lazy_attempts;    // Max matches to check for lazy matching
     uint32_t step_base;   // Base step for literal advancement
     uint32_t step_shift;  // Shift for distance-based stepping
+    int optimal;          // Price-based optimal parse instead of greedy/lazy
+    int binary_tree;      // Optimal parse: binary-tree match finder instead of hash chains
 } zxc_lz77_params_t;
 
 /**
@@ -220,18 +315,73 @@ typedef struct {
  * @return zxc_lz77_params_t The LZ77 parameters structure corresponding to the specified level.
  */
 static ZXC_ALWAYS_INLINE zxc_lz77_params_t zxc_get_lz77_params(int level) {
-    if (level >= 5) return (zxc_lz77_params_t){64, 256, 1, 16, 1, 31};
-    // search_depth, sufficient_len, use_lazy, lazy_attempts, step_base, step_shift
+    // search_depth, sufficient_len, use_lazy, lazy_attempts, step_base, step_shift, optimal,
+    // binary_tree (search_depth then counts tree nodes instead of chain links)
+    static const zxc_lz77_params_t optimal[5] = {
+        {48, 64, 0, 0, 1, 31, 1, 1},      // level 6
+        {128, 128, 0, 0, 1, 31, 1, 1},    // level 7
+        {256, 256, 0, 0, 1, 31, 1, 1},    // level 8
+        {1024, 1024, 0, 0, 1, 31, 1, 1},  // level 9
+        {1024, 1024, 0, 0, 1, 31, 1, 1}   // level 10 (ZXC_LEVEL_DENSE: Huffman literals)
+    };
+    if (level >= ZXC_LEVEL_OPTIMAL)
+        return optimal[(level > ZXC_LEVEL_MAX ? ZXC_LEVEL_MAX : level) - ZXC_LEVEL_OPTIMAL];
+    if (level >= 5) return (zxc_lz77_params_t){64, 256, 1, 16, 1, 31, 0, 0};
     static const zxc_lz77_params_t table[5] = {
-        {6, 16, 0, 0, 2, 3},  // fallback
-        {6, 16, 0, 0, 2, 3},  // level 1
-        {8, 32, 0, 0, 2, 4},  // level 2
-        {4, 32, 1, 8, 1, 4},  // level 3
-        {4, 32, 1, 8, 1, 5}   // level 4
+        {6, 16, 0, 0, 2, 3, 0, 0},  // fallback
+        {6, 16, 0, 0, 2, 3, 0, 0},  // level 1
+        {8, 32, 0, 0, 2, 4, 0, 0},  // level 2
+        {4, 32, 1, 8, 1, 4, 0, 0},  // level 3
+        {4, 32, 1, 8, 1, 5, 0, 0}   // level 4
     };
     return table[level < 1 ? 1 : level];
 }
 
+/**
+ * @brief Estimated decode cycles of a literal run beyond the sequence's first copy.
+ *
+ * @param[in] m Cost model.
+ * @param[in] ll Literal run length.
+ * @return Extra cycles (0 when the run fits in one wild copy).
+ */
+static ZXC_ALWAYS_INLINE uint32_t zxc_lit_decode_cycles(const zxc_cost_model_t* m, uint32_t ll) {
+    return ll > ZXC_PAD_SIZE ? m->long_lit_cycles + m->copy_cycles * ((ll - 1) / ZXC_PAD_SIZE)
+                             : 0;
+}
+
+/**
+ * @brief Estimated decode cycles of a sequence ending with a match.
+ *
+ * Mirrors the GLO/GHI decoders: 32-byte wild copies, 16-byte copies when the
+ * offset is below 32, and the overlap path for offsets below 16.
+ *
+ * @param[in] m Cost model.
+ * @param[in] len Match length.
+ * @param[in] off Match offset.
+ * @return Cycles of the sequence, literal run excluded (see zxc_lit_decode_cycles()).
+ */
+static ZXC_ALWAYS_INLINE uint32_t zxc_match_decode_cycles(const zxc_cost_model_t* m, uint32_t len,
+                                                          uint32_t off) {
+    if (off >= ZXC_PAD_SIZE) return m->seq_cycles + m->copy_cycles * ((len - 1) / ZXC_PAD_SIZE);
+    uint32_t c = m->seq_cycles + m->copy_cycles * ((len - 1) / (ZXC_PAD_SIZE / 2));
+    return off < ZXC_PAD_SIZE / 2 ? c + m->short_off_cycles : c;
+}
+
+/**
+ * @brief Validates a user-supplied block size.
+ *
+ * @param[in] block_size Requested block size in bytes (0 selects the default).
+ * @return The effective block size, or 0 if it is not a power of two within
+ * [ZXC_BLOCK_SIZE_MIN, ZXC_BLOCK_SIZE_MAX].
+ */
+static ZXC_ALWAYS_INLINE size_t zxc_resolve_block_size(size_t block_size) {
+    if (block_size == 0) return ZXC_BLOCK_SIZE;
+    if (UNLIKELY(block_size < ZXC_BLOCK_SIZE_MIN || block_size > ZXC_BLOCK_SIZE_MAX ||
+                 (block_size & (block_size - 1)) != 0))
+        return 0;
+    return block_size;
+}
+
 /**
  * @enum zxc_block_type_t
  * @brief Defines the different types of data blocks supported by the ZXC
@@ -243,16 +393,22 @@ static ZXC_ALWAYS_INLINE zxc_lz77_params_t zxc_get_lz77_params(int level) {
  * entropy) or when compression would expand the data size.
  * - `ZXC_BLOCK_GLO` (1): General-purpose compression (LZ77 + Bitpacking). This
  * is the default for most data (text, binaries, JSON, etc.). Includes 4 sections descriptors.
- * - `ZXC_BLOCK_NUM` (2): Specialized compression for arrays of 32-bit integers.
- *   Uses Delta Encoding + ZigZag + Bitpacking.
+ * - `ZXC_BLOCK_NUM` (2): Specialized compression for arrays of 16-, 32- or 64-bit
+ *   integers. Uses Delta Encoding + ZigZag + Bitpacking.
  * - `ZXC_BLOCK_GHI` (3): General-purpose high-velocity mode using LZ77 with advanced
  * techniques (lazy matching, step skipping) for maximum ratio. Includes 3 sections descriptors.
+ * - `ZXC_BLOCK_SEK` (4): Trailing seek table (no payload to decode). Terminates the
+ * block chain and maps raw offsets to compressed block offsets for random access.
+ * - `ZXC_BLOCK_FLT` (5): Specialized compression for arrays of 32- or 64-bit floats.
+ *   Uses XOR with the previous value + common trailing-zero shift + Bitpacking.
  */
 typedef enum {
     ZXC_BLOCK_RAW = 0,
     ZXC_BLOCK_GLO = 1,
     ZXC_BLOCK_NUM = 2,
-    ZXC_BLOCK_GHI = 3
+    ZXC_BLOCK_GHI = 3,
+    ZXC_BLOCK_SEK = 4,
+    ZXC_BLOCK_FLT = 5
 } zxc_block_type_t;
 
 /**
@@ -263,15 +419,17 @@ typedef enum {
  * or offsets) are stored within a block.
  * - `ZXC_SECTION_ENCODING_RAW`: Data is stored uncompressed.
  * - `ZXC_SECTION_ENCODING_RLE`: Run-Length Encoding.
- * - `ZXC_SECTION_ENCODING_BITPACK`: Bitpacking for integer values.
- * - `ZXC_SECTION_ENCODING_FSE`: Finite State Entropy (Reserved).
+ * - `ZXC_SECTION_ENCODING_BITPACK`: Bitpacking for integer values (NUM frames,
+ *   GLO offsets).
+ * - `ZXC_SECTION_ENCODING_HUFFMAN`: Canonical Huffman code over 4 interleaved
+ *   bit streams (GLO literals).
  * - `ZXC_SECTION_ENCODING_BITPACK_FSE`: Combined Bitpacking and FSE (Reserved).
  */
 typedef enum {
     ZXC_SECTION_ENCODING_RAW = 0,
     ZXC_SECTION_ENCODING_RLE = 1,
     ZXC_SECTION_ENCODING_BITPACK = 2,
-    ZXC_SECTION_ENCODING_FSE = 3,         // Reserved
+    ZXC_SECTION_ENCODING_HUFFMAN = 3,
     ZXC_SECTION_ENCODING_BITPACK_FSE = 4  // Reserved
 } zxc_section_encoding_t;
 
@@ -293,7 +451,14 @@ typedef enum {
  * @var zxc_gnr_header_t::enc_mlen
  * Encoding method used for the match lengths stream.
  * @var zxc_gnr_header_t::enc_off
- * Encoding method used for the offset stream.
+ * Encoding method used for the offset stream (GLO: ZXC_OFF_ENC_16,
+ * ZXC_OFF_ENC_8 or ZXC_OFF_ENC_FAR; GHI: 8-bit threshold hint only).
+ * @var zxc_gnr_header_t::off_bits
+ * GLO only: width of the offsets when the offset section is bit-packed
+ * (ZXC_SECTION_ENCODING_BITPACK, 16-bit modes only); 0 when byte-aligned.
+ * @var zxc_gnr_header_t::rep_offsets
+ * GLO only: non-zero when the offset stream holds repeat-offset codes
+ * (ZXC_OFF_ENC_REP, stored in the enc_off byte).
  */
 typedef struct {
     uint32_t n_sequences;  // Number of sequences
@@ -302,6 +467,8 @@ typedef struct {
     uint8_t enc_litlen;    // Literal lengths encoding
     uint8_t enc_mlen;      // Match lengths encoding
     uint8_t enc_off;       // Offset encoding (Unused in Token format, kept for alignment)
+    uint8_t off_bits;      // Bit-packed offset width (GLO, 0 = byte-aligned)
+    uint8_t rep_offsets;   // Repeat-offset codes (GLO, ZXC_OFF_ENC_REP)
 } zxc_gnr_header_t;
 
 /**
@@ -324,18 +491,42 @@ typedef struct {
  * @struct zxc_num_header_t
  * @brief Header specific to Numeric compression blocks.
  *
- * This header follows the main block header when the block type is NUM.
+ * This header follows the main block header when the block type is NUM or FLT.
  *
  * @var zxc_num_header_t::n_values
  * The total number of numeric values encoded in the block.
  * @var zxc_num_header_t::frame_size
  * The size of the frame used for processing.
+ * @var zxc_num_header_t::width
+ * Size of each value in bytes: 2, 4 or 8 (0 in streams written before the
+ * field existed, read as 4).
  */
 typedef struct {
     uint64_t n_values;
     uint16_t frame_size;
+    uint8_t width;
 } zxc_num_header_t;
 
+/**
+ * @struct zxc_seek_entry_t
+ * @brief One entry of the trailing seek table, describing a single data block.
+ *
+ * @var zxc_seek_entry_t::comp_offset
+ * Offset of the block header from the start of the file.
+ * @var zxc_seek_entry_t::raw_offset
+ * Offset of the first decompressed byte of the block in the original data.
+ * @var zxc_seek_entry_t::comp_size
+ * On-disk size of the block (header + checksum + payload).
+ * @var zxc_seek_entry_t::raw_size
+ * The size of the block after decompression.
+ */
+typedef struct {
+    uint64_t comp_offset;
+    uint64_t raw_offset;
+    uint32_t comp_size;
+    uint32_t raw_size;
+} zxc_seek_entry_t;
+
 /**
  * @typedef zxc_bit_reader_t
  * @brief Internal bit reader structure for ZXC compression/decompression.
@@ -581,6 +772,17 @@ static ZXC_ALWAYS_INLINE uint8_t zxc_highbit32(uint32_t n) {
 #endif
 }
 
+/**
+ * @brief 64-bit version of zxc_highbit32().
+ *
+ * @param[in] n The 64-bit unsigned integer to analyze.
+ * @return The number of significant bits of `n` (0 if n is 0).
+ */
+static ZXC_ALWAYS_INLINE uint8_t zxc_highbit64(uint64_t n) {
+    const uint32_t hi = (uint32_t)(n >> 32);
+    return hi ? (uint8_t)(32 + zxc_highbit32(hi)) : zxc_highbit32((uint32_t)n);
+}
+
 /**
  * @brief Encodes a signed 32-bit integer using ZigZag encoding.
  *
@@ -623,6 +825,26 @@ static ZXC_ALWAYS_INLINE int32_t zxc_zigzag_decode(uint32_t n) {
     return (int32_t)(n >> 1) ^ -(int32_t)(n & 1);
 }
 
+/**
+ * @brief 64-bit ZigZag encoding (see zxc_zigzag_encode()).
+ *
+ * @param[in] n The signed 64-bit integer to encode.
+ * @return The ZigZag encoded unsigned 64-bit integer.
+ */
+static ZXC_ALWAYS_INLINE uint64_t zxc_zigzag_encode64(int64_t n) {
+    return ((uint64_t)n << 1) ^ (0 - ((uint64_t)n >> 63));
+}
+
+/**
+ * @brief 64-bit ZigZag decoding (see zxc_zigzag_decode()).
+ *
+ * @param[in] n The ZigZag encoded unsigned 64-bit integer.
+ * @return The decoded value, as the two's complement unsigned integer.
+ */
+static ZXC_ALWAYS_INLINE uint64_t zxc_zigzag_decode64(uint64_t n) {
+    return (n >> 1) ^ (0 - (n & 1));
+}
+
 /**
  * @brief Allocates aligned memory in a cross-platform manner.
  *
@@ -764,6 +986,22 @@ static ZXC_ALWAYS_INLINE void zxc_br_ensure(zxc_bit_reader_t* br, int needed) {
 int zxc_bitpack_stream_32(const uint32_t* RESTRICT src, size_t count, uint8_t* RESTRICT dst,
                           size_t dst_cap, uint8_t bits);
 
+/**
+ * @brief Bit-packs a stream of 64-bit integers into a destination buffer.
+ *
+ * Same layout as zxc_bitpack_stream_32(), for widths up to 64 bits.
+ *
+ * @param[in] src Pointer to the source array of 64-bit integers.
+ * @param[in] count The number of integers to pack.
+ * @param[out] dst Pointer to the destination buffer.
+ * @param[in] dst_cap The capacity of the destination buffer in bytes.
+ * @param[in] bits The number of bits to use for each integer (0-64).
+ * @return int The number of bytes written to the destination buffer, or a negative
+ * error code on failure.
+ */
+int zxc_bitpack_stream_64(const uint64_t* RESTRICT src, size_t count, uint8_t* RESTRICT dst,
+                          size_t dst_cap, uint8_t bits);
+
 /**
  * @brief Writes a numeric header structure to a destination buffer.
  *
@@ -852,6 +1090,90 @@ int zxc_write_ghi_header_and_desc(uint8_t* dst, size_t rem, const zxc_gnr_header
 int zxc_read_ghi_header_and_desc(const uint8_t* src, size_t len, zxc_gnr_header_t* gh,
                                  zxc_section_desc_t desc[ZXC_GHI_SECTIONS]);
 
+/**
+ * @brief Assigns the canonical Huffman codes of a set of code lengths.
+ *
+ * Codes are assigned in order of length, then of symbol, and returned
+ * bit-reversed: the streams are written and read least significant bit first.
+ *
+ * @param[in] lens  Code length of each of the 256 symbols (0 = unused, at most
+ * ZXC_HUF_MAX_BITS).
+ * @param[out] codes Bit-reversed code of each symbol.
+ * @return 0 on success, or -1 if the lengths over-subscribe the code space.
+ */
+int zxc_huf_build_codes(const uint8_t lens[256], uint16_t codes[256]);
+
+/**
+ * @brief Writes the trailing seek table block (SEK) to a destination buffer.
+ *
+ * Layout: block header (type SEK, raw size 0), `n` entries of
+ * `ZXC_SEEK_ENTRY_SIZE` bytes, then the footer (entry count + `ZXC_SEEK_MAGIC`)
+ * so that readers can locate the table from the end of the file.
+ *
+ * @param[out] dst Pointer to the destination buffer.
+ * @param[in] rem The remaining space in the destination buffer.
+ * @param[in] entries Array of seek entries, in block order.
+ * @param[in] n Number of entries.
+ * @return int The number of bytes written, or a negative error code if the buffer
+ * is too small.
+ */
+int zxc_write_seek_table(uint8_t* dst, size_t rem, const zxc_seek_entry_t* entries, uint32_t n);
+
+/**
+ * @brief Locates and validates the trailing seek table of a complete ZXC file.
+ *
+ * @param[in] src Pointer to the start of the file.
+ * @param[in] src_size Size of the file in bytes.
+ * @param[out] entries Receives a pointer to the first serialized entry.
+ * @param[out] n Receives the number of entries.
+ * @return int Returns 0 if a valid seek table is present, or -1 otherwise.
+ */
+int zxc_find_seek_table(const uint8_t* src, size_t src_size, const uint8_t** entries,
+                        uint32_t* n);
+
+/**
+ * @brief Deserializes the seek entry at index `idx` of a serialized table.
+ *
+ * @param[in] entries Pointer to the first serialized entry.
+ * @param[in] idx Index of the entry to read.
+ * @param[out] e Pointer to the entry structure to populate.
+ */
+static ZXC_ALWAYS_INLINE void zxc_read_seek_entry(const uint8_t* entries, uint32_t idx,
+                                                  zxc_seek_entry_t* e) {
+    const uint8_t* p = entries + (size_t)idx * ZXC_SEEK_ENTRY_SIZE;
+    e->comp_offset = zxc_le64(p);
+    e->raw_offset = zxc_le64(p + 8);
+    e->comp_size = zxc_le32(p + 16);
+    e->raw_size = zxc_le32(p + 20);
+}
+
+/**
+ * @brief Prepares a (possibly already used) context for a new operation.
+ *
+ * Compression buffers are (re)allocated only when missing or sized for a
+ * smaller block; decompression needs no up-front allocation. A zeroed context
+ * is accepted. Level and checksum settings are always updated.
+ *
+ * @param[in,out] ctx Context to prepare.
+ * @param[in] chunk_size Block size of the upcoming operation.
+ * @param[in] mode 1 for compression, 0 for decompression.
+ * @param[in] level Compression level.
+ * @param[in] checksum_enabled Checksum flag.
+ * @return 0 on success, -1 if memory allocation fails.
+ */
+int zxc_cctx_reserve(zxc_cctx_t* ctx, size_t chunk_size, int mode, int level,
+                     int checksum_enabled);
+
+/**
+ * @brief Makes the block filter scratch (`ctx->filter_buf`) hold at least
+ * `size` bytes. Its contents are not preserved.
+ *
+ * @param[in,out] ctx Compression or decompression context.
+ * @param[in] size Required capacity.
+ * @return 0 on success, -1 if memory allocation fails.
+ */
+int zxc_cctx_filter_reserve(zxc_cctx_t* ctx, size_t size);
+
 /**
  * @brief Internal wrapper function to decompress a single chunk of data.
  *
@@ -859,6 +1181,9 @@ int zxc_read_ghi_header_and_desc(const uint8_t* src, size_t len, zxc_gnr_header_
  * buffer into the destination buffer using the provided compression context. It
  * serves as an abstraction layer over the core decompression logic.
  *
+ * In a linked frame, `ctx->prefix_len` bytes of the previous block's output
+ * must sit right before `dst`; matches may reach into them.
+ *
  * @param[in,out] ctx     Pointer to the ZXC compression context structure containing
  *                internal state and configuration.
  * @param[in] src     Pointer to the source buffer containing compressed data.
@@ -882,6 +1207,11 @@ int zxc_decompress_chunk_wrapper(zxc_cctx_t* ctx, const uint8_t* src, size_t src
  * provided compression context. It handles the interaction with the underlying
  * compression algorithm for a specific block of memory.
  *
+ * With `ctx->prefix_len` set, that many bytes right before `chunk` (the tail of
+ * the previous block) are indexed first and may be referenced by the block.
+ * With `ctx->block_trials` set, the block is encoded as GLO, GHI and NUM and
+ * the cheapest one under `ctx->cost_model` is kept.
+ *
  * @param[in,out] ctx   Pointer to the ZXC compression context containing configuration
  *              and state.
  * @param[in] chunk Pointer to the source buffer containing the raw data to
@@ -897,6 +1227,52 @@ int zxc_decompress_chunk_wrapper(zxc_cctx_t* ctx, const uint8_t* src, size_t src
 int zxc_compress_chunk_wrapper(zxc_cctx_t* ctx, const uint8_t* chunk, size_t src_sz, uint8_t* dst,
                                size_t dst_cap);
 
+/**
+ * @brief Compresses the first block of a frame with the context's dictionary
+ * as its history.
+ *
+ * The block is staged right after the dictionary in `ctx->dict_buf`, which is
+ * then indexed as a prefix (see zxc_compress_chunk_wrapper()).
+ *
+ * @param[in,out] ctx Compression context with a dictionary loaded.
+ * @param[in] chunk Raw block.
+ * @param[in] src_sz Size of the block.
+ * @param[out] dst Destination buffer.
+ * @param[in] dst_cap Capacity of `dst`.
+ * @return The number of bytes written, or -1 on error.
+ */
+int zxc_compress_dict_block(zxc_cctx_t* ctx, const uint8_t* chunk, size_t src_sz, uint8_t* dst,
+                            size_t dst_cap);
+
+/**
+ * @brief Decompresses the first block of a frame that was compressed with the
+ * context's dictionary.
+ *
+ * The block is decoded right after the dictionary in `ctx->dict_buf`, then
+ * copied to `dst`.
+ *
+ * @param[in,out] ctx Decompression context with a dictionary loaded.
+ * @param[in] src Compressed block (header included).
+ * @param[in] src_sz Size of `src`.
+ * @param[out] dst Destination buffer.
+ * @param[in] dst_cap Capacity of `dst`.
+ * @return The number of bytes written, or -1 on error.
+ */
+int zxc_decompress_dict_block(zxc_cctx_t* ctx, const uint8_t* src, size_t src_sz, uint8_t* dst,
+                              size_t dst_cap);
+
+/**
+ * @brief Estimated decode cycles of one block (see zxc_estimate_decode_cost()).
+ *
+ * @param[in] block Block, starting with its header.
+ * @param[in] size Bytes available at `block` (at least the whole block).
+ * @param[in] m Cost model.
+ * @param[out] n_seq Number of LZ sequences (0 for RAW and NUM blocks).
+ * @return The estimate, or UINT64_MAX if the block is malformed.
+ */
+uint64_t zxc_estimate_block_cycles(const uint8_t* block, size_t size,
+                                   const zxc_cost_model_t* m, uint32_t* n_seq);
+
 #ifdef __cplusplus
 }
 #endif
@@ -27,7 +27,7 @@ int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
         return 0;
     }
 
-    if (zxc_stream_compress(f_in, f_comp, 1, 2, 0) != 0) {
+    if (zxc_stream_compress(f_in, f_comp, 1, 2, 0, 0) != 0) {
         fclose(f_in);
         fclose(f_comp);
         free(comp_buf);
@@ -90,6 +90,28 @@ void gen_large_offset_data(uint8_t* buf, size_t size) {
     }
 }
 
+// Generates a small JSON-like message (records sharing keys and layout)
+size_t gen_message(uint8_t* buf, size_t size) {
+    static const char* status[] = {"ok", "pending", "failed", "refunded"};
+    size_t len = 0;
+    int n = snprintf((char*)buf, size, "{\"order\":%d,\"user\":\"user-%04d\",\"items\":[",
+                     rand() % 100000, rand() % 10000);
+    if (n > 0) len = (size_t)n;
+    for (int i = 0; len + 128 < size; i++) {
+        n = snprintf((char*)buf + len, size - len,
+                     "%s{\"sku\":\"SKU-%05d\",\"qty\":%d,\"price\":%d.%02d,\"status\":\"%s\"}",
+                     i ? "," : "", rand() % 100000, 1 + rand() % 9, rand() % 500, rand() % 100,
+                     status[rand() % 4]);
+        if (n <= 0) break;
+        len += (size_t)n;
+    }
+    if (len + 2 <= size) {
+        buf[len++] = ']';
+        buf[len++] = '}';
+    }
+    return len;
+}
+
 // Generic Round-Trip test function (Compress -> Decompress -> Compare)
 int test_round_trip(const char* test_name, const uint8_t* input, size_t size, int level,
                     int checksum) {
@@ -111,7 +133,7 @@ int test_round_trip(const char* test_name, const uint8_t* input, size_t size, in
     fwrite(input, 1, size, f_in);
     fseek(f_in, 0, SEEK_SET);
 
-    if (zxc_stream_compress(f_in, f_comp, 1, level, checksum) < 0) {
+    if (zxc_stream_compress(f_in, f_comp, 1, level, checksum, 0) < 0) {
         printf("Compression Failed!\n");
         fclose(f_in);
         fclose(f_comp);
@@ -213,18 +235,18 @@ int test_invalid_arguments() {
         return 0;
     }
     // Prepare a valid compressed stream for decompression tests
-    zxc_stream_compress(f, f_valid, 1, 1, 0);
+    zxc_stream_compress(f, f_valid, 1, 1, 0, 0);
     rewind(f_valid);
 
     // 1. Input NULL -> Must fail
-    if (zxc_stream_compress(NULL, f, 1, 5, 0) != -1) {
+    if (zxc_stream_compress(NULL, f, 1, 5, 0, 0) != -1) {
         printf("Failed: Should return -1 when Input is NULL\n");
         fclose(f);
         return 0;
     }
 
     // 2. Output NULL -> Must SUCCEED (Benchmark / Dry-Run Mode)
-    if (zxc_stream_compress(f, NULL, 1, 5, 0) == -1) {
+    if (zxc_stream_compress(f, NULL, 1, 5, 0, 0) == -1) {
         printf("Failed: Should allow NULL Output (Benchmark mode support)\n");
         fclose(f);
         return 0;
@@ -245,12 +267,12 @@ int test_invalid_arguments() {
     }
 
     // 4. zxc_compress NULL checks
-    if (zxc_compress(NULL, 100, (void*)1, 100, 3, 0) != 0) {
+    if (zxc_compress(NULL, 100, (void*)1, 100, 3, 0, 0) != 0) {
         printf("Failed: zxc_compress should return 0 when src is NULL\n");
         fclose(f);
         return 0;
     }
-    if (zxc_compress((void*)1, 100, NULL, 100, 3, 0) != 0) {
+    if (zxc_compress((void*)1, 100, NULL, 100, 3, 0, 0) != 0) {
         printf("Failed: zxc_compress should return 0 when dst is NULL\n");
         fclose(f);
         return 0;
@@ -306,7 +328,7 @@ int test_io_failures() {
     fseek(f_in, 0, SEEK_SET);
 
     // This should fail cleanly (return -1) because writing to f_out is impossible
-    if (zxc_stream_compress(f_in, f_out, 1, 5, 0) != -1) {
+    if (zxc_stream_compress(f_in, f_out, 1, 5, 0, 0) != -1) {
         printf("Failed: Should detect write error on read-only stream\n");
         fclose(f_in);
         fclose(f_out);
@@ -334,10 +356,10 @@ int test_thread_params() {
     }
 
     // Test with 0 (Auto) and negative value - must not crash
-    zxc_stream_compress(f_in, f_out, 0, 5, 0);
+    zxc_stream_compress(f_in, f_out, 0, 5, 0, 0);
     fseek(f_in, 0, SEEK_SET);
     fseek(f_out, 0, SEEK_SET);
-    zxc_stream_compress(f_in, f_out, -5, 5, 0);
+    zxc_stream_compress(f_in, f_out, -5, 5, 0, 0);
 
     printf("PASS (No crash observed)\n\n");
     fclose(f_in);
@@ -374,7 +396,7 @@ int test_multithread_roundtrip() {
 
         // Vary thread count: 2, 4, 8
         int num_threads = 2 << iter;
-        if (zxc_stream_compress(f_in, f_comp, num_threads, 3, 1) < 0) {
+        if (zxc_stream_compress(f_in, f_comp, num_threads, 3, 1, 0) < 0) {
             printf("Compression failed (threads=%d)!\n", num_threads);
             fclose(f_in);
             fclose(f_comp);
@@ -419,6 +441,62 @@ cleanup:
     return result;
 }
 
+// Many threads on small blocks: output must be identical to a single-threaded
+// run, and a corrupt block must fail the stream without stalling the pipeline
+int test_multithread_pipeline() {
+    printf("=== TEST: Multi-Thread Pipeline (Ordering & Error Drain) ===\n");
+
+    const size_t SIZE = 2 * 1024 * 1024 + 123;
+    uint8_t* input = malloc(SIZE);
+    uint8_t* ref = malloc(zxc_compress_bound(SIZE));
+    uint8_t* comp = malloc(zxc_compress_bound(SIZE));
+    int ok = input && ref && comp;
+    if (ok) gen_lz_data(input, SIZE);
+
+    int64_t ref_sz = -1;
+    const int threads[] = {1, 3, 16};
+    for (int t = 0; ok && t < 3; t++) {
+        FILE* f_in = tmpfile();
+        FILE* f_comp = tmpfile();
+        fwrite(input, 1, SIZE, f_in);
+        fseek(f_in, 0, SEEK_SET);
+        int64_t c_sz = zxc_stream_compress(f_in, f_comp, threads[t], 2, 1, ZXC_BLOCK_SIZE_MIN);
+        fseek(f_comp, 0, SEEK_SET);
+        uint8_t* dst = (t == 0) ? ref : comp;
+        if (c_sz <= 0 || fread(dst, 1, (size_t)c_sz, f_comp) != (size_t)c_sz ||
+            (t > 0 && (c_sz != ref_sz || memcmp(ref, comp, (size_t)c_sz) != 0))) {
+            printf("Failed: output differs with %d threads\n", threads[t]);
+            ok = 0;
+        }
+        if (t == 0) ref_sz = c_sz;
+        fclose(f_in);
+        fclose(f_comp);
+    }
+
+    if (ok) {
+        // Flip a byte in the payload of a block in the middle of the stream
+        memcpy(comp, ref, (size_t)ref_sz);
+        comp[ref_sz / 2] ^= 0x5A;
+        FILE* f_comp = tmpfile();
+        FILE* f_out = tmpfile();
+        fwrite(comp, 1, (size_t)ref_sz, f_comp);
+        fseek(f_comp, 0, SEEK_SET);
+        if (zxc_stream_decompress(f_comp, f_out, 16, 1) != -1) {
+            printf("Failed: corrupt stream was not rejected\n");
+            ok = 0;
+        }
+        fclose(f_comp);
+        fclose(f_out);
+    }
+
+    free(input);
+    free(ref);
+    free(comp);
+    if (!ok) return 0;
+    printf("PASS\n\n");
+    return 1;
+}
+
 // Checks the buffer-based API (zxc_compress / zxc_decompress)
 int test_buffer_api() {
     printf("=== TEST: Unit - Buffer API (zxc_compress/zxc_decompress) ===\n");
@@ -434,7 +512,7 @@ int test_buffer_api() {
 
     // 2. Compress
     size_t compressed_size =
-        zxc_compress(src, src_size, compressed, max_dst_size, 3, checksum_enabled);
+        zxc_compress(src, src_size, compressed, max_dst_size, 3, checksum_enabled, 0);
     if (compressed_size == 0) {
         printf("Failed: zxc_compress returned 0\n");
         free(src);
@@ -467,7 +545,8 @@ int test_buffer_api() {
 
     // 5. Test error case: Destination too small
     size_t small_capacity = compressed_size / 2;
-    size_t small_res = zxc_compress(src, src_size, compressed, small_capacity, 3, checksum_enabled);
+    size_t small_res =
+        zxc_compress(src, src_size, compressed, small_capacity, 3, checksum_enabled, 0);
     if (small_res != 0) {
         printf("Failed: zxc_compress should fail with small buffer (returned %zu)\n", small_res);
         free(src);
@@ -483,6 +562,1922 @@ int test_buffer_api() {
     return 1;
 }
 
+// Checks random-access decompression through the trailing seek table (stream
+// output) and through the block-header walk fallback (buffer output).
+int test_decompress_range() {
+    printf("=== TEST: Unit - Seek Table (zxc_decompress_range) ===\n");
+
+    size_t src_size = 5 * ZXC_BLOCK_SIZE + 12345;
+    uint8_t* src = malloc(src_size);
+    gen_lz_data(src, src_size);
+    gen_random_data(src + ZXC_BLOCK_SIZE, ZXC_BLOCK_SIZE / 2);
+
+    FILE* f_in = tmpfile();
+    FILE* f_comp = tmpfile();
+    fwrite(src, 1, src_size, f_in);
+    fseek(f_in, 0, SEEK_SET);
+    int64_t stream_size = zxc_stream_compress(f_in, f_comp, 2, 3, 1, 0);
+    fclose(f_in);
+    if (stream_size <= 0) {
+        printf("Failed: zxc_stream_compress returned %lld\n", (long long)stream_size);
+        fclose(f_comp);
+        free(src);
+        return 0;
+    }
+    uint8_t* stream = malloc((size_t)stream_size);
+    fseek(f_comp, 0, SEEK_SET);
+    size_t got = fread(stream, 1, (size_t)stream_size, f_comp);
+    fclose(f_comp);
+
+    size_t cap = zxc_compress_bound(src_size);
+    uint8_t* buf = malloc(cap);
+    size_t buf_size = zxc_compress(src, src_size, buf, cap, 3, 1, 0);
+    uint8_t* out = malloc(src_size);
+
+    const uint8_t* entries;
+    uint32_t n_entries;
+    int ok = got == (size_t)stream_size && buf_size > 0 &&
+             zxc_find_seek_table(stream, got, &entries, &n_entries) == 0 && n_entries == 6 &&
+             zxc_find_seek_table(buf, buf_size, &entries, &n_entries) != 0;
+    if (!ok) printf("Failed: seek table missing from stream output\n");
+
+    // A file ending with a seek table still decodes with the plain buffer API
+    if (ok && (zxc_decompress(stream, got, out, src_size, 1) != src_size ||
+               memcmp(out, src, src_size) != 0)) {
+        printf("Failed: zxc_decompress on seekable stream output\n");
+        ok = 0;
+    }
+
+    const size_t ranges[][2] = {{0, 100},
+                                {ZXC_BLOCK_SIZE - 10, 20},
+                                {3 * ZXC_BLOCK_SIZE + 7, 2 * ZXC_BLOCK_SIZE},
+                                {ZXC_BLOCK_SIZE, ZXC_BLOCK_SIZE},
+                                {src_size - 1, 1}};
+    for (size_t i = 0; ok && i < sizeof(ranges) / sizeof(ranges[0]); i++) {
+        size_t off = ranges[i][0], len = ranges[i][1];
+        size_t expect = (off + len > src_size) ? src_size - off : len;
+        if (zxc_decompress_range(stream, got, off, len, out) != expect ||
+            memcmp(out, src + off, expect) != 0 ||
+            zxc_decompress_range(buf, buf_size, off, len, out) != expect ||
+            memcmp(out, src + off, expect) != 0) {
+            printf("Failed: range [%zu, +%zu)\n", off, len);
+            ok = 0;
+        }
+    }
+
+    if (ok && zxc_decompress_range(stream, got, src_size, 1, out) != 0) {
+        printf("Failed: out-of-range offset should return 0\n");
+        ok = 0;
+    }
+
+    // Without the table, the stream is the same up to its last block
+    zxc_pool_t* pool = ok ? zxc_create_pool(2) : NULL;
+    FILE* f_plain = ok ? tmpfile() : NULL;
+    f_in = ok ? tmpfile() : NULL;
+    if (ok && (!pool || !f_plain || !f_in)) ok = 0;
+    if (ok) {
+        fwrite(src, 1, src_size, f_in);
+        rewind(f_in);
+        zxc_pool_set_seek_table(pool, 0);
+        int64_t plain_size = zxc_stream_compress_pool(pool, f_in, f_plain, 3, 1, 0);
+        const size_t table = ZXC_BLOCK_HEADER_SIZE + 6 * ZXC_SEEK_ENTRY_SIZE + ZXC_SEEK_FOOTER_SIZE;
+        size_t plain_got = 0;
+        if (plain_size == stream_size - (int64_t)table) {
+            rewind(f_plain);
+            plain_got = fread(buf, 1, (size_t)plain_size, f_plain);
+        }
+        if (plain_got != (size_t)stream_size - table || memcmp(buf, stream, plain_got) != 0 ||
+            zxc_find_seek_table(buf, plain_got, &entries, &n_entries) == 0 ||
+            zxc_decompress(buf, plain_got, out, src_size, 1) != src_size ||
+            memcmp(out, src, src_size) != 0 ||
+            zxc_decompress_range(buf, plain_got, 3 * ZXC_BLOCK_SIZE + 7, 100, out) != 100 ||
+            memcmp(out, src + 3 * ZXC_BLOCK_SIZE + 7, 100) != 0) {
+            printf("Failed: stream without seek table\n");
+            ok = 0;
+        }
+    }
+    if (f_in) fclose(f_in);
+    if (f_plain) fclose(f_plain);
+    zxc_free_pool(pool);
+
+    free(src);
+    free(stream);
+    free(buf);
+    free(out);
+    if (!ok) return 0;
+    printf("PASS\n\n");
+    return 1;
+}
+
+// Checks compression with every supported block size and rejection of invalid ones
+int test_block_sizes() {
+    printf("=== TEST: Unit - Configurable Block Size ===\n");
+
+    size_t src_size = 3 * 1024 * 1024 + 777;
+    uint8_t* src = malloc(src_size);
+    size_t third = (src_size / 3) & ~(size_t)3;
+    gen_lz_data(src, third);
+    gen_num_data(src + third, third);
+    gen_random_data(src + 2 * third, src_size - 2 * third);
+    size_t cap = zxc_compress_bound(src_size);
+    uint8_t* comp = malloc(cap);
+    uint8_t* out = malloc(src_size);
+    zxc_cctx_t* cctx = zxc_create_cctx();
+    int ok = cctx != NULL;
+
+    for (size_t bs = ZXC_BLOCK_SIZE_MIN; ok && bs <= ZXC_BLOCK_SIZE_MAX; bs *= 2) {
+        for (int level = 1; ok && level <= 5; level += 2) {
+            size_t c = zxc_compress_cctx(cctx, src, src_size, comp, cap, level, 1, bs);
+            size_t reported = 0;
+            zxc_read_file_header(comp, c, &reported, NULL, NULL, NULL);
+            if (c == 0 || reported != bs || zxc_decompress(comp, c, out, src_size, 1) != src_size ||
+                memcmp(out, src, src_size) != 0) {
+                printf("Failed: block size %zu, level %d\n", bs, level);
+                ok = 0;
+            }
+        }
+    }
+
+    // Stream API with small blocks + range access
+    FILE* f_in = tmpfile();
+    FILE* f_comp = tmpfile();
+    fwrite(src, 1, src_size, f_in);
+    fseek(f_in, 0, SEEK_SET);
+    int64_t s_size = zxc_stream_compress(f_in, f_comp, 3, 2, 0, ZXC_BLOCK_SIZE_MIN);
+    if (ok && (s_size <= 0 || (size_t)s_size > cap)) {
+        printf("Failed: stream compression with 16K blocks\n");
+        ok = 0;
+    }
+    if (ok) {
+        fseek(f_comp, 0, SEEK_SET);
+        size_t got = fread(comp, 1, (size_t)s_size, f_comp);
+        size_t off = 5 * ZXC_BLOCK_SIZE_MIN - 3;
+        if (zxc_decompress(comp, got, out, src_size, 0) != src_size ||
+            memcmp(out, src, src_size) != 0 ||
+            zxc_decompress_range(comp, got, off, 100, out) != 100 ||
+            memcmp(out, src + off, 100) != 0) {
+            printf("Failed: stream output with 16K blocks\n");
+            ok = 0;
+        }
+    }
+    fclose(f_in);
+    fclose(f_comp);
+
+    // Invalid sizes are rejected
+    const size_t bad[] = {1000, 48 * 1024, ZXC_BLOCK_SIZE_MIN / 2, ZXC_BLOCK_SIZE_MAX * 2};
+    for (size_t i = 0; ok && i < sizeof(bad) / sizeof(bad[0]); i++) {
+        if (zxc_compress(src, 4096, comp, cap, 3, 0, bad[i]) != 0 ||
+            zxc_stream_compress(stdin, NULL, 1, 3, 0, bad[i]) != -1) {
+            printf("Failed: block size %zu should be rejected\n", bad[i]);
+            ok = 0;
+        }
+    }
+
+    zxc_free_cctx(cctx);
+    free(src);
+    free(comp);
+    free(out);
+    if (!ok) return 0;
+    printf("PASS\n\n");
+    return 1;
+}
+
+// Checks that reusable contexts produce the same output as the one-shot API
+int test_context_reuse() {
+    printf("=== TEST: Unit - Reusable Contexts (cctx/dctx) ===\n");
+
+    zxc_cctx_t* cctx = zxc_create_cctx();
+    zxc_dctx_t* dctx = zxc_create_dctx();
+    size_t max_size = 16 * 1024;
+    uint8_t* src = malloc(max_size);
+    size_t cap = zxc_compress_bound(max_size);
+    uint8_t* ref = malloc(cap);
+    uint8_t* comp = malloc(cap);
+    uint8_t* out = malloc(max_size);
+    int ok = cctx && dctx;
+
+    for (int i = 0; ok && i < 200; i++) {
+        size_t sz = 1 + (size_t)rand() % max_size;
+        int level = 1 + i % 9;
+        if (i % 3 == 0)
+            gen_random_data(src, sz);
+        else
+            gen_lz_data(src, sz);
+
+        size_t ref_sz = zxc_compress(src, sz, ref, cap, level, i & 1, 0);
+        size_t comp_sz = zxc_compress_cctx(cctx, src, sz, comp, cap, level, i & 1, 0);
+        if (comp_sz == 0 || comp_sz != ref_sz || memcmp(comp, ref, comp_sz) != 0) {
+            printf("Failed: iteration %d differs from zxc_compress\n", i);
+            ok = 0;
+            break;
+        }
+        if (zxc_decompress_dctx(dctx, comp, comp_sz, out, sz, i & 1) != sz ||
+            memcmp(out, src, sz) != 0) {
+            printf("Failed: iteration %d round-trip mismatch\n", i);
+            ok = 0;
+        }
+    }
+
+    zxc_free_cctx(cctx);
+    zxc_free_dctx(dctx);
+    zxc_free_cctx(NULL);
+    zxc_free_dctx(NULL);
+    free(src);
+    free(ref);
+    free(comp);
+    free(out);
+    if (!ok) return 0;
+    printf("PASS\n\n");
+    return 1;
+}
+
+// Checks that the optimal parser (levels 6-10) round-trips and never loses to level 5
+// on text-like data with irregular repeats
+int test_optimal_levels() {
+    printf("=== TEST: Unit - Optimal Parser Levels (6-10) ===\n");
+
+    static const char* words[] = {"zxc ",   "block ", "offset ", "literal ", "match ",
+                                  "token ", "the ",   "of ",     "decoder ", "\n"};
+    const size_t src_size = 256 * 1024;
+    uint8_t* src = malloc(src_size);
+    size_t cap = zxc_compress_bound(src_size);
+    uint8_t* comp = malloc(cap);
+    uint8_t* out = malloc(src_size);
+    int ok = src && comp && out;
+
+    for (size_t n = 0; ok && n < src_size;) {
+        const char* w = words[rand() % 10];
+        for (; *w && n < src_size; w++) src[n++] = (uint8_t)*w;
+    }
+
+    size_t ref = ok ? zxc_compress(src, src_size, comp, cap, ZXC_LEVEL_COMPACT, 1, 0) : 0;
+    for (int level = ZXC_LEVEL_OPTIMAL; ok && level <= ZXC_LEVEL_MAX; level++) {
+        size_t c = zxc_compress(src, src_size, comp, cap, level, 1, 0);
+        if (c == 0 || c > ref) {
+            printf("Failed: level %d gave %zu bytes (level 5: %zu)\n", level, c, ref);
+            ok = 0;
+        } else if (zxc_decompress(comp, c, out, src_size, 1) != src_size ||
+                   memcmp(out, src, src_size) != 0) {
+            printf("Failed: level %d round-trip mismatch\n", level);
+            ok = 0;
+        }
+    }
+
+    free(src);
+    free(comp);
+    free(out);
+    if (!ok) return 0;
+    printf("PASS\n\n");
+    return 1;
+}
+
+// Level 10 codes the literals of text with Huffman codes: the frame is smaller
+// than at level 9, decodes through every API, and a damaged code is rejected
+int test_huffman_literals() {
+    printf("=== TEST: Unit - Huffman Literals (level 10) ===\n");
+
+    const size_t src_size = 600 * 1000;
+    uint8_t* src = malloc(src_size);
+    size_t cap = zxc_compress_bound(src_size);
+    uint8_t* comp = malloc(cap);
+    uint8_t* out = malloc(src_size);
+    zxc_pool_t* pool = zxc_create_pool(2);
+    int ok = src && comp && out && pool;
+    for (size_t n = 0; ok && n < src_size;) n += gen_message(src + n, src_size - n);
+
+    // Without checksum, the GLO header directly follows the block header
+    size_t ref = ok ? zxc_compress(src, src_size, comp, cap, ZXC_LEVEL_DENSE - 1, 0, 0) : 0;
+    size_t c = ok ? zxc_compress(src, src_size, comp, cap, ZXC_LEVEL_DENSE, 0, 0) : 0;
+    int h = c ? zxc_read_file_header(comp, c, NULL, NULL, NULL, NULL) : -1;
+    zxc_block_header_t bh;
+    if (ok && (h < 0 || zxc_read_block_header(comp + h, c - h, &bh) != 0 ||
+               bh.block_type != ZXC_BLOCK_GLO ||
+               comp[h + ZXC_BLOCK_HEADER_SIZE + 8] != ZXC_SECTION_ENCODING_HUFFMAN ||
+               c >= ref)) {
+        printf("Failed: level 10 gave %zu bytes (level 9: %zu)\n", c, ref);
+        ok = 0;
+    }
+
+    if (ok && (zxc_decompress(comp, c, out, src_size, 0) != src_size ||
+               memcmp(out, src, src_size) != 0)) {
+        printf("Failed: round-trip mismatch\n");
+        ok = 0;
+    }
+    if (ok && (zxc_decompress_pool(pool, comp, c, out, src_size, 0) != src_size ||
+               memcmp(out, src, src_size) != 0)) {
+        printf("Failed: pool decompression\n");
+        ok = 0;
+    }
+    // Blocks of skewed literals (few sequences after the Huffman section),
+    // compressed again into a buffer of exactly their size
+    uint32_t x = 1;
+    for (size_t i = 0; i < 4000; i++) {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        const uint32_t k = x % 10;
+        out[i] = (uint8_t)(k < 5 ? 'a' + (x >> 4) % 4 : k < 9 ? 'e' + (x >> 4) % 8 : x >> 8);
+    }
+    for (size_t n = 300; ok && n <= 4000; n += 3) {
+        size_t cn = zxc_compress(out, n, comp, cap, ZXC_LEVEL_DENSE, 0, 0);
+        if (!cn || zxc_compress(out, n, comp, cn, ZXC_LEVEL_DENSE, 0, 0) != cn) {
+            printf("Failed: %zu bytes into an exact-size buffer\n", n);
+            ok = 0;
+        }
+    }
+    c = ok ? zxc_compress(src, src_size, comp, cap, ZXC_LEVEL_DENSE, 0, 0) : 0;
+
+    const size_t r_off = 300 * 1000 + 17, r_len = 5000;
+    if (ok && (zxc_decompress_range(comp, c, r_off, r_len, out) != r_len ||
+               memcmp(out, src + r_off, r_len) != 0)) {
+        printf("Failed: range decompression\n");
+        ok = 0;
+    }
+
+    // Code lengths over-subscribing the code space are rejected
+    if (ok) {
+        uint8_t* lens = comp + h + ZXC_BLOCK_HEADER_SIZE + ZXC_GLO_HEADER_BINARY_SIZE +
+                        ZXC_GLO_SECTIONS * ZXC_SECTION_DESC_BINARY_SIZE;
+        ZXC_MEMSET(lens, 0x11, 64);
+        if (zxc_decompress(comp, c, out, src_size, 0) == src_size) {
+            printf("Failed: invalid code lengths accepted\n");
+            ok = 0;
+        }
+    }
+
+    zxc_free_pool(pool);
+    free(src);
+    free(comp);
+    free(out);
+    if (!ok) return 0;
+    printf("PASS\n\n");
+    return 1;
+}
+
+// Checks the binary-tree match finder of levels 6-9 on repetitive inputs: log
+// lines, long runs and short periods, over several blocks and context reuse
+int test_binary_tree_finder() {
+    printf("=== TEST: Unit - Binary-Tree Match Finder (levels 6-9) ===\n");
+
+    const size_t src_size = 600 * 1000;
+    uint8_t* src = malloc(src_size);
+    size_t cap = zxc_compress_bound(src_size);
+    uint8_t* comp = malloc(cap);
+    uint8_t* out = malloc(src_size);
+    zxc_cctx_t* cctx = zxc_create_cctx();
+    int ok = src && comp && out && cctx;
+
+    for (int pattern = 0; ok && pattern < 3; pattern++) {
+        size_t n = 0;
+        if (pattern == 0) {
+            // Telemetry lines: long shared prefixes, few distinct values
+            while (ok && n < src_size) {
+                char line[128];
+                int len = snprintf(line, sizeof(line),
+                                   "{\"ts\":%zu,\"host\":\"edge-%02d\",\"value\":%d}\n",
+                                   1700000000 + n / 7, rand() % 8, rand() % 100);
+                for (int i = 0; i < len && n < src_size; i++) src[n++] = (uint8_t)line[i];
+            }
+        } else if (pattern == 1) {
+            // A run of zeros, then a period-3 pattern, then random bytes
+            ZXC_MEMSET(src, 0, src_size / 3);
+            for (n = src_size / 3; n < 2 * src_size / 3; n++) src[n] = (uint8_t)(n % 3);
+            for (; n < src_size; n++) src[n] = (uint8_t)rand();
+        } else {
+            gen_lz_data(src, src_size);
+        }
+
+        // Ratio is compared on the telemetry lines; the other patterns leave the
+        // parsers within a few bytes of each other either way
+        size_t ref = zxc_compress(src, src_size, comp, cap, ZXC_LEVEL_COMPACT, 1, 0);
+        for (int level = ZXC_LEVEL_OPTIMAL; ok && level <= ZXC_LEVEL_MAX; level += 3) {
+            // Small blocks put several blocks (and epochs) through the same tree
+            size_t bs = level == ZXC_LEVEL_OPTIMAL ? ZXC_BLOCK_SIZE_MIN : 0;
+            size_t c = zxc_compress_cctx(cctx, src, src_size, comp, cap, level, 1, bs);
+            if (c == 0 || zxc_decompress(comp, c, out, src_size, 1) != src_size ||
+                memcmp(out, src, src_size) != 0) {
+                printf("Failed: pattern %d level %d round-trip\n", pattern, level);
+                ok = 0;
+            } else if (bs == 0 && pattern == 0 && c > ref) {
+                printf("Failed: pattern %d level %d gave %zu bytes (level 5: %zu)\n", pattern,
+                       level, c, ref);
+                ok = 0;
+            }
+        }
+    }
+
+    zxc_free_cctx(cctx);
+    free(src);
+    free(comp);
+    free(out);
+    if (!ok) return 0;
+    printf("PASS\n\n");
+    return 1;
+}
+
+// Checks that GLO blocks of the optimal levels reach repeats further back than
+// 64 KB (the greedy/lazy levels keep to the 64 KB window), and that a far offset
+// escape is rejected when the block header does not announce it
+int test_far_offsets() {
+    printf("=== TEST: Unit - Far GLO Offsets (> 64 KB) ===\n");
+
+    // One 256 KB block: X (80 KB), Y (96 KB), X again, 176 KB after the first copy
+    const size_t part = 80 * 1024;
+    const size_t src_size = ZXC_BLOCK_SIZE;
+    uint8_t* src = malloc(src_size);
+    size_t cap = zxc_compress_bound(src_size);
+    uint8_t* comp = malloc(cap);
+    uint8_t* out = malloc(src_size);
+    int ok = src && comp && out;
+    if (ok) {
+        gen_random_data(src, src_size - part);
+        ZXC_MEMCPY(src + src_size - part, src, part);
+    }
+
+    for (int level = 3; ok && level < ZXC_LEVEL_OPTIMAL; level++) {
+        size_t c = zxc_compress(src, src_size, comp, cap, level, 0, 0);
+        int h = c ? zxc_read_file_header(comp, c, NULL, NULL, NULL, NULL) : -1;
+        zxc_block_header_t bh;
+        if (h < 0 || zxc_read_block_header(comp + h, c - h, &bh) != 0 ||
+            (bh.block_type == ZXC_BLOCK_GLO &&
+             comp[h + ZXC_BLOCK_HEADER_SIZE + 11] == ZXC_OFF_ENC_FAR) ||
+            zxc_decompress(comp, c, out, src_size, 0) != src_size ||
+            memcmp(out, src, src_size) != 0) {
+            printf("Failed: level %d used far offsets\n", level);
+            ok = 0;
+        }
+    }
+
+    for (int level = ZXC_LEVEL_OPTIMAL; ok && level <= ZXC_LEVEL_MAX; level += 3) {
+        size_t c = zxc_compress(src, src_size, comp, cap, level, 0, 0);
+        int h = c ? zxc_read_file_header(comp, c, NULL, NULL, NULL, NULL) : -1;
+        zxc_block_header_t bh;
+        if (h < 0 || zxc_read_block_header(comp + h, c - h, &bh) != 0 ||
+            bh.block_type != ZXC_BLOCK_GLO) {
+            printf("Failed: level %d did not produce a GLO block\n", level);
+            ok = 0;
+            break;
+        }
+        uint8_t* enc_off = comp + h + ZXC_BLOCK_HEADER_SIZE + 11;
+        if (*enc_off != ZXC_OFF_ENC_FAR || c > src_size - part / 2 ||
+            zxc_decompress(comp, c, out, src_size, 0) != src_size ||
+            memcmp(out, src, src_size) != 0) {
+            printf("Failed: level %d (enc_off %d, %zu bytes)\n", level, *enc_off, c);
+            ok = 0;
+            break;
+        }
+
+        // Without the far encoding, the 0 escape is an invalid offset
+        *enc_off = ZXC_OFF_ENC_16;
+        if (zxc_decompress(comp, c, out, src_size, 0) == src_size) {
+            printf("Failed: level %d escape accepted as a 16-bit offset\n", level);
+            ok = 0;
+        }
+        *enc_off = ZXC_OFF_ENC_FAR + 1;
+        if (zxc_decompress(comp, c, out, src_size, 0) == src_size) {
+            printf("Failed: level %d unknown offset encoding accepted\n", level);
+            ok = 0;
+        }
+    }
+
+    free(src);
+    free(comp);
+    free(out);
+    if (!ok) return 0;
+    printf("PASS\n\n");
+    return 1;
+}
+
+// Mostly short offsets (< 2 KB) with a few long ones: GLO packs the offsets on
+// fewer than 16 bits and escapes the long ones through the extras stream
+int test_packed_offsets() {
+    printf("=== TEST: Unit - Bit-Packed GLO Offsets ===\n");
+
+    const size_t src_size = ZXC_BLOCK_SIZE;
+    uint8_t* src = malloc(src_size);
+    size_t cap = zxc_compress_bound(src_size);
+    uint8_t* comp = malloc(cap);
+    uint8_t* out = malloc(src_size);
+    int ok = src && comp && out;
+    size_t n = 0;
+    while (ok && n < src_size) {
+        size_t len = 6 + rand() % 16;
+        size_t off = (rand() % 64 == 0) ? 20000 + rand() % 40000 : 64 + rand() % 1900;
+        if (n >= 60000 && rand() % 2) {
+            for (size_t k = 0; k < len && n < src_size; k++, n++) src[n] = src[n - off];
+        } else {
+            for (size_t k = 0; k < len % 7 + 1 && n < src_size; k++, n++)
+                src[n] = (uint8_t)('a' + rand() % 26);
+        }
+    }
+
+    for (int level = 3; ok && level <= ZXC_LEVEL_MAX; level += 3) {
+        size_t c = zxc_compress(src, src_size, comp, cap, level, 0, 0);
+        int h = c ? zxc_read_file_header(comp, c, NULL, NULL, NULL, NULL) : -1;
+        zxc_block_header_t bh;
+        if (h < 0 || zxc_read_block_header(comp + h, c - h, &bh) != 0 ||
+            bh.block_type != ZXC_BLOCK_GLO) {
+            printf("Failed: level %d did not produce a GLO block\n", level);
+            ok = 0;
+            break;
+        }
+        uint8_t* glo = comp + h + ZXC_BLOCK_HEADER_SIZE;
+        const uint8_t off_bits = glo[12];
+        if (off_bits < ZXC_OFF_PACK_MIN_BITS || off_bits >= 16 ||
+            zxc_decompress(comp, c, out, src_size, 0) != src_size ||
+            memcmp(out, src, src_size) != 0) {
+            printf("Failed: level %d (off_bits %d, %zu bytes)\n", level, off_bits, c);
+            ok = 0;
+            break;
+        }
+
+        // Widths of 16 bits and more, or packed 8-bit offsets, are malformed
+        glo[12] = 16;
+        if (zxc_decompress(comp, c, out, src_size, 0) == src_size) {
+            printf("Failed: level %d 16-bit packed width accepted\n", level);
+            ok = 0;
+        }
+        glo[12] = off_bits;
+        const uint8_t enc_off = glo[11];
+        glo[11] = ZXC_OFF_ENC_8;
+        if (zxc_decompress(comp, c, out, src_size, 0) == src_size) {
+            printf("Failed: level %d packed 8-bit offsets accepted\n", level);
+            ok = 0;
+        }
+        glo[11] = enc_off;
+    }
+
+    free(src);
+    free(comp);
+    free(out);
+    if (!ok) return 0;
+    printf("PASS\n\n");
+    return 1;
+}
+
+// Records that repeat the previous one but for a byte or two: the matches
+// resume at the same distance after each change, as repeat-offset codes
+int test_repeat_offsets() {
+    printf("=== TEST: Unit - GLO Repeat Offsets ===\n");
+
+    const size_t rec = 28;
+    const size_t src_size = ZXC_BLOCK_SIZE;
+    uint8_t* src = malloc(src_size);
+    size_t cap = zxc_compress_bound(src_size);
+    uint8_t* comp = malloc(cap);
+    uint8_t* out = malloc(src_size);
+    int ok = src && comp && out;
+    for (size_t i = 0; ok && i < src_size; i++)
+        src[i] = (i < rec || rand() % 24 == 0) ? (uint8_t)rand() : src[i - rec];
+
+    for (int level = 3; ok && level <= 5; level++) {
+        size_t c = zxc_compress(src, src_size, comp, cap, level, 0, 0);
+        int h = c ? zxc_read_file_header(comp, c, NULL, NULL, NULL, NULL) : -1;
+        zxc_block_header_t bh;
+        if (h < 0 || zxc_read_block_header(comp + h, c - h, &bh) != 0 ||
+            bh.block_type != ZXC_BLOCK_GLO) {
+            printf("Failed: level %d did not produce a GLO block\n", level);
+            ok = 0;
+            break;
+        }
+        uint8_t* glo = comp + h + ZXC_BLOCK_HEADER_SIZE;
+        const uint8_t enc_off = glo[11];
+        if (!(enc_off & ZXC_OFF_ENC_REP) || zxc_decompress(comp, c, out, src_size, 0) != src_size ||
+            memcmp(out, src, src_size) != 0) {
+            printf("Failed: level %d (enc_off 0x%02x, %zu bytes)\n", level, enc_off, c);
+            ok = 0;
+            break;
+        }
+
+        // Unknown offset modes are malformed, with or without repeat codes
+        glo[11] = (ZXC_OFF_ENC_FAR + 1) | ZXC_OFF_ENC_REP;
+        if (zxc_decompress(comp, c, out, src_size, 0) == src_size) {
+            printf("Failed: level %d unknown offset mode accepted\n", level);
+            ok = 0;
+        }
+        glo[11] = enc_off;
+    }
+
+    free(src);
+    free(comp);
+    free(out);
+    if (!ok) return 0;
+    printf("PASS\n\n");
+    return 1;
+}
+
+// Text and counter blocks: the trials keep the best type of each block, and a
+// decode-biased cost model never picks slower blocks than the size-only one
+int test_block_trials() {
+    printf("=== TEST: Unit - Block Type Trials ===\n");
+
+    static const char* const words[] = {"block ", "trial ", "encode ", "the ", "of ",
+                                        "offset ", "literal ", "match ", "length ", "zxc "};
+    const size_t block = 32 * 1024;
+    const size_t src_size = 4 * block;
+    uint8_t* src = malloc(src_size);
+    size_t cap = zxc_compress_bound(src_size);
+    uint8_t* ref = malloc(cap);
+    uint8_t* comp = malloc(cap);
+    uint8_t* comp2 = malloc(cap);
+    uint8_t* out = malloc(src_size);
+    zxc_cctx_t* cctx = zxc_create_cctx();
+    zxc_pool_t* pool = zxc_create_pool(2);
+    int ok = src && ref && comp && comp2 && out && cctx && pool;
+    for (size_t b = 0; ok && b < 4; b++) {
+        uint8_t* p = src + b * block;
+        if (b % 2 == 0) {
+            size_t n = 0;
+            while (n < block) {
+                const char* w = words[rand() % 10];
+                for (size_t k = 0; w[k] && n < block; k++) p[n++] = (uint8_t)w[k];
+            }
+        } else {
+            for (size_t i = 0; i < block / 4; i++) {
+                const uint32_t v = (uint32_t)(1000000 + 3 * i + rand() % 4);
+                p[4 * i] = (uint8_t)v;
+                p[4 * i + 1] = (uint8_t)(v >> 8);
+                p[4 * i + 2] = (uint8_t)(v >> 16);
+                p[4 * i + 3] = (uint8_t)(v >> 24);
+            }
+        }
+    }
+
+    // Size only: never larger than the level's own choice, GLO text at level 2
+    for (int level = 2; ok && level <= 3; level++) {
+        zxc_cctx_set_block_trials(cctx, 0);
+        size_t r_sz = zxc_compress_cctx(cctx, src, src_size, ref, cap, level, 1, block);
+        zxc_cctx_set_block_trials(cctx, 1);
+        size_t c_sz = zxc_compress_cctx(cctx, src, src_size, comp, cap, level, 1, block);
+        zxc_block_cost_t bc[4];
+        if (r_sz == 0 || c_sz == 0 || c_sz > r_sz ||
+            zxc_estimate_decode_cost(comp, c_sz, NULL, bc, 4) != 4 ||
+            bc[0].block_type != ZXC_BLOCK_GLO || bc[1].block_type != ZXC_BLOCK_NUM) {
+            printf("Failed: level %d trials %zu bytes vs %zu\n", level, c_sz, r_sz);
+            ok = 0;
+            break;
+        }
+        zxc_pool_set_block_trials(pool, 1);
+        size_t p_sz = zxc_compress_pool(pool, src, src_size, comp2, cap, level, 1, block);
+        if (p_sz != c_sz || memcmp(comp2, comp, c_sz) != 0 ||
+            zxc_decompress(comp, c_sz, out, src_size, 1) != src_size ||
+            memcmp(out, src, src_size) != 0) {
+            printf("Failed: level %d pool output or decompression\n", level);
+            ok = 0;
+        }
+    }
+
+    // Decode-biased: fewer (or as many) estimated cycles in every block
+    zxc_cost_model_t cm;
+    zxc_cost_model_init(&cm, 64);
+    zxc_block_cost_t size_bc[4], fast_bc[4];
+    size_t r_sz = ok ? zxc_compress_cctx(cctx, src, src_size, ref, cap, 3, 0, block) : 0;
+    zxc_cctx_set_cost_model(cctx, &cm);
+    size_t c_sz = ok ? zxc_compress_cctx(cctx, src, src_size, comp, cap, 3, 0, block) : 0;
+    zxc_cctx_set_cost_model(cctx, NULL);
+    if (ok && (r_sz == 0 || c_sz == 0 ||
+               zxc_estimate_decode_cost(ref, r_sz, &cm, size_bc, 4) != 4 ||
+               zxc_estimate_decode_cost(comp, c_sz, &cm, fast_bc, 4) != 4 ||
+               zxc_decompress(comp, c_sz, out, src_size, 0) != src_size ||
+               memcmp(out, src, src_size) != 0)) {
+        printf("Failed: decode-biased trials\n");
+        ok = 0;
+    }
+    for (int b = 0; ok && b < 4; b++) {
+        if (fast_bc[b].est_cycles > size_bc[b].est_cycles) {
+            printf("Failed: block %d slower under the decode-biased model\n", b);
+            ok = 0;
+        }
+    }
+
+    zxc_free_pool(pool);
+    zxc_free_cctx(cctx);
+    free(src);
+    free(ref);
+    free(comp);
+    free(comp2);
+    free(out);
+    if (!ok) return 0;
+    printf("PASS\n\n");
+    return 1;
+}
+
+// Counters whose deltas fill every width from 0 to 32 bits, in a partial last
+// frame too: the SIMD unpackers and the scalar tail must agree
+int test_num_widths() {
+    printf("=== TEST: Unit - NUM Delta Widths ===\n");
+
+    const size_t n_vals = 8 * 128 + 37;
+    const size_t src_size = n_vals * 4;
+    uint8_t* src = malloc(src_size);
+    size_t cap = zxc_compress_bound(src_size);
+    uint8_t* comp = malloc(cap);
+    uint8_t* out = malloc(src_size);
+    zxc_cctx_t* cctx = zxc_create_cctx();
+    int ok = src && comp && out && cctx;
+    if (ok) zxc_cctx_set_block_trials(cctx, 1);
+
+    int num_blocks = 0;
+    for (unsigned bits = 0; ok && bits <= 32; bits++) {
+        // Zigzag of a delta in [-2^(bits-1), 2^(bits-1)) takes at most `bits` bits
+        uint32_t v = (uint32_t)rand();
+        for (size_t i = 0; i < n_vals; i++) {
+            uint32_t z = 0;
+            if (bits > 0) {
+                z = ((uint32_t)rand() << 16) ^ (uint32_t)rand();
+                z = bits < 32 ? z & ((1U << bits) - 1) : z;
+                if (i % 7 == 0) z |= 1U << (bits - 1);  // Full width in every frame
+            }
+            v += (z >> 1) ^ (0U - (z & 1));
+            src[4 * i] = (uint8_t)v;
+            src[4 * i + 1] = (uint8_t)(v >> 8);
+            src[4 * i + 2] = (uint8_t)(v >> 16);
+            src[4 * i + 3] = (uint8_t)(v >> 24);
+        }
+        size_t c = zxc_compress_cctx(cctx, src, src_size, comp, cap, 3, 1, 0);
+        zxc_block_cost_t bc;
+        if (c == 0 || zxc_estimate_decode_cost(comp, c, NULL, &bc, 1) != 1 ||
+            zxc_decompress(comp, c, out, src_size, 1) != src_size ||
+            memcmp(out, src, src_size) != 0) {
+            printf("Failed: %u-bit deltas\n", bits);
+            ok = 0;
+            break;
+        }
+        num_blocks += bc.block_type == ZXC_BLOCK_NUM;
+    }
+    // Up to 30 bits, the deltas beat both LZ and raw storage
+    if (ok && num_blocks < 30) {
+        printf("Failed: only %d NUM blocks\n", num_blocks);
+        ok = 0;
+    }
+
+    zxc_free_cctx(cctx);
+    free(src);
+    free(comp);
+    free(out);
+    if (!ok) return 0;
+    printf("PASS\n\n");
+    return 1;
+}
+
+// 16-bit samples and 64-bit counters: the probe picks their width without
+// trials, and every delta width of both round-trips (with trials)
+int test_num_element_widths() {
+    printf("=== TEST: Unit - NUM Element Widths ===\n");
+    zxc_cost_model_t cm;
+    zxc_cost_model_init(&cm, 16);
+
+    const size_t src_size = 8 * (8 * 128 + 37);
+    uint8_t* src = malloc(src_size);
+    size_t cap = zxc_compress_bound(src_size);
+    uint8_t* comp = malloc(cap);
+    uint8_t* out = malloc(src_size);
+    zxc_cctx_t* cctx = zxc_create_cctx();
+    int ok = src && comp && out && cctx;
+
+    for (size_t width = 2; ok && width <= 8; width += 6) {
+        const unsigned max_bits = (unsigned)width * 8;
+        // Default path: slowly varying values, small deltas for their width
+        uint64_t v = 0;
+        for (size_t i = 0; i < src_size / width; i++) {
+            v += (uint64_t)(i % 64 < 32 ? 40 : -40) + (uint64_t)(rand() % 9);
+            for (size_t k = 0; k < width; k++) src[i * width + k] = (uint8_t)(v >> (8 * k));
+        }
+        zxc_cctx_set_block_trials(cctx, 0);
+        size_t c = zxc_compress_cctx(cctx, src, src_size, comp, cap, 3, 0, 0);
+        int h = c ? zxc_read_file_header(comp, c, NULL, NULL, NULL, NULL) : -1;
+        zxc_block_header_t bh;
+        if (h < 0 || zxc_read_block_header(comp + h, c - h, &bh) != 0 ||
+            bh.block_type != ZXC_BLOCK_NUM || comp[h + ZXC_BLOCK_HEADER_SIZE + 10] != width ||
+            zxc_decompress(comp, c, out, src_size, 0) != src_size ||
+            memcmp(out, src, src_size) != 0) {
+            printf("Failed: %zu-byte values not detected\n", width);
+            ok = 0;
+            break;
+        }
+
+        // Decode-biased: LZ on byte planes can be smaller, never faster to decode
+        zxc_cctx_set_block_trials(cctx, 1);
+        zxc_cctx_set_cost_model(cctx, &cm);
+        unsigned num_blocks = 0;
+        for (unsigned bits = 0; ok && bits <= max_bits; bits++) {
+            const uint64_t zmask = bits < 64 ? (1ULL << bits) - 1 : UINT64_MAX;
+            v = ((uint64_t)rand() << 32) ^ (uint64_t)rand();
+            for (size_t i = 0; i < src_size / width; i++) {
+                uint64_t z = 0;
+                if (bits > 0) {
+                    z = ((uint64_t)rand() << 42) ^ ((uint64_t)rand() << 21) ^ (uint64_t)rand();
+                    z &= zmask;
+                    if (i % 7 == 0) z |= 1ULL << (bits - 1);  // Full width in every frame
+                }
+                v += (z >> 1) ^ (0 - (z & 1));
+                for (size_t k = 0; k < width; k++) src[i * width + k] = (uint8_t)(v >> (8 * k));
+            }
+            c = zxc_compress_cctx(cctx, src, src_size, comp, cap, 3, 1, 0);
+            zxc_block_cost_t bc;
+            if (c == 0 || zxc_estimate_decode_cost(comp, c, NULL, &bc, 1) != 1 ||
+                zxc_decompress(comp, c, out, src_size, 1) != src_size ||
+                memcmp(out, src, src_size) != 0) {
+                printf("Failed: %zu-byte values, %u-bit deltas\n", width, bits);
+                ok = 0;
+                break;
+            }
+            num_blocks += bc.block_type == ZXC_BLOCK_NUM;
+        }
+        // All but the widest deltas (and constant values) beat LZ and raw storage
+        if (ok && num_blocks + 3 < max_bits) {
+            printf("Failed: only %u NUM blocks of %zu-byte values\n", num_blocks, width);
+            ok = 0;
+        }
+    }
+
+    zxc_free_cctx(cctx);
+    free(src);
+    free(comp);
+    free(out);
+    if (!ok) return 0;
+    printf("PASS\n\n");
+    return 1;
+}
+
+int test_float_blocks() {
+    printf("=== TEST: Unit - FLT Blocks ===\n");
+    zxc_cost_model_t cm;
+    zxc_cost_model_init(&cm, 16);
+
+    const size_t src_size = 8 * (8 * 128 + 37);
+    uint8_t* src = malloc(src_size);
+    size_t cap = zxc_compress_bound(src_size);
+    uint8_t* comp = malloc(cap);
+    uint8_t* out = malloc(src_size);
+    zxc_cctx_t* cctx = zxc_create_cctx();
+    int ok = src && comp && out && cctx;
+
+    for (size_t width = 4; ok && width <= 8; width += 4) {
+        const unsigned max_bits = (unsigned)width * 8;
+        // Default path: noisy series around 50 (floats), the same widened to doubles
+        float x = 50.0f;
+        for (size_t i = 0; i < src_size / width; i++) {
+            x += (float)(rand() % 2001 - 1000) / 2000.0f - (x - 50.0f) / 64.0f;
+            if (width == 4) {
+                memcpy(src + i * 4, &x, 4);
+            } else {
+                const double d = x;
+                memcpy(src + i * 8, &d, 8);
+            }
+        }
+        zxc_cctx_set_block_trials(cctx, 0);
+        size_t c = zxc_compress_cctx(cctx, src, src_size, comp, cap, 3, 0, 0);
+        int h = c ? zxc_read_file_header(comp, c, NULL, NULL, NULL, NULL) : -1;
+        zxc_block_header_t bh;
+        if (h < 0 || zxc_read_block_header(comp + h, c - h, &bh) != 0 ||
+            bh.block_type != ZXC_BLOCK_FLT || comp[h + ZXC_BLOCK_HEADER_SIZE + 10] != width ||
+            zxc_decompress(comp, c, out, src_size, 0) != src_size ||
+            memcmp(out, src, src_size) != 0) {
+            printf("Failed: %zu-byte floats not detected\n", width);
+            ok = 0;
+            break;
+        }
+
+        // Every residual width, shifted by a varying count of trailing zeros
+        // (decode-biased, as LZ on byte planes can be smaller)
+        zxc_cctx_set_block_trials(cctx, 1);
+        zxc_cctx_set_cost_model(cctx, &cm);
+        unsigned flt_blocks = 0;
+        for (unsigned bits = 0; ok && bits <= max_bits; bits++) {
+            const unsigned shift = bits ? (bits * 7) % (max_bits - bits + 1) : 0;
+            const uint64_t xmask = bits < 64 ? (1ULL << bits) - 1 : UINT64_MAX;
+            uint64_t v = ((uint64_t)rand() << 32) ^ (uint64_t)rand();
+            for (size_t i = 0; i < src_size / width; i++) {
+                uint64_t r = 0;
+                if (bits > 0) {
+                    r = ((uint64_t)rand() << 42) ^ ((uint64_t)rand() << 21) ^ (uint64_t)rand();
+                    r &= xmask;
+                    if (i % 7 == 0) r |= 1ULL << (bits - 1) | 1;  // Full width in every frame
+                }
+                v ^= r << shift;
+                for (size_t k = 0; k < width; k++) src[i * width + k] = (uint8_t)(v >> (8 * k));
+            }
+            c = zxc_compress_cctx(cctx, src, src_size, comp, cap, 3, 1, 0);
+            zxc_block_cost_t bc;
+            if (c == 0 || zxc_estimate_decode_cost(comp, c, NULL, &bc, 1) != 1 ||
+                zxc_decompress(comp, c, out, src_size, 1) != src_size ||
+                memcmp(out, src, src_size) != 0) {
+                printf("Failed: %zu-byte floats, %u-bit residuals\n", width, bits);
+                ok = 0;
+                break;
+            }
+            flt_blocks += bc.block_type == ZXC_BLOCK_FLT;
+        }
+        // All but the widest residuals (and constant values) beat LZ and raw storage
+        if (ok && flt_blocks + 4 < max_bits) {
+            printf("Failed: only %u FLT blocks of %zu-byte floats\n", flt_blocks, width);
+            ok = 0;
+        }
+    }
+
+    zxc_free_cctx(cctx);
+    free(src);
+    free(comp);
+    free(out);
+    if (!ok) return 0;
+    printf("PASS\n\n");
+    return 1;
+}
+
+// Vertex-like records (float coordinates, a varying tail) split into byte
+// planes: the block is flagged with its stride, whole or not, with trials too
+int test_shuffle_filter() {
+    printf("=== TEST: Unit - Byte-Shuffle Filter ===\n");
+
+    const size_t max_size = 16 * 4096 + 5;
+    uint8_t* src = malloc(max_size);
+    size_t cap = zxc_compress_bound(max_size);
+    uint8_t* comp = malloc(cap);
+    uint8_t* out = malloc(max_size);
+    zxc_cctx_t* cctx = zxc_create_cctx();
+    int ok = src && comp && out && cctx;
+
+    for (size_t stride = 12; ok && stride <= 16; stride += 4) {
+        const size_t n_rec = 4096;
+        float p[3] = {0.0f, 100.0f, -50.0f};
+        for (size_t i = 0; i < n_rec; i++) {
+            uint8_t* r = src + i * stride;
+            for (int k = 0; k < 3; k++) {
+                p[k] += (float)(rand() % 2001 - 1000) / 1000.0f;
+                memcpy(r + 4 * k, &p[k], 4);
+            }
+            if (stride == 16) memcpy(r + 12, (const uint8_t[]){0, 0, (uint8_t)i, 0x3F}, 4);
+        }
+        for (size_t tail = 0; ok && tail <= 5; tail += 5) {
+            const size_t src_size = n_rec * stride + tail;
+            if (tail) gen_random_data(src + n_rec * stride, tail);
+            for (int trials = 0; ok && trials <= 1; trials++) {
+                zxc_cctx_set_block_trials(cctx, trials);
+                for (int level = 1; ok && level <= 5; level++) {
+                    size_t c = zxc_compress_cctx(cctx, src, src_size, comp, cap, level, 1, 0);
+                    int h = c ? zxc_read_file_header(comp, c, NULL, NULL, NULL, NULL) : -1;
+                    zxc_block_header_t bh;
+                    if (h < 0 || zxc_read_block_header(comp + h, c - h, &bh) != 0 ||
+                        !(bh.block_flags & ZXC_BLOCK_FLAG_SHUFFLE) || bh.reserved != stride ||
+                        zxc_decompress(comp, c, out, src_size, 1) != src_size ||
+                        memcmp(out, src, src_size) != 0 ||
+                        zxc_compress_cctx(cctx, src, src_size, comp, c, level, 1, 0) != c) {
+                        printf("Failed: %zu-byte records + %zu, trials %d, level %d\n", stride,
+                               tail, trials, level);
+                        ok = 0;
+                    }
+                }
+            }
+        }
+    }
+
+    // Text has no record stride: no filter
+    gen_lz_data(src, max_size);
+    zxc_cctx_set_block_trials(cctx, 0);
+    size_t c = ok ? zxc_compress_cctx(cctx, src, max_size, comp, cap, 3, 0, 0) : 0;
+    int h = c ? zxc_read_file_header(comp, c, NULL, NULL, NULL, NULL) : -1;
+    zxc_block_header_t bh;
+    if (ok && (h < 0 || zxc_read_block_header(comp + h, c - h, &bh) != 0 ||
+               (bh.block_flags & ZXC_BLOCK_FLAG_SHUFFLE) || bh.reserved != 0)) {
+        printf("Failed: filter on text\n");
+        ok = 0;
+    }
+
+    // Smooth vertices in [1, 2): NUM and FLT accept them too, but the planes are smaller
+    float q[3] = {1.5f, 1.5f, 1.5f};
+    for (size_t i = 0; i < 4096; i++) {
+        for (int k = 0; k < 3; k++) {
+            q[k] += (float)(rand() % 201 - 100) * 1e-5f;
+            memcpy(src + i * 12 + 4 * k, &q[k], 4);
+        }
+    }
+    for (int level = 1; ok && level <= 5; level += 2) {
+        c = zxc_compress_cctx(cctx, src, 4096 * 12, comp, cap, level, 1, 0);
+        h = c ? zxc_read_file_header(comp, c, NULL, NULL, NULL, NULL) : -1;
+        if (h < 0 || zxc_read_block_header(comp + h, c - h, &bh) != 0 ||
+            !(bh.block_flags & ZXC_BLOCK_FLAG_SHUFFLE) || bh.reserved != 12 ||
+            zxc_decompress(comp, c, out, 4096 * 12, 1) != 4096 * 12 ||
+            memcmp(out, src, 4096 * 12) != 0) {
+            printf("Failed: smooth vertices, level %d\n", level);
+            ok = 0;
+        }
+    }
+
+    zxc_free_cctx(cctx);
+    free(src);
+    free(comp);
+    free(out);
+    if (!ok) return 0;
+    printf("PASS\n\n");
+    return 1;
+}
+
+// Machine code calling a few functions from everywhere: the branch filter
+// makes the calls repeat. The x86 filler is full of E8/E9, 00 and FF bytes,
+// so that skipped and converted displacements overlap the opcodes around them
+int test_bcj_filter() {
+    printf("=== TEST: Unit - Branch (BCJ) Filter ===\n");
+
+    const size_t src_size = 64 * 1024 + 3;
+    uint8_t* src = malloc(src_size);
+    size_t cap = zxc_compress_bound(src_size);
+    uint8_t* comp = malloc(cap);
+    uint8_t* out = malloc(src_size);
+    zxc_cctx_t* cctx = zxc_create_cctx();
+    int ok = src && comp && out && cctx;
+
+    const uint32_t targets[4] = {0x100, 0x2340, 0x8000, 0xF0F0};
+    for (uint16_t arch = ZXC_BCJ_X86; ok && arch <= ZXC_BCJ_ARM64; arch++) {
+        size_t i = 0;
+        if (arch == ZXC_BCJ_X86) {
+            static const uint8_t filler[6] = {0xE8, 0xE9, 0x00, 0xFF, 0x48, 0x8B};
+            while (i + 5 <= src_size) {
+                if (rand() % 4 == 0) {
+                    const uint32_t d = targets[rand() % 4] - (uint32_t)(i + 5);
+                    src[i] = 0xE8;
+                    zxc_store_le32(src + i + 1, d);
+                    i += 5;
+                } else {
+                    src[i++] = rand() % 2 ? filler[rand() % 6] : (uint8_t)rand();
+                }
+            }
+        } else {
+            static const uint32_t insns[4] = {0xD503201FU, 0xAA0003E0U, 0xF9400000U, 0xD65F03C0U};
+            for (; i + 4 <= src_size; i += 4) {
+                uint32_t w = insns[rand() % 4];
+                // BL with imm26 = target - word index
+                if (rand() % 8 == 0)
+                    w = 0x94000000U | ((targets[rand() % 4] - (uint32_t)(i / 4)) & 0x03FFFFFFU);
+                zxc_store_le32(src + i, w);
+            }
+        }
+        for (; i < src_size; i++) src[i] = 0xE8;
+
+        for (int trials = 0; ok && trials <= 1; trials++) {
+            zxc_cctx_set_block_trials(cctx, trials);
+            for (int level = 1; ok && level <= 5; level++) {
+                size_t c = zxc_compress_cctx(cctx, src, src_size, comp, cap, level, 1, 0);
+                int h = c ? zxc_read_file_header(comp, c, NULL, NULL, NULL, NULL) : -1;
+                zxc_block_header_t bh;
+                if (h < 0 || zxc_read_block_header(comp + h, c - h, &bh) != 0 ||
+                    !(bh.block_flags & ZXC_BLOCK_FLAG_BCJ) || bh.reserved != arch ||
+                    zxc_decompress(comp, c, out, src_size, 1) != src_size ||
+                    memcmp(out, src, src_size) != 0 ||
+                    // Same output into a buffer of exactly its size
+                    zxc_compress_cctx(cctx, src, src_size, comp, c, level, 1, 0) != c) {
+                    printf("Failed: architecture %u, trials %d, level %d\n", arch, trials, level);
+                    ok = 0;
+                }
+            }
+        }
+    }
+
+    zxc_free_cctx(cctx);
+    free(src);
+    free(comp);
+    free(out);
+    if (!ok) return 0;
+    printf("PASS\n\n");
+    return 1;
+}
+
+// Linked blocks: a period longer than a block but shorter than block + 64 KB
+// only compresses when each block can reference the tail of the previous one
+int test_linked_blocks() {
+    printf("=== TEST: Unit - Linked Blocks (64 KB prefix) ===\n");
+
+    const size_t block = 32 * 1024;
+    const size_t period = 40 * 1024;
+    const size_t src_size = 300 * 1000;
+    uint8_t* src = malloc(src_size);
+    size_t cap = zxc_compress_bound(src_size);
+    uint8_t* ref = malloc(cap);
+    uint8_t* comp = malloc(cap);
+    uint8_t* comp2 = malloc(cap);
+    uint8_t* out = malloc(src_size);
+    zxc_cctx_t* cctx = zxc_create_cctx();
+    zxc_dctx_t* dctx = zxc_create_dctx();
+    zxc_pool_t* pool = zxc_create_pool(2);
+    int ok = src && ref && comp && comp2 && out && cctx && dctx && pool;
+    if (ok) {
+        gen_random_data(src, period);
+        for (size_t i = period; i < src_size; i++) src[i] = src[i - period];
+    }
+
+    for (int level = 1; ok && level <= ZXC_LEVEL_MAX; level += (level < 3 ? 2 : 3)) {
+        zxc_cctx_set_linked_blocks(cctx, 0);
+        size_t r_sz = zxc_compress_cctx(cctx, src, src_size, ref, cap, level, 1, block);
+        zxc_cctx_set_linked_blocks(cctx, 1);
+        size_t c_sz = zxc_compress_cctx(cctx, src, src_size, comp, cap, level, 1, block);
+        int linked = 0;
+        if (r_sz == 0 || c_sz == 0 ||
+            zxc_read_file_header(comp, c_sz, NULL, NULL, &linked, NULL) < 0 || !linked ||
+            c_sz > r_sz / 2) {
+            printf("Failed: level %d linked %zu bytes vs independent %zu\n", level, c_sz, r_sz);
+            ok = 0;
+            break;
+        }
+
+        // Parallel compression gives the same frame; every decoder accepts it
+        zxc_pool_set_linked_blocks(pool, 1);
+        size_t p_sz = zxc_compress_pool(pool, src, src_size, comp2, cap, level, 1, block);
+        if (p_sz != c_sz || memcmp(comp2, comp, c_sz) != 0) {
+            printf("Failed: level %d pool output differs\n", level);
+            ok = 0;
+        }
+        if (zxc_decompress(comp, c_sz, out, src_size, 1) != src_size ||
+            memcmp(out, src, src_size) != 0) {
+            printf("Failed: level %d decompression\n", level);
+            ok = 0;
+        }
+        ZXC_MEMSET(out, 0, src_size);
+        if (zxc_decompress_pool(pool, comp, c_sz, out, src_size, 1) != src_size ||
+            memcmp(out, src, src_size) != 0) {
+            printf("Failed: level %d pool decompression\n", level);
+            ok = 0;
+        }
+        const size_t r_off = 5 * block + 1234, r_len = 3 * block;
+        if (zxc_decompress_range(comp, c_sz, r_off, r_len, out) != r_len ||
+            memcmp(out, src + r_off, r_len) != 0) {
+            printf("Failed: level %d range decompression\n", level);
+            ok = 0;
+        }
+
+        // Each block decodes again alone, in place, after the blocks before it
+        zxc_block_cost_t bc[16];
+        size_t n_blk = zxc_estimate_decode_cost(comp, c_sz, NULL, bc, 16);
+        int blk_ok = n_blk == 10 && zxc_decompress_dctx(dctx, comp, c_sz, out, src_size, 1) ==
+                                        src_size;
+        for (size_t i = 0; blk_ok && i < n_blk; i++) {
+            ZXC_MEMSET(out + bc[i].raw_offset, 0, bc[i].raw_size);
+            blk_ok = zxc_decompress_block_dctx(dctx, comp, c_sz, &bc[i], out, src_size, 1) ==
+                     bc[i].raw_size;
+        }
+        if (!blk_ok || memcmp(out, src, src_size) != 0) {
+            printf("Failed: level %d block decompression\n", level);
+            ok = 0;
+        }
+
+        // Without the flag, the references into the previous block are invalid
+        comp[6] &= (uint8_t)~ZXC_FILE_FLAG_LINKED;
+        if (zxc_decompress(comp, c_sz, out, src_size, 0) == src_size &&
+            memcmp(out, src, src_size) == 0) {
+            printf("Failed: level %d decoded without the linked flag\n", level);
+            ok = 0;
+        }
+        comp[6] |= ZXC_FILE_FLAG_LINKED;
+    }
+
+    // Streams: linked compression on a pool, decompression on several threads
+    FILE* f_in = ok ? tmpfile() : NULL;
+    FILE* f_comp = ok ? tmpfile() : NULL;
+    FILE* f_out = ok ? tmpfile() : NULL;
+    if (ok && (!f_in || !f_comp || !f_out)) ok = 0;
+    if (ok) {
+        fwrite(src, 1, src_size, f_in);
+        rewind(f_in);
+        zxc_pool_set_linked_blocks(pool, 1);
+        int64_t c_sz = zxc_stream_compress_pool(pool, f_in, f_comp, 3, 1, block);
+        rewind(f_comp);
+        int64_t d_sz = c_sz > 0 ? zxc_stream_decompress(f_comp, f_out, 3, 1) : -1;
+        rewind(f_out);
+        if (d_sz != (int64_t)src_size || fread(out, 1, src_size, f_out) != src_size ||
+            memcmp(out, src, src_size) != 0) {
+            printf("Failed: linked stream round-trip\n");
+            ok = 0;
+        }
+    }
+
+    if (f_in) fclose(f_in);
+    if (f_comp) fclose(f_comp);
+    if (f_out) fclose(f_out);
+    zxc_free_pool(pool);
+    zxc_free_dctx(dctx);
+    zxc_free_cctx(cctx);
+    free(src);
+    free(ref);
+    free(comp);
+    free(comp2);
+    free(out);
+    if (!ok) return 0;
+    printf("PASS\n\n");
+    return 1;
+}
+
+// Checks that a dictionary shrinks small messages, that the frames carry its ID
+// and need it to decode, and that every compression path gives the same frame
+int test_dictionary() {
+    printf("=== TEST: Unit - Dictionaries (train, compress, decompress) ===\n");
+
+    const size_t block = 16 * 1024;
+    const size_t samples_cap = 256 * 1024;
+    const size_t big_size = 100 * 1000;
+    uint8_t* samples = malloc(samples_cap);
+    size_t sizes[96];
+    uint8_t* dict = malloc(ZXC_DICT_SIZE_MAX);
+    uint8_t msg[3000];
+    uint8_t* big = malloc(big_size);
+    size_t cap = zxc_compress_bound(big_size);
+    uint8_t* ref = malloc(cap);
+    uint8_t* comp = malloc(cap);
+    uint8_t* comp2 = malloc(cap);
+    uint8_t* out = malloc(big_size);
+    zxc_cctx_t* cctx = zxc_create_cctx();
+    zxc_cctx_t* cctx2 = zxc_create_cctx();
+    zxc_dctx_t* dctx = zxc_create_dctx();
+    zxc_pool_t* pool = zxc_create_pool(2);
+    int ok = samples && dict && big && ref && comp && comp2 && out && cctx && cctx2 && dctx &&
+             pool;
+
+    size_t total = 0, dict_size = 0;
+    for (size_t i = 0; ok && i < 96; i++) {
+        sizes[i] = gen_message(samples + total, 1000 + (size_t)(rand() % 2000));
+        total += sizes[i];
+    }
+    if (ok) {
+        dict_size = zxc_train_dict(dict, ZXC_DICT_SIZE_MAX, samples, sizes, 96);
+        if (dict_size == 0 || dict_size > ZXC_DICT_SIZE_MAX) {
+            printf("Failed: training gave %zu bytes\n", dict_size);
+            ok = 0;
+        }
+    }
+    const size_t msg_size = gen_message(msg, sizeof(msg));
+    for (size_t pos = 0; pos < big_size;) {
+        size_t n = gen_message(big + pos, big_size - pos < 3000 ? big_size - pos : 3000);
+        if (n == 0) {
+            ZXC_MEMSET(big + pos, ' ', big_size - pos);
+            break;
+        }
+        pos += n;
+    }
+    const uint32_t id = ok ? zxc_dict_id(dict, dict_size) : 0;
+
+    for (int level = 1; ok && level <= ZXC_LEVEL_MAX; level += (level < 3 ? 2 : 3)) {
+        zxc_cctx_load_dict(cctx, NULL, 0);
+        size_t r_sz = zxc_compress_cctx(cctx, msg, msg_size, ref, cap, level, 1, 0);
+        zxc_cctx_load_dict(cctx, dict, dict_size);
+        size_t c_sz = zxc_compress_cctx(cctx, msg, msg_size, comp, cap, level, 1, 0);
+        if (r_sz == 0 || c_sz == 0 || c_sz > r_sz * 3 / 4 || zxc_get_dict_id(comp, c_sz) != id ||
+            zxc_get_dict_id(ref, r_sz) != 0) {
+            printf("Failed: level %d with dictionary %zu bytes vs %zu\n", level, c_sz, r_sz);
+            ok = 0;
+            break;
+        }
+
+        // The indexed dictionary is reused: same frame again, after a frame whose
+        // later blocks overwrote the tables, and from a fresh context
+        size_t again = zxc_compress_cctx(cctx, msg, msg_size, comp2, cap, level, 1, 0);
+        int same = again == c_sz && memcmp(comp2, comp, c_sz) == 0;
+        zxc_compress_cctx(cctx, big, big_size, ref, cap, level, 1, block);
+        again = zxc_compress_cctx(cctx, msg, msg_size, comp2, cap, level, 1, 0);
+        same = same && again == c_sz && memcmp(comp2, comp, c_sz) == 0;
+        zxc_cctx_load_dict(cctx2, dict, dict_size);
+        again = zxc_compress_cctx(cctx2, msg, msg_size, comp2, cap, level, 1, 0);
+        same = same && again == c_sz && memcmp(comp2, comp, c_sz) == 0;
+        if (!same) {
+            printf("Failed: level %d output depends on the context history\n", level);
+            ok = 0;
+        }
+
+        // Decoding needs the dictionary
+        zxc_dctx_load_dict(dctx, dict, dict_size);
+        if (zxc_decompress_dctx(dctx, comp, c_sz, out, msg_size, 1) != msg_size ||
+            memcmp(out, msg, msg_size) != 0) {
+            printf("Failed: level %d decompression\n", level);
+            ok = 0;
+        }
+        if (zxc_decompress(comp, c_sz, out, msg_size, 1) != 0) {
+            printf("Failed: level %d decoded without the dictionary\n", level);
+            ok = 0;
+        }
+        zxc_dctx_load_dict(dctx, dict, dict_size - 1);
+        if (zxc_decompress_dctx(dctx, comp, c_sz, out, msg_size, 1) != 0) {
+            printf("Failed: level %d decoded with another dictionary\n", level);
+            ok = 0;
+        }
+
+        // Multi-block frames: only the first block uses the dictionary
+        c_sz = zxc_compress_cctx(cctx, big, big_size, comp, cap, level, 1, block);
+        zxc_pool_load_dict(pool, dict, dict_size);
+        size_t p_sz = zxc_compress_pool(pool, big, big_size, comp2, cap, level, 1, block);
+        if (c_sz == 0 || p_sz != c_sz || memcmp(comp2, comp, c_sz) != 0) {
+            printf("Failed: level %d pool output differs\n", level);
+            ok = 0;
+        }
+        ZXC_MEMSET(out, 0, big_size);
+        if (zxc_decompress_pool(pool, comp, c_sz, out, big_size, 1) != big_size ||
+            memcmp(out, big, big_size) != 0) {
+            printf("Failed: level %d pool decompression\n", level);
+            ok = 0;
+        }
+        const size_t r_off = 2 * block + 100, r_len = block;
+        if (zxc_decompress_range(comp, c_sz, r_off, r_len, out) != r_len ||
+            memcmp(out, big + r_off, r_len) != 0 ||
+            zxc_decompress_range(comp, c_sz, 100, r_len, out) != 0) {
+            printf("Failed: level %d range decompression\n", level);
+            ok = 0;
+        }
+        // The first block decodes again alone with the context's dictionary
+        zxc_block_cost_t bc;
+        zxc_dctx_load_dict(dctx, dict, dict_size);
+        ZXC_MEMSET(out, 0, block);
+        if (zxc_decompress_dctx(dctx, comp, c_sz, out, big_size, 1) != big_size ||
+            zxc_estimate_decode_cost(comp, c_sz, NULL, &bc, 1) == 0 ||
+            zxc_decompress_block_dctx(dctx, comp, c_sz, &bc, out, big_size, 1) != block ||
+            memcmp(out, big, big_size) != 0) {
+            printf("Failed: level %d block decompression\n", level);
+            ok = 0;
+        }
+        // Ranges of the first block decode with the context's dictionary
+        if (zxc_decompress_range_dctx(dctx, comp, c_sz, 100, r_len, out, 1) != r_len ||
+            memcmp(out, big + 100, r_len) != 0) {
+            printf("Failed: level %d first-block range with the dictionary\n", level);
+            ok = 0;
+        }
+
+        // Linked frames decode every range from the first block: only with the dictionary
+        zxc_cctx_set_linked_blocks(cctx, 1);
+        c_sz = zxc_compress_cctx(cctx, big, big_size, comp, cap, level, 1, block);
+        zxc_cctx_set_linked_blocks(cctx, 0);
+        const size_t l_off = big_size - 300;
+        if (c_sz == 0 || zxc_decompress_range(comp, c_sz, l_off, 200, out) != 0 ||
+            zxc_decompress_range_dctx(dctx, comp, c_sz, l_off, 200, out, 1) != 200 ||
+            memcmp(out, big + l_off, 200) != 0 ||
+            zxc_decompress_range_dctx(dctx, comp, c_sz, 100, r_len, out, 1) != r_len ||
+            memcmp(out, big + 100, r_len) != 0) {
+            printf("Failed: level %d linked range with the dictionary\n", level);
+            ok = 0;
+        }
+    }
+
+    // Streams: dictionary on the pool for both directions
+    FILE* f_in = ok ? tmpfile() : NULL;
+    FILE* f_comp = ok ? tmpfile() : NULL;
+    FILE* f_out = ok ? tmpfile() : NULL;
+    if (ok && (!f_in || !f_comp || !f_out)) ok = 0;
+    if (ok) {
+        fwrite(big, 1, big_size, f_in);
+        rewind(f_in);
+        zxc_pool_load_dict(pool, dict, dict_size);
+        int64_t c_sz = zxc_stream_compress_pool(pool, f_in, f_comp, 3, 1, block);
+        rewind(f_comp);
+        int64_t d_sz = c_sz > 0 ? zxc_stream_decompress_pool(pool, f_comp, f_out, 1) : -1;
+        rewind(f_out);
+        if (d_sz != (int64_t)big_size || fread(out, 1, big_size, f_out) != big_size ||
+            memcmp(out, big, big_size) != 0) {
+            printf("Failed: dictionary stream round-trip\n");
+            ok = 0;
+        }
+        rewind(f_comp);
+        if (zxc_stream_decompress(f_comp, f_out, 2, 1) >= 0) {
+            printf("Failed: stream decoded without the dictionary\n");
+            ok = 0;
+        }
+
+        // Linked blocks: the dictionary, then the previous block, as prefix
+        rewind(f_in);
+        rewind(f_comp);
+        rewind(f_out);
+        zxc_pool_set_linked_blocks(pool, 1);
+        c_sz = zxc_stream_compress_pool(pool, f_in, f_comp, 3, 1, block);
+        rewind(f_comp);
+        d_sz = c_sz > 0 ? zxc_stream_decompress_pool(pool, f_comp, f_out, 1) : -1;
+        rewind(f_out);
+        if (d_sz != (int64_t)big_size || fread(out, 1, big_size, f_out) != big_size ||
+            memcmp(out, big, big_size) != 0) {
+            printf("Failed: linked dictionary stream round-trip\n");
+            ok = 0;
+        }
+    }
+
+    if (f_in) fclose(f_in);
+    if (f_comp) fclose(f_comp);
+    if (f_out) fclose(f_out);
+    zxc_free_pool(pool);
+    zxc_free_cctx(cctx);
+    zxc_free_cctx(cctx2);
+    zxc_free_dctx(dctx);
+    free(samples);
+    free(dict);
+    free(big);
+    free(ref);
+    free(comp);
+    free(comp2);
+    free(out);
+    if (!ok) return 0;
+    printf("PASS\n\n");
+    return 1;
+}
+
+// Checks that a decode-cost bias keeps the output valid, lowers the estimated
+// decode cost, and gives the same output through a cctx and a pool
+int test_decode_cost_model() {
+    printf("=== TEST: Unit - Decode Cost Model (levels 6-9) ===\n");
+
+    const size_t src_size = 300 * 1000;
+    uint8_t* src = malloc(src_size);
+    gen_lz_data(src, src_size);
+    size_t cap = zxc_compress_bound(src_size);
+    uint8_t* ref = malloc(cap);
+    uint8_t* comp = malloc(cap);
+    uint8_t* out = malloc(src_size);
+    zxc_block_cost_t blocks[8];
+    zxc_block_cost_t ref_blocks[8];
+    zxc_cctx_t* cctx = zxc_create_cctx();
+    zxc_pool_t* pool = zxc_create_pool(2);
+    int ok = src && ref && comp && out && cctx && pool;
+
+    zxc_cost_model_t cm;
+    zxc_cost_model_init(&cm, 8);
+    size_t r_sz = ok ? zxc_compress_cctx(cctx, src, src_size, ref, cap, 9, 1, 0) : 0;
+    zxc_cctx_set_cost_model(cctx, &cm);
+    size_t c_sz = ok ? zxc_compress_cctx(cctx, src, src_size, comp, cap, 9, 1, 0) : 0;
+    if (ok && (r_sz == 0 || c_sz == 0 || zxc_decompress(comp, c_sz, out, src_size, 1) != src_size ||
+               memcmp(out, src, src_size) != 0)) {
+        printf("Failed: biased round-trip\n");
+        ok = 0;
+    }
+
+    // 300 KB in 256 KB blocks: two blocks, estimated with the same model
+    size_t n_ref = ok ? zxc_estimate_decode_cost(ref, r_sz, &cm, ref_blocks, 8) : 0;
+    size_t n = ok ? zxc_estimate_decode_cost(comp, c_sz, &cm, blocks, 8) : 0;
+    if (ok && (n != 2 || n_ref != 2 || zxc_estimate_decode_cost(comp, c_sz, &cm, NULL, 0) != 2)) {
+        printf("Failed: expected 2 blocks, got %zu / %zu\n", n, n_ref);
+        ok = 0;
+    }
+    uint64_t est = 0, est_ref = 0;
+    uint32_t seqs = 0, seqs_ref = 0;
+    for (size_t i = 0; ok && i < n; i++) {
+        est += blocks[i].est_cycles;
+        est_ref += ref_blocks[i].est_cycles;
+        seqs += blocks[i].n_sequences;
+        seqs_ref += ref_blocks[i].n_sequences;
+    }
+    if (ok && (est > est_ref || seqs > seqs_ref)) {
+        printf("Failed: biased cost %llu (%u seqs) > size-only %llu (%u seqs)\n",
+               (unsigned long long)est, seqs, (unsigned long long)est_ref, seqs_ref);
+        ok = 0;
+    }
+    if (ok && zxc_estimate_decode_cost(comp, c_sz / 2, &cm, NULL, 0) != 0) {
+        printf("Failed: truncated buffer was accepted\n");
+        ok = 0;
+    }
+
+    // The pool applies the same model to its contexts
+    zxc_pool_set_cost_model(pool, &cm);
+    size_t p_sz = ok ? zxc_compress_pool(pool, src, src_size, out, src_size, 9, 1, 0) : 0;
+    if (ok && (p_sz != c_sz || memcmp(out, comp, c_sz) != 0)) {
+        printf("Failed: pool output differs from cctx output\n");
+        ok = 0;
+    }
+
+    zxc_free_pool(pool);
+    zxc_free_cctx(cctx);
+    free(src);
+    free(ref);
+    free(comp);
+    free(out);
+    if (!ok) return 0;
+    printf("PASS\n\n");
+    return 1;
+}
+
+// Checks that a persistent pool gives the same results as one-shot calls, across
+// repeated stream and buffer operations with varying block sizes
+int test_thread_pool() {
+    printf("=== TEST: Unit - Persistent Thread Pool (zxc_pool_t) ===\n");
+
+    size_t src_size = 700 * 1000;
+    uint8_t* src = malloc(src_size);
+    gen_lz_data(src, src_size);
+    size_t cap = zxc_compress_bound(src_size);
+    uint8_t* ref = malloc(cap);
+    uint8_t* comp = malloc(cap);
+    uint8_t* out = malloc(src_size);
+    zxc_pool_t* pool = zxc_create_pool(3);
+    int ok = pool != NULL;
+
+    const size_t sizes[] = {ZXC_BLOCK_SIZE_MIN, 0, ZXC_BLOCK_SIZE_MIN * 4, 0};
+    for (int i = 0; ok && i < 4; i++) {
+        int level = 1 + i;
+        // Stream round trip on the pool, compared with a one-shot stream call
+        FILE* f_in = tmpfile();
+        FILE* f_ref = tmpfile();
+        FILE* f_comp = tmpfile();
+        FILE* f_out = tmpfile();
+        fwrite(src, 1, src_size, f_in);
+        fseek(f_in, 0, SEEK_SET);
+        int64_t r_sz = zxc_stream_compress(f_in, f_ref, 2, level, 1, sizes[i]);
+        fseek(f_in, 0, SEEK_SET);
+        int64_t c_sz = zxc_stream_compress_pool(pool, f_in, f_comp, level, 1, sizes[i]);
+        fseek(f_ref, 0, SEEK_SET);
+        fseek(f_comp, 0, SEEK_SET);
+        if (r_sz <= 0 || c_sz != r_sz || fread(ref, 1, (size_t)r_sz, f_ref) != (size_t)r_sz ||
+            fread(comp, 1, (size_t)c_sz, f_comp) != (size_t)c_sz ||
+            memcmp(ref, comp, (size_t)c_sz) != 0) {
+            printf("Failed: pooled stream compression differs (iteration %d)\n", i);
+            ok = 0;
+        }
+        fseek(f_comp, 0, SEEK_SET);
+        if (ok && (zxc_stream_decompress_pool(pool, f_comp, f_out, 1) != (int64_t)src_size ||
+                   fseek(f_out, 0, SEEK_SET) != 0 ||
+                   fread(out, 1, src_size, f_out) != src_size || memcmp(out, src, src_size) != 0)) {
+            printf("Failed: pooled stream decompression (iteration %d)\n", i);
+            ok = 0;
+        }
+        fclose(f_in);
+        fclose(f_ref);
+        fclose(f_comp);
+        fclose(f_out);
+
+        // Buffer calls on the same pool
+        size_t r = zxc_compress(src, src_size, ref, cap, level, 0, sizes[i]);
+        size_t c = zxc_compress_pool(pool, src, src_size, comp, cap, level, 0, sizes[i]);
+        if (ok && (r == 0 || c != r || memcmp(ref, comp, c) != 0 ||
+                   zxc_decompress_pool(pool, comp, c, out, src_size, 0) != src_size ||
+                   memcmp(out, src, src_size) != 0)) {
+            printf("Failed: pooled buffer API (iteration %d)\n", i);
+            ok = 0;
+        }
+    }
+
+    if (ok && (zxc_stream_compress_pool(NULL, stdin, NULL, 3, 0, 0) != -1 ||
+               zxc_compress_pool(NULL, src, src_size, comp, cap, 3, 0, 0) != 0)) {
+        printf("Failed: NULL pool should be rejected\n");
+        ok = 0;
+    }
+
+    zxc_free_pool(pool);
+    zxc_free_pool(NULL);
+    free(src);
+    free(ref);
+    free(comp);
+    free(out);
+    if (!ok) return 0;
+    printf("PASS\n\n");
+    return 1;
+}
+
+// Checks that parallel buffer compression reproduces zxc_compress() exactly
+int test_compress_mt() {
+    printf("=== TEST: Unit - Parallel Buffer Compression (zxc_compress_mt) ===\n");
+
+    void (*gens[])(uint8_t*, size_t) = {gen_lz_data, gen_num_data, gen_random_data,
+                                        gen_binary_data, gen_large_offset_data};
+    size_t src_size = 500 * 1000 + 11;
+    uint8_t* src = malloc(src_size);
+    size_t cap = zxc_compress_bound(src_size);
+    uint8_t* ref = malloc(cap);
+    uint8_t* comp = malloc(cap);
+    uint8_t* out = malloc(src_size);
+    int ok = 1;
+
+    for (int g = 0; ok && g < 5; g++) {
+        gens[g](src, src_size);
+        int level = 1 + g;
+        size_t bs = (g & 1) ? ZXC_BLOCK_SIZE_MIN : 0;
+        size_t r = zxc_compress(src, src_size, ref, cap, level, g & 1, bs);
+        size_t c = zxc_compress_mt(src, src_size, comp, cap, 3, level, g & 1, bs);
+        if (r == 0 || c != r || memcmp(comp, ref, r) != 0 ||
+            zxc_decompress(comp, c, out, src_size, 1) != src_size ||
+            memcmp(out, src, src_size) != 0) {
+            printf("Failed: parallel output differs (generator %d)\n", g);
+            ok = 0;
+        }
+        // Exact-size destination: too tight for the slot layout, still correct
+        memset(comp, 0, cap);
+        if (ok && (zxc_compress_mt(src, src_size, comp, r, 3, level, g & 1, bs) != r ||
+                   memcmp(comp, ref, r) != 0)) {
+            printf("Failed: tight destination (generator %d)\n", g);
+            ok = 0;
+        }
+    }
+
+    if (ok && (zxc_compress_mt(src, src_size, comp, 16, 2, 3, 0, 0) != 0 ||
+               zxc_compress_mt(src, src_size, comp, cap, 2, 3, 0, 1000) != 0)) {
+        printf("Failed: invalid arguments accepted\n");
+        ok = 0;
+    }
+
+    free(src);
+    free(ref);
+    free(comp);
+    free(out);
+    if (!ok) return 0;
+    printf("PASS\n\n");
+    return 1;
+}
+
+// Checks parallel buffer decompression against the sequential decoder
+int test_decompress_mt() {
+    printf("=== TEST: Unit - Parallel Buffer Decompression (zxc_decompress_mt) ===\n");
+
+    void (*gens[])(uint8_t*, size_t) = {gen_lz_data, gen_num_data, gen_random_data,
+                                        gen_small_offset_data, gen_large_offset_data};
+    size_t src_size = 600 * 1000 + 3;
+    uint8_t* src = malloc(src_size);
+    size_t cap = zxc_compress_bound(src_size);
+    uint8_t* comp = malloc(cap);
+    // Exact-size destination: any write past a block's region would overlap
+    // its neighbour or, for the last block, trip the sanitizers.
+    uint8_t* out = malloc(src_size);
+    zxc_pool_t* pool = zxc_create_pool(4);
+    int ok = pool != NULL;
+
+    for (int g = 0; ok && g < 5; g++) {
+        gens[g](src, src_size);
+        int level = 1 + g;
+        size_t c = zxc_compress(src, src_size, comp, cap, level, g & 1, ZXC_BLOCK_SIZE_MIN);
+        memset(out, 0, src_size);
+        if (c == 0 || zxc_decompress_mt(comp, c, out, src_size, 3, 1) != src_size ||
+            memcmp(out, src, src_size) != 0) {
+            printf("Failed: zxc_decompress_mt (generator %d)\n", g);
+            ok = 0;
+        }
+        memset(out, 0, src_size);
+        if (ok && (zxc_decompress_pool(pool, comp, c, out, src_size, 1) != src_size ||
+                   memcmp(out, src, src_size) != 0)) {
+            printf("Failed: zxc_decompress_pool (generator %d)\n", g);
+            ok = 0;
+        }
+        if (ok && zxc_decompress_pool(pool, comp, c, out, src_size - 1, 1) != 0) {
+            printf("Failed: undersized destination accepted (generator %d)\n", g);
+            ok = 0;
+        }
+    }
+
+    // Stream output (seek table) and a corrupted block
+    FILE* f_in = tmpfile();
+    FILE* f_comp = tmpfile();
+    fwrite(src, 1, src_size, f_in);
+    fseek(f_in, 0, SEEK_SET);
+    int64_t s_sz = zxc_stream_compress(f_in, f_comp, 2, 3, 1, 0);
+    fseek(f_comp, 0, SEEK_SET);
+    if (ok && (s_sz <= 0 || fread(comp, 1, (size_t)s_sz, f_comp) != (size_t)s_sz ||
+               zxc_decompress_mt(comp, (size_t)s_sz, out, src_size, 0, 1) != src_size ||
+               memcmp(out, src, src_size) != 0)) {
+        printf("Failed: parallel decode of stream output\n");
+        ok = 0;
+    }
+    fclose(f_in);
+    fclose(f_comp);
+    if (ok) {
+        comp[(size_t)s_sz / 2] ^= 0x55;
+        if (zxc_decompress_mt(comp, (size_t)s_sz, out, src_size, 3, 1) != 0) {
+            printf("Failed: corruption not detected\n");
+            ok = 0;
+        }
+    }
+
+    zxc_free_pool(pool);
+    free(src);
+    free(comp);
+    free(out);
+    if (!ok) return 0;
+    printf("PASS\n\n");
+    return 1;
+}
+
+// In-memory source/sink for the callback stream API
+typedef struct {
+    uint8_t* buf;
+    size_t size;
+    size_t pos;
+    int fail;
+} test_mem_io_t;
+
+static int64_t test_mem_read(void* opaque, void* buf, size_t len) {
+    test_mem_io_t* m = (test_mem_io_t*)opaque;
+    size_t n = m->size - m->pos < len ? m->size - m->pos : len;
+    memcpy(buf, m->buf + m->pos, n);
+    m->pos += n;
+    return (int64_t)n;
+}
+
+static const void* test_mem_borrow(void* opaque, size_t len, size_t* avail) {
+    test_mem_io_t* m = (test_mem_io_t*)opaque;
+    size_t n = m->size - m->pos < len ? m->size - m->pos : len;
+    const uint8_t* p = m->buf + m->pos;
+    m->pos += n;
+    *avail = n;
+    return p;
+}
+
+static int test_mem_write(void* opaque, const void* buf, size_t len) {
+    test_mem_io_t* m = (test_mem_io_t*)opaque;
+    if (m->fail || len > m->size - m->pos) return -1;
+    memcpy(m->buf + m->pos, buf, len);
+    m->pos += len;
+    return 0;
+}
+
+// Checks the callback stream API against the FILE-based one
+int test_stream_callbacks() {
+    printf("=== TEST: Unit - Callback Stream I/O (zxc_stream_*_cb) ===\n");
+
+    size_t src_size = 500 * 1000 + 17;
+    uint8_t* src = malloc(src_size);
+    gen_lz_data(src, src_size);
+    size_t cap = zxc_compress_bound(src_size);
+    uint8_t* ref = malloc(cap);
+    uint8_t* comp = malloc(cap);
+    uint8_t* out = malloc(src_size);
+    int ok = 1;
+
+    FILE* f_in = tmpfile();
+    FILE* f_ref = tmpfile();
+    fwrite(src, 1, src_size, f_in);
+    fseek(f_in, 0, SEEK_SET);
+    int64_t r_sz = zxc_stream_compress(f_in, f_ref, 2, 3, 1, ZXC_BLOCK_SIZE_MIN * 4);
+    fseek(f_ref, 0, SEEK_SET);
+    if (r_sz <= 0 || fread(ref, 1, (size_t)r_sz, f_ref) != (size_t)r_sz) ok = 0;
+    fclose(f_in);
+    fclose(f_ref);
+
+    // Both reader flavours must produce the FILE API output and read it back
+    for (int use_borrow = 0; ok && use_borrow < 2; use_borrow++) {
+        test_mem_io_t m_src = {src, src_size, 0, 0};
+        test_mem_io_t m_comp = {comp, cap, 0, 0};
+        zxc_reader_t in = {&m_src, use_borrow ? NULL : test_mem_read,
+                           use_borrow ? test_mem_borrow : NULL, src_size};
+        zxc_writer_t wr = {&m_comp, test_mem_write};
+        int64_t c_sz = zxc_stream_compress_cb(&in, &wr, 2, 3, 1, ZXC_BLOCK_SIZE_MIN * 4);
+        if (c_sz != r_sz || m_comp.pos != (size_t)c_sz || memcmp(comp, ref, (size_t)c_sz) != 0) {
+            printf("Failed: callback compression differs (borrow=%d)\n", use_borrow);
+            ok = 0;
+            break;
+        }
+
+        test_mem_io_t m_in = {comp, (size_t)c_sz, 0, 0};
+        test_mem_io_t m_out = {out, src_size, 0, 0};
+        zxc_reader_t in_c = {&m_in, use_borrow ? NULL : test_mem_read,
+                             use_borrow ? test_mem_borrow : NULL, 0};
+        zxc_writer_t wr_d = {&m_out, test_mem_write};
+        if (zxc_stream_decompress_cb(&in_c, &wr_d, 3, 1) != (int64_t)src_size ||
+            memcmp(out, src, src_size) != 0) {
+            printf("Failed: callback decompression (borrow=%d)\n", use_borrow);
+            ok = 0;
+        }
+    }
+
+    // Errors: failing writer, wrong announced size, missing callbacks
+    test_mem_io_t m_src = {src, src_size, 0, 0};
+    test_mem_io_t m_fail = {comp, cap, 0, 1};
+    zxc_reader_t in = {&m_src, NULL, test_mem_borrow, src_size};
+    zxc_writer_t wr_fail = {&m_fail, test_mem_write};
+    if (ok && zxc_stream_compress_cb(&in, &wr_fail, 2, 3, 0, 0) != -1) {
+        printf("Failed: write error not reported\n");
+        ok = 0;
+    }
+    m_src.pos = 0;
+    in.content_size = src_size + 1;
+    if (ok && zxc_stream_compress_cb(&in, NULL, 2, 3, 0, 0) != -1) {
+        printf("Failed: content size mismatch not reported\n");
+        ok = 0;
+    }
+    zxc_reader_t none = {&m_src, NULL, NULL, 0};
+    if (ok && (zxc_stream_compress_cb(&none, NULL, 2, 3, 0, 0) != -1 ||
+               zxc_stream_decompress_cb(NULL, NULL, 2, 0) != -1)) {
+        printf("Failed: invalid reader accepted\n");
+        ok = 0;
+    }
+
+    free(src);
+    free(ref);
+    free(comp);
+    free(out);
+    if (!ok) return 0;
+    printf("PASS\n\n");
+    return 1;
+}
+
+// Checks that FILE inputs (mapped when they are regular files) honour the stream position
+int test_stream_file_offset() {
+    printf("=== TEST: Unit - Stream Input At An Offset (mapped input) ===\n");
+
+    const size_t prefix = 1000;
+    size_t src_size = 400 * 1000;
+    uint8_t* src = malloc(src_size);
+    gen_lz_data(src, src_size);
+    size_t cap = zxc_compress_bound(src_size);
+    uint8_t* comp = malloc(cap);
+    uint8_t* junk = calloc(1, prefix);
+    int ok = 1;
+
+    // Compression starts at the current position and leaves the stream at its end
+    FILE* f_in = tmpfile();
+    FILE* f_comp = tmpfile();
+    fwrite(junk, 1, prefix, f_in);
+    fwrite(src, 1, src_size, f_in);
+    fseek(f_in, (long)prefix, SEEK_SET);
+    int64_t c_sz = zxc_stream_compress(f_in, f_comp, 2, 3, 1, 0);
+    if (c_sz <= 0 || ftell(f_in) != (long)(prefix + src_size)) {
+        printf("Failed: compression from an offset\n");
+        ok = 0;
+    }
+
+    // Decompression of a stream that does not start at offset 0
+    FILE* f_dec = tmpfile();
+    FILE* f_out = tmpfile();
+    fseek(f_comp, 0, SEEK_SET);
+    if (ok && fread(comp, 1, (size_t)c_sz, f_comp) != (size_t)c_sz) ok = 0;
+    fwrite(junk, 1, prefix, f_dec);
+    fwrite(comp, 1, (size_t)c_sz, f_dec);
+    fseek(f_dec, (long)prefix, SEEK_SET);
+    uint8_t* out = malloc(src_size);
+    if (ok && (zxc_stream_decompress(f_dec, f_out, 2, 1) != (int64_t)src_size ||
+               fseek(f_out, 0, SEEK_SET) != 0 || fread(out, 1, src_size, f_out) != src_size ||
+               memcmp(out, src, src_size) != 0)) {
+        printf("Failed: decompression from an offset\n");
+        ok = 0;
+    }
+    // The buffer API decodes what the stream API produced
+    if (ok && (zxc_decompress(comp, (size_t)c_sz, out, src_size, 1) != src_size ||
+               memcmp(out, src, src_size) != 0)) {
+        printf("Failed: buffer decode of stream output\n");
+        ok = 0;
+    }
+
+    fclose(f_in);
+    fclose(f_comp);
+    fclose(f_dec);
+    fclose(f_out);
+    free(src);
+    free(comp);
+    free(junk);
+    free(out);
+    if (!ok) return 0;
+    printf("PASS\n\n");
+    return 1;
+}
+
+// Checks the optional content size field of the file header
+int test_decompressed_size() {
+    printf("=== TEST: Unit - Content Size (zxc_get_decompressed_size) ===\n");
+
+    size_t src_size = 300 * 1000;
+    uint8_t* src = malloc(src_size);
+    gen_lz_data(src, src_size);
+    size_t cap = zxc_compress_bound(src_size);
+    uint8_t* comp = malloc(cap);
+    uint8_t* out = malloc(src_size);
+    int ok = 1;
+
+    // 1. Buffer API always records the size
+    size_t comp_size = zxc_compress(src, src_size, comp, cap, 3, 0, 0);
+    if (comp_size == 0 || zxc_get_decompressed_size(comp, comp_size) != src_size) {
+        printf("Failed: buffer output does not report its content size\n");
+        ok = 0;
+    }
+
+    // 2. Known size lets zxc_decompress reject a short destination up front
+    if (ok && zxc_decompress(comp, comp_size, out, src_size - 1, 0) != 0) {
+        printf("Failed: zxc_decompress should fail when dst < content size\n");
+        ok = 0;
+    }
+
+    // 3. Stream API records the size of seekable inputs
+    FILE* f_in = tmpfile();
+    FILE* f_comp = tmpfile();
+    fwrite(src, 1, src_size, f_in);
+    fseek(f_in, 0, SEEK_SET);
+    int64_t stream_size = zxc_stream_compress(f_in, f_comp, 2, 3, 0, 0);
+    if (ok && (stream_size <= 0 || (size_t)stream_size > cap)) {
+        printf("Failed: zxc_stream_compress returned %lld\n", (long long)stream_size);
+        ok = 0;
+    }
+    if (ok) {
+        fseek(f_comp, 0, SEEK_SET);
+        size_t got = fread(comp, 1, (size_t)stream_size, f_comp);
+        if (zxc_get_decompressed_size(comp, got) != src_size) {
+            printf("Failed: stream output does not report its content size\n");
+            ok = 0;
+        }
+        // Without the header field, the seek table still knows the total
+        comp[6] = 0;
+        if (ok && zxc_get_decompressed_size(comp, got) != src_size) {
+            printf("Failed: seek table fallback\n");
+            ok = 0;
+        }
+    }
+    fclose(f_in);
+    fclose(f_comp);
+
+    // 4. Garbage is reported as unknown
+    if (ok && zxc_get_decompressed_size(src, 64) != 0) {
+        printf("Failed: invalid header should report 0\n");
+        ok = 0;
+    }
+
+    free(src);
+    free(comp);
+    free(out);
+    if (!ok) return 0;
+    printf("PASS\n\n");
+    return 1;
+}
+
 /*
  * Test for zxc_br_init and zxc_br_ensure
  */
@@ -606,6 +2601,8 @@ int main() {
     if (!test_round_trip("Level 3", buffer, BUF_SIZE, 3, 1)) total_failures++;
     if (!test_round_trip("Level 4", buffer, BUF_SIZE, 4, 1)) total_failures++;
     if (!test_round_trip("Level 5", buffer, BUF_SIZE, 5, 1)) total_failures++;
+    if (!test_round_trip("Level 6", buffer, BUF_SIZE, 6, 1)) total_failures++;
+    if (!test_round_trip("Level 9", buffer, BUF_SIZE, 9, 1)) total_failures++;
 
     printf("\n--- Test Coverage: Binary Data Preservation ---\n");
     gen_binary_data(buffer, BUF_SIZE);
@@ -641,8 +2638,25 @@ int main() {
     // --- UNIT TESTS (ROBUSTNESS/API) ---
 
     if (!test_buffer_api()) total_failures++;
+    if (!test_decompress_range()) total_failures++;
+    if (!test_decompressed_size()) total_failures++;
+    if (!test_context_reuse()) total_failures++;
+    if (!test_optimal_levels()) total_failures++;
+    if (!test_huffman_literals()) total_failures++;
+    if (!test_binary_tree_finder()) total_failures++;
+    if (!test_far_offsets()) total_failures++;
+    if (!test_linked_blocks()) total_failures++;
+    if (!test_dictionary()) total_failures++;
+    if (!test_decode_cost_model()) total_failures++;
+    if (!test_block_sizes()) total_failures++;
 
     if (!test_multithread_roundtrip()) total_failures++;
+    if (!test_multithread_pipeline()) total_failures++;
+    if (!test_thread_pool()) total_failures++;
+    if (!test_compress_mt()) total_failures++;
+    if (!test_decompress_mt()) total_failures++;
+    if (!test_stream_callbacks()) total_failures++;
+    if (!test_stream_file_offset()) total_failures++;
 
     if (!test_max_compressed_size_logic()) total_failures++;
     if (!test_invalid_arguments()) total_failures++;
@@ -650,6 +2664,14 @@ int main() {
     if (!test_thread_params()) total_failures++;
     if (!test_bit_reader()) total_failures++;
     if (!test_bitpack()) total_failures++;
+    if (!test_packed_offsets()) total_failures++;
+    if (!test_repeat_offsets()) total_failures++;
+    if (!test_block_trials()) total_failures++;
+    if (!test_num_widths()) total_failures++;
+    if (!test_num_element_widths()) total_failures++;
+    if (!test_float_blocks()) total_failures++;
+    if (!test_shuffle_filter()) total_failures++;
+    if (!test_bcj_filter()) total_failures++;
 
     if (total_failures > 0) {
         printf("FAILED: %d tests failed.\n", total_failures);